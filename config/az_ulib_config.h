@@ -17,12 +17,17 @@ extern "C"
  */
 
 /**
- * @brief   IPC public API shall validate the contract
+ * @brief   IPC shall validate the contract of the interfaces
  *
- * This definition enables the argument check on all IPC public APIs. This check will verify if the
- * provided arguments follow the contract defined in the documentation.
+ * This definition enables the contract fingerprint of the interfaces. On az_ulib_ipc_publish(), the
+ * IPC computes a 32 bits hash of the name, type, and order of all capabilities in the descriptor,
+ * the same one returned by az_ulib_ipc_get_contract(). A consumer that knows the contract that it
+ * was built for may get the interface with az_ulib_ipc_try_get_interface_with_contract(), which
+ * validates all capabilities with a single compare, and use its capability indexes without
+ * calling az_ulib_ipc_try_get_capability() for each one of them.
  *
- * Commenting this definition, the IPC public APIs will not test any of the received arguments.
+ * Commenting this definition will remove these APIs and the fingerprint from each interface in
+ * the IPC.
  */
 #define AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
 
@@ -46,13 +51,45 @@ extern "C"
  */
 #define AZ_ULIB_CONFIG_MAX_IPC_INSTANCES 20
 
+/**
+ * @brief   Number of buckets in the IPC interface index.
+ *
+ * The IPC keeps a hash index of the published interfaces by name, where each bucket points to the
+ * list of versions of one interface name. This value shall be a power of 2 and bigger than
+ * #AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; keeping it at least twice as big will keep the lookups short.
+ *
+ * Each bucket uses 2 bytes of the memory reserved to the IPC.
+ */
+#define AZ_ULIB_CONFIG_IPC_INTERFACE_INDEX_SIZE 32
+
+/**
+ * @brief   Number of buckets in the capability index of each IPC interface.
+ *
+ * When an interface is published, the IPC builds a hash index of its capability names, so
+ * az_ulib_ipc_try_get_capability() finds a capability without comparing its name with the names of
+ * all the other capabilities. Interfaces with more than half of this number of capabilities are
+ * searched linearly. This value shall be a power of 2 up to 256, or 0 to remove the index.
+ *
+ * Each bucket uses 1 byte of the memory reserved to the IPC for each interface.
+ */
+#define AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE 64
+
+/**
+ * @brief   Maximum number of subscriptions to the IPC registry.
+ *
+ * Defines the maximum number of active az_ulib_ipc_subscribe() at the same time. Each subscription
+ * uses one `_az_ulib_ipc_subscription` in the memory reserved to the IPC, and publish and unpublish
+ * visit all of them to report the change.
+ */
+#define AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS 8
+
 #ifndef AZ_ULIB_CONFIG_REMOVE_UNPUBLISH
 /**
  * @brief   Enable unpublish on IPC.
  *
  * @note    Comment this line will:
  *            - Improve performance.
- *            - Reduce memory by 2 longs per IPC interface.
+ *            - Reduce memory by #AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS cache lines per IPC interface.
  *            - Remove the API az_ulib_ipc_unpublish.
  *
  * To allow users to unpublish interfaces in the IPC, it is necessary to add a flag to avoid an
@@ -67,6 +104,172 @@ extern "C"
 #define AZ_ULIB_CONFIG_IPC_UNPUBLISH
 #endif /*AZ_ULIB_CONFIG_REMOVE_UNPUBLISH*/
 
+/**
+ * @brief   Number of shards of the counter of running calls in each IPC interface.
+ *
+ * With #AZ_ULIB_CONFIG_IPC_UNPUBLISH, each call counts itself in the interface while it runs. To
+ * avoid that threads calling the same interface fight for the same cache line, the counter is
+ * split in shards, each one in its own cache line, and each thread uses one shard. This value
+ * shall be a power of 2; use 1 to keep a single counter per interface.
+ *
+ * Each shard uses one `AZ_ULIB_PORT_CACHE_LINE_SIZE` of the memory reserved to the IPC for each
+ * interface. Ports without `AZ_ULIB_PORT_THREAD_LOCAL` always use a single shard.
+ */
+#define AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS 4
+
+#ifdef AZ_ULIB_CONFIG_ADD_IPC_ASYNC
+/**
+ * @brief   Enable asynchronous calls on IPC.
+ *
+ * @note    Define this will:
+ *            - Create #AZ_ULIB_CONFIG_IPC_ASYNC_WORKERS worker threads in az_ulib_ipc_init().
+ *            - Reserve the asynchronous call queue and the worker threads in the memory reserved
+ *              to the IPC.
+ *            - Add the APIs az_ulib_ipc_call_async and az_ulib_ipc_cancel_async.
+ *
+ * @note  **The asynchronous calls are disabled by default, and without them the IPC creates no
+ *        threads. To enable it, define AZ_ULIB_CONFIG_ADD_IPC_ASYNC as part of the make file that
+ *        will build the project. For cmake, use the option -DADD_IPC_ASYNC.**
+ */
+#define AZ_ULIB_CONFIG_IPC_ASYNC
+
+/**
+ * @brief   Number of worker threads that run the asynchronous calls.
+ *
+ * The IPC creates these threads in az_ulib_ipc_init() and joins them in az_ulib_ipc_deinit(). It
+ * defines how many asynchronous calls may run in parallel.
+ */
+#define AZ_ULIB_CONFIG_IPC_ASYNC_WORKERS 2
+
+/**
+ * @brief   Maximum number of pending asynchronous calls.
+ *
+ * Defines the maximum number of asynchronous calls queued or in execution at the same time. Each
+ * pending call uses one `_az_ulib_ipc_async_call` in the memory reserved to the IPC.
+ */
+#define AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE 16
+#endif /*AZ_ULIB_CONFIG_ADD_IPC_ASYNC*/
+
+#ifdef AZ_ULIB_CONFIG_ADD_SEGMENTED_REGISTRY
+/**
+ * @brief   Enable the segmented registry on IPC.
+ *
+ * @note    Define this will:
+ *            - Allow the IPC to publish more than #AZ_ULIB_CONFIG_MAX_IPC_INTERFACE interfaces, if
+ *              the IPC was initialized with az_ulib_ipc_init_with_allocator().
+ *            - Remove the #AZ_ULIB_CONFIG_MAX_IPC_INSTANCES limit.
+ *            - Add the API az_ulib_ipc_init_with_allocator.
+ *
+ * The `interface_list` in the IPC control block is the first segment of the registry. When it is
+ * full, publish allocates a new segment of #AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE interfaces, and, if
+ * needed, a bigger interface index. Segments never move, so the interface handles stay valid, and
+ * all the memory allocated by the IPC is released by az_ulib_ipc_deinit().
+ *
+ * @note  **This registry is disabled by default, to keep the fixed memory of the MCU builds. To
+ *        enable it, define AZ_ULIB_CONFIG_ADD_SEGMENTED_REGISTRY as part of the make file that
+ *        will build the project. For cmake, use the option -DADD_IPC_SEGMENTED_REGISTRY.**
+ */
+#define AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+/**
+ * @brief   Number of interfaces in each segment of the IPC registry.
+ *
+ * This value shall be a power of 2. Each segment is allocated at once when the registry is full.
+ */
+#define AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE 64
+
+/**
+ * @brief   Maximum number of segments in the IPC registry.
+ *
+ * Each segment uses 2 pointers of the memory reserved to the IPC. The IPC may publish up to
+ * #AZ_ULIB_CONFIG_MAX_IPC_INTERFACE plus #AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE times this value
+ * interfaces, which shall be smaller than 65535.
+ */
+#define AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS 256
+#endif /*AZ_ULIB_CONFIG_ADD_SEGMENTED_REGISTRY*/
+
+#ifdef AZ_ULIB_CONFIG_ADD_IPC_STATS
+/**
+ * @brief   Enable the call statistics on IPC.
+ *
+ * @note    Define this will:
+ *            - Count the calls, the errors, and the latency of the first
+ *              #AZ_ULIB_CONFIG_IPC_STATS_MAX_CAPABILITIES capabilities of each interface in the
+ *              synchronous calls.
+ *            - Add the API az_ulib_ipc_get_stats.
+ *            - Publish the `ipc_stats` interface in az_ulib_ipc_init().
+ *
+ * Each thread counts its calls in the same shard of #AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS used by the
+ * running counter, and az_ulib_ipc_get_stats() adds the shards. The latency is measured with
+ * az_pal_os_clock_us().
+ *
+ * @note  **The statistics are disabled by default, and without them the IPC calls have no extra
+ *        code. To enable it, define AZ_ULIB_CONFIG_ADD_IPC_STATS as part of the make file that
+ *        will build the project. For cmake, use the option -DADD_IPC_STATS.**
+ */
+#define AZ_ULIB_CONFIG_IPC_STATS
+
+/**
+ * @brief   Number of capabilities with statistics in each interface.
+ *
+ * Each capability uses `(2 + #AZ_ULIB_CONFIG_IPC_STATS_LATENCY_BUCKETS)` longs for each shard of
+ * each interface in the memory reserved to the IPC.
+ */
+#define AZ_ULIB_CONFIG_IPC_STATS_MAX_CAPABILITIES 8
+
+/**
+ * @brief   Number of buckets in the latency histogram of each capability.
+ *
+ * The bucket `0` counts the calls that took less than 1 microsecond, the bucket `n` counts the
+ * calls that took from `2^(n-1)` to `2^n - 1` microseconds, and the last bucket also counts all
+ * the calls that took longer than that.
+ */
+#define AZ_ULIB_CONFIG_IPC_STATS_LATENCY_BUCKETS 16
+
+/**
+ * @brief   Maximum number of bytes of each capability name returned by the `ipc_stats` interface.
+ *
+ * The `ipc_stats` interface copies the names before it releases the interface, because the
+ * descriptor that owns the names may be unpublished and released right after that.
+ */
+#define AZ_ULIB_CONFIG_IPC_STATS_NAME_SIZE 32
+#endif /*AZ_ULIB_CONFIG_ADD_IPC_STATS*/
+
+#ifdef AZ_ULIB_CONFIG_ADD_IPC_TRACE
+/**
+ * @brief   Enable the call tracing on IPC.
+ *
+ * @note    Define this will:
+ *            - Reserve one ring of #AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE events for each shard of
+ *              #AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS in the IPC control block.
+ *            - Add the APIs az_ulib_ipc_trace_enable and az_ulib_ipc_trace_dump.
+ *
+ * While the tracing is enabled, each synchronous call records a begin and an end event, and each
+ * publish and unpublish records an instant event, in the ring of the shard of the thread that runs
+ * it, with the id of this thread. While it is disabled, a call only tests one flag.
+ *
+ * @note  **The tracing is disabled by default, and without it the IPC calls have no extra code.
+ *        To enable it, define AZ_ULIB_CONFIG_ADD_IPC_TRACE as part of the make file that will
+ *        build the project. For cmake, use the option -DADD_IPC_TRACE.**
+ */
+#define AZ_ULIB_CONFIG_IPC_TRACE
+
+/**
+ * @brief   Number of events in each ring of the IPC trace. It shall be a power of 2.
+ *
+ * When a ring is full, the new events overwrite the oldest ones.
+ */
+#define AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE 64
+
+/**
+ * @brief   Maximum number of bytes of the interface name recorded in each event of the IPC trace.
+ *
+ * Each event keeps its own copy of the name, because the descriptor that owns the name may be
+ * released before the trace is dumped. Longer names are truncated.
+ */
+#define AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE 32
+#endif /*AZ_ULIB_CONFIG_ADD_IPC_TRACE*/
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
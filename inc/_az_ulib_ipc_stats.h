@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#ifndef _az_ULIB_IPC_STATS_H
+#define _az_ULIB_IPC_STATS_H
+
+#include "az_ulib_result.h"
+
+#include "azure/core/_az_cfg_prefix.h"
+
+/*
+ * Publish IPC stats interface.
+ */
+az_result _az_ulib_ipc_stats_interface_publish(void);
+
+/*
+ * Unpublish IPC stats interface.
+ */
+az_result _az_ulib_ipc_stats_interface_unpublish(void);
+
+#include "azure/core/_az_cfg_suffix.h"
+
+#endif /* _az_ULIB_IPC_STATS_H */
@@ -153,6 +153,28 @@ typedef az_result (
 typedef az_result (
     *az_ulib_capability_command_span_wrapper)(az_span model_in_span, az_span* model_out_span);
 
+/**
+ * @brief       Call a capability in the interface using a binary TLV buffer in `az_span`.
+ *
+ * This type defines the same synchronous command as #az_ulib_capability_command_span_wrapper, but
+ * both `model_in` and `model_out` shall be TLV buffers, written and read with the APIs in
+ * az_ulib_tlv.h. The interface defines the tag of each field in the models.
+ *
+ * @param[in]   model_in_binary     The `az_span` that contains a TLV buffer with the input
+ *                                  arguments for the command. It may be empty, the IPC will not
+ *                                  validate it. The command itself shall implement any needed
+ *                                  validation.
+ * @param[out]  model_out_binary    The `az_span*` that contains the memory to store the TLV buffer
+ *                                  with the output arguments from the command. The command shall
+ *                                  resize it to the written fields.
+ *
+ * @return The #az_result with the result of the command call. All possible results shall be
+ * defined as part of the interface.
+ */
+typedef az_result (*az_ulib_capability_command_binary_wrapper)(
+    az_span model_in_binary,
+    az_span* model_out_binary);
+
 /**
  * @brief       IPC asynchronous task signature.
  */
@@ -74,6 +74,12 @@ typedef struct az_ulib_capability_descriptor_tag
       const az_ulib_capability_set_span_wrapper set;
     } span_wrapper_ptr_2;
 
+    /** The binary wrapper of the capability. */
+    const union
+    {
+      const az_ulib_capability_command_binary_wrapper command;
+    } binary_wrapper_ptr_1;
+
     /** This is an 8 bit flag that handles the internal status of the capability. */
     const uint8_t flags;
 
@@ -107,6 +113,10 @@ typedef struct az_ulib_interface_descriptor_tag
 
 /**
  * @brief Interface handle.
+ *
+ * The handle identifies the interface in the IPC, and it is not a pointer. Once the interface is
+ * unpublished, all calls using the handle return #AZ_ERROR_ITEM_NOT_FOUND, even if the IPC reuses
+ * the same memory to publish another interface.
  */
 typedef void* az_ulib_ipc_interface_handle;
 
@@ -203,6 +213,37 @@ typedef void* az_ulib_ipc_interface_handle;
            .flags = (uint8_t)(AZ_ULIB_CAPABILITY_TYPE_COMMAND) }                             \
   }
 
+/**
+ * @brief   Add a synchronous command with a binary wrapper to the interface descriptor.
+ *
+ * Populate a new [*synchronous command* capability](#AZ_ULIB_CAPABILITY_TYPE_COMMAND) that can
+ * also be called with az_ulib_ipc_call_with_binary().
+ *
+ * @param[in] command_name            The `/0` terminated `const char* const` with the command
+ *                                    name. It cannot be `NULL` and shall be allocated in a way
+ *                                    that it stays valid until the interface is unpublished at
+ *                                    some (potentially) unknown time in the future.
+ * @param[in] command_concrete        The function pointer to #az_ulib_capability_command with the
+ *                                    implementation of the synchronous command.
+ * @param[in] command_span_wrapper    The function pointer to
+ *                                    #az_ulib_capability_command_span_wrapper with the wrapper for
+ *                                    the command using strings in `az_span`.
+ * @param[in] command_binary_wrapper  The function pointer to
+ *                                    #az_ulib_capability_command_binary_wrapper with the wrapper
+ *                                    for the command using TLV buffers in `az_span`.
+ * @return The #az_ulib_capability_descriptor with the command.
+ */
+#define AZ_ULIB_DESCRIPTOR_ADD_COMMAND_WITH_BINARY(                               \
+    command_name, command_concrete, command_span_wrapper, command_binary_wrapper) \
+  {                                                                               \
+    ._internal                                                                    \
+        = {.name = AZ_SPAN_LITERAL_FROM_STR(command_name),                        \
+           .capability_ptr_1 = { .command = command_concrete },                   \
+           .span_wrapper_ptr_1 = { .command = command_span_wrapper },             \
+           .binary_wrapper_ptr_1 = { .command = command_binary_wrapper },         \
+           .flags = (uint8_t)(AZ_ULIB_CAPABILITY_TYPE_COMMAND) }                  \
+  }
+
 /**
  * @brief   Add an asynchronous command to the interface descriptor.
  *
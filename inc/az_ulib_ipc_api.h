@@ -32,6 +32,94 @@
 
 #include "azure/core/_az_cfg_prefix.h"
 
+#ifdef AZ_ULIB_PORT_THREAD_LOCAL
+#define _AZ_ULIB_IPC_RUNNING_SHARDS AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS
+#else
+#define _AZ_ULIB_IPC_RUNNING_SHARDS 1
+#endif // AZ_ULIB_PORT_THREAD_LOCAL
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+/*
+ * Shard of the counters of calls running in an interface, one counter per unpublish epoch. Each
+ * shard starts in its own cache line.
+ */
+typedef struct
+{
+  AZ_ULIB_PORT_CACHE_ALIGNED volatile long running_count[2];
+} _az_ulib_ipc_running_shard;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+/*
+ * Counters of the calls to one capability.
+ */
+typedef struct
+{
+  volatile long call_count;
+  volatile long error_count;
+  volatile long latency_histogram[AZ_ULIB_CONFIG_IPC_STATS_LATENCY_BUCKETS];
+} _az_ulib_ipc_capability_counters;
+
+/*
+ * Shard of the statistics of the capabilities in an interface, used by the threads that use the
+ * same shard of the running counter. Each shard starts in its own cache line.
+ */
+typedef struct
+{
+  AZ_ULIB_PORT_CACHE_ALIGNED _az_ulib_ipc_capability_counters
+      capability_list[AZ_ULIB_CONFIG_IPC_STATS_MAX_CAPABILITIES];
+} _az_ulib_ipc_stats_shard;
+
+/**
+ * @brief   Statistics of the calls to one capability, returned by az_ulib_ipc_get_stats().
+ */
+typedef struct
+{
+  /** The `az_span` with the name of the capability. It points to the interface descriptor. */
+  az_span name;
+
+  /** The `uint32_t` with the number of calls. */
+  uint32_t call_count;
+
+  /** The `uint32_t` with the number of calls that returned an error. */
+  uint32_t error_count;
+
+  /** The `uint32_t` with the number of calls in each latency bucket. See
+   *  #AZ_ULIB_CONFIG_IPC_STATS_LATENCY_BUCKETS. */
+  uint32_t latency_histogram[AZ_ULIB_CONFIG_IPC_STATS_LATENCY_BUCKETS];
+} az_ulib_ipc_capability_stats;
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+/*
+ * Event in the IPC trace. The sequence is the position of the event in its ring plus 1, and it is
+ * only written after all other fields, so a reader can detect an event that is not complete or
+ * was overwritten. The event keeps a copy of the interface name, truncated to
+ * #AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE bytes, because the descriptor may be gone when it is dumped.
+ */
+typedef struct
+{
+  volatile long sequence;
+  long thread_id;
+  az_ulib_version version;
+  uint32_t timestamp;
+  az_result result;
+  az_ulib_capability_index capability_index;
+  uint8_t type;
+  uint8_t name_size;
+  uint8_t name[AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE];
+} _az_ulib_ipc_trace_event;
+
+/*
+ * Ring of trace events written by the threads that use the same shard of the running counter.
+ */
+typedef struct
+{
+  AZ_ULIB_PORT_CACHE_ALIGNED volatile long head;
+  _az_ulib_ipc_trace_event event_list[AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE];
+} _az_ulib_ipc_trace_ring;
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
+
 /*
  * IPC interface control block.
  */
@@ -39,12 +127,98 @@ typedef struct
 {
   volatile const az_ulib_interface_descriptor* interface_descriptor;
   volatile long ref_count;
+
+  /* Copy of the descriptor key, used by the interface index. */
+  az_span name;
+  uint32_t name_hash;
+  az_ulib_version version;
+
+  /* Next interface with the same name and a higher version. */
+  uint16_t next_version;
+
+  /* Number of times that an interface was unpublished from this slot, it is part of the handle. */
+  volatile uint16_t generation;
+
+  /* Registry generation when the interface was published, used to validate the query tokens. */
+  uint32_t publish_generation;
+
+  /* Registry generation when a version with the same name was last published or unpublished, used
+   * to validate the query tokens of a name with a limited version range. */
+  uint32_t name_generation;
+
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+  /* Fingerprint of the capabilities in the descriptor, see az_ulib_ipc_get_contract(). */
+  uint32_t contract;
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+
+#if AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+  /* Hash index of the capability names, each bucket has the capability index plus 1, or 0. */
+  uint8_t capability_index[AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE];
+#endif // AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+
 #ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-  volatile long running_count;
-  volatile long running_count_low_watermark;
+  _az_ulib_ipc_running_shard running_shard_list[_AZ_ULIB_IPC_RUNNING_SHARDS];
+
+  /* Descriptor that a replace took out of the interface, while its calls may still be running. */
+  const az_ulib_interface_descriptor* volatile replaced_descriptor;
 #endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+  _az_ulib_ipc_stats_shard stats_shard_list[_AZ_ULIB_IPC_RUNNING_SHARDS];
+#endif // AZ_ULIB_CONFIG_IPC_STATS
 } _az_ulib_ipc_interface;
 
+/*
+ * IPC subscription control block. The filter and callback are only written while the subscription
+ * is free, and `running_count` counts the callbacks in execution.
+ */
+typedef struct
+{
+  volatile long state;
+  volatile long running_count;
+  az_ulib_ipc_subscription_filter filter;
+  az_ulib_ipc_subscription_callback callback;
+  void* context;
+} _az_ulib_ipc_subscription;
+
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+/*
+ * IPC asynchronous call control block.
+ */
+typedef struct
+{
+  volatile long state;
+  _az_ulib_ipc_interface* ipc_interface;
+  uint16_t generation;
+  az_ulib_capability_index command_index;
+  const void* model_in;
+  az_ulib_model_out model_out;
+  az_ulib_capability_result_callback result_callback;
+  az_ulib_capability_token capability_token;
+} _az_ulib_ipc_async_call;
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+/*
+ * Maximum number of times that the interface index may grow. Each growth doubles the index, and
+ * the index never needs more than 65536 buckets.
+ */
+#define _AZ_ULIB_IPC_MAX_INDEX_GROWTH 16
+
+/**
+ * @brief   Allocator used by the IPC to grow the registry.
+ */
+typedef struct
+{
+  /** Allocates a block of memory with at least `size` bytes. Returns `NULL` if there is no memory
+   *  available. */
+  void* (*allocate)(size_t size);
+
+  /** Releases a block of memory returned by `allocate`. */
+  void (*release)(void* ptr);
+} az_ulib_ipc_allocator;
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
 /**
  * @brief IPC handle.
  */
@@ -53,7 +227,45 @@ typedef struct az_ulib_ipc_tag
   struct
   {
     az_ulib_pal_os_lock lock;
+    volatile long sequence;
     _az_ulib_ipc_interface interface_list[AZ_ULIB_CONFIG_MAX_IPC_INTERFACE];
+    uint16_t interface_index[AZ_ULIB_CONFIG_IPC_INTERFACE_INDEX_SIZE];
+    uint16_t sorted_index[AZ_ULIB_CONFIG_MAX_IPC_INTERFACE];
+    uint16_t sorted_count;
+    uint16_t first_free_hint;
+    volatile uint32_t generation;
+    az_ulib_pal_os_lock subscription_lock;
+    az_ulib_pal_os_event subscription_event;
+    _az_ulib_ipc_subscription subscription_list[AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS];
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+    az_ulib_ipc_allocator allocator;
+    uint16_t* volatile index;
+    volatile uint32_t index_mask;
+    uint16_t* sorted;
+    volatile uint16_t interface_count;
+    uint16_t segment_count;
+    _az_ulib_ipc_interface* volatile segment_list[AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS];
+    void* segment_memory_list[AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS];
+    uint16_t* retired_index_list[_AZ_ULIB_IPC_MAX_INDEX_GROWTH];
+    uint16_t retired_index_count;
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    az_ulib_pal_os_lock drain_lock;
+    az_ulib_pal_os_event unpublish_event;
+    volatile long epoch;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+    _az_ulib_ipc_async_call async_call_list[AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE];
+    uint16_t async_queue[AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE];
+    uint16_t async_queue_head;
+    uint16_t async_queue_count;
+    az_ulib_pal_os_semaphore async_semaphore;
+    az_ulib_pal_os_thread async_worker_list[AZ_ULIB_CONFIG_IPC_ASYNC_WORKERS];
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+    volatile long trace_enabled;
+    _az_ulib_ipc_trace_ring trace_ring_list[_AZ_ULIB_IPC_RUNNING_SHARDS];
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
   } _internal;
 } az_ulib_ipc;
 
@@ -77,9 +289,47 @@ typedef struct az_ulib_ipc_tag
  *
  * @return The #az_result with the result of the initialization.
  *  @retval #AZ_OK                              If the IPC initialize with success.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM               With #AZ_ULIB_CONFIG_IPC_ASYNC, if the IPC cannot
+ *                                              create the worker threads for the asynchronous
+ *                                              calls.
  */
 AZ_NODISCARD az_result az_ulib_ipc_init(az_ulib_ipc* ipc_handle);
 
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+/**
+ * @brief   Initialize the IPC system with an allocator to grow the registry.
+ *
+ * This API initialize the IPC in the same way as az_ulib_ipc_init(), and allows the IPC to use
+ * the provided allocator to grow the registry when the `interface_list` is full. An IPC initialized
+ * by az_ulib_ipc_init() does not grow.
+ *
+ * @note    You may add this API defining a global key `AZ_ULIB_CONFIG_ADD_SEGMENTED_REGISTRY` on
+ * your compilation environment. See more at #AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY.
+ *
+ * @param[in]   ipc_handle      The #az_ulib_ipc* that points to a memory position where
+ *                              the IPC shall create its control block.
+ * @param[in]   allocator       The `const` #az_ulib_ipc_allocator* with the functions to allocate
+ *                              and release the memory of the registry. It cannot be `NULL`. The IPC
+ *                              copies the allocator.
+ *
+ * @pre     \p ipc_handle shall not be 'NULL'.
+ * @pre     \p allocator shall not be 'NULL', and its functions shall not be 'NULL'.
+ * @pre     IPC shall not been initialized.
+ *
+ * @note    This API **is not** thread safe, no other IPC API may be called during the execution of
+ *          this init.
+ *
+ * @return The #az_result with the result of the initialization.
+ *  @retval #AZ_OK                              If the IPC initialize with success.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM               With #AZ_ULIB_CONFIG_IPC_ASYNC, if the IPC cannot
+ *                                              create the worker threads for the asynchronous
+ *                                              calls.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_init_with_allocator(
+    az_ulib_ipc* ipc_handle,
+    const az_ulib_ipc_allocator* allocator);
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
 /**
  * @brief   De-initialize the IPC system.
  *
@@ -88,7 +338,7 @@ AZ_NODISCARD az_result az_ulib_ipc_init(az_ulib_ipc* ipc_handle);
  *
  * 1) Stop all threads that make calls to the published interfaces.
  * 2) Finalize or cancel all asynchronous calls, and ensure that their callbacks were called.
- * 3) Unsubscribe all telemetries.
+ * 3) Unsubscribe all telemetries, and all the subscriptions done by az_ulib_ipc_subscribe().
  * 4) Unpublish all interfaces.
  *
  * If the system needs the IPC again, it may call az_ulib_ipc_init() again to reinitialize the IPC.
@@ -181,6 +431,104 @@ AZ_NODISCARD az_result az_ulib_ipc_unpublish(
     uint32_t wait_option_ms);
 #endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
 
+/**
+ * @brief   Replace a published interface by a compatible one, without unpublishing it.
+ *
+ * The new descriptor takes the place of the old one in the IPC, so the handles to the interface
+ * stay valid and the consumers never see #AZ_ERROR_ITEM_NOT_FOUND. The next calls to the interface
+ * run the capabilities of the new descriptor. The calls that are already running the capabilities
+ * of the old descriptor finish on it, and this API waits up to \p wait_option_ms for them, out of
+ * the IPC lock, so the other IPC APIs do not wait for them. When it returns #AZ_OK, the old
+ * descriptor and its capabilities may be released.
+ *
+ * If the calls do not finish in time, this API returns #AZ_ULIB_PENDING. The new descriptor is
+ * already the published one, and the old descriptor shall stay valid up to
+ * az_ulib_ipc_wait_replaced() with it returns #AZ_OK. An unpublish of the new descriptor that
+ * returns #AZ_OK also waits for all calls in the interface, so the old descriptor may be released
+ * after it too. The IPC keeps only one old descriptor per interface, so a new replace of the same
+ * interface returns #AZ_ERROR_ULIB_BUSY while the old descriptor is pending.
+ *
+ * The new descriptor shall be compatible with the old one: same name, same version, and the same
+ * capabilities, in the same order and with the same types, so the capability indexes that the
+ * consumers already have refer to the same capabilities. After this API returns #AZ_OK or
+ * #AZ_ULIB_PENDING, the new descriptor is the published one, az_ulib_ipc_unpublish() and
+ * az_ulib_ipc_replace() shall use it, and the subscribers receive #AZ_ULIB_IPC_EVENT_REPLACE.
+ *
+ * @note    Without #AZ_ULIB_CONFIG_IPC_UNPUBLISH, the IPC does not count the running calls, so this
+ *          API does not wait, and the old descriptor shall never be released.
+ *
+ * @param[in]   old_interface_descriptor  The `const` #az_ulib_interface_descriptor* with the
+ *                                        descriptor of the published interface. It cannot be
+ *                                        `NULL`.
+ * @param[in]   new_interface_descriptor  The `const` #az_ulib_interface_descriptor* with the
+ *                                        descriptor that will replace it. It cannot be `NULL`,
+ *                                        and shall be valid up to the interface is unpublished
+ *                                        or replaced with success.
+ * @param[in]   wait_option_ms            The `uint32_t` with the maximum number of milliseconds
+ *                                        the function may wait for the calls that are running
+ *                                        the old descriptor:
+ *                                            - #AZ_ULIB_NO_WAIT (0x00000000)
+ *                                            - #AZ_ULIB_WAIT_FOREVER (0xFFFFFFFF)
+ *                                            - timeout value (0x00000001 through 0xFFFFFFFE)
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p old_interface_descriptor shall not be `NULL`.
+ * @pre     \p new_interface_descriptor shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the replace.
+ *  @retval #AZ_OK                              If the interface is replaced with success, and the
+ *                                              old descriptor is not in use anymore.
+ *  @retval #AZ_ULIB_PENDING                    If the interface is replaced with success, but some
+ *                                              calls are still running the old descriptor.
+ *  @retval #AZ_ERROR_ITEM_NOT_FOUND            If the old descriptor didn't match any published
+ *                                              interface.
+ *  @retval #AZ_ERROR_ULIB_INCOMPATIBLE_VERSION If the new descriptor is not compatible with the
+ *                                              old one.
+ *  @retval #AZ_ERROR_ULIB_BUSY                 If the descriptor of a previous replace of the
+ *                                              interface is still pending. The interface is not
+ *                                              replaced.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_replace(
+    const az_ulib_interface_descriptor* const old_interface_descriptor,
+    const az_ulib_interface_descriptor* const new_interface_descriptor,
+    uint32_t wait_option_ms);
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+/**
+ * @brief   Wait for the calls that are still running a descriptor taken out by a replace.
+ *
+ * If az_ulib_ipc_replace() returns #AZ_ULIB_PENDING, this API waits up to \p wait_option_ms for
+ * the calls that are still running the old descriptor, out of the IPC lock. When it returns
+ * #AZ_OK, the old descriptor and its capabilities may be released.
+ *
+ * @note    You may remove this API defining a global key `AZ_ULIB_CONFIG_REMOVE_UNPUBLISH` on your
+ * compilation environment. See more at #AZ_ULIB_CONFIG_IPC_UNPUBLISH.
+ *
+ * @param[in]   interface_descriptor  The `const` #az_ulib_interface_descriptor* with the old
+ *                                    descriptor provided to az_ulib_ipc_replace(). It cannot be
+ *                                    `NULL`.
+ * @param[in]   wait_option_ms        The `uint32_t` with the maximum number of milliseconds
+ *                                    the function may wait for the calls that are running
+ *                                    the descriptor:
+ *                                        - #AZ_ULIB_NO_WAIT (0x00000000)
+ *                                        - #AZ_ULIB_WAIT_FOREVER (0xFFFFFFFF)
+ *                                        - timeout value (0x00000001 through 0xFFFFFFFE)
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p interface_descriptor shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the wait.
+ *  @retval #AZ_OK                              If no call is running the descriptor anymore, and
+ *                                              it is not published.
+ *  @retval #AZ_ERROR_ITEM_NOT_FOUND            If the descriptor is still published, so it was not
+ *                                              replaced.
+ *  @retval #AZ_ERROR_ULIB_BUSY                 If some calls are still running the descriptor.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_wait_replaced(
+    const az_ulib_interface_descriptor* const interface_descriptor,
+    uint32_t wait_option_ms);
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
 /**
  * @brief   Try get an interface handle by the name from the IPC.
  *
@@ -194,6 +542,9 @@ AZ_NODISCARD az_result az_ulib_ipc_unpublish(
  *
  * @note    **Do not release an interface will cause memory leak.**
  *
+ * @note    This API does not take the IPC lock, it may run in parallel with other lookups, and it
+ *          only retries the lookup if an interface is published or unpublished at the same time.
+ *
  * @param[in]   name              The `az_span` with the interface name.
  * @param[in]   version           The #az_ulib_version with the desired version.
  * @param[in]   match_criteria    The #az_ulib_version_match_criteria with the match criteria for
@@ -219,11 +570,74 @@ AZ_NODISCARD az_result az_ulib_ipc_try_get_interface(
     az_ulib_version_match_criteria match_criteria,
     az_ulib_ipc_interface_handle* interface_handle);
 
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+/**
+ * @brief   Get the contract fingerprint of an interface descriptor.
+ *
+ * The contract is a 32 bits hash of the name and type of each capability in the descriptor, in
+ * the order of the capability list. Two descriptors with the same contract have, with a high
+ * probability, the same capabilities at the same capability indexes. The interface name and
+ * version are not part of the contract.
+ *
+ * This API does not use the IPC, so a consumer may call it with a copy of the descriptor that it
+ * was built for, or store the result as a constant.
+ *
+ * @param[in]   interface_descriptor  The `const` #az_ulib_interface_descriptor* with the
+ *                                    descriptor. It cannot be `NULL`.
+ *
+ * @pre     \p interface_descriptor shall not be `NULL`.
+ *
+ * @return The `uint32_t` with the contract of the descriptor.
+ */
+AZ_NODISCARD uint32_t
+az_ulib_ipc_get_contract(const az_ulib_interface_descriptor* const interface_descriptor);
+
+/**
+ * @brief   Try get an interface handle by the name and the contract from the IPC.
+ *
+ * This API works as az_ulib_ipc_try_get_interface(), and it also compares the contract that the
+ * IPC computed on az_ulib_ipc_publish() with the expected one. If they match, the consumer may use
+ * the capability indexes of the descriptor that it was built for, without calling
+ * az_ulib_ipc_try_get_capability() for each capability.
+ *
+ * @param[in]   name              The `az_span` with the interface name.
+ * @param[in]   version           The #az_ulib_version with the desired version.
+ * @param[in]   match_criteria    The #az_ulib_version_match_criteria with the match criteria for
+ *                                the interface version.
+ * @param[in]   contract          The `uint32_t` with the expected contract. Call
+ *                                az_ulib_ipc_get_contract() to get it.
+ * @param[out]  interface_handle  The #az_ulib_ipc_interface_handle* with the memory to store
+ *                                the interface handle. It cannot be `NULL`.
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p name shall not be 'NULL'.
+ * @pre     \p interface_handle shall not be 'NULL'.
+ *
+ * @return The #az_result with the result of the get handle.
+ *  @retval #AZ_OK                              If the interface was found with the expected
+ *                                              contract and the returned handle can be used.
+ *  @retval #AZ_ERROR_ITEM_NOT_FOUND            If the provided name didn't match any published
+ *                                              interface.
+ *  @retval #AZ_ERROR_NOT_ENOUGH_SPACE          If the interface already provided the maximum
+ *                                              number of instances.
+ *  @retval #AZ_ERROR_ULIB_INCOMPATIBLE_VERSION If the interface was found, but its contract is
+ *                                              not the expected one. No handle is returned.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_try_get_interface_with_contract(
+    az_span name,
+    az_ulib_version version,
+    az_ulib_version_match_criteria match_criteria,
+    uint32_t contract,
+    az_ulib_ipc_interface_handle* interface_handle);
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+
 /**
  * @brief   Try get a capability index in the interface by the name from the IPC.
  *
  * This API tries to find an capability that fits the provided name in the interface. It returns
- * the capability index.
+ * the capability index. It does not take the IPC lock, and it uses the capability index built by
+ * az_ulib_ipc_publish() (see #AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE), so its cost does not grow
+ * with the number of capabilities in the interface.
  *
  * @param[in]   interface_handle    The #az_ulib_ipc_interface_handle with the interface handle.
  *                                  It cannot be `NULL`. Call az_ulib_ipc_try_get_interface() to
@@ -308,6 +722,74 @@ AZ_NODISCARD az_result az_ulib_ipc_get_interface(
  */
 AZ_NODISCARD az_result az_ulib_ipc_release_interface(az_ulib_ipc_interface_handle interface_handle);
 
+/**
+ * @brief   Subscribe to the publish and unpublish of interfaces.
+ *
+ * This API registers a callback that the IPC calls each time an interface that matches the filter
+ * is published, unpublished, or replaced, so a consumer may get a new interface or drop a handle as
+ * soon as the registry changes, instead of polling az_ulib_ipc_try_get_interface().
+ *
+ * The callback runs in the thread that changed the interface, after the IPC released its lock, and
+ * before az_ulib_ipc_publish(), az_ulib_ipc_unpublish(), or az_ulib_ipc_replace() returns. It shall
+ * be short, and it may call the other IPC APIs, but it cannot unsubscribe itself. Reports of
+ * different interfaces published in parallel may arrive in any order, so a handle reported by
+ * #AZ_ULIB_IPC_EVENT_PUBLISH may already be unpublished when the callback uses it.
+ *
+ * Reporting a change does not take any lock, so the subscriptions do not delay the lookups or the
+ * calls in the other threads.
+ *
+ * @param[in]   filter                The `const` #az_ulib_ipc_subscription_filter* with the
+ *                                    interfaces to report. It cannot be `NULL`. The IPC copies the
+ *                                    filter, but the memory pointed by its `name` shall be valid up
+ *                                    to the subscription is unsubscribed with success.
+ * @param[in]   callback              The #az_ulib_ipc_subscription_callback to call on each change.
+ *                                    It cannot be `NULL`.
+ * @param[in]   context               The `void*` to provide to the callback. It may be `NULL`.
+ * @param[out]  subscription_handle   The #az_ulib_ipc_subscription_handle* with the memory to store
+ *                                    the subscription handle. It cannot be `NULL`.
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p filter shall not be 'NULL'.
+ * @pre     \p callback shall not be 'NULL'.
+ * @pre     \p subscription_handle shall not be 'NULL'.
+ *
+ * @return The #az_result with the result of the subscribe.
+ *  @retval #AZ_OK                              If the subscription is registered with success.
+ *  @retval #AZ_ERROR_NOT_ENOUGH_SPACE          If there are already
+ *                                              #AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS subscriptions.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_subscribe(
+    const az_ulib_ipc_subscription_filter* filter,
+    az_ulib_ipc_subscription_callback callback,
+    void* context,
+    az_ulib_ipc_subscription_handle* subscription_handle);
+
+/**
+ * @brief   Unsubscribe from the publish and unpublish of interfaces.
+ *
+ * After this API returns #AZ_OK, the IPC will not call the callback of the subscription anymore,
+ * and no call to it is in execution, so the caller may release the context.
+ *
+ * @param[in]   subscription_handle   The #az_ulib_ipc_subscription_handle returned by
+ *                                    az_ulib_ipc_subscribe(). It cannot be `NULL`.
+ * @param[in]   wait_option_ms        The `uint32_t` with the maximum number of milliseconds
+ *                                    the function may wait for the callbacks in execution:
+ *                                        - #AZ_ULIB_NO_WAIT (0x00000000)
+ *                                        - #AZ_ULIB_WAIT_FOREVER (0xFFFFFFFF)
+ *                                        - timeout value (0x00000001 through 0xFFFFFFFE)
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p subscription_handle shall be an active subscription.
+ *
+ * @return The #az_result with the result of the unsubscribe.
+ *  @retval #AZ_OK                              If the subscription is removed with success.
+ *  @retval #AZ_ERROR_ULIB_BUSY                 If the callback is still running. The subscription
+ *                                              stays active.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_unsubscribe(
+    az_ulib_ipc_subscription_handle subscription_handle,
+    uint32_t wait_option_ms);
+
 /**
  * @brief   Synchronously Call a published procedure.
  *
@@ -361,15 +843,197 @@ AZ_NODISCARD az_result az_ulib_ipc_call_with_str(
     az_span* model_out_span);
 
 /**
- * @brief   Query IPC information.
+ * @brief   Synchronously Call a published procedure using binary models.
+ *
+ * This API is the binary version of az_ulib_ipc_call_with_str(). The models are TLV buffers,
+ * written and read with the APIs in az_ulib_tlv.h, which are smaller and cheaper to marshal than
+ * JSON. The command shall be published with AZ_ULIB_DESCRIPTOR_ADD_COMMAND_WITH_BINARY().
+ *
+ * @param[in]   interface_handle    The #az_ulib_ipc_interface_handle with the interface handle.
+ *                                  It cannot be `NULL`. Call az_ulib_ipc_try_get_interface() to
+ *                                  get the interface handle.
+ * @param[in]   command_index       The #az_ulib_capability_index with the command index. Call
+ *                                  az_ulib_ipc_try_get_capability() to get the command index.
+ * @param[in]   model_in_binary     The #az_span with the TLV buffer with the model in.
+ * @param[out]  model_out_binary    The pointer to #az_span with the memory where the capability
+ *                                  should store the TLV buffer with the model out. The
+ *                                  capability resizes it to the stored content.
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p interface_handle shall not be 'NULL'.
+ *
+ * @return The #az_result with the result of the call.
+ *  @retval #AZ_OK                              If the IPC get success calling the procedure.
+ *  @retval #AZ_ERROR_ITEM_NOT_FOUND            If the target command does not exist.
+ *  @retval #AZ_ERROR_NOT_SUPPORTED             If the target command has no binary wrapper.
+ *  @retval Others                              Defined by the target function.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_call_with_binary(
+    az_ulib_ipc_interface_handle interface_handle,
+    az_ulib_capability_index command_index,
+    az_span model_in_binary,
+    az_span* model_out_binary);
+
+/**
+ * @brief   Synchronously Call a sequence of published procedures in the same interface.
+ *
+ * This API calls the commands in \p entries back-to-back, in the provided order, and stores the
+ * result of each command in the same position of \p results. All commands runs inside a single
+ * interlock with az_ulib_ipc_unpublish(), which is cheaper than calling az_ulib_ipc_call() for
+ * each command. The interface cannot be unpublished in the middle of the batch, so
+ * az_ulib_ipc_unpublish() will wait for the whole batch to finish.
+ *
+ * If \p stop_on_error is `true`, the batch stops on the first command that returns an error, and
+ * the result of all following entries are set to #AZ_ERROR_CANCELED.
+ *
+ * @param[in]   interface_handle  The #az_ulib_ipc_interface_handle with the interface handle. It
+ *                                cannot be `NULL`. Call
+ *                                az_ulib_ipc_try_get_interface() to get the interface handle.
+ * @param[in]   entries           The list of #az_ulib_ipc_call_entry with the commands to call. It
+ *                                cannot be `NULL`.
+ * @param[in]   entries_size      The `size_t` with the number of entries in \p entries. It shall
+ *                                be bigger than zero.
+ * @param[out]  results           The list of #az_result with at least \p entries_size positions,
+ *                                where the IPC will store the result of each command. It cannot be
+ *                                `NULL`.
+ * @param[in]   stop_on_error     The `bool` that indicates if the batch shall stop on the first
+ *                                command that fails.
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p interface_handle shall not be 'NULL'.
+ * @pre     \p entries shall not be 'NULL'.
+ * @pre     \p entries_size shall be bigger than zero.
+ * @pre     \p results shall not be 'NULL'.
+ *
+ * @return The #az_result with the result of the batch.
+ *  @retval #AZ_OK                              If the IPC called all commands in the batch. The
+ *                                              result of each command is in \p results.
+ *  @retval #AZ_ERROR_ITEM_NOT_FOUND            If the target interface was disabled. No command
+ *                                              was called and \p results was not changed.
+ *  @retval Others                              If \p stop_on_error is `true`, the error returned
+ *                                              by the first command that failed.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_call_batch(
+    az_ulib_ipc_interface_handle interface_handle,
+    const az_ulib_ipc_call_entry* entries,
+    size_t entries_size,
+    az_result* results,
+    bool stop_on_error);
+
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+/**
+ * @brief   Asynchronously Call a published procedure.
+ *
+ * This API queues the call and returns immediately. One of the IPC worker threads will run the
+ * command and report its result calling the \p result_callback with the \p capability_token. The
+ * callback is always called, even if the call is canceled or the interface is unpublished before
+ * the call runs.
  *
- * Creates a query for IPC. The query retrieves information from the IPC, depending on the content
- * of the `query` argument. There are 2 valid query strings:
+ * The command may be a #AZ_ULIB_CAPABILITY_TYPE_COMMAND or a
+ * #AZ_ULIB_CAPABILITY_TYPE_COMMAND_ASYNC. An asynchronous command receives the
+ * \p capability_token and a cancellation callback that returns #AZ_ERROR_CANCELED if
+ * az_ulib_ipc_cancel_async() was called for this token, so long commands can stop early.
  *
- *  1) Empty string: query will return a list of all published interfaces.
- *  2) Interface name: query will return a list of all capabilities in the interface.
+ * The worker thread holds an instance of the interface up to the callback returns, and runs the
+ * command inside the same interlock as az_ulib_ipc_call(), so az_ulib_ipc_unpublish() will wait
+ * for the running asynchronous calls.
  *
- * The result of the query will be a list with the information separated by comma.
+ * @note    **The \p model_in and \p model_out shall be valid up to the \p result_callback is
+ *          called.**
+ *
+ * @note    This API only exists if the global key `AZ_ULIB_CONFIG_ADD_IPC_ASYNC` is defined on your
+ *          compilation environment. See more at #AZ_ULIB_CONFIG_IPC_ASYNC.
+ *
+ * @param[in]   interface_handle  The #az_ulib_ipc_interface_handle with the interface handle. It
+ *                                cannot be `NULL`. Call
+ *                                az_ulib_ipc_try_get_interface() to get the interface handle.
+ * @param[in]   command_index     The #az_ulib_capability_index with the command handle.
+ * @param[in]   model_in          The `const void *const` that points to the memory with the
+ *                                input model content.
+ * @param[out]  model_out         The `const void *` that points to the memory where the capability
+ *                                should store the output model content.
+ * @param[in]   result_callback   The #az_ulib_capability_result_callback to call with the result
+ *                                of the command. It cannot be `NULL`.
+ * @param[in]   capability_token  The #az_ulib_capability_token that identifies this call. It
+ *                                shall be unique up to the \p result_callback is called.
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p interface_handle shall not be 'NULL'.
+ * @pre     \p result_callback shall not be 'NULL'.
+ *
+ * @return The #az_result with the result of the call.
+ *  @retval #AZ_OK                              If the call was queued, the result will be reported
+ *                                              by the \p result_callback.
+ *  @retval #AZ_ERROR_ITEM_NOT_FOUND            If the target command was disabled.
+ *  @retval #AZ_ERROR_NOT_ENOUGH_SPACE          If the queue of asynchronous calls is full or the
+ *                                              interface already provided the maximum number of
+ *                                              instances.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_call_async(
+    az_ulib_ipc_interface_handle interface_handle,
+    az_ulib_capability_index command_index,
+    az_ulib_model_in model_in,
+    az_ulib_model_out model_out,
+    az_ulib_capability_result_callback result_callback,
+    az_ulib_capability_token capability_token);
+
+/**
+ * @brief   Cancel an asynchronous call.
+ *
+ * If the call is still in the queue, this API removes it and calls the `result_callback` with
+ * #AZ_ERROR_CANCELED before returning. If the call is already running, this API flags it as
+ * canceled and calls the `cancel` of the capability, if the capability has one. In this case,
+ * the `result_callback` will receive the result returned by the command.
+ *
+ * @param[in]   capability_token  The #az_ulib_capability_token provided to
+ *                                az_ulib_ipc_call_async().
+ *
+ * @pre     IPC shall already be initialized.
+ *
+ * @return The #az_result with the result of the cancel.
+ *  @retval #AZ_OK                              If the call was canceled or flagged as canceled.
+ *  @retval #AZ_ERROR_ITEM_NOT_FOUND            If there is no pending call with the provided
+ *                                              token.
+ *  @retval Others                              Defined by the `cancel` of the capability.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_cancel_async(az_ulib_capability_token capability_token);
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+
+/**
+ * @brief   Query IPC information.
+ *
+ * Creates a query for IPC. The query retrieves the published interfaces that match the `query`
+ * argument. The valid query strings are:
+ *
+ *  1) Empty string: all published interfaces, in the order of the registry.
+ *  2) `name=<name>`: all versions of the interface `<name>`, sorted by version. It may be followed
+ *     by `;version=<min>-<max>` to only return the versions from `<min>` to `<max>`. Both limits
+ *     are optional, and `;version=<version>` returns only one version.
+ *  3) `prefix=<prefix>`: all interfaces with a name that starts with `<prefix>`, sorted by name
+ *     and version. The prefix may have up to 255 characters.
+ *  4) `capability=<name>`: all interfaces that expose a capability `<name>` in one of their first
+ *     256 capabilities, sorted by name and version.
+ *
+ * The queries are served by the interface indexes, and the continuation token keeps the kind of
+ * the query and the position of the next interface, so each call to az_ulib_ipc_query_next() only
+ * visits the interfaces that it returns. A version range with an upper limit reports up to 254
+ * versions.
+ *
+ * The continuation token also keeps a stamp of the next interface, with the lower bits of the
+ * registry generation when it was published, see az_ulib_ipc_get_generation(). The token has all
+ * the bits that the position in the registry does not need for the stamp, which is, at least, 5
+ * bits. If interfaces were published or unpublished since the token was created,
+ * az_ulib_ipc_query_next() checks the stamp to know that the next interface is still the same one,
+ * and continues from its current position in the registry. In this case, the query reports the
+ * interfaces published after the token only if they come after the next interface, and does not
+ * report the same interface twice. For a name with a version range with an upper limit, the stamp
+ * is the generation when a version of this name was last published or unpublished, so only the
+ * changes in this name stop the query. The changes in the other interfaces never affect the token.
+ * The stamp only cannot tell apart two interfaces published in the same position of the registry
+ * when the lower bits of their generations are the same.
+ *
+ * The result of the query will be a list of `"<name>.<version>"` separated by comma. The names are
+ * escaped as JSON strings, so the result can be copied as it is inside a JSON array.
  *
  * @param[in]   query               The `az_span` with the query string.
  * @param[in]   result              The `az_span` with the buffer to return the query result.
@@ -410,9 +1074,111 @@ az_ulib_ipc_query(az_span query, az_span* result, uint32_t* continuation_token);
  *                                      continuation have valid information.
  *  @retval #AZ_ULIB_EOF                If there is no more information to return in this query.
  *  @retval #AZ_ERROR_NOT_SUPPORTED     If the continuation token is not supported.
+ *  @retval #AZ_ERROR_ITEM_NOT_FOUND    If the registry changed and the query cannot continue from
+ *                                      the token, because the next interface was unpublished, or
+ *                                      the query is a name with a limited version range and a
+ *                                      version of this name was published or unpublished. The
+ *                                      caller shall start the query again.
  */
 AZ_NODISCARD az_result az_ulib_ipc_query_next(uint32_t* continuation_token, az_span* result);
 
+/**
+ * @brief   Get the generation of the IPC registry.
+ *
+ * The generation starts at `0` when the IPC is initialized, and increments each time that an
+ * interface is published or unpublished. A caller that keeps the result of a query may compare
+ * the generation with the one at the time of the query to know if the result is still valid.
+ *
+ * @pre     IPC shall already be initialized.
+ *
+ * @return The `uint32_t` with the current generation of the registry.
+ */
+AZ_NODISCARD uint32_t az_ulib_ipc_get_generation(void);
+
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+/**
+ * @brief   Get the statistics of the calls to a capability.
+ *
+ * Returns the calls to the capability made by az_ulib_ipc_call(), az_ulib_ipc_call_with_str(),
+ * az_ulib_ipc_call_with_binary(), and az_ulib_ipc_call_batch() since the interface was published.
+ * The same statistics are available to any consumer in the `ipc_stats` interface.
+ *
+ * @note    You may add this API defining a global key `AZ_ULIB_CONFIG_ADD_IPC_STATS` on your
+ *          compilation environment. See more at #AZ_ULIB_CONFIG_IPC_STATS.
+ *
+ * @param[in]   interface_handle    The #az_ulib_ipc_interface_handle with the interface handle.
+ *                                  It cannot be `NULL`.
+ * @param[in]   capability_index    The #az_ulib_capability_index with the capability index.
+ * @param[out]  stats               The #az_ulib_ipc_capability_stats* to return the statistics.
+ *                                  It cannot be `NULL`.
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p interface_handle shall not be `NULL`.
+ * @pre     \p stats shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the get.
+ *  @retval #AZ_OK                      If the statistics were stored in \p stats.
+ *  @retval #AZ_ERROR_ITEM_NOT_FOUND    If the interface was unpublished, or it does not have the
+ *                                      capability.
+ *  @retval #AZ_ERROR_NOT_SUPPORTED     If the capability is not one of the first
+ *                                      #AZ_ULIB_CONFIG_IPC_STATS_MAX_CAPABILITIES in the interface.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_get_stats(
+    az_ulib_ipc_interface_handle interface_handle,
+    az_ulib_capability_index capability_index,
+    az_ulib_ipc_capability_stats* stats);
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+/**
+ * @brief   Enable or disable the IPC trace.
+ *
+ * While the trace is enabled, az_ulib_ipc_call(), az_ulib_ipc_call_with_str(),
+ * az_ulib_ipc_call_with_binary(), and az_ulib_ipc_call_batch() record a begin and an end event
+ * for each call, and az_ulib_ipc_publish() and az_ulib_ipc_unpublish() record an instant event.
+ * Each thread records its events, with its own id, in the ring of its shard without any lock, so
+ * the threads that share a shard also share a ring. The new events overwrite the oldest ones when
+ * the ring is full. Disable the trace does not clear the recorded events.
+ *
+ * @note    You may add this API defining a global key `AZ_ULIB_CONFIG_ADD_IPC_TRACE` on your
+ *          compilation environment. See more at #AZ_ULIB_CONFIG_IPC_TRACE.
+ *
+ * @param[in]   enable              The `bool` that enables the trace if `true`, or disables it if
+ *                                  `false`.
+ *
+ * @pre     IPC shall already be initialized.
+ */
+void az_ulib_ipc_trace_enable(bool enable);
+
+/**
+ * @brief   Dump the IPC trace as Chrome trace event JSON.
+ *
+ * Writes the events in the rings as `{"traceEvents":[...]}`, which chrome://tracing and Perfetto
+ * can open. Each call is a pair of `B` and `E` events named with the interface name, with the
+ * version and the capability index in the `args`, and the result in the `args` of the `E` event.
+ * Publish and unpublish are `i` events. The `ts` is az_pal_os_clock_us(), and the `tid` is the id
+ * that the IPC gave to the thread, or 0 if the platform has no thread local storage.
+ *
+ * The dump may run while other threads record events; it skips the events that are overwritten
+ * while it reads them.
+ *
+ * @note    You may add this API defining a global key `AZ_ULIB_CONFIG_ADD_IPC_TRACE` on your
+ *          compilation environment. See more at #AZ_ULIB_CONFIG_IPC_TRACE.
+ *
+ * @param[in,out]   trace           The `az_span*` with the buffer to write the JSON. On return, it
+ *                                  contains the part of the buffer with the JSON. It cannot be
+ *                                  `NULL`.
+ *
+ * @pre     IPC shall already be initialized.
+ * @pre     \p trace shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the dump.
+ *  @retval #AZ_OK                      If the JSON was written in \p trace.
+ *  @retval #AZ_ERROR_NOT_ENOUGH_SPACE  If the buffer is too small for all events.
+ */
+AZ_NODISCARD az_result az_ulib_ipc_trace_dump(az_span* trace);
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
+
 #include "azure/core/_az_cfg_suffix.h"
 
 #endif /* AZ_ULIB_IPC_API_H */
@@ -11,6 +11,7 @@
 #include "azure/az_core.h"
 
 #ifndef __cplusplus
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #else
@@ -20,11 +21,92 @@
 
 #include "azure/core/_az_cfg_prefix.h"
 
+/**
+ * @brief   Command call in a batch.
+ *
+ * Each entry of the list provided to az_ulib_ipc_call_batch() describes one command call.
+ */
+typedef struct
+{
+  /** The #az_ulib_capability_index with the command to call. */
+  az_ulib_capability_index command_index;
+
+  /** The `const void *` that points to the memory with the input model content. */
+  const void* model_in;
+
+  /** The #az_ulib_model_out that points to the memory where the command should store the output
+   * model content. */
+  az_ulib_model_out model_out;
+} az_ulib_ipc_call_entry;
+
+/**
+ * @brief   Change in the IPC registry reported to the subscribers.
+ */
+typedef enum az_ulib_ipc_event_tag
+{
+  /** An interface was published. */
+  AZ_ULIB_IPC_EVENT_PUBLISH = 0,
+
+  /** An interface was unpublished. */
+  AZ_ULIB_IPC_EVENT_UNPUBLISH = 1,
+
+  /** An interface was replaced by a compatible descriptor, see az_ulib_ipc_replace(). */
+  AZ_ULIB_IPC_EVENT_REPLACE = 2
+} az_ulib_ipc_event;
+
+/**
+ * @brief   Interfaces that a subscriber wants to hear about.
+ *
+ * The IPC reports the publish, unpublish, and replace of the interfaces with the `name` and a
+ * version that matches the `version` and `match_criteria`, in the same way as
+ * az_ulib_ipc_try_get_interface().
+ */
+typedef struct
+{
+  /** The `az_span` with the name of the interfaces. Use #AZ_SPAN_EMPTY to report all interfaces.
+   */
+  az_span name;
+
+  /** The #az_ulib_version to compare with the version of the interfaces. */
+  az_ulib_version version;
+
+  /** The #az_ulib_version_match_criteria to compare the versions. */
+  az_ulib_version_match_criteria match_criteria;
+} az_ulib_ipc_subscription_filter;
+
+/**
+ * @brief   Callback that reports a change in the IPC registry.
+ *
+ * @param[in]   event             The #az_ulib_ipc_event with the change.
+ * @param[in]   name              The `az_span` with the name of the interface.
+ * @param[in]   version           The #az_ulib_version with the version of the interface.
+ * @param[in]   interface_handle  The #az_ulib_ipc_interface_handle of the interface. For
+ *                                #AZ_ULIB_IPC_EVENT_PUBLISH, az_ulib_ipc_get_interface() may use it
+ *                                to get an instance of the new interface. For
+ *                                #AZ_ULIB_IPC_EVENT_UNPUBLISH, it is the handle that the interface
+ *                                had, and the IPC APIs will not accept it anymore. For
+ *                                #AZ_ULIB_IPC_EVENT_REPLACE, it is the handle of the interface,
+ *                                which stays valid.
+ * @param[in]   context           The `void*` provided by the subscriber.
+ */
+typedef void (*az_ulib_ipc_subscription_callback)(
+    az_ulib_ipc_event event,
+    az_span name,
+    az_ulib_version version,
+    az_ulib_ipc_interface_handle interface_handle,
+    void* context);
+
+/**
+ * @brief   Handle of a subscription.
+ */
+typedef void* az_ulib_ipc_subscription_handle;
+
 /**
  * @brief Vtable to IPC APIs.
  *
  * Set of pointers to the IPC APIs uses to expose the IPC APIs to Modules that cannot be statically
- * linked to the IPC APIs.
+ * linked to the IPC APIs. The pointers to APIs that the build does not include are `NULL`, for
+ * example, `call_async` and `cancel_async` are `NULL` without `AZ_ULIB_CONFIG_ADD_IPC_ASYNC`.
  */
 typedef struct
 {
@@ -69,6 +151,59 @@ typedef struct
 
   az_result (*query_next)(uint32_t* continuation_token, az_span* result);
 
+  az_result (*call_async)(
+      az_ulib_ipc_interface_handle interface_handle,
+      az_ulib_capability_index command_index,
+      az_ulib_model_in model_in,
+      az_ulib_model_out model_out,
+      az_ulib_capability_result_callback result_callback,
+      az_ulib_capability_token capability_token);
+
+  az_result (*cancel_async)(az_ulib_capability_token capability_token);
+
+  az_result (*call_batch)(
+      az_ulib_ipc_interface_handle interface_handle,
+      const az_ulib_ipc_call_entry* entries,
+      size_t entries_size,
+      az_result* results,
+      bool stop_on_error);
+
+  az_result (*call_with_binary)(
+      az_ulib_ipc_interface_handle interface_handle,
+      az_ulib_capability_index command_index,
+      az_span model_in_binary,
+      az_span* model_out_binary);
+
+  az_result (*subscribe)(
+      const az_ulib_ipc_subscription_filter* filter,
+      az_ulib_ipc_subscription_callback callback,
+      void* context,
+      az_ulib_ipc_subscription_handle* subscription_handle);
+
+  az_result (*unsubscribe)(
+      az_ulib_ipc_subscription_handle subscription_handle,
+      uint32_t wait_option_ms);
+
+  uint32_t (*get_generation)(void);
+
+  az_result (*replace)(
+      const az_ulib_interface_descriptor* const old_interface_descriptor,
+      const az_ulib_interface_descriptor* const new_interface_descriptor,
+      uint32_t wait_option_ms);
+
+  uint32_t (*get_contract)(const az_ulib_interface_descriptor* const interface_descriptor);
+
+  az_result (*try_get_interface_with_contract)(
+      az_span name,
+      az_ulib_version version,
+      az_ulib_version_match_criteria match_criteria,
+      uint32_t contract,
+      az_ulib_ipc_interface_handle* interface_handle);
+
+  az_result (*wait_replaced)(
+      const az_ulib_interface_descriptor* const interface_descriptor,
+      uint32_t wait_option_ms);
+
 } az_ulib_ipc_vtable;
 
 /*
@@ -188,6 +323,140 @@ AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_query_next(
   return vtable->query_next(continuation_token, result);
 }
 
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_call_async().
+ */
+AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_call_async(
+    const az_ulib_ipc_vtable* const vtable,
+    az_ulib_ipc_interface_handle interface_handle,
+    az_ulib_capability_index command_index,
+    az_ulib_model_in model_in,
+    az_ulib_model_out model_out,
+    az_ulib_capability_result_callback result_callback,
+    az_ulib_capability_token capability_token)
+{
+  return vtable->call_async(
+      interface_handle, command_index, model_in, model_out, result_callback, capability_token);
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_cancel_async().
+ */
+AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_cancel_async(
+    const az_ulib_ipc_vtable* const vtable,
+    az_ulib_capability_token capability_token)
+{
+  return vtable->cancel_async(capability_token);
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_call_batch().
+ */
+AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_call_batch(
+    const az_ulib_ipc_vtable* const vtable,
+    az_ulib_ipc_interface_handle interface_handle,
+    const az_ulib_ipc_call_entry* entries,
+    size_t entries_size,
+    az_result* results,
+    bool stop_on_error)
+{
+  return vtable->call_batch(interface_handle, entries, entries_size, results, stop_on_error);
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_call_with_binary().
+ */
+AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_call_with_binary(
+    const az_ulib_ipc_vtable* const vtable,
+    az_ulib_ipc_interface_handle interface_handle,
+    az_ulib_capability_index command_index,
+    az_span model_in_binary,
+    az_span* model_out_binary)
+{
+  return vtable->call_with_binary(
+      interface_handle, command_index, model_in_binary, model_out_binary);
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_subscribe().
+ */
+AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_subscribe(
+    const az_ulib_ipc_vtable* const vtable,
+    const az_ulib_ipc_subscription_filter* filter,
+    az_ulib_ipc_subscription_callback callback,
+    void* context,
+    az_ulib_ipc_subscription_handle* subscription_handle)
+{
+  return vtable->subscribe(filter, callback, context, subscription_handle);
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_unsubscribe().
+ */
+AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_unsubscribe(
+    const az_ulib_ipc_vtable* const vtable,
+    az_ulib_ipc_subscription_handle subscription_handle,
+    uint32_t wait_option_ms)
+{
+  return vtable->unsubscribe(subscription_handle, wait_option_ms);
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_get_generation().
+ */
+AZ_INLINE AZ_NODISCARD uint32_t azi_ulib_ipc_get_generation(const az_ulib_ipc_vtable* const vtable)
+{
+  return vtable->get_generation();
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_replace().
+ */
+AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_replace(
+    const az_ulib_ipc_vtable* const vtable,
+    const az_ulib_interface_descriptor* const old_interface_descriptor,
+    const az_ulib_interface_descriptor* const new_interface_descriptor,
+    uint32_t wait_option_ms)
+{
+  return vtable->replace(old_interface_descriptor, new_interface_descriptor, wait_option_ms);
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_get_contract().
+ */
+AZ_INLINE AZ_NODISCARD uint32_t azi_ulib_ipc_get_contract(
+    const az_ulib_ipc_vtable* const vtable,
+    const az_ulib_interface_descriptor* const interface_descriptor)
+{
+  return vtable->get_contract(interface_descriptor);
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_try_get_interface_with_contract().
+ */
+AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_try_get_interface_with_contract(
+    const az_ulib_ipc_vtable* const vtable,
+    az_span name,
+    az_ulib_version version,
+    az_ulib_version_match_criteria match_criteria,
+    uint32_t contract,
+    az_ulib_ipc_interface_handle* interface_handle)
+{
+  return vtable->try_get_interface_with_contract(
+      name, version, match_criteria, contract, interface_handle);
+}
+
+/*
+ * @brief   Dynamically linked wrapper to az_ulib_ipc_wait_replaced().
+ */
+AZ_INLINE AZ_NODISCARD az_result azi_ulib_ipc_wait_replaced(
+    const az_ulib_ipc_vtable* const vtable,
+    const az_ulib_interface_descriptor* const interface_descriptor,
+    uint32_t wait_option_ms)
+{
+  return vtable->wait_replaced(interface_descriptor, wait_option_ms);
+}
+
 #include "azure/core/_az_cfg_suffix.h"
 
 #endif /* AZ_ULIB_IPC_INTERFACE_H */
@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+/********************************************************************
+ * This code was auto-generated from stats v1 DL and shall not be
+ * modified.
+ ********************************************************************/
+
+#ifndef AZ_ULIB_STATS_1_MODEL_H
+#define AZ_ULIB_STATS_1_MODEL_H
+
+#include "az_ulib_ipc_api.h"
+#include "az_ulib_result.h"
+#include "azure/az_core.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include "azure/core/_az_cfg_prefix.h"
+
+/*
+ * interface definition
+ */
+#define STATS_1_INTERFACE_NAME "stats"
+#define STATS_1_INTERFACE_VERSION 1
+#define STATS_1_CAPABILITY_SIZE 1
+
+/*
+ * Define get command on stats interface.
+ */
+#define STATS_1_GET_COMMAND (az_ulib_capability_index)0
+#define STATS_1_GET_COMMAND_NAME "get"
+#define STATS_1_GET_NAME_NAME "name"
+#define STATS_1_GET_VERSION_NAME "version"
+#define STATS_1_GET_CAPABILITIES_NAME "capabilities"
+#define STATS_1_GET_CAPABILITY_NAME_NAME "name"
+#define STATS_1_GET_CALLS_NAME "calls"
+#define STATS_1_GET_ERRORS_NAME "errors"
+#define STATS_1_GET_LATENCY_US_NAME "latency_us"
+typedef struct
+{
+  az_span name;
+  az_ulib_version version;
+} stats_1_get_model_in;
+typedef struct
+{
+  az_ulib_ipc_capability_stats* capabilities;
+  az_ulib_capability_index capabilities_size;
+  az_span names;
+} stats_1_get_model_out;
+
+#include "azure/core/_az_cfg_suffix.h"
+
+#endif /* AZ_ULIB_STATS_1_MODEL_H */
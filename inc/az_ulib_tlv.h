@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_tlv.h
+ *
+ * @brief Compact binary codec for the IPC models.
+ *
+ * The TLV codec is the binary alternative to the JSON used by az_ulib_ipc_call_with_str(). A TLV
+ * buffer is a sequence of fields, each one with:
+ *  - `tag`: 1 byte that identifies the field in the model. The interface defines the tags.
+ *  - `length`: the number of bytes in the value, encoded as a LEB128 varint.
+ *  - `value`: `length` bytes. Integers are encoded as LEB128 varints, with signed integers
+ *    zigzag encoded first; spans are copied as they are.
+ *
+ * Fields may be in any order, and a reader shall skip the tags that it does not know, so new
+ * fields can be added to a model without breaking the old readers.
+ */
+
+#ifndef AZ_ULIB_TLV_H
+#define AZ_ULIB_TLV_H
+
+#include "az_ulib_result.h"
+#include "azure/az_core.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif /* __cplusplus */
+
+#include "azure/core/_az_cfg_prefix.h"
+
+/**
+ * @brief   Maximum number of bytes in a TLV field with a 32 bits integer.
+ *
+ * 1 byte of tag, 1 byte of length, and up to 5 bytes of varint.
+ */
+#define AZ_ULIB_TLV_MAX_INT32_FIELD_SIZE 7
+
+/**
+ * @brief   Writes a TLV buffer.
+ *
+ * @note    All fields are internal, use the az_ulib_tlv_writer APIs to access them.
+ */
+typedef struct
+{
+  struct
+  {
+    az_span destination;
+    int32_t bytes_written;
+  } _internal;
+} az_ulib_tlv_writer;
+
+/**
+ * @brief   Reads a TLV buffer, one field at a time.
+ *
+ * After a successful az_ulib_tlv_reader_next(), `tag` and `value` contain the current field.
+ */
+typedef struct
+{
+  /** The `uint8_t` with the tag of the current field. */
+  uint8_t tag;
+
+  /** The `az_span` with the value of the current field. It points to the read buffer. */
+  az_span value;
+
+  struct
+  {
+    az_span buffer;
+    int32_t position;
+  } _internal;
+} az_ulib_tlv_reader;
+
+/**
+ * @brief   Initialize a TLV writer.
+ *
+ * @param[out]  tlv_writer          The #az_ulib_tlv_writer* to initialize. It cannot be `NULL`.
+ * @param[in]   destination_buffer  The `az_span` with the buffer where the fields will be written.
+ *
+ * @pre     \p tlv_writer shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the initialization.
+ *  @retval #AZ_OK                              If the writer was initialized with success.
+ */
+AZ_NODISCARD az_result
+az_ulib_tlv_writer_init(az_ulib_tlv_writer* tlv_writer, az_span destination_buffer);
+
+/**
+ * @brief   Append a field with an unsigned 32 bits integer.
+ *
+ * @param[in,out]   tlv_writer      The #az_ulib_tlv_writer* with the writer. It cannot be `NULL`.
+ * @param[in]       tag             The `uint8_t` with the field tag.
+ * @param[in]       value           The `uint32_t` with the field value.
+ *
+ * @pre     \p tlv_writer shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the append.
+ *  @retval #AZ_OK                              If the field was appended with success.
+ *  @retval #AZ_ERROR_NOT_ENOUGH_SPACE          If the destination buffer is too small. The writer
+ *                                              is not changed.
+ */
+AZ_NODISCARD az_result
+az_ulib_tlv_writer_append_uint32(az_ulib_tlv_writer* tlv_writer, uint8_t tag, uint32_t value);
+
+/**
+ * @brief   Append a field with a signed 32 bits integer.
+ *
+ * @param[in,out]   tlv_writer      The #az_ulib_tlv_writer* with the writer. It cannot be `NULL`.
+ * @param[in]       tag             The `uint8_t` with the field tag.
+ * @param[in]       value           The `int32_t` with the field value.
+ *
+ * @pre     \p tlv_writer shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the append.
+ *  @retval #AZ_OK                              If the field was appended with success.
+ *  @retval #AZ_ERROR_NOT_ENOUGH_SPACE          If the destination buffer is too small. The writer
+ *                                              is not changed.
+ */
+AZ_NODISCARD az_result
+az_ulib_tlv_writer_append_int32(az_ulib_tlv_writer* tlv_writer, uint8_t tag, int32_t value);
+
+/**
+ * @brief   Append a field with the content of a span.
+ *
+ * @param[in,out]   tlv_writer      The #az_ulib_tlv_writer* with the writer. It cannot be `NULL`.
+ * @param[in]       tag             The `uint8_t` with the field tag.
+ * @param[in]       value           The `az_span` with the field value. It may be empty.
+ *
+ * @pre     \p tlv_writer shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the append.
+ *  @retval #AZ_OK                              If the field was appended with success.
+ *  @retval #AZ_ERROR_NOT_ENOUGH_SPACE          If the destination buffer is too small. The writer
+ *                                              is not changed.
+ */
+AZ_NODISCARD az_result
+az_ulib_tlv_writer_append_span(az_ulib_tlv_writer* tlv_writer, uint8_t tag, az_span value);
+
+/**
+ * @brief   Get the part of the destination buffer with the fields written so far.
+ *
+ * @param[in]   tlv_writer          The #az_ulib_tlv_writer* with the writer. It cannot be `NULL`.
+ *
+ * @pre     \p tlv_writer shall not be `NULL`.
+ *
+ * @return The `az_span` with the written fields.
+ */
+AZ_NODISCARD az_span
+az_ulib_tlv_writer_get_bytes_used_in_destination(const az_ulib_tlv_writer* tlv_writer);
+
+/**
+ * @brief   Initialize a TLV reader.
+ *
+ * @param[out]  tlv_reader          The #az_ulib_tlv_reader* to initialize. It cannot be `NULL`.
+ * @param[in]   buffer              The `az_span` with the fields to read. It may be empty.
+ *
+ * @pre     \p tlv_reader shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the initialization.
+ *  @retval #AZ_OK                              If the reader was initialized with success.
+ */
+AZ_NODISCARD az_result az_ulib_tlv_reader_init(az_ulib_tlv_reader* tlv_reader, az_span buffer);
+
+/**
+ * @brief   Read the next field.
+ *
+ * @param[in,out]   tlv_reader      The #az_ulib_tlv_reader* with the reader. It cannot be `NULL`.
+ *
+ * @pre     \p tlv_reader shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the read.
+ *  @retval #AZ_OK                              If the reader moved to the next field.
+ *  @retval #AZ_ULIB_EOF                        If there are no more fields in the buffer.
+ *  @retval #AZ_ERROR_UNEXPECTED_END            If the buffer ends in the middle of a field.
+ *  @retval #AZ_ERROR_UNEXPECTED_CHAR           If the length of the field is not a valid varint.
+ */
+AZ_NODISCARD az_result az_ulib_tlv_reader_next(az_ulib_tlv_reader* tlv_reader);
+
+/**
+ * @brief   Get the value of the current field as an unsigned 32 bits integer.
+ *
+ * @param[in]   tlv_reader          The #az_ulib_tlv_reader* with the reader. It cannot be `NULL`.
+ * @param[out]  value               The `uint32_t*` to store the value. It cannot be `NULL`.
+ *
+ * @pre     \p tlv_reader shall not be `NULL`.
+ * @pre     \p value shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the get.
+ *  @retval #AZ_OK                              If the value was stored in \p value.
+ *  @retval #AZ_ERROR_UNEXPECTED_CHAR           If the current field is not a valid 32 bits
+ *                                              integer.
+ */
+AZ_NODISCARD az_result
+az_ulib_tlv_reader_get_uint32(const az_ulib_tlv_reader* tlv_reader, uint32_t* value);
+
+/**
+ * @brief   Get the value of the current field as a signed 32 bits integer.
+ *
+ * @param[in]   tlv_reader          The #az_ulib_tlv_reader* with the reader. It cannot be `NULL`.
+ * @param[out]  value               The `int32_t*` to store the value. It cannot be `NULL`.
+ *
+ * @pre     \p tlv_reader shall not be `NULL`.
+ * @pre     \p value shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the get.
+ *  @retval #AZ_OK                              If the value was stored in \p value.
+ *  @retval #AZ_ERROR_UNEXPECTED_CHAR           If the current field is not a valid 32 bits
+ *                                              integer.
+ */
+AZ_NODISCARD az_result
+az_ulib_tlv_reader_get_int32(const az_ulib_tlv_reader* tlv_reader, int32_t* value);
+
+#include "azure/core/_az_cfg_suffix.h"
+
+#endif /* AZ_ULIB_TLV_H */
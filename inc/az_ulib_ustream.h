@@ -12,6 +12,7 @@
 #define AZ_ULIB_USTREAM_H
 
 #include "az_ulib_ustream_base.h"
+#include "azure/az_core.h"
 
 #ifdef __cplusplus
 #include <cstddef>
@@ -82,6 +83,143 @@ AZ_NODISCARD az_result az_ulib_ustream_init(
     size_t data_buffer_length,
     az_ulib_release_callback data_buffer_release);
 
+/**
+ * @brief   Structure for the control block of a ustream over a memory mapped file.
+ *
+ * The file ustream is a ustream over a buffer, where the buffer is the content of a file mapped in
+ *      the memory, read-only. The mapping belongs to the control block, and it is released with
+ *      the control block, when all the instances of the ustream are disposed.
+ *
+ * @note    This structure should be viewed and used as internal to the implementation of the
+ *          ustream. Users should therefore not act on it directly and only allocate the memory
+ *          necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_file_data_cb_tag
+{
+  /** The #az_ulib_ustream_data_cb to manage the mapped content. */
+  az_ulib_ustream_data_cb control_block;
+
+  /** The #az_ulib_pal_os_file_map with the platform mapping of the file. */
+  az_ulib_pal_os_file_map file_map;
+
+  /** The #az_ulib_release_callback to call to release this structure once the mapping is
+   * released. */
+  az_ulib_release_callback file_data_release;
+} az_ulib_ustream_file_data_cb;
+
+/**
+ * @brief   Factory to initialize a new ustream over the content of a file.
+ *
+ *  This factory maps the file in the memory, read-only, and initializes a ustream that handles the
+ *      mapped content, in the same way as az_ulib_ustream_init() handles a buffer. The content is
+ *      not copied: the pages of the file are only loaded when a read touches them, so the cost to
+ *      stream a large file does not depend on the file size. The ustream can be cloned, split,
+ *      and concatenated as any other ustream.
+ *
+ *  The mapping is released when the ref count of the control block goes to zero, and after that
+ *      the `file_data_release` is called to release the `file_data`.
+ *
+ *  An empty file is not mapped, it creates an empty ustream that returns #AZ_ULIB_EOF on the first
+ *      read.
+ *
+ * @note    The file shall not be changed while the ustream exists. The ustream assumes that its
+ *          content is immutable.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct.
+ *                                          It cannot be `NULL`.
+ * @param[in]       file_data               The pointer to the allocated
+ *                                          #az_ulib_ustream_file_data_cb struct. This memory shall
+ *                                          stay valid until the passed `file_data_release` is
+ *                                          called. It cannot be `NULL`.
+ * @param[in]       file_data_release       The #az_ulib_release_callback function that will be
+ *                                          called to release the `file_data` once all the
+ *                                          references to the ustream are disposed. It may be
+ *                                          `NULL` if the `file_data` does not need to be released.
+ * @param[in]       file_name               The `const char*` with the name of the file. It cannot
+ *                                          be `NULL`.
+ *
+ * @return The #az_result with result of the initialization.
+ *      @retval #AZ_OK                        If the #az_ulib_ustream* is successfully
+ *                                            initialized.
+ *      @retval #AZ_ERROR_ITEM_NOT_FOUND      If the file does not exist, or cannot be mapped in
+ *                                            the memory by this platform. The
+ *                                            `file_data_release` is not called.
+ */
+AZ_NODISCARD az_result az_ulib_ustream_init_from_file(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_file_data_cb* file_data,
+    az_ulib_release_callback file_data_release,
+    const char* file_name);
+
+/**
+ * @brief   Structure for the spans ustream control block.
+ *
+ *  The spans ustream exposes a list of #az_span as a single ustream. It keeps the position right
+ *      after the end of each span in a caller provided array, so it finds the span of any position
+ *      with a binary search.
+ *
+ * @note    This structure should be viewed and used as internal to the implementation of the
+ *          ustream. Users should therefore not act on it directly and only allocate the memory
+ *          necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_spans_data_cb_tag
+{
+  /** The #az_ulib_ustream_data_cb to manage the spans. */
+  az_ulib_ustream_data_cb control_block;
+
+  /** The #az_span array with the content of the ustream. */
+  const az_span* spans;
+
+  /** The `offset_t` array with the position right after the end of each span. */
+  offset_t* span_ends;
+
+  /** The `size_t` with the number of spans. */
+  size_t span_count;
+} az_ulib_ustream_spans_data_cb;
+
+/**
+ * @brief   Factory to initialize a new ustream over a list of spans.
+ *
+ *  This factory initializes a ustream that handles the content of all the provided `spans`, in
+ *      order, as if they were one buffer, without copying them. It allows a message that is
+ *      stored in fragments, like the header, the body, and the trailer, to be exposed as a
+ *      single ustream without a concat chain. Empty spans are allowed and ignored.
+ *
+ *  The `spans` array, the `span_ends` array, and the content of the spans shall stay valid and
+ *      unchanged until the `spans_data_release` is called, when the ref count of the control
+ *      block goes to zero. The `spans_data`, the `spans`, and the `span_ends` may be part of the
+ *      same allocation.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct.
+ *                                          It cannot be `NULL`.
+ * @param[in]       spans_data              The pointer to the allocated
+ *                                          #az_ulib_ustream_spans_data_cb struct. It cannot be
+ *                                          `NULL`.
+ * @param[in]       spans_data_release      The #az_ulib_release_callback function that will be
+ *                                          called to release the `spans_data` once all the
+ *                                          references to the ustream are disposed. It may be
+ *                                          `NULL` if the `spans_data` does not need to be
+ *                                          released.
+ * @param[in]       spans                   The `const` #az_span array with the content of the
+ *                                          ustream. It cannot be `NULL`.
+ * @param[in]       span_ends               The `offset_t` array, with at least `span_count`
+ *                                          elements, that the ustream will use to store the end
+ *                                          of each span. It cannot be `NULL`.
+ * @param[in]       span_count              The `size_t` with the number of spans. It cannot be
+ *                                          zero.
+ *
+ * @return The #az_result with result of the initialization.
+ *      @retval #AZ_OK                        If the #az_ulib_ustream* is successfully
+ *                                            initialized.
+ */
+AZ_NODISCARD az_result az_ulib_ustream_init_from_spans(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_spans_data_cb* spans_data,
+    az_ulib_release_callback spans_data_release,
+    const az_span* spans,
+    offset_t* span_ends,
+    size_t span_count);
+
 /**
  * @brief   Concatenate a ustream to the existing ustream.
  *
@@ -156,6 +294,165 @@ AZ_NODISCARD az_result az_ulib_ustream_split(
     az_ulib_ustream* ustream_instance_split,
     offset_t split_pos);
 
+/**
+ * @brief   Exposes the content of a ustream as a list of spans without copying it.
+ *
+ *  This API fills the `spans` with the content of the ustream, from the current position to the
+ *      end, using az_ulib_ustream_peek() on a clone of the ustream, so it does not change the
+ *      current position. The result may be passed to scatter-gather APIs, like `writev` or
+ *      `sendmsg`, or to `az_json_reader_chunked_init`.
+ *
+ *  The spans point to the content of the ustream, so they are valid while the `ustream_instance`
+ *      is not disposed and the content is not released. The consumer shall not change the content
+ *      of the spans.
+ *
+ * @param[in]       ustream_instance        The #az_ulib_ustream* with the interface of the
+ *                                          ustream. It cannot be `NULL`, and it shall be a valid
+ *                                          ustream.
+ * @param[out]      spans                   The #az_span array to fill. It cannot be `NULL`.
+ * @param[in]       max_spans               The `size_t` with the number of elements in `spans`.
+ *                                          It cannot be zero.
+ * @param[out]      span_count              The `size_t*` to return the number of spans filled. It
+ *                                          cannot be `NULL`.
+ *
+ * @return The #az_result with the result of the operation.
+ *      @retval #AZ_OK                        If all the remaining content is in the `spans`.
+ *      @retval #AZ_ERROR_NOT_ENOUGH_SPACE    If the remaining content needs more than `max_spans`
+ *                                            spans. The `spans` contain the first `max_spans`
+ *                                            parts of the content.
+ *      @retval #AZ_ERROR_NOT_SUPPORTED       If the ustream, or one of its parts, does not
+ *                                            implement az_ulib_ustream_peek().
+ */
+AZ_NODISCARD az_result az_ulib_ustream_to_span_array(
+    az_ulib_ustream* ustream_instance,
+    az_span* spans,
+    size_t max_spans,
+    size_t* span_count);
+
+/**
+ * @brief   Structure for one segment of a rope ustream.
+ *
+ *  Each segment keeps a clone of one appended ustream, and the position of the rope right after
+ *      its last byte. The segments are sorted by position, so the rope finds the segment of any
+ *      position with a binary search.
+ *
+ * @note    This structure should be viewed and used as internal to the implementation of the
+ *          ustream. Users should therefore not act on it directly and only allocate the memory
+ *          necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_rope_segment_tag
+{
+  /** The #az_ulib_ustream with the clone of the appended ustream. */
+  az_ulib_ustream ustream;
+
+  /** The `offset_t` with the position of the rope right after the last byte of this segment. */
+  offset_t end;
+} az_ulib_ustream_rope_segment;
+
+/**
+ * @brief   Structure for the rope ustream control block.
+ *
+ *  The rope ustream concatenates any number of ustreams with a single control block. It keeps the
+ *      appended ustreams in a caller provided array of #az_ulib_ustream_rope_segment, so
+ *      positioning a rope of K segments costs O(log K), instead of the O(K) of a chain of
+ *      az_ulib_ustream_concat().
+ *
+ * @note    This structure should be viewed and used as internal to the implementation of the
+ *          ustream. Users should therefore not act on it directly and only allocate the memory
+ *          necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_rope_data_cb_tag
+{
+  /** The #az_ulib_ustream_data_cb to manage the rope. */
+  az_ulib_ustream_data_cb control_block;
+
+  /** The #az_ulib_ustream_rope_segment array with the appended ustreams. */
+  az_ulib_ustream_rope_segment* segments;
+
+  /** The `size_t` with the number of segments in use. */
+  size_t segment_count;
+
+  /** The `size_t` with the number of segments in the array. */
+  size_t max_segments;
+
+  /** The #az_ulib_pal_os_lock with controls the critical section of the segments that cannot
+   * read at a given position. */
+  az_ulib_pal_os_lock lock;
+} az_ulib_ustream_rope_data_cb;
+
+/**
+ * @brief   Factory to initialize a new empty rope ustream.
+ *
+ *  The rope is a ustream that concatenates the ustreams added by az_ulib_ustream_rope_append().
+ *      It uses a single control block and a single array of segments for all the appended
+ *      ustreams, so building a message from many fragments does not need one
+ *      #az_ulib_ustream_multi_data_cb per fragment, and the cost to position or read the rope
+ *      does not grow linearly with the number of fragments. The `rope_data` and the `segments`
+ *      may be part of the same allocation.
+ *
+ *  The rope is a regular ustream that can be cloned, split, and concatenated as any other
+ *      ustream. When the ref count of the control block goes to zero, the rope disposes all the
+ *      appended ustreams and calls the `rope_data_release` to release the `rope_data`.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct.
+ *                                          It cannot be `NULL`.
+ * @param[in]       rope_data               The pointer to the allocated
+ *                                          #az_ulib_ustream_rope_data_cb struct. This memory shall
+ *                                          stay valid until the passed `rope_data_release` is
+ *                                          called. It cannot be `NULL`.
+ * @param[in]       rope_data_release       The #az_ulib_release_callback function that will be
+ *                                          called to release the `rope_data` once all the
+ *                                          references to the ustream are disposed. It may be
+ *                                          `NULL` if the `rope_data` does not need to be released.
+ * @param[in]       segments                The pointer to the allocated array of
+ *                                          #az_ulib_ustream_rope_segment. This memory shall stay
+ *                                          valid until the passed `rope_data_release` is called.
+ *                                          It cannot be `NULL`.
+ * @param[in]       max_segments            The `size_t` with the number of segments in the
+ *                                          `segments` array. It cannot be zero.
+ *
+ * @return The #az_result with result of the initialization.
+ *      @retval #AZ_OK                        If the #az_ulib_ustream* is successfully
+ *                                            initialized.
+ */
+AZ_NODISCARD az_result az_ulib_ustream_rope_init(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_rope_data_cb* rope_data,
+    az_ulib_release_callback rope_data_release,
+    az_ulib_ustream_rope_segment* segments,
+    size_t max_segments);
+
+/**
+ * @brief   Append a ustream at the end of a rope ustream.
+ *
+ *  The append clones the `ustream_to_append`, from its current position to its end, in the next
+ *      free segment of the rope. The `ustream_instance` will then be read as if its content and
+ *      the content of the `ustream_to_append` were one ustream. The `ustream_to_append` shall
+ *      still be disposed by the calling function.
+ *
+ *  If the `ustream_to_append` has no remaining content, the append does nothing. Clones of the
+ *      rope created before the append will not contain the appended content.
+ *
+ * @note    The append changes the control block of the rope. It shall not be called while other
+ *          threads use any instance of the same rope.
+ *
+ * @param[in,out]  ustream_instance        The #az_ulib_ustream* with the rope ustream. It cannot
+ *                                         be `NULL`, and it shall be a rope ustream created by
+ *                                         az_ulib_ustream_rope_init().
+ * @param[in]      ustream_to_append       The #az_ulib_ustream* with the interface of the
+ *                                         ustream to append to `ustream_instance`. It cannot be
+ *                                         `NULL`, and it shall be a valid ustream.
+ *
+ * @return The #az_result with the result of the `append` operation.
+ *     @retval #AZ_OK                         If the ustream was appended with success.
+ *     @retval #AZ_ERROR_ARG                  If the `ustream_instance` does not end at the end
+ *                                            of the rope, like a clone created before another
+ *                                            append, or the first part of a split.
+ *     @retval #AZ_ERROR_NOT_ENOUGH_SPACE     If all the segments of the rope are in use.
+ */
+AZ_NODISCARD az_result
+az_ulib_ustream_rope_append(az_ulib_ustream* ustream_instance, az_ulib_ustream* ustream_to_append);
+
 #include "azure/core/_az_cfg_suffix.h"
 
 #endif /* AZ_ULIB_USTREAM_H */
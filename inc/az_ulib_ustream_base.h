@@ -21,10 +21,12 @@
  *
  *  The ustream shall have a clear separation between the internal content (provider domain)
  *      and what it exposes as external content (consumer domain). The ustream shall never expose
- *      the internal content (ex: providing a pointer to a internal memory position). All
- *      exposed content shall be copied from the internal data source to some given external
- *      memory. To do that in a clear way, the ustream shall always work with the concept of two
- *      buffers, the `data source` and the `local buffer`, adhering to the following definition:
+ *      the internal content for write, and, except for the optional az_ulib_ustream_peek(), it
+ *      shall never expose a pointer to an internal memory position. All content exposed by
+ *      az_ulib_ustream_read() shall be copied from the internal data source to some given
+ *      external memory. To do that in a clear way, the ustream shall always work with the concept
+ *      of two buffers, the `data source` and the `local buffer`, adhering to the following
+ *      definition:
  *      - <b>Data source</b> - is the place where the data is stored by the implementation of the
  *          ustream interface. The data source is in the provider domain, and it shall be
  *          protected, immutable, and non volatile. Consumers can read the data from the data
@@ -391,6 +393,24 @@ typedef struct az_ulib_ustream_interface_tag
   /** Concrete `dispose` implementation. */
   az_result (*dispose)(az_ulib_ustream* ustream_instance);
 
+  /** Concrete `peek` implementation. `NULL` if the ustream cannot expose its data source. */
+  az_result (*peek)(
+      az_ulib_ustream* ustream_instance,
+      const uint8_t** const data,
+      size_t* const size);
+
+  /** Concrete `advance` implementation. `NULL` if the ustream cannot expose its data source. */
+  az_result (*advance)(az_ulib_ustream* ustream_instance, size_t size);
+
+  /** Concrete `read_at` implementation. `NULL` if the ustream only reads from the current
+   * position. */
+  az_result (*read_at)(
+      az_ulib_ustream* ustream_instance,
+      offset_t position,
+      uint8_t* const buffer,
+      size_t buffer_length,
+      size_t* const size);
+
 } az_ulib_ustream_interface;
 
 /**
@@ -677,6 +697,173 @@ AZ_INLINE az_result az_ulib_ustream_read(
   return ustream_instance->control_block->api->read(ustream_instance, buffer, buffer_length, size);
 }
 
+/**
+ * @brief   Gets the next portion of the ustream starting at the provided position.
+ *
+ *  This is an optional API that copies the content of the `Data Source` to the local buffer in
+ *      the same way as az_ulib_ustream_read(), but starting at the provided logical `position`
+ *      instead of the current position. It does not change the current position, or any other
+ *      state of the instance, so many threads can read the same instance at the same time
+ *      without a lock. It is also the way that a ustream that contains other ustreams, as the
+ *      ones created by az_ulib_ustream_concat(), reads them without moving their current
+ *      position.
+ *
+ *  The `az_ulib_ustream_read_at` API shall follow the following minimum requirements:
+ *      - The `read_at` shall copy the contents of the `Data Source` starting at the logical
+ *          `position` to the provided local buffer.
+ *      - If the contents of the `Data Source` is bigger than the `buffer_length`, the `read_at`
+ *          shall limit the copy size up to the buffer_length.
+ *      - The `read_at` shall return the number of valid `uint8_t` values in the local buffer in
+ *          the provided `size`.
+ *      - The `read_at` shall not change the current position of the ustream.
+ *      - If the `position` is the end of the ustream, the `read_at` shall return #AZ_ULIB_EOF,
+ *          size shall be set to 0, and will not change the contents of the local buffer.
+ *      - If the `position` is after the end of the ustream, or before the first valid position,
+ *          the `read_at` shall return #AZ_ERROR_ITEM_NOT_FOUND.
+ *      - If the ustream does not implement `read_at`, it shall return #AZ_ERROR_NOT_SUPPORTED.
+ *          In this case, the consumer shall use az_ulib_ustream_set_position() and
+ *          az_ulib_ustream_read().
+ *      - If the provided buffer_length is zero, the `read_at` shall fail with precondition.
+ *      - If the provided interface is `NULL`, the `read_at` shall fail with precondition.
+ *      - If the provided interface is not the implemented ustream type, the `read_at` shall fail
+ *          with precondition.
+ *      - If the provided local buffer is `NULL`, the `read_at` shall fail with precondition.
+ *      - If the provided return size pointer is `NULL`, the `read_at` shall fail with
+ *          precondition.
+ *
+ * @param[in]       ustream_instance    The #az_ulib_ustream* with the interface of the ustream.
+ * @param[in]       position            The `offset_t` with the logical position of the first
+ *                                      `uint8_t` to copy.
+ * @param[out]      buffer              The `uint8_t* const` that points to the local buffer.
+ * @param[in]       buffer_length       The `size_t` with the size of the local buffer.
+ * @param[out]      size                The `size_t* const` that points to the place where the
+ *                                      `read_at` shall store the number of valid `uint8_t`
+ *                                      values returned in the local buffer.
+ *
+ * @pre     \p ustream_instance shall not be `NULL`.
+ * @pre     \p ustream_instance shall be a valid ustream that is the implemented ustream type.
+ * @pre     \p buffer shall not be `NULL`.
+ * @pre     \p buffer_length shall be bigger than 0.
+ * @pre     \p size shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the `read_at` operation.
+ *      @retval #AZ_OK                        If the ustream copied the content of the `Data
+ *                                            Source` to the local buffer with success.
+ *      @retval #AZ_ULIB_EOF                  If the `position` is the end of the `Data Source`.
+ *      @retval #AZ_ERROR_ITEM_NOT_FOUND      If the `position` is out of the range of the
+ *                                            ustream.
+ *      @retval #AZ_ERROR_NOT_SUPPORTED       If the ustream cannot read at a given position.
+ *      @retval #AZ_ERROR_ULIB_BUSY           If the resource necessary to read the ustream
+ *                                            content is busy.
+ *      @retval #AZ_ERROR_ULIB_SYSTEM         If the `read_at` operation failed on the system
+ *                                            level.
+ */
+AZ_INLINE az_result az_ulib_ustream_read_at(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  return (ustream_instance->control_block->api->read_at == NULL)
+      ? AZ_ERROR_NOT_SUPPORTED
+      : ustream_instance->control_block->api->read_at(
+          ustream_instance, position, buffer, buffer_length, size);
+}
+
+/**
+ * @brief   Returns the next contiguous part of the ustream without copying it.
+ *
+ *  This is an optional API that exposes a read-only pointer to the `Data Source` starting at the
+ *      current position, and the number of contiguous bytes available from it. It allows
+ *      consumers that only inspect or forward the content to skip the copy to a local buffer. The
+ *      current position is not changed, the consumer shall call az_ulib_ustream_advance() to
+ *      move it after using the content.
+ *
+ *  The `az_ulib_ustream_peek` API shall follow the following minimum requirements:
+ *      - The `peek` shall return in `data` a pointer to the content of the `Data Source` at the
+ *          current position, and in `size` the number of contiguous bytes in it.
+ *      - The `size` shall not be bigger than the remaining size of the ustream, but it may be
+ *          smaller if the `Data Source` is not contiguous.
+ *      - The `peek` shall not change the current position.
+ *      - The content pointed by `data` shall be valid while the instance of the ustream is not
+ *          disposed and the content is not released.
+ *      - If there is no more content to return, the `peek` shall return #AZ_ULIB_EOF, `data`
+ *          shall be set to `NULL`, and `size` shall be set to 0.
+ *      - If the ustream does not implement `peek`, it shall return #AZ_ERROR_NOT_SUPPORTED. In
+ *          this case, the consumer shall use az_ulib_ustream_read().
+ *      - If the provided interface is `NULL`, the `peek` shall fail with precondition.
+ *      - If the provided interface is not the implemented ustream type, the `peek` shall fail
+ *          with precondition.
+ *      - If the provided data or size pointer is `NULL`, the `peek` shall fail with
+ *          precondition.
+ *
+ * @param[in]   ustream_instance    The #az_ulib_ustream* with the interface of the ustream.
+ * @param[out]  data                The `const uint8_t** const` to return the pointer to the
+ *                                  content at the current position.
+ * @param[out]  size                The `size_t* const` to return the number of contiguous
+ *                                  `uint8_t` values in `data`.
+ *
+ * @pre     \p ustream_instance shall not be `NULL`.
+ * @pre     \p ustream_instance shall be a valid ustream that is the implemented ustream type.
+ * @pre     \p data shall not be `NULL`.
+ * @pre     \p size shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the `peek` operation.
+ *      @retval #AZ_OK                        If the ustream returned the content at the current
+ *                                            position.
+ *      @retval #AZ_ULIB_EOF                  If there are no more `uint8_t` values in the `Data
+ *                                            Source` to return.
+ *      @retval #AZ_ERROR_NOT_SUPPORTED       If the ustream cannot expose its `Data Source`.
+ *      @retval #AZ_ERROR_ULIB_BUSY           If the resource necessary to peek the ustream
+ *                                            content is busy.
+ *      @retval #AZ_ERROR_ULIB_SYSTEM         If the `peek` operation failed on the system level.
+ */
+AZ_INLINE az_result az_ulib_ustream_peek(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t** const data,
+    size_t* const size)
+{
+  return (ustream_instance->control_block->api->peek == NULL)
+      ? AZ_ERROR_NOT_SUPPORTED
+      : ustream_instance->control_block->api->peek(ustream_instance, data, size);
+}
+
+/**
+ * @brief   Moves the current position of the ustream forward.
+ *
+ *  This is the optional counterpart of the az_ulib_ustream_peek(). After consuming `size` bytes
+ *      exposed by the `peek`, the consumer calls this API to move the current position to the
+ *      first byte that was not consumed, in the same way that az_ulib_ustream_read() does.
+ *
+ *  The `az_ulib_ustream_advance` API shall follow the following minimum requirements:
+ *      - The `advance` shall move the current position `size` bytes forward.
+ *      - If `size` is bigger than the remaining size of the ustream, the `advance` shall return
+ *          #AZ_ERROR_ITEM_NOT_FOUND and shall not change the current position.
+ *      - If the ustream does not implement `advance`, it shall return #AZ_ERROR_NOT_SUPPORTED.
+ *      - If the provided interface is `NULL`, the `advance` shall fail with precondition.
+ *      - If the provided interface is not the implemented ustream type, the `advance` shall fail
+ *          with precondition.
+ *
+ * @param[in]   ustream_instance    The #az_ulib_ustream* with the interface of the ustream.
+ * @param[in]   size                The `size_t` with the number of `uint8_t` values to skip.
+ *
+ * @pre     \p ustream_instance shall not be `NULL`.
+ * @pre     \p ustream_instance shall be a valid ustream that is the implemented ustream type.
+ *
+ * @return The #az_result with the result of the `advance` operation.
+ *      @retval #AZ_OK                        If the current position was moved with success.
+ *      @retval #AZ_ERROR_ITEM_NOT_FOUND      If `size` is bigger than the remaining size of the
+ *                                            ustream.
+ *      @retval #AZ_ERROR_NOT_SUPPORTED       If the ustream cannot expose its `Data Source`.
+ */
+AZ_INLINE az_result az_ulib_ustream_advance(az_ulib_ustream* ustream_instance, size_t size)
+{
+  return (ustream_instance->control_block->api->advance == NULL)
+      ? AZ_ERROR_NOT_SUPPORTED
+      : ustream_instance->control_block->api->advance(ustream_instance, size);
+}
+
 /**
  * @brief   Returns the remaining size of the ustream.
  *
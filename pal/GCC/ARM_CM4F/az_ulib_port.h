@@ -29,7 +29,7 @@ extern "C"
                    : "r"(addr)
                    : "cc", "memory");
 
-    return prev;
+    return result;
   }
 
   __attribute__((always_inline)) static inline long AZ_ULIB_PORT_ATOMIC_DEC_W(volatile long* addr)
@@ -48,7 +48,7 @@ extern "C"
                    : "r"(addr)
                    : "cc", "memory");
 
-    return prev;
+    return result;
   }
 
   __attribute__((always_inline)) static inline long AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
@@ -87,8 +87,15 @@ extern "C"
     return result;
   }
 
+#define AZ_ULIB_PORT_MEMORY_BARRIER() __asm volatile("dmb" ::: "memory")
+
 #define AZ_ULIB_PORT_THROW_HARD_FAULT (*(char*)NULL = 0)
 
+  /*single core without data cache, so there is no false sharing to avoid. There is no thread
+   * local storage, so AZ_ULIB_PORT_THREAD_LOCAL is not defined*/
+#define AZ_ULIB_PORT_CACHE_LINE_SIZE 4
+#define AZ_ULIB_PORT_CACHE_ALIGNED
+
 #ifdef __cplusplus
 }
 #endif
@@ -57,6 +57,10 @@ extern "C"
     *addr = val;
     return prev;
   }
+#define AZ_ULIB_PORT_MEMORY_BARRIER() \
+  do                                \
+  {                                 \
+  } while (0)
 
 #elif defined(AZURE_ULIB_C_USE_STD_ATOMIC)
 #ifndef __cplusplus
@@ -74,6 +78,7 @@ static inline long AZ_ULIB_PORT_ATOMIC_DEC_W(volatile long* addr)
 }
 #define AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(target, value) atomic_exchange((target), (value))
 #define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(target, value) atomic_exchange((target), (value))
+#define AZ_ULIB_PORT_MEMORY_BARRIER() atomic_thread_fence(memory_order_seq_cst)
 
 #elif defined(AZURE_ULIB_C_USE_GNU_C_ATOMIC)
 #define AZ_ULIB_PORT_ATOMIC_INC_W(count) __sync_add_and_fetch((count), 1)
@@ -82,11 +87,17 @@ static inline long AZ_ULIB_PORT_ATOMIC_DEC_W(volatile long* addr)
   __sync_val_compare_and_swap((target), *(target), (value))
 #define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(target, value) \
   __sync_val_compare_and_swap((target), *(target), (value))
+#define AZ_ULIB_PORT_MEMORY_BARRIER() __sync_synchronize()
 
 #endif /*defined(AZURE_ULIB_C_USE_GNU_C_ATOMIC)*/
 
 #define AZ_ULIB_PORT_THROW_HARD_FAULT (*(char*)NULL = 0)
 
+  /*the following macros avoid false sharing between counters updated by different threads*/
+#define AZ_ULIB_PORT_CACHE_LINE_SIZE 64
+#define AZ_ULIB_PORT_CACHE_ALIGNED __attribute__((aligned(AZ_ULIB_PORT_CACHE_LINE_SIZE)))
+#define AZ_ULIB_PORT_THREAD_LOCAL __thread
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -13,7 +13,12 @@
   InterlockedExchange((volatile LONG*)(target), (LONG)(value))
 #define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(target, value) \
   InterlockedExchangePointer((volatile PVOID*)(target), (PVOID)(value))
+#define AZ_ULIB_PORT_MEMORY_BARRIER() MemoryBarrier()
 
 #define AZ_ULIB_PORT_THROW_HARD_FAULT (*(char*)NULL = 0)
 
+#define AZ_ULIB_PORT_CACHE_LINE_SIZE 64
+#define AZ_ULIB_PORT_CACHE_ALIGNED __declspec(align(AZ_ULIB_PORT_CACHE_LINE_SIZE))
+#define AZ_ULIB_PORT_THREAD_LOCAL __declspec(thread)
+
 #endif /* MSBUILD_X86_ULIB_PORT_H */
@@ -12,8 +12,11 @@
 #include "az_ulib_pal_os.h"
 
 #ifndef __cplusplus
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #else
+#include <cstddef>
 #include <cstdint>
 extern "C"
 {
@@ -56,6 +59,139 @@ void az_pal_os_lock_release(az_ulib_pal_os_lock* lock);
  */
 void az_pal_os_sleep(uint32_t sleep_time_ms);
 
+/**
+ * @brief   Get the time of a monotonic clock in microseconds.
+ *
+ * The clock starts in an arbitrary point and wraps around, so only the difference between two
+ * readings has meaning. The resolution depends on the platform.
+ *
+ * @return The `uint32_t` with the current time of the clock in microseconds.
+ */
+uint32_t az_pal_os_clock_us(void);
+
+/**
+ * @brief   Signature of the function that runs in a new thread.
+ *
+ * @param[in]       arg     The `void*` provided to az_pal_os_thread_create().
+ */
+typedef void (*az_ulib_pal_os_thread_function)(void* arg);
+
+/**
+ * @brief   Create and start a new thread.
+ *
+ * @param[in,out]   thread      The #az_ulib_pal_os_thread* that points to the thread control block.
+ *                              It shall be valid up to the thread is joined.
+ * @param[in]       function    The #az_ulib_pal_os_thread_function that the thread shall run.
+ * @param[in]       arg         The `void*` to pass to the function.
+ *
+ * @return `true` if the thread was created, `false` otherwise.
+ */
+bool az_pal_os_thread_create(
+    az_ulib_pal_os_thread* thread,
+    az_ulib_pal_os_thread_function function,
+    void* arg);
+
+/**
+ * @brief   Wait for the end of a thread and release its resources.
+ *
+ * @param[in]       thread      The #az_ulib_pal_os_thread* that points to a thread created by
+ *                              az_pal_os_thread_create().
+ */
+void az_pal_os_thread_join(az_ulib_pal_os_thread* thread);
+
+/**
+ * @brief   This API initialize a counting semaphore.
+ *
+ * @param[in,out]   semaphore       The #az_ulib_pal_os_semaphore* that points to the semaphore.
+ * @param[in]       initial_count   The `uint32_t` with the initial count of the semaphore.
+ */
+void az_pal_os_semaphore_init(az_ulib_pal_os_semaphore* semaphore, uint32_t initial_count);
+
+/**
+ * @brief   The semaphore instance is destroyed.
+ *
+ * @param[in]       semaphore   The #az_ulib_pal_os_semaphore* that points to a valid semaphore.
+ */
+void az_pal_os_semaphore_deinit(az_ulib_pal_os_semaphore* semaphore);
+
+/**
+ * @brief   Wait until the semaphore count is bigger than zero, and decrement it.
+ *
+ * @param[in]       semaphore   The #az_ulib_pal_os_semaphore* that points to a valid semaphore.
+ */
+void az_pal_os_semaphore_wait(az_ulib_pal_os_semaphore* semaphore);
+
+/**
+ * @brief   Increment the semaphore count, releasing one waiting thread if there is any.
+ *
+ * @param[in]       semaphore   The #az_ulib_pal_os_semaphore* that points to a valid semaphore.
+ */
+void az_pal_os_semaphore_post(az_ulib_pal_os_semaphore* semaphore);
+
+/**
+ * @brief   This API initialize an auto-reset event in the not signaled state.
+ *
+ * @param[in,out]   event       The #az_ulib_pal_os_event* that points to the event.
+ */
+void az_pal_os_event_init(az_ulib_pal_os_event* event);
+
+/**
+ * @brief   The event instance is destroyed.
+ *
+ * @param[in]       event       The #az_ulib_pal_os_event* that points to a valid event.
+ */
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event);
+
+/**
+ * @brief   Signal the event, releasing the thread waiting for it. If there is no thread waiting,
+ *          the event stays signaled up to the next az_pal_os_event_wait().
+ *
+ * @param[in]       event       The #az_ulib_pal_os_event* that points to a valid event.
+ */
+void az_pal_os_event_set(az_ulib_pal_os_event* event);
+
+/**
+ * @brief   Wait until the event is signaled, and reset it.
+ *
+ * @param[in]       event           The #az_ulib_pal_os_event* that points to a valid event.
+ * @param[in]       wait_option_ms  The `uint32_t` with the maximum number of milliseconds to wait.
+ *                                  `0xFFFFFFFF` waits forever.
+ *
+ * @return `true` if the event was signaled, `false` if the wait timed out.
+ */
+bool az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms);
+
+/**
+ * @brief   Map the content of a file in the memory, read-only.
+ *
+ * The mapped memory stays valid up to az_pal_os_file_unmap(), even if the file is deleted.
+ * An empty file is not mapped: it returns `true` with `data` set to `NULL` and `size` set to 0,
+ * and az_pal_os_file_unmap() shall still be called for it. Platforms without files or memory
+ * mapping shall always return `false`.
+ *
+ * @param[out]      file_map    The #az_ulib_pal_os_file_map* that points to the mapping control
+ *                              block.
+ * @param[in]       file_name   The `const char*` with the name of the file to map.
+ * @param[out]      data        The `const uint8_t**` to store the pointer to the mapped content.
+ * @param[out]      size        The `size_t*` to store the number of bytes in the mapped content.
+ *
+ * @return `true` if the file was mapped or is empty, `false` if it does not exist or cannot be
+ *         mapped.
+ */
+bool az_pal_os_file_map(
+    az_ulib_pal_os_file_map* file_map,
+    const char* file_name,
+    const uint8_t** data,
+    size_t* size);
+
+/**
+ * @brief   Release the memory mapped by az_pal_os_file_map().
+ *
+ * @param[in,out]   file_map    The #az_ulib_pal_os_file_map* that points to the mapping control
+ *                              block.
+ */
+void az_pal_os_file_unmap(az_ulib_pal_os_file_map* file_map);
+
 #ifdef __cplusplus
 }
 #endif
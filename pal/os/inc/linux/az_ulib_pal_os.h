@@ -6,6 +6,8 @@
 #define AZ_ULIB_PAL_OS_LINUX_H
 
 #include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -19,6 +21,51 @@ extern "C"
    */
   typedef pthread_mutex_t az_ulib_pal_os_lock;
 
+  /*
+   *  @struct az_ulib_pal_os_thread
+   *
+   *  @brief  platform specific struct for a thread implementation
+   */
+  typedef struct
+  {
+    pthread_t thread;
+    void (*function)(void* arg);
+    void* arg;
+  } az_ulib_pal_os_thread;
+
+  /*
+   *  @struct az_ulib_pal_os_semaphore
+   *
+   *  @brief  platform specific struct for a counting semaphore implementation
+   */
+  typedef struct
+  {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t count;
+  } az_ulib_pal_os_semaphore;
+
+  /*
+   *  @struct az_ulib_pal_os_event
+   *
+   *  @brief  platform specific struct for an auto-reset event implementation, based on futex
+   */
+  typedef struct
+  {
+    volatile int state;
+  } az_ulib_pal_os_event;
+
+  /*
+   *  @struct az_ulib_pal_os_file_map
+   *
+   *  @brief  platform specific struct for a read-only file mapping implementation
+   */
+  typedef struct
+  {
+    void* ptr;
+    size_t size;
+  } az_ulib_pal_os_file_map;
+
 #ifdef __cplusplus
 }
 #endif
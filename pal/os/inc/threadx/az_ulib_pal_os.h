@@ -19,6 +19,57 @@ extern "C"
    */
   typedef TX_MUTEX az_ulib_pal_os_lock;
 
+#ifndef AZ_ULIB_PAL_OS_THREAD_STACK_SIZE
+/*
+ * Size, in bytes, of the stack of each thread created by the PAL.
+ */
+#define AZ_ULIB_PAL_OS_THREAD_STACK_SIZE 2048
+#endif
+
+#ifndef AZ_ULIB_PAL_OS_THREAD_PRIORITY
+/*
+ * ThreadX priority of the threads created by the PAL.
+ */
+#define AZ_ULIB_PAL_OS_THREAD_PRIORITY 16
+#endif
+
+  /*
+   *  @struct az_ulib_pal_os_thread
+   *
+   *  @brief  platform specific struct for a thread implementation
+   */
+  typedef struct
+  {
+    TX_THREAD thread;
+    void (*function)(void* arg);
+    void* arg;
+    ULONG stack[AZ_ULIB_PAL_OS_THREAD_STACK_SIZE / sizeof(ULONG)];
+  } az_ulib_pal_os_thread;
+
+  /*
+   *  @struct az_ulib_pal_os_semaphore
+   *
+   *  @brief  pointer to a platform specific struct for a counting semaphore implementation
+   */
+  typedef TX_SEMAPHORE az_ulib_pal_os_semaphore;
+
+  /*
+   *  @struct az_ulib_pal_os_event
+   *
+   *  @brief  pointer to a platform specific struct for an auto-reset event implementation
+   */
+  typedef TX_EVENT_FLAGS_GROUP az_ulib_pal_os_event;
+
+  /*
+   *  @struct az_ulib_pal_os_file_map
+   *
+   *  @brief  placeholder, ThreadX has no file mapping
+   */
+  typedef struct
+  {
+    void* ptr;
+  } az_ulib_pal_os_file_map;
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,42 @@ extern "C"
    */
   typedef SRWLOCK az_ulib_pal_os_lock;
 
+  /*
+   *  @struct az_ulib_pal_os_thread
+   *
+   *  @brief  platform specific struct for a thread implementation
+   */
+  typedef struct
+  {
+    HANDLE thread;
+    void (*function)(void* arg);
+    void* arg;
+  } az_ulib_pal_os_thread;
+
+  /*
+   *  @struct az_ulib_pal_os_semaphore
+   *
+   *  @brief  pointer to a platform specific struct for a counting semaphore implementation
+   */
+  typedef HANDLE az_ulib_pal_os_semaphore;
+
+  /*
+   *  @struct az_ulib_pal_os_event
+   *
+   *  @brief  pointer to a platform specific struct for an auto-reset event implementation
+   */
+  typedef HANDLE az_ulib_pal_os_event;
+
+  /*
+   *  @struct az_ulib_pal_os_file_map
+   *
+   *  @brief  platform specific struct for a read-only file mapping implementation
+   */
+  typedef struct
+  {
+    LPVOID view;
+  } az_ulib_pal_os_file_map;
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,12 +2,23 @@
 // Licensed under the MIT license.
 // See LICENSE file in the project root for full license information.
 
+// syscall() is required by the futex based event.
+#define _DEFAULT_SOURCE
+
 #include <pthread.h>
 #include <time.h>
 
 #ifdef TI_RTOS
+#include <ti/sysbios/knl/Clock.h>
 #include <ti/sysbios/knl/Task.h>
 #else
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 #endif
 
@@ -45,3 +56,233 @@ void az_pal_os_sleep(uint32_t sleep_time_ms)
   (void)nanosleep(&time_to_sleep, NULL);
 #endif
 }
+
+uint32_t az_pal_os_clock_us(void)
+{
+#ifdef TI_RTOS
+  return (uint32_t)(Clock_getTicks() * Clock_tickPeriod);
+#else
+  struct timespec now;
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)(((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000));
+#endif
+}
+
+static void* thread_entry(void* arg)
+{
+  az_ulib_pal_os_thread* thread = (az_ulib_pal_os_thread*)arg;
+  thread->function(thread->arg);
+  return NULL;
+}
+
+bool az_pal_os_thread_create(
+    az_ulib_pal_os_thread* thread,
+    az_ulib_pal_os_thread_function function,
+    void* arg)
+{
+  thread->function = function;
+  thread->arg = arg;
+  return (pthread_create(&(thread->thread), NULL, thread_entry, thread) == 0);
+}
+
+void az_pal_os_thread_join(az_ulib_pal_os_thread* thread)
+{
+  (void)pthread_join(thread->thread, NULL);
+}
+
+void az_pal_os_semaphore_init(az_ulib_pal_os_semaphore* semaphore, uint32_t initial_count)
+{
+  pthread_mutex_init(&(semaphore->mutex), NULL);
+  pthread_cond_init(&(semaphore->cond), NULL);
+  semaphore->count = initial_count;
+}
+
+void az_pal_os_semaphore_deinit(az_ulib_pal_os_semaphore* semaphore)
+{
+  pthread_cond_destroy(&(semaphore->cond));
+  pthread_mutex_destroy(&(semaphore->mutex));
+}
+
+void az_pal_os_semaphore_wait(az_ulib_pal_os_semaphore* semaphore)
+{
+  pthread_mutex_lock(&(semaphore->mutex));
+  while (semaphore->count == 0)
+  {
+    pthread_cond_wait(&(semaphore->cond), &(semaphore->mutex));
+  }
+  semaphore->count--;
+  pthread_mutex_unlock(&(semaphore->mutex));
+}
+
+void az_pal_os_semaphore_post(az_ulib_pal_os_semaphore* semaphore)
+{
+  pthread_mutex_lock(&(semaphore->mutex));
+  semaphore->count++;
+  pthread_cond_signal(&(semaphore->cond));
+  pthread_mutex_unlock(&(semaphore->mutex));
+}
+
+#define EVENT_RESET 0
+#define EVENT_SIGNALED 1
+#define EVENT_WAIT_FOREVER 0xFFFFFFFF
+
+#ifndef TI_RTOS
+static long futex(volatile int* address, int operation, int value, const struct timespec* timeout)
+{
+  return syscall(SYS_futex, address, operation, value, timeout, NULL, 0);
+}
+
+/*
+ * Returns false if the deadline already passed, otherwise stores the time up to the deadline in
+ * remaining.
+ */
+static bool get_remaining_time(const struct timespec* deadline, struct timespec* remaining)
+{
+  struct timespec now;
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  remaining->tv_sec = deadline->tv_sec - now.tv_sec;
+  remaining->tv_nsec = deadline->tv_nsec - now.tv_nsec;
+  if (remaining->tv_nsec < 0)
+  {
+    remaining->tv_sec--;
+    remaining->tv_nsec += 1000000000;
+  }
+
+  return (remaining->tv_sec > 0) || ((remaining->tv_sec == 0) && (remaining->tv_nsec > 0));
+}
+#endif
+
+void az_pal_os_event_init(az_ulib_pal_os_event* event)
+{
+  event->state = EVENT_RESET;
+}
+
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event)
+{
+  (void)event;
+}
+
+void az_pal_os_event_set(az_ulib_pal_os_event* event)
+{
+  if (__sync_lock_test_and_set(&(event->state), EVENT_SIGNALED) == EVENT_RESET)
+  {
+#ifndef TI_RTOS
+    (void)futex(&(event->state), FUTEX_WAKE_PRIVATE, 1, NULL);
+#endif
+  }
+}
+
+bool az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms)
+{
+#ifdef TI_RTOS
+  while (!__sync_bool_compare_and_swap(&(event->state), EVENT_SIGNALED, EVENT_RESET))
+  {
+    if (wait_option_ms == 0)
+    {
+      return false;
+    }
+    Task_sleep(1);
+    if (wait_option_ms != EVENT_WAIT_FOREVER)
+    {
+      wait_option_ms--;
+    }
+  }
+#else
+  struct timespec deadline;
+  struct timespec remaining;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += (time_t)(wait_option_ms / 1000);
+  deadline.tv_nsec += (long)(wait_option_ms % 1000) * 1000000;
+  if (deadline.tv_nsec >= 1000000000)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000;
+  }
+
+  while (!__sync_bool_compare_and_swap(&(event->state), EVENT_SIGNALED, EVENT_RESET))
+  {
+    if (wait_option_ms == EVENT_WAIT_FOREVER)
+    {
+      (void)futex(&(event->state), FUTEX_WAIT_PRIVATE, EVENT_RESET, NULL);
+    }
+    else if (get_remaining_time(&deadline, &remaining))
+    {
+      (void)futex(&(event->state), FUTEX_WAIT_PRIVATE, EVENT_RESET, &remaining);
+    }
+    else
+    {
+      return false;
+    }
+  }
+#endif
+
+  return true;
+}
+
+bool az_pal_os_file_map(
+    az_ulib_pal_os_file_map* file_map,
+    const char* file_name,
+    const uint8_t** data,
+    size_t* size)
+{
+#ifdef TI_RTOS
+  (void)file_map;
+  (void)file_name;
+  (void)data;
+  (void)size;
+  return false;
+#else
+  bool result = false;
+  int fd = open(file_name, O_RDONLY);
+
+  if (fd >= 0)
+  {
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0)
+    {
+      result = false;
+    }
+    else if (file_stat.st_size == 0)
+    {
+      // mmap rejects a zero length, so an empty file is reported as empty content without a
+      // mapping.
+      file_map->ptr = NULL;
+      file_map->size = 0;
+      *data = NULL;
+      *size = 0;
+      result = true;
+    }
+    else if ((file_stat.st_size > 0) && ((uintmax_t)file_stat.st_size <= (uintmax_t)SIZE_MAX))
+    {
+      // The mapping keeps its own reference to the file, so the file descriptor is not needed
+      // after the mmap.
+      void* ptr = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (ptr != MAP_FAILED)
+      {
+        file_map->ptr = ptr;
+        file_map->size = (size_t)file_stat.st_size;
+        *data = (const uint8_t*)ptr;
+        *size = file_map->size;
+        result = true;
+      }
+    }
+    (void)close(fd);
+  }
+
+  return result;
+#endif
+}
+
+void az_pal_os_file_unmap(az_ulib_pal_os_file_map* file_map)
+{
+#ifdef TI_RTOS
+  (void)file_map;
+#else
+  if (file_map->ptr != NULL)
+  {
+    (void)munmap(file_map->ptr, file_map->size);
+  }
+#endif
+}
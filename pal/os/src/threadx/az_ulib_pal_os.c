@@ -31,3 +31,109 @@ void az_pal_os_sleep(uint32_t sleep_time_ms)
 {
   tx_thread_sleep(sleep_time_ms);
 }
+
+uint32_t az_pal_os_clock_us(void)
+{
+  return (uint32_t)(tx_time_get() * (1000000 / TX_TIMER_TICKS_PER_SECOND));
+}
+
+static VOID thread_entry(ULONG arg)
+{
+  az_ulib_pal_os_thread* thread = (az_ulib_pal_os_thread*)arg;
+  thread->function(thread->arg);
+}
+
+bool az_pal_os_thread_create(
+    az_ulib_pal_os_thread* thread,
+    az_ulib_pal_os_thread_function function,
+    void* arg)
+{
+  thread->function = function;
+  thread->arg = arg;
+  return (
+      tx_thread_create(
+          &(thread->thread),
+          "az_ulib",
+          thread_entry,
+          (ULONG)thread,
+          thread->stack,
+          sizeof(thread->stack),
+          AZ_ULIB_PAL_OS_THREAD_PRIORITY,
+          AZ_ULIB_PAL_OS_THREAD_PRIORITY,
+          TX_NO_TIME_SLICE,
+          TX_AUTO_START)
+      == TX_SUCCESS);
+}
+
+void az_pal_os_thread_join(az_ulib_pal_os_thread* thread)
+{
+  UINT state;
+
+  // ThreadX does not have join, so wait for the thread to complete.
+  while ((tx_thread_info_get(&(thread->thread), NULL, &state, NULL, NULL, NULL, NULL, NULL, NULL)
+          == TX_SUCCESS)
+         && (state != TX_COMPLETED))
+  {
+    tx_thread_sleep(1);
+  }
+  tx_thread_delete(&(thread->thread));
+}
+
+void az_pal_os_semaphore_init(az_ulib_pal_os_semaphore* semaphore, uint32_t initial_count)
+{
+  tx_semaphore_create(semaphore, NULL, initial_count);
+}
+
+void az_pal_os_semaphore_deinit(az_ulib_pal_os_semaphore* semaphore)
+{
+  tx_semaphore_delete(semaphore);
+}
+
+void az_pal_os_semaphore_wait(az_ulib_pal_os_semaphore* semaphore)
+{
+  tx_semaphore_get(semaphore, TX_WAIT_FOREVER);
+}
+
+void az_pal_os_semaphore_post(az_ulib_pal_os_semaphore* semaphore)
+{
+  tx_semaphore_put(semaphore);
+}
+
+#define EVENT_FLAG 0x1
+
+void az_pal_os_event_init(az_ulib_pal_os_event* event)
+{
+  tx_event_flags_create(event, NULL);
+}
+
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event)
+{
+  tx_event_flags_delete(event);
+}
+
+void az_pal_os_event_set(az_ulib_pal_os_event* event)
+{
+  tx_event_flags_set(event, EVENT_FLAG, TX_OR);
+}
+
+bool az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms)
+{
+  ULONG actual_flags;
+  return (tx_event_flags_get(event, EVENT_FLAG, TX_OR_CLEAR, &actual_flags, wait_option_ms)
+          == TX_SUCCESS);
+}
+
+bool az_pal_os_file_map(
+    az_ulib_pal_os_file_map* file_map,
+    const char* file_name,
+    const uint8_t** data,
+    size_t* size)
+{
+  (void)file_map;
+  (void)file_name;
+  (void)data;
+  (void)size;
+  return false;
+}
+
+void az_pal_os_file_unmap(az_ulib_pal_os_file_map* file_map) { (void)file_map; }
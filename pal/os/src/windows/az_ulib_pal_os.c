@@ -2,6 +2,8 @@
 // Licensed under the MIT license.
 // See LICENSE file in the project root for full license information.
 
+#include <limits.h>
+#include <stdint.h>
 #include <windows.h>
 
 #include "az_ulib_pal_os.h"
@@ -16,3 +18,130 @@ void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock) { AcquireSRWLockExclusive
 void az_pal_os_lock_release(az_ulib_pal_os_lock* lock) { ReleaseSRWLockExclusive((SRWLOCK*)lock); }
 
 void az_pal_os_sleep(uint32_t sleep_time_ms) { Sleep(sleep_time_ms); }
+
+uint32_t az_pal_os_clock_us(void)
+{
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  (void)QueryPerformanceFrequency(&frequency);
+  (void)QueryPerformanceCounter(&counter);
+  return (uint32_t)(
+      ((counter.QuadPart / frequency.QuadPart) * 1000000)
+      + (((counter.QuadPart % frequency.QuadPart) * 1000000) / frequency.QuadPart));
+}
+
+static DWORD WINAPI thread_entry(LPVOID arg)
+{
+  az_ulib_pal_os_thread* thread = (az_ulib_pal_os_thread*)arg;
+  thread->function(thread->arg);
+  return 0;
+}
+
+bool az_pal_os_thread_create(
+    az_ulib_pal_os_thread* thread,
+    az_ulib_pal_os_thread_function function,
+    void* arg)
+{
+  thread->function = function;
+  thread->arg = arg;
+  thread->thread = CreateThread(NULL, 0, thread_entry, thread, 0, NULL);
+  return (thread->thread != NULL);
+}
+
+void az_pal_os_thread_join(az_ulib_pal_os_thread* thread)
+{
+  (void)WaitForSingleObject(thread->thread, INFINITE);
+  (void)CloseHandle(thread->thread);
+}
+
+void az_pal_os_semaphore_init(az_ulib_pal_os_semaphore* semaphore, uint32_t initial_count)
+{
+  *semaphore = CreateSemaphore(NULL, (LONG)initial_count, LONG_MAX, NULL);
+}
+
+void az_pal_os_semaphore_deinit(az_ulib_pal_os_semaphore* semaphore)
+{
+  (void)CloseHandle(*semaphore);
+}
+
+void az_pal_os_semaphore_wait(az_ulib_pal_os_semaphore* semaphore)
+{
+  (void)WaitForSingleObject(*semaphore, INFINITE);
+}
+
+void az_pal_os_semaphore_post(az_ulib_pal_os_semaphore* semaphore)
+{
+  (void)ReleaseSemaphore(*semaphore, 1, NULL);
+}
+
+void az_pal_os_event_init(az_ulib_pal_os_event* event)
+{
+  *event = CreateEvent(NULL, FALSE, FALSE, NULL);
+}
+
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event) { (void)CloseHandle(*event); }
+
+void az_pal_os_event_set(az_ulib_pal_os_event* event) { (void)SetEvent(*event); }
+
+bool az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms)
+{
+  return (WaitForSingleObject(*event, (DWORD)wait_option_ms) == WAIT_OBJECT_0);
+}
+
+bool az_pal_os_file_map(
+    az_ulib_pal_os_file_map* file_map,
+    const char* file_name,
+    const uint8_t** data,
+    size_t* size)
+{
+  bool result = false;
+  HANDLE file = CreateFileA(
+      file_name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+  if (file != INVALID_HANDLE_VALUE)
+  {
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size))
+    {
+      result = false;
+    }
+    else if (file_size.QuadPart == 0)
+    {
+      // CreateFileMappingA rejects an empty file, so it is reported as empty content without a
+      // view.
+      file_map->view = NULL;
+      *data = NULL;
+      *size = 0;
+      result = true;
+    }
+    else if ((ULONGLONG)file_size.QuadPart <= (ULONGLONG)SIZE_MAX)
+    {
+      // The view keeps its own reference to the mapping and to the file, so both handles are
+      // closed after the map.
+      HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (mapping != NULL)
+      {
+        LPVOID view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view != NULL)
+        {
+          file_map->view = view;
+          *data = (const uint8_t*)view;
+          *size = (size_t)file_size.QuadPart;
+          result = true;
+        }
+        (void)CloseHandle(mapping);
+      }
+    }
+    (void)CloseHandle(file);
+  }
+
+  return result;
+}
+
+void az_pal_os_file_unmap(az_ulib_pal_os_file_map* file_map)
+{
+  if (file_map->view != NULL)
+  {
+    (void)UnmapViewOfFile(file_map->view);
+  }
+}
@@ -3,6 +3,7 @@
 // See LICENSE file in the project root for full license information.
 
 #include "my_consumer.h"
+#include "az_ulib_pal_os_api.h"
 #include "az_ulib_result.h"
 #include "wrappers/display_1_wrapper.h"
 
@@ -23,19 +24,93 @@ static const char bunny_11[] = "/)/)";
 static const size_t bunny_11_size = sizeof(bunny_11) - 1;
 
 static az_ulib_ipc_interface_handle _display_1;
+static az_ulib_pal_os_lock _display_1_lock;
+static az_ulib_ipc_subscription_handle _display_1_subscription;
 
-static void get_handle_if_need(void)
+/*
+ * The subscription callback runs in the publisher thread, so it can race with my_consumer_create()
+ * and my_consumer_do_display(). Only the first path that gets a display.1 keeps it; any other path
+ * releases its own handle.
+ */
+static void keep_display_1(az_ulib_ipc_interface_handle display_1)
 {
-  az_result result;
+  az_pal_os_lock_acquire(&_display_1_lock);
   if (_display_1 == NULL)
   {
-    if ((result = display_1_create(&_display_1)) == AZ_OK)
-    {
-      (void)printf("My consumer got display.1 interface with success.\r\n");
-    }
-    else if (result == AZ_ERROR_ITEM_NOT_FOUND)
+    _display_1 = display_1;
+    display_1 = NULL;
+  }
+  az_pal_os_lock_release(&_display_1_lock);
+
+  if (display_1 == NULL)
+  {
+    (void)printf("My consumer got display.1 interface with success.\r\n");
+  }
+  else
+  {
+    display_1_destroy(display_1);
+  }
+}
+
+/*
+ * Release display_1 only if it is still the handle that my consumer keeps, so the same handle is
+ * never released twice.
+ */
+static void release_display_1(az_ulib_ipc_interface_handle display_1)
+{
+  az_pal_os_lock_acquire(&_display_1_lock);
+  if ((display_1 != NULL) && (_display_1 == display_1))
+  {
+    _display_1 = NULL;
+  }
+  else
+  {
+    display_1 = NULL;
+  }
+  az_pal_os_lock_release(&_display_1_lock);
+
+  if (display_1 != NULL)
+  {
+    (void)printf("Release the handle.\r\n");
+    display_1_destroy(display_1);
+  }
+}
+
+static az_ulib_ipc_interface_handle get_display_1(void)
+{
+  az_pal_os_lock_acquire(&_display_1_lock);
+  az_ulib_ipc_interface_handle display_1 = _display_1;
+  az_pal_os_lock_release(&_display_1_lock);
+  return display_1;
+}
+
+/*
+ * IPC reports every time that a display.1 is published or unpublished, so my consumer does not need
+ * to look for the interface before each use.
+ */
+static void display_1_changed(
+    az_ulib_ipc_event event,
+    az_span name,
+    az_ulib_version version,
+    az_ulib_ipc_interface_handle interface_handle,
+    void* context)
+{
+  (void)name;
+  (void)version;
+  (void)context;
+
+  az_result result;
+  az_ulib_ipc_interface_handle display_1;
+  if ((event == AZ_ULIB_IPC_EVENT_UNPUBLISH) && (get_display_1() != NULL))
+  {
+    (void)printf("display.1 was uninstalled.\r\n");
+    release_display_1(interface_handle);
+  }
+  else if ((event == AZ_ULIB_IPC_EVENT_PUBLISH) && (get_display_1() == NULL))
+  {
+    if ((result = az_ulib_ipc_get_interface(interface_handle, &display_1)) == AZ_OK)
     {
-      (void)printf("display.1 is not available.\r\n");
+      keep_display_1(display_1);
     }
     else
     {
@@ -46,9 +121,39 @@ static void get_handle_if_need(void)
 
 void my_consumer_create(void)
 {
+  az_result result;
+  az_ulib_ipc_subscription_filter filter = { AZ_SPAN_LITERAL_FROM_STR(DISPLAY_1_INTERFACE_NAME),
+                                             DISPLAY_1_INTERFACE_VERSION,
+                                             AZ_ULIB_VERSION_EQUALS_TO };
+
   (void)printf("Create my consumer...\r\n");
 
   _display_1 = NULL;
+  az_pal_os_lock_init(&_display_1_lock);
+
+  if ((result = az_ulib_ipc_subscribe(
+           &filter, display_1_changed, NULL, &_display_1_subscription))
+      != AZ_OK)
+  {
+    (void)printf("Subscribe to display.1 failed with code %" PRIi32 "\r\n", result);
+    _display_1_subscription = NULL;
+  }
+
+  /* The subscription only reports the next changes, so get the display.1 that is already
+   * published. The callback may have got it first. */
+  az_ulib_ipc_interface_handle display_1;
+  if ((result = display_1_create(&display_1)) == AZ_OK)
+  {
+    keep_display_1(display_1);
+  }
+  else if (result == AZ_ERROR_ITEM_NOT_FOUND)
+  {
+    (void)printf("display.1 is not available.\r\n");
+  }
+  else
+  {
+    (void)printf("Get display.1 interface failed with code %" PRIi32 "\r\n", result);
+  }
 }
 
 void my_consumer_do_display(void)
@@ -56,9 +161,12 @@ void my_consumer_do_display(void)
   static char state = 0;
   (void)printf("My consumer try use display.1 interface... \r\n");
 
-  get_handle_if_need();
-
-  if (_display_1 != NULL)
+  az_ulib_ipc_interface_handle display_1 = get_display_1();
+  if (display_1 == NULL)
+  {
+    (void)printf("display.1 is not available.\r\n");
+  }
+  else
   {
     switch (state)
     {
@@ -66,12 +174,12 @@ void my_consumer_do_display(void)
       {
         AZ_ULIB_TRY
         {
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_cls(_display_1));
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(_display_1, 0, 0, hello, hello_size));
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(_display_1, 6, 1, bunny_1, bunny_1_size));
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(_display_1, 5, 2, bunny_2, bunny_2_size));
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(_display_1, 5, 3, bunny_3, bunny_3_size));
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_invalidate(_display_1));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_cls(display_1));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(display_1, 0, 0, hello, hello_size));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(display_1, 6, 1, bunny_1, bunny_1_size));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(display_1, 5, 2, bunny_2, bunny_2_size));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(display_1, 5, 3, bunny_3, bunny_3_size));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_invalidate(display_1));
           state = 1;
         }
         AZ_ULIB_CATCH(...)
@@ -86,9 +194,7 @@ void my_consumer_do_display(void)
                 "my consumer uses display.1.cls failed with error %" PRIi32 ".\r\n",
                 AZ_ULIB_TRY_RESULT);
           }
-          (void)printf("Release the handle.\r\n");
-          display_1_destroy(_display_1);
-          _display_1 = NULL;
+          release_display_1(display_1);
         }
         break;
       }
@@ -96,8 +202,8 @@ void my_consumer_do_display(void)
       {
         AZ_ULIB_TRY
         {
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(_display_1, 6, 1, bunny_11, bunny_11_size));
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_invalidate(_display_1));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(display_1, 6, 1, bunny_11, bunny_11_size));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_invalidate(display_1));
           state = 2;
         }
         AZ_ULIB_CATCH(...)
@@ -112,9 +218,7 @@ void my_consumer_do_display(void)
                 "my consumer uses display.1.cls failed with error %" PRIi32 ".\r\n",
                 AZ_ULIB_TRY_RESULT);
           }
-          (void)printf("Release the handle.\r\n");
-          display_1_destroy(_display_1);
-          _display_1 = NULL;
+          release_display_1(display_1);
           state = 0;
         }
         break;
@@ -123,8 +227,8 @@ void my_consumer_do_display(void)
       {
         AZ_ULIB_TRY
         {
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(_display_1, 6, 1, bunny_1, bunny_1_size));
-          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_invalidate(_display_1));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_print(display_1, 6, 1, bunny_1, bunny_1_size));
+          AZ_ULIB_THROW_IF_AZ_ERROR(display_1_invalidate(display_1));
           state = 1;
         }
         AZ_ULIB_CATCH(...)
@@ -135,9 +239,7 @@ void my_consumer_do_display(void)
             (void)printf(
                 "my consumer uses display.1.cls failed with error %" PRIi32 ".\r\n",
                 AZ_ULIB_TRY_RESULT);
-          (void)printf("Release the handle.\r\n");
-          display_1_destroy(_display_1);
-          _display_1 = NULL;
+          release_display_1(display_1);
           state = 0;
         }
         break;
@@ -149,8 +251,12 @@ void my_consumer_do_display(void)
 void my_consumer_destroy(void)
 {
   (void)printf("Destroy my consumer\r\n");
-  if (_display_1 != NULL)
+  if (_display_1_subscription != NULL)
   {
-    display_1_destroy(_display_1);
+    az_result result = az_ulib_ipc_unsubscribe(_display_1_subscription, AZ_ULIB_WAIT_FOREVER);
+    (void)result;
+    _display_1_subscription = NULL;
   }
+  release_display_1(get_display_1());
+  az_pal_os_lock_deinit(&_display_1_lock);
 }
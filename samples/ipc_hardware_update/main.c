@@ -36,7 +36,7 @@ int main(void)
     contoso_display_20x4_1_create();
     (void)printf("\r\n");
 
-    /* Consumer will use the display interface. */
+    /* Consumer will use the display interface, and subscribe to know when it changes. */
     my_consumer_create();
     (void)printf("\r\n");
 
@@ -46,17 +46,16 @@ int main(void)
     my_consumer_do_display();
     (void)printf("\r\n");
 
-    /* Unpublish display interface. After this point, any call to display will return
-     * AZ_ERROR_ITEM_NOT_FOUND. */
+    /* Unpublish display interface. IPC reports it to my consumer, that releases the handle. */
     contoso_display_20x4_1_destroy();
     (void)printf("\r\n");
 
     /* My consumer try to use display to add numbers. */
-    my_consumer_do_display(); // It will fail because the Contoso handle is not available anymore.
+    my_consumer_do_display(); // It will fail because there is not display interface in IPC.
     my_consumer_do_display(); // It will fail because there is not display interface in IPC.
     (void)printf("\r\n");
 
-    /* Fabrikan publish display interface.
+    /* Fabrikan publish display interface. IPC reports it to my consumer, that gets the handle.
      * After this point anybody can call the display commands through IPC. */
     fabrikan_display_48x4_1_create();
     (void)printf("\r\n");
@@ -72,13 +71,13 @@ int main(void)
     fabrikan_display_48x4_1_destroy();
     (void)printf("\r\n");
 
-    /* Contoso publish display interface again.
-     * After this point anybody can call the display commands through IPC. */
+    /* Contoso publish display interface again. IPC reports it to my consumer, that gets the new
+     * handle. After this point anybody can call the display commands through IPC. */
     contoso_display_20x4_1_create();
     (void)printf("\r\n");
 
     /* My consumer try to use display to add numbers. */
-    my_consumer_do_display(); // It will fail because the handle is still from Fabrikan interface.
+    my_consumer_do_display();
     my_consumer_do_display();
     my_consumer_do_display();
     my_consumer_do_display();
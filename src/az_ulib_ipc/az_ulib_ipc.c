@@ -2,10 +2,12 @@
 // Licensed under the MIT license.
 // See LICENSE file in the project root for full license information.
 
+#include <limits.h>
 #include <memory.h>
 #include <stdint.h>
 
 #include "_az_ulib_ipc_query.h"
+#include "_az_ulib_ipc_stats.h"
 #include "az_ulib_base.h"
 #include "az_ulib_capability_api.h"
 #include "az_ulib_config.h"
@@ -19,659 +21,3442 @@
 
 #include <azure/core/internal/az_precondition_internal.h>
 
-typedef union
+/*
+ * The continuation token keeps, from the lower bits:
+ *  - The type of the query.
+ *  - The reserved, with the information that the query needs to continue from the next interface:
+ *    - name: the number of versions to report, or QUERY_OPEN_RANGE if there is no upper limit.
+ *    - prefix: the size of the prefix, which is the beginning of the next interface name.
+ *    - capability: the index of the capability in the next interface.
+ *  - The position in the registry of the next interface to report, with only the bits that the
+ *    registry needs, and all bits set if there is no next interface.
+ *  - The stamp, with the lower bits of the registry generation when the next interface was
+ *    published, or, for a name with a limited version range, when a version with this name was
+ *    last published or unpublished. All the other bits of the token are for the stamp.
+ */
+#define QUERY_TYPE_ALL 0x07
+#define QUERY_TYPE_NAME 0x01
+#define QUERY_TYPE_PREFIX 0x02
+#define QUERY_TYPE_CAPABILITY 0x03
+#define QUERY_TYPE_MASK 0x07
+#define QUERY_RESERVED_SHIFT 3
+#define QUERY_RESERVED_MASK 0xFF
+#define QUERY_POSITION_SHIFT 11
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+#define QUERY_MAX_INTERFACES                                                                      \
+  (AZ_ULIB_CONFIG_MAX_IPC_INTERFACE                                                               \
+   + (AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE * AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS))
+#else
+#define QUERY_MAX_INTERFACES AZ_ULIB_CONFIG_MAX_IPC_INTERFACE
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+#if QUERY_MAX_INTERFACES < 0x10
+#define QUERY_POSITION_BITS 4
+#elif QUERY_MAX_INTERFACES < 0x100
+#define QUERY_POSITION_BITS 8
+#elif QUERY_MAX_INTERFACES < 0x1000
+#define QUERY_POSITION_BITS 12
+#elif QUERY_MAX_INTERFACES < 0x2000
+#define QUERY_POSITION_BITS 13
+#elif QUERY_MAX_INTERFACES < 0x4000
+#define QUERY_POSITION_BITS 14
+#elif QUERY_MAX_INTERFACES < 0x8000
+#define QUERY_POSITION_BITS 15
+#else
+#define QUERY_POSITION_BITS 16
+#endif
+
+#define QUERY_POSITION_MASK ((1UL << QUERY_POSITION_BITS) - 1)
+#define QUERY_STAMP_SHIFT (QUERY_POSITION_SHIFT + QUERY_POSITION_BITS)
+#define QUERY_STAMP_MASK (UINT32_MAX >> QUERY_STAMP_SHIFT)
+#define QUERY_OPEN_RANGE 0xFF
+#define QUERY_MAX_RANGE 0xFE
+#define QUERY_NAME_KEY "name="
+#define QUERY_PREFIX_KEY "prefix="
+#define QUERY_CAPABILITY_KEY "capability="
+#define QUERY_VERSION_KEY ";version="
+#define QUERY_VERSION_SEPARATOR "-"
+
+/*
+ * State of a query while it reports interfaces.
+ */
+typedef struct
+{
+  uint8_t query_type;
+  uint8_t reserved;
+  uint16_t next_index;
+  az_span key;
+  uint32_t key_hash;
+  uint16_t position;
+} ipc_query;
+
+#if (AZ_ULIB_CONFIG_IPC_INTERFACE_INDEX_SIZE & (AZ_ULIB_CONFIG_IPC_INTERFACE_INDEX_SIZE - 1)) != 0
+#error "AZ_ULIB_CONFIG_IPC_INTERFACE_INDEX_SIZE shall be a power of 2."
+#endif
+
+#if AZ_ULIB_CONFIG_IPC_INTERFACE_INDEX_SIZE <= AZ_ULIB_CONFIG_MAX_IPC_INTERFACE
+#error "AZ_ULIB_CONFIG_IPC_INTERFACE_INDEX_SIZE shall be bigger than the maximum number of interfaces."
+#endif
+
+#if ((AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE & (AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE - 1)) \
+     != 0)                                                                                        \
+    || (AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE > 256)
+#error "AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE shall be a power of 2 up to 256, or 0."
+#endif
+
+#if (AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS & (AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS - 1)) != 0
+#error "AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS shall be a power of 2."
+#endif
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+#if (AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE & (AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE - 1)) != 0
+#error "AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE shall be a power of 2."
+#endif
+
+#if (AZ_ULIB_CONFIG_MAX_IPC_INTERFACE                                                             \
+     + (AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE * AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS))                       \
+    >= 65535
+#error "The segmented registry shall have less than 65535 interfaces."
+#endif
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+#define INDEX_EMPTY UINT16_MAX
+#define INDEX_MASK ((uint32_t)(AZ_ULIB_CONFIG_IPC_INTERFACE_INDEX_SIZE - 1))
+#define INDEX_READ_RETRIES 16
+
+#if AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+#define CAPABILITY_INDEX_EMPTY 0
+#define CAPABILITY_INDEX_MASK ((uint32_t)(AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE - 1))
+#define MAX_INDEXED_CAPABILITIES (AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE >> 1)
+#endif // AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+#define SEGMENT_MASK ((uint16_t)(AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE - 1))
+
+// The instances do not use any memory, so the segmented registry only avoids the ref_count
+// overflow.
+#define MAX_IPC_INSTANCES (LONG_MAX >> 1)
+#else
+#define MAX_IPC_INSTANCES AZ_ULIB_CONFIG_MAX_IPC_INSTANCES
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+#define ASYNC_CALL_FREE 0
+#define ASYNC_CALL_QUEUED 1
+#define ASYNC_CALL_RUNNING 2
+#define ASYNC_CALL_CANCELED 3
+#define ASYNC_CALL_DROPPED 4
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+
+#define SUBSCRIPTION_FREE 0
+#define SUBSCRIPTION_ACTIVE 1
+#define SUBSCRIPTION_CLOSING 2
+
+/*
+ * IPC is a singleton component, and shall be initialized only once.
+ *
+ * Make it volatile to avoid any compilation optimization.
+ */
+static az_ulib_ipc* volatile _az_ipc_cb = NULL;
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+/*
+ * The registry is the interface_list followed by the segments. The position of an interface in
+ * the registry never changes, even when a new segment is added.
+ */
+static inline _az_ulib_ipc_interface* get_ipc_interface(uint16_t interface_index)
+{
+  _az_ulib_ipc_interface* ipc_interface;
+
+  if (interface_index < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE)
+  {
+    ipc_interface = &(_az_ipc_cb->_internal.interface_list[interface_index]);
+  }
+  else
+  {
+    uint16_t segment_index = (uint16_t)(interface_index - AZ_ULIB_CONFIG_MAX_IPC_INTERFACE);
+    ipc_interface = &(_az_ipc_cb->_internal.segment_list[segment_index
+                                                          / AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE]
+                                                         [segment_index & SEGMENT_MASK]);
+  }
+
+  return ipc_interface;
+}
+
+/*
+ * The index only grows, and grow_index() changes the index before its mask, so the mask read here
+ * is never bigger than the index read after it, even if the index grows in between. The sequence
+ * lock will repeat the lookup in this case.
+ */
+static inline uint16_t* get_index(uint32_t* index_mask)
+{
+  *index_mask = _az_ipc_cb->_internal.index_mask;
+  AZ_ULIB_PORT_MEMORY_BARRIER();
+  return _az_ipc_cb->_internal.index;
+}
+
+#define get_interface_count() (_az_ipc_cb->_internal.interface_count)
+#define get_sorted_index() (_az_ipc_cb->_internal.sorted)
+#else
+#define get_ipc_interface(interface_index) \
+  (&(_az_ipc_cb->_internal.interface_list[interface_index]))
+#define get_index(index_mask) (*(index_mask) = INDEX_MASK, _az_ipc_cb->_internal.interface_index)
+#define get_interface_count() ((uint16_t)AZ_ULIB_CONFIG_MAX_IPC_INTERFACE)
+#define get_sorted_index() (_az_ipc_cb->_internal.sorted_index)
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+
+/*
+ * Add the bytes of the name to a FNV-1a hash.
+ */
+static uint32_t hash_append(uint32_t hash, az_span name)
+{
+  const uint8_t* name_ptr = az_span_ptr(name);
+  for (int32_t i = 0; i < az_span_size(name); i++)
+  {
+    hash ^= name_ptr[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+/*
+ * FNV-1a hash of the interface name.
+ */
+static uint32_t hash_name(az_span name) { return hash_append(FNV_OFFSET_BASIS, name); }
+
+#if AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+/*
+ * The capability index is an open addressing hash table with linear probing, built by publish
+ * before the interface is visible, and never changed while the interface is published. It is at
+ * most half full, so a lookup compares, on average, less than 2 names.
+ */
+static void build_capability_index(
+    _az_ulib_ipc_interface* ipc_interface,
+    const az_ulib_interface_descriptor* interface_descriptor)
+{
+  for (uint32_t i = 0; i < AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE; i++)
+  {
+    ipc_interface->capability_index[i] = CAPABILITY_INDEX_EMPTY;
+  }
+
+  if (interface_descriptor->_internal.size <= MAX_INDEXED_CAPABILITIES)
+  {
+    for (az_ulib_capability_index index = 0; index < interface_descriptor->_internal.size; index++)
+    {
+      uint32_t bucket
+          = hash_name(interface_descriptor->_internal.capability_list[index]._internal.name)
+          & CAPABILITY_INDEX_MASK;
+      while (ipc_interface->capability_index[bucket] != CAPABILITY_INDEX_EMPTY)
+      {
+        bucket = (bucket + 1) & CAPABILITY_INDEX_MASK;
+      }
+      ipc_interface->capability_index[bucket] = (uint8_t)(index + 1);
+    }
+  }
+}
+#endif // AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+
+/*
+ * The interface index is an open addressing hash table with linear probing. Each bucket contains
+ * the position in the registry of the lowest version of one interface name, and the other versions
+ * of the same name are linked by `next_version`, sorted by version.
+ *
+ * This function returns the bucket that contains the provided name, or the empty bucket where it
+ * shall be inserted. The table is always bigger than the registry, so there is always at least one
+ * empty bucket. The caller shall hold the IPC lock; the lock-free readers use find_index_head().
+ */
+static uint16_t* find_index_bucket(az_span name, uint32_t name_hash)
+{
+  uint32_t index_mask;
+  uint16_t* interface_index = get_index(&index_mask);
+  uint32_t bucket = name_hash & index_mask;
+
+  while (interface_index[bucket] != INDEX_EMPTY)
+  {
+    _az_ulib_ipc_interface* ipc_interface = get_ipc_interface(interface_index[bucket]);
+    if ((ipc_interface->name_hash == name_hash)
+        && az_span_is_content_equal(ipc_interface->name, name))
+    {
+      break;
+    }
+    bucket = (bucket + 1) & index_mask;
+  }
+
+  return &(interface_index[bucket]);
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+/*
+ * Remove an empty bucket from the index, moving back the buckets that follows it in the same
+ * cluster, so the linear probing will not find a hole in the middle of it.
+ */
+static void remove_index_bucket(uint16_t* removed_bucket)
+{
+  uint32_t index_mask;
+  uint16_t* interface_index = get_index(&index_mask);
+  uint32_t hole = (uint32_t)(removed_bucket - interface_index);
+  uint32_t bucket = hole;
+
+  while (interface_index[(bucket = (bucket + 1) & index_mask)] != INDEX_EMPTY)
+  {
+    uint32_t home = get_ipc_interface(interface_index[bucket])->name_hash & index_mask;
+    if (((bucket - home) & index_mask) >= ((bucket - hole) & index_mask))
+    {
+      interface_index[hole] = interface_index[bucket];
+      hole = bucket;
+    }
+  }
+
+  interface_index[hole] = INDEX_EMPTY;
+}
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+/*
+ * Returns the link in the index that points to the interface with the provided descriptor, or NULL
+ * if the descriptor is not published.
+ */
+static uint16_t* find_interface_descriptor(
+    const az_ulib_interface_descriptor* interface_descriptor,
+    uint16_t** bucket)
+{
+  uint16_t* link = *bucket = find_index_bucket(
+      interface_descriptor->_internal.name, hash_name(interface_descriptor->_internal.name));
+
+  while ((*link != INDEX_EMPTY)
+         && (get_ipc_interface(*link)->interface_descriptor != interface_descriptor))
+  {
+    link = &(get_ipc_interface(*link)->next_version);
+  }
+
+  return (*link == INDEX_EMPTY) ? NULL : link;
+}
+
+/*
+ * Two descriptors are compatible if they have the same name, version, and capabilities in the same
+ * order and with the same types, so the capability indexes that the consumers already have refer
+ * to the same capabilities in both.
+ */
+static bool is_compatible_descriptor(
+    const az_ulib_interface_descriptor* interface_descriptor,
+    const az_ulib_interface_descriptor* other_interface_descriptor)
+{
+  bool is_compatible
+      = az_span_is_content_equal(
+            interface_descriptor->_internal.name, other_interface_descriptor->_internal.name)
+      && (interface_descriptor->_internal.version == other_interface_descriptor->_internal.version)
+      && (interface_descriptor->_internal.size == other_interface_descriptor->_internal.size);
+
+  for (az_ulib_capability_index i = 0; is_compatible && (i < interface_descriptor->_internal.size);
+       i++)
+  {
+    const az_ulib_capability_descriptor* capability
+        = &(interface_descriptor->_internal.capability_list[i]);
+    const az_ulib_capability_descriptor* other_capability
+        = &(other_interface_descriptor->_internal.capability_list[i]);
+    is_compatible
+        = az_span_is_content_equal(capability->_internal.name, other_capability->_internal.name)
+        && (capability->_internal.flags == other_capability->_internal.flags);
+  }
+
+  return is_compatible;
+}
+
+/*
+ * Compare the name and version of an interface with the provided ones, in the order of the sorted
+ * index: by name, with a shorter name before the longer names that start with it, and then by
+ * version.
+ */
+static int32_t compare_interface(
+    const _az_ulib_ipc_interface* ipc_interface,
+    az_span name,
+    az_ulib_version version)
+{
+  int32_t interface_name_size = az_span_size(ipc_interface->name);
+  int32_t name_size = az_span_size(name);
+  int32_t result = memcmp(
+      az_span_ptr(ipc_interface->name),
+      az_span_ptr(name),
+      (size_t)((interface_name_size < name_size) ? interface_name_size : name_size));
+
+  if (result == 0)
+  {
+    if (interface_name_size != name_size)
+    {
+      result = (interface_name_size < name_size) ? -1 : 1;
+    }
+    else if (ipc_interface->version != version)
+    {
+      result = (ipc_interface->version < version) ? -1 : 1;
+    }
+  }
+
+  return result;
+}
+
+static inline bool has_prefix(const _az_ulib_ipc_interface* ipc_interface, az_span prefix)
+{
+  return (az_span_size(ipc_interface->name) >= az_span_size(prefix))
+      && (memcmp(
+              az_span_ptr(ipc_interface->name), az_span_ptr(prefix), (size_t)az_span_size(prefix))
+          == 0);
+}
+
+/*
+ * The sorted index keeps the position in the registry of all published interfaces, sorted by name
+ * and version, so the queries find a name or a prefix with a binary search. It is only used under
+ * the IPC lock.
+ *
+ * This function returns the position in the sorted index of the first interface that is not lower
+ * than the provided name and version.
+ */
+static uint16_t find_sorted_position(az_span name, az_ulib_version version)
+{
+  uint16_t* sorted_index = get_sorted_index();
+  uint16_t low = 0;
+  uint16_t high = _az_ipc_cb->_internal.sorted_count;
+
+  while (low < high)
+  {
+    uint16_t middle = (uint16_t)((low + high) >> 1);
+    if (compare_interface(get_ipc_interface(sorted_index[middle]), name, version) < 0)
+    {
+      low = (uint16_t)(middle + 1);
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  return low;
+}
+
+static void insert_sorted_index(uint16_t interface_index)
+{
+  _az_ulib_ipc_interface* ipc_interface = get_ipc_interface(interface_index);
+  uint16_t* sorted_index = get_sorted_index();
+  uint16_t position = find_sorted_position(ipc_interface->name, ipc_interface->version);
+
+  memmove(
+      &(sorted_index[position + 1]),
+      &(sorted_index[position]),
+      (size_t)(_az_ipc_cb->_internal.sorted_count - position) * sizeof(uint16_t));
+  sorted_index[position] = interface_index;
+  _az_ipc_cb->_internal.sorted_count++;
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+static void remove_sorted_index(uint16_t interface_index)
+{
+  _az_ulib_ipc_interface* ipc_interface = get_ipc_interface(interface_index);
+  uint16_t* sorted_index = get_sorted_index();
+  uint16_t position = find_sorted_position(ipc_interface->name, ipc_interface->version);
+
+  _az_ipc_cb->_internal.sorted_count--;
+  memmove(
+      &(sorted_index[position]),
+      &(sorted_index[position + 1]),
+      (size_t)(_az_ipc_cb->_internal.sorted_count - position) * sizeof(uint16_t));
+}
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+/*
+ * The interface handle is not a pointer. Its lower 16 bits keep the position of the interface in
+ * the registry plus 1, so it is never NULL, and the next 16 bits keep the generation of this
+ * position when the handle was created. Unpublish increments the generation, so the handles to the
+ * old interface do not match a new interface published in the same position.
+ */
+#define HANDLE_INDEX_MASK ((uintptr_t)0xFFFF)
+#define HANDLE_GENERATION_SHIFT 16
+
+static inline az_ulib_ipc_interface_handle get_handle(uint16_t interface_index)
+{
+  return (az_ulib_ipc_interface_handle)(
+      ((uintptr_t)get_ipc_interface(interface_index)->generation << HANDLE_GENERATION_SHIFT)
+      | ((uintptr_t)interface_index + 1));
+}
+
+static inline bool is_handle_in_range(az_ulib_ipc_interface_handle interface_handle)
+{
+  uintptr_t index = (uintptr_t)interface_handle & HANDLE_INDEX_MASK;
+  return (index > 0) && (index <= get_interface_count());
+}
+
+static inline _az_ulib_ipc_interface* get_handle_interface(
+    az_ulib_ipc_interface_handle interface_handle)
+{
+  return get_ipc_interface((uint16_t)(((uintptr_t)interface_handle & HANDLE_INDEX_MASK) - 1));
+}
+
+static inline uint16_t get_handle_generation(az_ulib_ipc_interface_handle interface_handle)
+{
+  return (uint16_t)((uintptr_t)interface_handle >> HANDLE_GENERATION_SHIFT);
+}
+
+static az_result get_instance(_az_ulib_ipc_interface* ipc_interface)
+{
+  az_result result;
+  if (AZ_ULIB_PORT_ATOMIC_INC_W(&(ipc_interface->ref_count)) > MAX_IPC_INSTANCES)
+  {
+    (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->ref_count));
+    result = AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+  else
+  {
+    result = AZ_OK;
+  }
+  return result;
+}
+
+/*
+ * The interface index is protected by a sequence lock. Publish and unpublish change the index
+ * holding the IPC lock, and increment the sequence before and after the change, so the sequence is
+ * odd while the index is inconsistent. Readers do not take any lock, they just repeat the lookup if
+ * the sequence changed while they were reading the index.
+ *
+ * On a single core, a reader may preempt a writer in the middle of the change, and the writer only
+ * runs again when the reader blocks, so the readers only retry INDEX_READ_RETRIES times, and after
+ * that they wait for the writer in the IPC lock.
+ */
+static inline void begin_write_index(void)
+{
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(_az_ipc_cb->_internal.sequence));
+}
+
+static inline void end_write_index(void)
+{
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(_az_ipc_cb->_internal.sequence));
+}
+
+static inline bool begin_read_index(long* sequence)
+{
+  bool result = false;
+
+  for (uint32_t retry = 0; (retry < INDEX_READ_RETRIES) && !result; retry++)
+  {
+    result = (((*sequence = _az_ipc_cb->_internal.sequence) & 1) == 0);
+  }
+  AZ_ULIB_PORT_MEMORY_BARRIER();
+
+  return result;
+}
+
+static inline bool end_read_index(long sequence)
+{
+  AZ_ULIB_PORT_MEMORY_BARRIER();
+  return (sequence == _az_ipc_cb->_internal.sequence);
+}
+
+/*
+ * Interval between the checks of a counter that the caller waits to drain for up to wait_option_ms.
+ */
+static uint32_t get_retry_interval(uint32_t wait_option_ms)
+{
+  uint32_t retry_interval;
+
+  if (wait_option_ms == AZ_ULIB_WAIT_FOREVER)
+  {
+    retry_interval = AZ_ULIB_WAIT_FOREVER;
+  }
+  else
+  {
+    retry_interval = wait_option_ms >> 3;
+    if (retry_interval == 0)
+    {
+      retry_interval = 1;
+    }
+  }
+
+  return retry_interval;
+}
+
+#if defined(AZ_ULIB_CONFIG_IPC_UNPUBLISH) || defined(AZ_ULIB_CONFIG_IPC_STATS) \
+    || defined(AZ_ULIB_CONFIG_IPC_TRACE)
+#ifdef AZ_ULIB_PORT_THREAD_LOCAL
+/*
+ * Each thread gets an id in its first call. The id identifies the thread in the trace, and selects
+ * the shard of the running counter, of the statistics, and of the trace that the thread uses in
+ * all interfaces. As enter_interface and leave_interface always run in the same thread, each call
+ * increments and decrements the same shard, so no shard is ever negative.
+ */
+static AZ_ULIB_PORT_THREAD_LOCAL long _thread_id = 0;
+static volatile long _thread_next_id = 0;
+
+static inline long get_thread_id(void)
+{
+  if (_thread_id == 0)
+  {
+    _thread_id = AZ_ULIB_PORT_ATOMIC_INC_W(&_thread_next_id);
+  }
+  return _thread_id;
+}
+#else
+#define get_thread_id() 0L
+#endif // AZ_ULIB_PORT_THREAD_LOCAL
+
+#if _AZ_ULIB_IPC_RUNNING_SHARDS > 1
+#define get_shard() ((unsigned long)get_thread_id() & (_AZ_ULIB_IPC_RUNNING_SHARDS - 1))
+#else
+#define get_shard() 0
+#endif // _AZ_ULIB_IPC_RUNNING_SHARDS > 1
+#endif // defined(AZ_ULIB_CONFIG_IPC_UNPUBLISH) || defined(AZ_ULIB_CONFIG_IPC_STATS) ...
+
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+/*
+ * Bucket 0 counts the calls under 1 microsecond, and bucket n the calls from 2^(n-1) to 2^n - 1
+ * microseconds. The last bucket also counts all longer calls.
+ */
+static inline uint32_t get_latency_bucket(uint32_t latency_us)
+{
+  uint32_t bucket = 0;
+  while ((latency_us != 0) && (bucket < (AZ_ULIB_CONFIG_IPC_STATS_LATENCY_BUCKETS - 1)))
+  {
+    latency_us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+/*
+ * Count a call in the shard of the current thread. The counters are atomic because more threads
+ * than shards may share the same shard.
+ */
+static void record_call(
+    _az_ulib_ipc_interface* ipc_interface,
+    az_ulib_capability_index command_index,
+    az_result result,
+    uint32_t start_time,
+    uint32_t end_time)
+{
+  if (command_index < AZ_ULIB_CONFIG_IPC_STATS_MAX_CAPABILITIES)
+  {
+    _az_ulib_ipc_capability_counters* counters
+        = &(ipc_interface->stats_shard_list[get_shard()].capability_list[command_index]);
+    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(counters->call_count));
+    if (az_result_failed(result))
+    {
+      (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(counters->error_count));
+    }
+    (void)AZ_ULIB_PORT_ATOMIC_INC_W(
+        &(counters->latency_histogram[get_latency_bucket(end_time - start_time)]));
+  }
+}
+
+static void reset_stats(_az_ulib_ipc_interface* ipc_interface)
+{
+  memset(ipc_interface->stats_shard_list, 0, sizeof(ipc_interface->stats_shard_list));
+}
+
+#else
+#define record_call(ipc_interface, command_index, result, start_time, end_time) \
+  (void)(start_time), (void)(end_time)
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+#if (AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE & (AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE - 1)) != 0
+#error "AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE shall be a power of 2."
+#endif
+
+#define TRACE_CALL_BEGIN 0
+#define TRACE_CALL_END 1
+#define TRACE_PUBLISH 2
+#define TRACE_UNPUBLISH 3
+#define TRACE_REPLACE 4
+#define TRACE_RING_MASK ((unsigned long)(AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE - 1))
+
+#if (AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE == 0) || (AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE > 255)
+#error "AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE shall be from 1 to 255."
+#endif
+
+/*
+ * Reserve the next position in the ring of the shard of the current thread, and only write the
+ * sequence after all other fields. Other threads in the same shard reserve different positions, so
+ * the rings do not need a lock, and each event records the id of its thread, so the dump does not
+ * mix the calls of the threads that share a ring. The name is copied, so the event does not point
+ * to the descriptor.
+ */
+static void add_trace_event(
+    uint8_t type,
+    az_span name,
+    az_ulib_version version,
+    az_ulib_capability_index capability_index,
+    az_result result,
+    uint32_t timestamp)
+{
+  long thread_id = get_thread_id();
+  _az_ulib_ipc_trace_ring* ring = &(_az_ipc_cb->_internal.trace_ring_list[get_shard()]);
+  long sequence = AZ_ULIB_PORT_ATOMIC_INC_W(&(ring->head));
+  _az_ulib_ipc_trace_event* event
+      = &(ring->event_list[((unsigned long)sequence - 1) & TRACE_RING_MASK]);
+
+  int32_t name_size = az_span_size(name);
+  if (name_size > AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE)
+  {
+    name_size = AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE;
+  }
+
+  (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(event->sequence), 0);
+  (void)memcpy(event->name, az_span_ptr(name), (size_t)name_size);
+  event->name_size = (uint8_t)name_size;
+  event->thread_id = thread_id;
+  event->version = version;
+  event->timestamp = timestamp;
+  event->result = result;
+  event->capability_index = capability_index;
+  event->type = type;
+  (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(event->sequence), sequence);
+}
+
+/*
+ * The call reads the trace flag only once, so each begin event has its end event even if the
+ * trace is disabled in the middle of the call.
+ */
+#define is_call_traced() (_az_ipc_cb->_internal.trace_enabled != 0)
+
+static inline void trace_call_begin(
+    bool is_traced,
+    _az_ulib_ipc_interface* ipc_interface,
+    az_ulib_capability_index command_index,
+    uint32_t start_time)
+{
+  if (is_traced)
+  {
+    add_trace_event(
+        TRACE_CALL_BEGIN,
+        ipc_interface->name,
+        ipc_interface->version,
+        command_index,
+        AZ_OK,
+        start_time);
+  }
+}
+
+static inline void trace_call_end(
+    bool is_traced,
+    _az_ulib_ipc_interface* ipc_interface,
+    az_ulib_capability_index command_index,
+    az_result result,
+    uint32_t end_time)
+{
+  if (is_traced)
+  {
+    add_trace_event(
+        TRACE_CALL_END,
+        ipc_interface->name,
+        ipc_interface->version,
+        command_index,
+        result,
+        end_time);
+  }
+}
+
+static inline void trace_registry(
+    uint8_t type,
+    const az_ulib_interface_descriptor* const interface_descriptor,
+    az_result result)
+{
+  if (_az_ipc_cb->_internal.trace_enabled != 0)
+  {
+    add_trace_event(
+        type,
+        interface_descriptor->_internal.name,
+        interface_descriptor->_internal.version,
+        0,
+        result,
+        az_pal_os_clock_us());
+  }
+}
+
+static void reset_trace(void)
+{
+  _az_ipc_cb->_internal.trace_enabled = 0;
+  for (size_t i = 0; i < _AZ_ULIB_IPC_RUNNING_SHARDS; i++)
+  {
+    _az_ipc_cb->_internal.trace_ring_list[i].head = 0;
+    for (size_t j = 0; j < AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE; j++)
+    {
+      _az_ipc_cb->_internal.trace_ring_list[i].event_list[j].sequence = 0;
+    }
+  }
+}
+#else
+#define is_call_traced() false
+#define trace_call_begin(is_traced, ipc_interface, command_index, start_time) (void)(is_traced)
+#define trace_call_end(is_traced, ipc_interface, command_index, result, end_time) (void)(is_traced)
+#define trace_registry(type, interface_descriptor, result)
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
+
+/*
+ * The statistics and the trace share the same clock samples, so a call reads the clock only once
+ * when it starts and once when it ends. Without the statistics, only the traced calls read it.
+ */
+#if defined(AZ_ULIB_CONFIG_IPC_STATS)
+#define get_call_time(is_traced) az_pal_os_clock_us()
+#elif defined(AZ_ULIB_CONFIG_IPC_TRACE)
+#define get_call_time(is_traced) ((is_traced) ? az_pal_os_clock_us() : 0)
+#else
+#define get_call_time(is_traced) 0
+#endif // defined(AZ_ULIB_CONFIG_IPC_STATS)
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+#define get_running_shard(ipc_interface) (&((ipc_interface)->running_shard_list[get_shard()]))
+
+/*
+ * Only az_ulib_ipc_init and az_ulib_ipc_deinit reset the running_count. A call with a stale handle,
+ * or a lookup, may count itself in a free position while another interface is published in it, so
+ * publish shall keep the count that they will decrement when they leave.
+ */
+static void reset_running_count(_az_ulib_ipc_interface* ipc_interface)
+{
+  for (size_t i = 0; i < _AZ_ULIB_IPC_RUNNING_SHARDS; i++)
+  {
+    ipc_interface->running_shard_list[i].running_count[0] = 0;
+    ipc_interface->running_shard_list[i].running_count[1] = 0;
+  }
+}
+
+static long get_running_count(_az_ulib_ipc_interface* ipc_interface, long epoch)
+{
+  long running_count = 0;
+  for (size_t i = 0; i < _AZ_ULIB_IPC_RUNNING_SHARDS; i++)
+  {
+    running_count += ipc_interface->running_shard_list[i].running_count[epoch];
+  }
+  return running_count;
+}
+
+/*
+ * Each call counts itself in the running_count of the epoch that was current when it entered the
+ * interface. The epoch only changes in az_ulib_ipc_unpublish, so out of it, all calls leave the
+ * current epoch and do not touch the event. A call that drains a shard of an old epoch signals the
+ * unpublish_event, because an unpublish may be waiting for it.
+ *
+ * The per-interface epoch counters take the place of a thread-local epoch announcement with a
+ * retire list. An announcement also needs a full barrier in each call, before it reads the
+ * descriptor, so it saves only the cost of the atomic on a shard that the thread owns. But it needs
+ * a registry of threads that unpublish shall scan, and a retire list, while here the producer owns
+ * the descriptor and releases it when unpublish returns. As with the announcement, unpublish only
+ * waits for the calls that entered before it moved the epoch, so new calls cannot keep it busy.
+ */
+static inline void leave_interface(_az_ulib_ipc_interface* ipc_interface, long epoch)
+{
+  if ((AZ_ULIB_PORT_ATOMIC_DEC_W(&(get_running_shard(ipc_interface)->running_count[epoch])) == 0)
+      && (epoch != _az_ipc_cb->_internal.epoch))
+  {
+    az_pal_os_event_set(&(_az_ipc_cb->_internal.unpublish_event));
+  }
+}
+
+/*
+ * The double test on the interface_descriptor is part of the interlock between the users of the
+ * interface descriptor and az_ulib_ipc_unpublish. It will allow a interface to be unpublished even
+ * if it has a high volume of calls. If this function returns a descriptor, it will be valid up to
+ * the leave_interface() with the returned epoch.
+ *
+ * Unpublish only increments the generation after all calls left the interface, and publish only
+ * reuses the position after that, so a call that entered the interface with the generation of its
+ * handle is using the interface that the handle refers to.
+ */
+static inline volatile const az_ulib_interface_descriptor* enter_interface(
+    _az_ulib_ipc_interface* ipc_interface,
+    uint16_t generation,
+    long* epoch)
+{
+  volatile const az_ulib_interface_descriptor* interface_descriptor = NULL;
+
+  if (ipc_interface->interface_descriptor != NULL)
+  {
+    *epoch = _az_ipc_cb->_internal.epoch;
+    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(get_running_shard(ipc_interface)->running_count[*epoch]));
+    if (((interface_descriptor = ipc_interface->interface_descriptor) == NULL)
+        || (ipc_interface->generation != generation))
+    {
+      leave_interface(ipc_interface, *epoch);
+      interface_descriptor = NULL;
+    }
+  }
+
+  return interface_descriptor;
+}
+
+/*
+ * Wait for the running_count of the epoch to drain in all shards of the interface, sharing the
+ * wait_option_ms between the calls. Only the waits that time out count in the retry_total_time.
+ */
+static bool wait_running_count(
+    _az_ulib_ipc_interface* ipc_interface,
+    long epoch,
+    uint32_t wait_option_ms,
+    uint32_t* retry_total_time)
+{
+  uint32_t retry_interval = get_retry_interval(wait_option_ms);
+
+  while ((get_running_count(ipc_interface, epoch) != 0) && (*retry_total_time < wait_option_ms))
+  {
+    if ((!az_pal_os_event_wait(&(_az_ipc_cb->_internal.unpublish_event), retry_interval))
+        && (wait_option_ms != AZ_ULIB_WAIT_FOREVER))
+    {
+      *retry_total_time += retry_interval;
+    }
+  }
+
+  return (get_running_count(ipc_interface, epoch) == 0);
+}
+
+/*
+ * Wait for the calls and lookups that entered the interface before this point, sharing the
+ * wait_option_ms between the epochs. The caller shall hold the drain_lock.
+ *
+ * The calls count themselves in the current epoch. This function first waits for the calls that
+ * are still in the previous epoch, moves the new calls to it, and waits only for the calls in the
+ * old current epoch. The calls only signal the unpublish_event when they drain an old epoch, so
+ * az_ulib_ipc_call does not pay for the event in the common path. The event keeps a signal that
+ * comes before the wait, and the drain_lock serializes the drains, because they share the epoch
+ * and the event. Unpublish takes the drain_lock while it holds the IPC lock, and replace takes it
+ * out of the IPC lock, so no drain takes the IPC lock while it holds the drain_lock.
+ */
+static bool drain_interface(_az_ulib_ipc_interface* ipc_interface, uint32_t wait_option_ms)
+{
+  long epoch = _az_ipc_cb->_internal.epoch;
+  uint32_t retry_total_time = 0;
+  bool is_drained = false;
+
+  if (wait_running_count(ipc_interface, epoch ^ 1, wait_option_ms, &retry_total_time))
+  {
+    (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(_az_ipc_cb->_internal.epoch), epoch ^ 1);
+    is_drained = wait_running_count(ipc_interface, epoch, wait_option_ms, &retry_total_time);
+  }
+
+  return is_drained;
+}
+
+/*
+ * A lookup counts itself in the running_count of an interface while it compares the interface
+ * name, so az_ulib_ipc_unpublish and az_ulib_ipc_replace, that wait for the running_count, do not
+ * return while the name they removed from the index is in use.
+ */
+static inline long enter_lookup(_az_ulib_ipc_interface* ipc_interface)
+{
+  long epoch = _az_ipc_cb->_internal.epoch;
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(get_running_shard(ipc_interface)->running_count[epoch]));
+  return epoch;
+}
+
+#define leave_lookup(ipc_interface, epoch) leave_interface(ipc_interface, epoch)
+#else
+#define enter_interface(ipc_interface, generation, epoch) \
+  ((void)(generation), *(epoch) = 0, (ipc_interface)->interface_descriptor)
+#define leave_interface(ipc_interface, epoch) (void)(epoch)
+#define enter_lookup(ipc_interface) ((void)(ipc_interface), 0L)
+#define leave_lookup(ipc_interface, epoch) (void)(epoch)
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+static void reset_interface(_az_ulib_ipc_interface* ipc_interface)
+{
+  ipc_interface->ref_count = 0;
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  reset_running_count(ipc_interface);
+  ipc_interface->replaced_descriptor = NULL;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+  reset_stats(ipc_interface);
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+  ipc_interface->interface_descriptor = NULL;
+  ipc_interface->next_version = INDEX_EMPTY;
+  ipc_interface->generation = 0;
+  ipc_interface->publish_generation = 0;
+  ipc_interface->name_generation = 0;
+}
+
+/*
+ * Read a position from the index, or from a `next_version`, only once. The lock-free readers may
+ * read it while a writer changes it, so they shall check the value that they use, and not read it
+ * again.
+ */
+static inline uint16_t load_index(const uint16_t* link) { return *(const volatile uint16_t*)link; }
+
+/*
+ * Lock-free version of find_index_bucket(), for the readers of the index. It returns the position
+ * of the lowest version with the provided name, or INDEX_EMPTY if there is no such name or if the
+ * index changed after the `sequence`, in which case the caller shall repeat the lookup.
+ *
+ * A reader may see the index in the middle of a change, so each position is read only once and
+ * checked against the registry size, and the probe never visits more buckets than the index has.
+ * The name of an interface belongs to its descriptor, which the producer may release after
+ * az_ulib_ipc_unpublish or az_ulib_ipc_replace, so the reader compares the hash and the size first,
+ * and only reads the name after it counted itself in the interface and checked that the index did
+ * not change. Unpublish and replace change the index before they wait for the running_count, so
+ * they either see this lookup in the running_count, or this lookup sees the index changed.
+ */
+static uint16_t find_index_head(az_span name, uint32_t name_hash, long sequence)
+{
+  uint16_t result = INDEX_EMPTY;
+  uint16_t interface_count = get_interface_count();
+  uint32_t index_mask;
+  uint16_t* interface_index = get_index(&index_mask);
+  uint32_t bucket = name_hash & index_mask;
+
+  for (uint32_t probe = 0; probe <= index_mask; probe++)
+  {
+    uint16_t head = load_index(&(interface_index[bucket]));
+    if (head >= interface_count)
+    {
+      break;
+    }
+
+    _az_ulib_ipc_interface* ipc_interface = get_ipc_interface(head);
+    if ((ipc_interface->name_hash == name_hash)
+        && (az_span_size(ipc_interface->name) == az_span_size(name)))
+    {
+      long epoch = enter_lookup(ipc_interface);
+      az_span interface_name = ipc_interface->name;
+      bool is_index_valid = end_read_index(sequence);
+      bool is_name_equal = is_index_valid && az_span_is_content_equal(interface_name, name);
+      leave_lookup(ipc_interface, epoch);
+      if (is_name_equal)
+      {
+        result = head;
+      }
+      if (is_name_equal || !is_index_valid)
+      {
+        break;
+      }
+    }
+    bucket = (bucket + 1) & index_mask;
+  }
+
+  return result;
+}
+
+/*
+ * Find the lowest version that fits the criteria, without the IPC lock. Versions are sorted, so the
+ * first match is the lowest one, and if the criteria do not accept greater versions, there is no
+ * reason to look after the required version. The chain of versions may change while it is read, so
+ * each link is checked, and the walk stops after as many steps as the registry has interfaces.
+ */
+static uint16_t get_interface(
+    az_span name,
+    az_ulib_version version,
+    az_ulib_version_match_criteria match_criteria,
+    long sequence)
+{
+  uint16_t result = INDEX_EMPTY;
+  uint16_t interface_count = get_interface_count();
+  uint16_t interface_index = find_index_head(name, hash_name(name), sequence);
+
+  for (uint16_t step = 0; (interface_index < interface_count) && (step < interface_count); step++)
+  {
+    _az_ulib_ipc_interface* ipc_interface = get_ipc_interface(interface_index);
+    if ((ipc_interface->interface_descriptor != NULL)
+        && az_ulib_version_match(ipc_interface->version, version, match_criteria))
+    {
+      result = interface_index;
+      break;
+    }
+    if (!AZ_ULIB_FLAGS_IS_SET(match_criteria, AZ_ULIB_VERSION_GREATER_THAN)
+        && (ipc_interface->version > version))
+    {
+      break;
+    }
+    interface_index = load_index(&(ipc_interface->next_version));
+  }
+
+  return result;
+}
+
+static bool is_subscribed(
+    const az_ulib_ipc_subscription_filter* filter,
+    az_span name,
+    az_ulib_version version)
+{
+  return ((az_span_size(filter->name) == 0) || az_span_is_content_equal(filter->name, name))
+      && az_ulib_version_match(version, filter->version, filter->match_criteria);
+}
+
+/*
+ * Report a change in the registry to the subscribers. It runs out of the IPC lock, so it does not
+ * take any lock; each callback counts itself in the running_count of its subscription, using the
+ * same double test on the state as enter_interface, so az_ulib_ipc_unsubscribe knows when the
+ * callback is not running anymore.
+ */
+static void notify_subscribers(
+    az_ulib_ipc_event event,
+    az_span name,
+    az_ulib_version version,
+    az_ulib_ipc_interface_handle interface_handle)
+{
+  for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS; i++)
+  {
+    _az_ulib_ipc_subscription* subscription = &(_az_ipc_cb->_internal.subscription_list[i]);
+    if (subscription->state == SUBSCRIPTION_ACTIVE)
+    {
+      (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(subscription->running_count));
+      if ((subscription->state == SUBSCRIPTION_ACTIVE)
+          && is_subscribed(&(subscription->filter), name, version))
+      {
+        subscription->callback(event, name, version, interface_handle, subscription->context);
+      }
+      if ((AZ_ULIB_PORT_ATOMIC_DEC_W(&(subscription->running_count)) == 0)
+          && (subscription->state != SUBSCRIPTION_ACTIVE))
+      {
+        az_pal_os_event_set(&(_az_ipc_cb->_internal.subscription_event));
+      }
+    }
+  }
+}
+
+static inline bool is_subscription_handle(az_ulib_ipc_subscription_handle subscription_handle)
+{
+  const _az_ulib_ipc_subscription* subscription
+      = (const _az_ulib_ipc_subscription*)subscription_handle;
+  const _az_ulib_ipc_subscription* subscription_list = _az_ipc_cb->_internal.subscription_list;
+
+  return (subscription >= subscription_list)
+      && (subscription < &(subscription_list[AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS]))
+      && (subscription->state == SUBSCRIPTION_ACTIVE);
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+/*
+ * Keep the index at least twice as big as the registry. The new index is filled before it replaces
+ * the current one, and the old indexes are only released by az_ulib_ipc_deinit(), because a lookup
+ * may still be reading them.
+ */
+static az_result grow_index(uint32_t interface_count)
+{
+  az_result result = AZ_OK;
+  uint32_t index_mask;
+  uint16_t* interface_index = get_index(&index_mask);
+  uint32_t new_index_size = index_mask + 1;
+
+  while (new_index_size < (interface_count << 1))
+  {
+    new_index_size <<= 1;
+  }
+
+  if (new_index_size != (index_mask + 1))
+  {
+    uint16_t* new_interface_index;
+    uint32_t new_index_mask = new_index_size - 1;
+
+    if ((_az_ipc_cb->_internal.retired_index_count == _AZ_ULIB_IPC_MAX_INDEX_GROWTH)
+        || ((new_interface_index = (uint16_t*)_az_ipc_cb->_internal.allocator.allocate(
+                 new_index_size * sizeof(uint16_t)))
+            == NULL))
+    {
+      result = AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+    else
+    {
+      for (uint32_t i = 0; i < new_index_size; i++)
+      {
+        new_interface_index[i] = INDEX_EMPTY;
+      }
+
+      // Each bucket has a different name, so there is no need to compare the names here.
+      for (uint32_t i = 0; i <= index_mask; i++)
+      {
+        if (interface_index[i] != INDEX_EMPTY)
+        {
+          uint32_t bucket = get_ipc_interface(interface_index[i])->name_hash & new_index_mask;
+          while (new_interface_index[bucket] != INDEX_EMPTY)
+          {
+            bucket = (bucket + 1) & new_index_mask;
+          }
+          new_interface_index[bucket] = interface_index[i];
+        }
+      }
+
+      begin_write_index();
+      _az_ipc_cb->_internal.index = new_interface_index;
+      AZ_ULIB_PORT_MEMORY_BARRIER();
+      _az_ipc_cb->_internal.index_mask = new_index_mask;
+      end_write_index();
+
+      if (interface_index != _az_ipc_cb->_internal.interface_index)
+      {
+        _az_ipc_cb->_internal.retired_index_list[_az_ipc_cb->_internal.retired_index_count++]
+            = interface_index;
+      }
+    }
+  }
+
+  return result;
+}
+
+/*
+ * Keep the sorted index as big as the registry. Only the queries read it, under the IPC lock, so
+ * the old sorted index may be released right away.
+ */
+static az_result grow_sorted_index(uint32_t interface_count)
+{
+  az_result result;
+  uint16_t* new_sorted_index
+      = (uint16_t*)_az_ipc_cb->_internal.allocator.allocate(interface_count * sizeof(uint16_t));
+
+  if (new_sorted_index == NULL)
+  {
+    result = AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+  else
+  {
+    memcpy(
+        new_sorted_index,
+        _az_ipc_cb->_internal.sorted,
+        (size_t)_az_ipc_cb->_internal.sorted_count * sizeof(uint16_t));
+    if (_az_ipc_cb->_internal.sorted != _az_ipc_cb->_internal.sorted_index)
+    {
+      _az_ipc_cb->_internal.allocator.release(_az_ipc_cb->_internal.sorted);
+    }
+    _az_ipc_cb->_internal.sorted = new_sorted_index;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+/*
+ * Add a new segment at the end of the registry. The segment is only visible by the lookups after
+ * publish adds one of its interfaces to the index.
+ */
+static az_result add_segment(void)
+{
+  az_result result;
+  uint16_t segment_count = _az_ipc_cb->_internal.segment_count;
+  uint16_t interface_count = get_interface_count();
+  void* segment_memory;
+
+  if ((_az_ipc_cb->_internal.allocator.allocate == NULL)
+      || (segment_count == AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS))
+  {
+    result = AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+  else if (
+      (segment_memory = _az_ipc_cb->_internal.allocator.allocate(
+           (sizeof(_az_ulib_ipc_interface) * AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE)
+           + AZ_ULIB_PORT_CACHE_LINE_SIZE - 1))
+      == NULL)
+  {
+    result = AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+  else if (
+      ((result = grow_index((uint32_t)interface_count + AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE)) != AZ_OK)
+      || ((result = grow_sorted_index((uint32_t)interface_count + AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE))
+          != AZ_OK))
+  {
+    _az_ipc_cb->_internal.allocator.release(segment_memory);
+  }
+  else
+  {
+    // The allocator does not know about the alignment of the running shards.
+    _az_ulib_ipc_interface* segment
+        = (_az_ulib_ipc_interface*)(((uintptr_t)segment_memory + AZ_ULIB_PORT_CACHE_LINE_SIZE - 1)
+                                    & ~((uintptr_t)AZ_ULIB_PORT_CACHE_LINE_SIZE - 1));
+    for (uint16_t i = 0; i < AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE; i++)
+    {
+      reset_interface(&(segment[i]));
+    }
+
+    _az_ipc_cb->_internal.segment_memory_list[segment_count] = segment_memory;
+    _az_ipc_cb->_internal.segment_list[segment_count] = segment;
+    AZ_ULIB_PORT_MEMORY_BARRIER();
+    _az_ipc_cb->_internal.segment_count = (uint16_t)(segment_count + 1);
+    _az_ipc_cb->_internal.interface_count
+        = (uint16_t)(interface_count + AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE);
+  }
+
+  return result;
+}
+
+static void release_registry(void)
+{
+  for (uint16_t i = 0; i < _az_ipc_cb->_internal.segment_count; i++)
+  {
+    _az_ipc_cb->_internal.allocator.release(_az_ipc_cb->_internal.segment_memory_list[i]);
+  }
+
+  if (_az_ipc_cb->_internal.index != _az_ipc_cb->_internal.interface_index)
+  {
+    _az_ipc_cb->_internal.allocator.release(_az_ipc_cb->_internal.index);
+  }
+
+  if (_az_ipc_cb->_internal.sorted != _az_ipc_cb->_internal.sorted_index)
+  {
+    _az_ipc_cb->_internal.allocator.release(_az_ipc_cb->_internal.sorted);
+  }
+
+  for (uint16_t i = 0; i < _az_ipc_cb->_internal.retired_index_count; i++)
+  {
+    _az_ipc_cb->_internal.allocator.release(_az_ipc_cb->_internal.retired_index_list[i]);
+  }
+}
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+/*
+ * Returns the first free position in the registry. All positions before the first_free_hint are
+ * in use by published interfaces, so the search starts from it.
+ */
+static uint16_t get_first_free(void)
+{
+  uint16_t result = INDEX_EMPTY;
+  uint16_t interface_count = get_interface_count();
+  bool is_hint = true;
+
+  for (uint16_t i = _az_ipc_cb->_internal.first_free_hint; i < interface_count; i++)
+  {
+    _az_ulib_ipc_interface* ipc_interface = get_ipc_interface(i);
+    if (ipc_interface->interface_descriptor != NULL)
+    {
+      if (is_hint)
+      {
+        _az_ipc_cb->_internal.first_free_hint = (uint16_t)(i + 1);
+      }
+    }
+    else if (ipc_interface->ref_count == 0)
+    {
+      result = i;
+      break;
+    }
+    else
+    {
+      // An unpublished interface that still has instances is not free, but it will be.
+      is_hint = false;
+    }
+  }
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+  if ((result == INDEX_EMPTY) && (add_segment() == AZ_OK))
+  {
+    result = interface_count;
+  }
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+  return result;
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+/*
+ * Cancellation callback provided to the asynchronous commands. It returns AZ_ERROR_CANCELED if
+ * az_ulib_ipc_cancel_async() was called for the running call with the provided token.
+ */
+static az_result get_async_call_cancellation(const az_ulib_capability_token capability_token)
+{
+  az_result result = AZ_OK;
+
+  for (uint16_t i = 0; i < AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE; i++)
+  {
+    _az_ulib_ipc_async_call* async_call = &(_az_ipc_cb->_internal.async_call_list[i]);
+    if ((async_call->state == ASYNC_CALL_CANCELED)
+        && (async_call->capability_token == capability_token))
+    {
+      result = AZ_ERROR_CANCELED;
+      break;
+    }
+  }
+
+  return result;
+}
+
+static uint16_t get_first_free_async_call(void)
+{
+  uint16_t result = INDEX_EMPTY;
+
+  for (uint16_t i = 0; i < AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE; i++)
+  {
+    if (_az_ipc_cb->_internal.async_call_list[i].state == ASYNC_CALL_FREE)
+    {
+      result = i;
+      break;
+    }
+  }
+
+  return result;
+}
+
+static void run_async_call(_az_ulib_ipc_async_call* async_call)
+{
+  az_result result;
+  _az_ulib_ipc_interface* ipc_interface = async_call->ipc_interface;
+  volatile const az_ulib_interface_descriptor* interface_descriptor;
+  long epoch;
+
+  if ((interface_descriptor = enter_interface(ipc_interface, async_call->generation, &epoch))
+      != NULL)
+  {
+    const az_ulib_capability_descriptor* capability
+        = &(interface_descriptor->_internal.capability_list[async_call->command_index]);
+    if (capability->_internal.flags == (uint8_t)AZ_ULIB_CAPABILITY_TYPE_COMMAND_ASYNC)
+    {
+      result = capability->_internal.capability_ptr_1.command_async(
+          async_call->model_in,
+          async_call->model_out,
+          async_call->capability_token,
+          get_async_call_cancellation);
+    }
+    else
+    {
+      result = capability->_internal.capability_ptr_1.command(
+          async_call->model_in, async_call->model_out);
+    }
+    leave_interface(ipc_interface, epoch);
+  }
+  else
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  async_call->result_callback(async_call->capability_token, result, async_call->model_out);
+
+  // Free the call before releasing the instance, az_ulib_ipc_cancel_async() relies on the instance
+  // of a running call to access its interface.
+  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  async_call->state = ASYNC_CALL_FREE;
+  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+
+  (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->ref_count));
+}
+
+/*
+ * Each call in the queue posts the semaphore once, so a worker that finds the queue empty after
+ * the wait was woken up by stop_async_workers().
+ */
+static void async_worker(void* arg)
+{
+  (void)arg;
+  bool is_running = true;
+
+  while (is_running)
+  {
+    _az_ulib_ipc_async_call* async_call = NULL;
+
+    az_pal_os_semaphore_wait(&(_az_ipc_cb->_internal.async_semaphore));
+
+    az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+    if (_az_ipc_cb->_internal.async_queue_count == 0)
+    {
+      is_running = false;
+    }
+    else
+    {
+      uint16_t head = _az_ipc_cb->_internal.async_queue_head;
+      uint16_t async_call_index = _az_ipc_cb->_internal.async_queue[head];
+      async_call = &(_az_ipc_cb->_internal.async_call_list[async_call_index]);
+      _az_ipc_cb->_internal.async_queue_head
+          = (uint16_t)((head + 1) % AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE);
+      _az_ipc_cb->_internal.async_queue_count--;
+
+      if (async_call->state == ASYNC_CALL_DROPPED)
+      {
+        // The call was canceled in the queue, az_ulib_ipc_cancel_async() already reported it.
+        async_call->state = ASYNC_CALL_FREE;
+        async_call = NULL;
+      }
+      else
+      {
+        async_call->state = ASYNC_CALL_RUNNING;
+      }
+    }
+    az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+
+    if (async_call != NULL)
+    {
+      run_async_call(async_call);
+    }
+  }
+}
+
+static void stop_async_workers(uint16_t worker_count)
+{
+  for (uint16_t i = 0; i < worker_count; i++)
+  {
+    az_pal_os_semaphore_post(&(_az_ipc_cb->_internal.async_semaphore));
+  }
+
+  for (uint16_t i = 0; i < worker_count; i++)
+  {
+    az_pal_os_thread_join(&(_az_ipc_cb->_internal.async_worker_list[i]));
+  }
+
+  az_pal_os_semaphore_deinit(&(_az_ipc_cb->_internal.async_semaphore));
+}
+
+static az_result start_async_workers(void)
+{
+  az_result result = AZ_OK;
+
+  for (uint16_t i = 0; i < AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE; i++)
+  {
+    _az_ipc_cb->_internal.async_call_list[i].state = ASYNC_CALL_FREE;
+  }
+  _az_ipc_cb->_internal.async_queue_head = 0;
+  _az_ipc_cb->_internal.async_queue_count = 0;
+  az_pal_os_semaphore_init(&(_az_ipc_cb->_internal.async_semaphore), 0);
+
+  for (uint16_t i = 0; i < AZ_ULIB_CONFIG_IPC_ASYNC_WORKERS; i++)
+  {
+    if (!az_pal_os_thread_create(&(_az_ipc_cb->_internal.async_worker_list[i]), async_worker, NULL))
+    {
+      stop_async_workers(i);
+      result = AZ_ERROR_ULIB_SYSTEM;
+      break;
+    }
+  }
+
+  return result;
+}
+#else
+#define start_async_workers() AZ_OK
+#define stop_async_workers(worker_count)
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+
+AZ_NODISCARD az_result az_ulib_ipc_init(az_ulib_ipc* ipc_handle)
+{
+  _az_PRECONDITION_IS_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(ipc_handle);
+
+  _az_ipc_cb = ipc_handle;
+
+  az_pal_os_lock_init(&(_az_ipc_cb->_internal.subscription_lock));
+  az_pal_os_event_init(&(_az_ipc_cb->_internal.subscription_event));
+  for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS; i++)
+  {
+    _az_ipc_cb->_internal.subscription_list[i].state = SUBSCRIPTION_FREE;
+    _az_ipc_cb->_internal.subscription_list[i].running_count = 0;
+  }
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  az_pal_os_lock_init(&(_az_ipc_cb->_internal.drain_lock));
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  az_pal_os_lock_init(&(_az_ipc_cb->_internal.lock));
+  _az_ipc_cb->_internal.sequence = 0;
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  az_pal_os_event_init(&(_az_ipc_cb->_internal.unpublish_event));
+  _az_ipc_cb->_internal.epoch = 0;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++)
+  {
+    reset_interface(&(_az_ipc_cb->_internal.interface_list[i]));
+  }
+  _az_ipc_cb->_internal.first_free_hint = 0;
+  _az_ipc_cb->_internal.sorted_count = 0;
+  _az_ipc_cb->_internal.generation = 0;
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+  reset_trace();
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
+
+  for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_INTERFACE_INDEX_SIZE; i++)
+  {
+    _az_ipc_cb->_internal.interface_index[i] = INDEX_EMPTY;
+  }
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+  _az_ipc_cb->_internal.allocator.allocate = NULL;
+  _az_ipc_cb->_internal.allocator.release = NULL;
+  _az_ipc_cb->_internal.index = _az_ipc_cb->_internal.interface_index;
+  _az_ipc_cb->_internal.index_mask = INDEX_MASK;
+  _az_ipc_cb->_internal.sorted = _az_ipc_cb->_internal.sorted_index;
+  _az_ipc_cb->_internal.interface_count = AZ_ULIB_CONFIG_MAX_IPC_INTERFACE;
+  _az_ipc_cb->_internal.segment_count = 0;
+  _az_ipc_cb->_internal.retired_index_count = 0;
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+  az_result result;
+  if ((result = start_async_workers()) == AZ_OK)
+  {
+    result = _az_ulib_ipc_query_interface_publish();
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+    if (result == AZ_OK)
+    {
+      result = _az_ulib_ipc_stats_interface_publish();
+    }
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+  }
+  else
+  {
+    az_pal_os_event_deinit(&(_az_ipc_cb->_internal.subscription_event));
+    az_pal_os_lock_deinit(&(_az_ipc_cb->_internal.subscription_lock));
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    az_pal_os_event_deinit(&(_az_ipc_cb->_internal.unpublish_event));
+    az_pal_os_lock_deinit(&(_az_ipc_cb->_internal.drain_lock));
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    az_pal_os_lock_deinit(&(_az_ipc_cb->_internal.lock));
+    _az_ipc_cb = NULL;
+  }
+
+  return result;
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+AZ_NODISCARD az_result
+az_ulib_ipc_init_with_allocator(az_ulib_ipc* ipc_handle, const az_ulib_ipc_allocator* allocator)
+{
+  _az_PRECONDITION_IS_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(ipc_handle);
+  _az_PRECONDITION_NOT_NULL(allocator);
+  _az_PRECONDITION_NOT_NULL(allocator->allocate);
+  _az_PRECONDITION_NOT_NULL(allocator->release);
+
+  az_result result;
+
+  if ((result = az_ulib_ipc_init(ipc_handle)) == AZ_OK)
+  {
+    _az_ipc_cb->_internal.allocator = *allocator;
+  }
+
+  return result;
+}
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+AZ_NODISCARD az_result az_ulib_ipc_deinit(void)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+
+  az_result result = AZ_OK;
+
+  for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS; i++)
+  {
+    if (_az_ipc_cb->_internal.subscription_list[i].state != SUBSCRIPTION_FREE)
+    {
+      result = AZ_ERROR_ULIB_BUSY;
+      break;
+    }
+  }
+
+  if (result == AZ_OK)
+  {
+    result = _az_ulib_ipc_query_interface_unpublish();
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+    if (result == AZ_OK)
+    {
+      result = _az_ulib_ipc_stats_interface_unpublish();
+    }
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+
+    for (uint16_t i = 0; i < get_interface_count(); i++)
+    {
+      _az_ulib_ipc_interface* ipc_interface = get_ipc_interface(i);
+      if ((ipc_interface->interface_descriptor != NULL) || (ipc_interface->ref_count != 0)
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+          || (get_running_count(ipc_interface, 0) != 0)
+          || (get_running_count(ipc_interface, 1) != 0)
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+      )
+      {
+        // Do our best to publish IPC query the interface again.
+        (void)_az_ulib_ipc_query_interface_publish();
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+        (void)_az_ulib_ipc_stats_interface_publish();
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+        result = AZ_ERROR_ULIB_BUSY;
+        break;
+      }
+    }
+  }
+
+  if (result == AZ_OK)
+  {
+    stop_async_workers(AZ_ULIB_CONFIG_IPC_ASYNC_WORKERS);
+    az_pal_os_event_deinit(&(_az_ipc_cb->_internal.subscription_event));
+    az_pal_os_lock_deinit(&(_az_ipc_cb->_internal.subscription_lock));
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    az_pal_os_event_deinit(&(_az_ipc_cb->_internal.unpublish_event));
+    az_pal_os_lock_deinit(&(_az_ipc_cb->_internal.drain_lock));
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+    release_registry();
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+    az_pal_os_lock_deinit(&(_az_ipc_cb->_internal.lock));
+    _az_ipc_cb = NULL;
+  }
+
+  return result;
+}
+
+/*
+ * Find the position of a version in the list of versions with the same name. The caller shall hold
+ * the IPC lock.
+ */
+static uint16_t* find_version_link(az_span name, uint32_t name_hash, az_ulib_version version)
+{
+  uint16_t* link = find_index_bucket(name, name_hash);
+  while ((*link != INDEX_EMPTY) && (get_ipc_interface(*link)->version < version))
+  {
+    link = &(get_ipc_interface(*link)->next_version);
+  }
+  return link;
+}
+
+/*
+ * Stamp all versions of the name with the current registry generation, so the queries of this name
+ * with a limited version range know that the versions changed.
+ */
+static void touch_name(az_span name, uint32_t name_hash)
+{
+  for (uint16_t interface_index = *find_index_bucket(name, name_hash);
+       interface_index != INDEX_EMPTY;
+       interface_index = get_ipc_interface(interface_index)->next_version)
+  {
+    get_ipc_interface(interface_index)->name_generation = _az_ipc_cb->_internal.generation;
+  }
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_publish(
+    const az_ulib_interface_descriptor* const interface_descriptor,
+    az_ulib_ipc_interface_handle* interface_handle)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_descriptor);
+
+  az_result result;
+  az_span name = interface_descriptor->_internal.name;
+  az_ulib_version version = interface_descriptor->_internal.version;
+  uint32_t name_hash = hash_name(name);
+  uint16_t new_interface_index;
+  az_ulib_ipc_interface_handle new_interface_handle = NULL;
+
+  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  {
+    uint16_t* link = find_version_link(name, name_hash, version);
+
+    if ((*link != INDEX_EMPTY) && (get_ipc_interface(*link)->version == version))
+    {
+      // IPC shall not accept interfaces with same name and version because it cannot decided each
+      // one to retrieve when someone uses az_ulib_ipc_try_get_interface().
+      result = AZ_ERROR_ULIB_ELEMENT_DUPLICATE;
+    }
+    else if ((new_interface_index = get_first_free()) == INDEX_EMPTY)
+    {
+      result = AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+    else
+    {
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+      // A new segment may have rehashed the index.
+      link = find_version_link(name, name_hash, version);
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+      begin_write_index();
+      _az_ulib_ipc_interface* new_interface = get_ipc_interface(new_interface_index);
+      new_interface->name = name;
+      new_interface->name_hash = name_hash;
+      new_interface->version = version;
+      new_interface->next_version = *link;
+#if AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+      build_capability_index(new_interface, interface_descriptor);
+#endif // AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+      new_interface->contract = az_ulib_ipc_get_contract(interface_descriptor);
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+      *link = new_interface_index;
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+      reset_stats(new_interface);
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
+          (const volatile void**)&(new_interface->interface_descriptor),
+          (const void*)interface_descriptor);
+      end_write_index();
+      insert_sorted_index(new_interface_index);
+      _az_ipc_cb->_internal.generation++;
+      new_interface->publish_generation = _az_ipc_cb->_internal.generation;
+      touch_name(name, name_hash);
+      new_interface_handle = get_handle(new_interface_index);
+      if (interface_handle != NULL)
+      {
+        *interface_handle = new_interface_handle;
+      }
+      result = AZ_OK;
+    }
+  }
+  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+
+  trace_registry(TRACE_PUBLISH, interface_descriptor, result);
+  if (result == AZ_OK)
+  {
+    notify_subscribers(AZ_ULIB_IPC_EVENT_PUBLISH, name, version, new_interface_handle);
+  }
+
+  return result;
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+AZ_NODISCARD az_result az_ulib_ipc_unpublish(
+    const az_ulib_interface_descriptor* const interface_descriptor,
+    uint32_t wait_option_ms)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_descriptor);
+
+  az_result result;
+  uint16_t* bucket;
+  uint16_t* link;
+  az_ulib_ipc_interface_handle release_interface_handle = NULL;
+
+  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  {
+    if ((link = find_interface_descriptor(interface_descriptor, &bucket)) == NULL)
+    {
+      result = AZ_ERROR_ITEM_NOT_FOUND;
+    }
+    else
+    {
+      uint16_t release_index = *link;
+      _az_ulib_ipc_interface* release_interface = get_ipc_interface(release_index);
+
+      // The order of the code here, including the ones that looks not necessary, are associated to
+      // the interlock between this function and the az_ulib_ipc_call.
+
+      // Block access to this interface. After this point, any new call to az_ulib_ipc_call that
+      // didn't get the interface pointer yet will return AZ_ERROR_ITEM_NOT_FOUND.
+      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
+          (const volatile void**)(&(release_interface->interface_descriptor)), (const void*)NULL);
+
+      // Remove the interface from the index before the wait, so the lookups that may be reading
+      // its name are either in the running_count, or will see that the index changed.
+      begin_write_index();
+      *link = release_interface->next_version;
+      release_interface->next_version = INDEX_EMPTY;
+      if (*bucket == INDEX_EMPTY)
+      {
+        remove_index_bucket(bucket);
+      }
+      end_write_index();
+
+      // If the running_count is `0` is because no other process is inside of any of the functions
+      // commands, and they may be removed from the memory. There will be the case that the other
+      // process is already in the az_ulib_ipc_call, in the direction to call a command in this
+      // interface, but the call will just return AZ_ERROR_ITEM_NOT_FOUND from there.
+      az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.drain_lock));
+      bool is_drained = drain_interface(release_interface, wait_option_ms);
+      az_pal_os_lock_release(&(_az_ipc_cb->_internal.drain_lock));
+      if (is_drained)
+      {
+        // The calls of a descriptor that a replace took out of this interface were drained too.
+        release_interface->replaced_descriptor = NULL;
+        release_interface_handle = get_handle(release_index);
+        release_interface->generation = (uint16_t)(release_interface->generation + 1);
+        remove_sorted_index(release_index);
+        _az_ipc_cb->_internal.generation++;
+        touch_name(release_interface->name, release_interface->name_hash);
+        if (release_index < _az_ipc_cb->_internal.first_free_hint)
+        {
+          _az_ipc_cb->_internal.first_free_hint = release_index;
+        }
+        result = AZ_OK;
+      }
+      else
+      {
+        // If caller doesn't want to wait anymore, recover the interface and return
+        // AZ_ERROR_ULIB_BUSY.
+        link = find_version_link(
+            release_interface->name, release_interface->name_hash, release_interface->version);
+        begin_write_index();
+        release_interface->next_version = *link;
+        *link = release_index;
+        end_write_index();
+        (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
+            (const volatile void**)(&(release_interface->interface_descriptor)),
+            (const void*)interface_descriptor);
+        result = AZ_ERROR_ULIB_BUSY;
+      }
+    }
+  }
+  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+
+  trace_registry(TRACE_UNPUBLISH, interface_descriptor, result);
+  if (result == AZ_OK)
+  {
+    notify_subscribers(
+        AZ_ULIB_IPC_EVENT_UNPUBLISH,
+        interface_descriptor->_internal.name,
+        interface_descriptor->_internal.version,
+        release_interface_handle);
+  }
+
+  return result;
+}
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+/*
+ * Wait, out of the IPC lock, for the calls that may still use the descriptor that a replace took
+ * out of the interface. Only the replace that finds replaced_descriptor `NULL` sets it, under the
+ * IPC lock, and only the drains clear it, under the drain_lock, so the drain clears it only if no
+ * other drain did it before, and no replace changes it in between.
+ */
+static bool drain_replaced(
+    _az_ulib_ipc_interface* ipc_interface,
+    const az_ulib_interface_descriptor* replaced_descriptor,
+    uint32_t wait_option_ms)
+{
+  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.drain_lock));
+  bool is_drained = drain_interface(ipc_interface, wait_option_ms);
+  if (is_drained && (ipc_interface->replaced_descriptor == replaced_descriptor))
+  {
+    ipc_interface->replaced_descriptor = NULL;
+  }
+  az_pal_os_lock_release(&(_az_ipc_cb->_internal.drain_lock));
+
+  return is_drained;
+}
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+AZ_NODISCARD az_result az_ulib_ipc_replace(
+    const az_ulib_interface_descriptor* const old_interface_descriptor,
+    const az_ulib_interface_descriptor* const new_interface_descriptor,
+    uint32_t wait_option_ms)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(old_interface_descriptor);
+  _az_PRECONDITION_NOT_NULL(new_interface_descriptor);
+
+  az_result result;
+  uint16_t* bucket;
+  uint16_t* link;
+  _az_ulib_ipc_interface* ipc_interface = NULL;
+  az_ulib_ipc_interface_handle interface_handle = NULL;
+
+  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  {
+    if ((link = find_interface_descriptor(old_interface_descriptor, &bucket)) == NULL)
+    {
+      result = AZ_ERROR_ITEM_NOT_FOUND;
+    }
+    else if (!is_compatible_descriptor(old_interface_descriptor, new_interface_descriptor))
+    {
+      result = AZ_ERROR_ULIB_INCOMPATIBLE_VERSION;
+    }
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    else if (get_ipc_interface(*link)->replaced_descriptor != NULL)
+    {
+      // The interface keeps only one replaced descriptor, and the calls of the previous replace
+      // are still running.
+      result = AZ_ERROR_ULIB_BUSY;
+    }
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    else
+    {
+      ipc_interface = get_ipc_interface(*link);
+
+      // The interface keeps its position, generation, and running_count, so the handles stay
+      // valid. The calls that already got the old descriptor in enter_interface finish on it, and
+      // the next calls get the new one. The name in the index points to the descriptor, so it
+      // moves to the new one in a change of the index, and the lookups that may still compare the
+      // old name are in the running_count, or see that the index changed.
+      begin_write_index();
+      ipc_interface->name = new_interface_descriptor->_internal.name;
+      end_write_index();
+      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
+          (const volatile void**)(&(ipc_interface->interface_descriptor)),
+          (const void*)new_interface_descriptor);
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+      ipc_interface->replaced_descriptor = old_interface_descriptor;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+      interface_handle = get_handle(*link);
+      result = AZ_OK;
+    }
+  }
+  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+
+  trace_registry(TRACE_REPLACE, new_interface_descriptor, result);
+  if (result == AZ_OK)
+  {
+    notify_subscribers(
+        AZ_ULIB_IPC_EVENT_REPLACE,
+        new_interface_descriptor->_internal.name,
+        new_interface_descriptor->_internal.version,
+        interface_handle);
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    // Wait for the calls and lookups that may still use the old descriptor out of the IPC lock, so
+    // the other IPC APIs do not wait for them. The new descriptor stays published even if they do
+    // not finish in time, and az_ulib_ipc_wait_replaced may wait for them later.
+    if (!drain_replaced(ipc_interface, old_interface_descriptor, wait_option_ms))
+    {
+      result = AZ_ULIB_PENDING;
+    }
+#else
+    // Without unpublish, the descriptors are never released, so there is nothing to wait for.
+    (void)ipc_interface;
+    (void)wait_option_ms;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  }
+
+  return result;
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+AZ_NODISCARD az_result az_ulib_ipc_wait_replaced(
+    const az_ulib_interface_descriptor* const interface_descriptor,
+    uint32_t wait_option_ms)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_descriptor);
+
+  az_result result = AZ_OK;
+  _az_ulib_ipc_interface* ipc_interface = NULL;
+
+  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  {
+    uint16_t* bucket;
+    az_span name = interface_descriptor->_internal.name;
+    uint16_t* link = find_version_link(
+        name, hash_name(name), interface_descriptor->_internal.version);
+
+    if (find_interface_descriptor(interface_descriptor, &bucket) != NULL)
+    {
+      result = AZ_ERROR_ITEM_NOT_FOUND;
+    }
+    else if (
+        (*link != INDEX_EMPTY)
+        && (get_ipc_interface(*link)->replaced_descriptor == interface_descriptor))
+    {
+      ipc_interface = get_ipc_interface(*link);
+    }
+  }
+  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+
+  // If the descriptor is not published and no interface keeps it as replaced, its calls were
+  // already drained.
+  if ((ipc_interface != NULL)
+      && !drain_replaced(ipc_interface, interface_descriptor, wait_option_ms))
+  {
+    result = AZ_ERROR_ULIB_BUSY;
+  }
+
+  return result;
+}
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+/*
+ * Get an instance of the interface with the provided name and version. With
+ * AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT, if `contract` is not `NULL`, the interface shall also have
+ * this contract, which is read in the same lookup, so it cannot be the contract of another
+ * interface published in the same slot.
+ */
+static az_result try_get_interface(
+    az_span name,
+    az_ulib_version version,
+    az_ulib_version_match_criteria match_criteria,
+    const uint32_t* contract,
+    az_ulib_ipc_interface_handle* interface_handle)
+{
+  az_result result;
+  _az_ulib_ipc_interface* ipc_interface;
+  uint16_t interface_index;
+  uint32_t attempt = 0;
+  bool is_locked = false;
+  bool retry;
+
+  do
+  {
+    long sequence;
+    if (!is_locked && ((++attempt > INDEX_READ_RETRIES) || !begin_read_index(&sequence)))
+    {
+      // Writers change the index holding the IPC lock, so the sequence does not change while the
+      // reader holds it.
+      az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+      is_locked = true;
+      sequence = _az_ipc_cb->_internal.sequence;
+    }
+
+    if ((interface_index = get_interface(name, version, match_criteria, sequence)) == INDEX_EMPTY)
+    {
+      result = AZ_ERROR_ITEM_NOT_FOUND;
+      retry = !end_read_index(sequence);
+    }
+    else if ((result = get_instance(ipc_interface = get_ipc_interface(interface_index))) != AZ_OK)
+    {
+      retry = !end_read_index(sequence);
+    }
+    else
+    {
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+      bool is_contract_valid = (contract == NULL) || (ipc_interface->contract == *contract);
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+      if ((ipc_interface->interface_descriptor == NULL) || !end_read_index(sequence))
+      {
+        // The interface was unpublished after the lookup and its slot may be in use by another
+        // interface, so release the instance and try again.
+        (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->ref_count));
+        retry = true;
+      }
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+      else if (!is_contract_valid)
+      {
+        (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->ref_count));
+        result = AZ_ERROR_ULIB_INCOMPATIBLE_VERSION;
+        retry = false;
+      }
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+      else
+      {
+        *interface_handle = get_handle(interface_index);
+        retry = false;
+      }
+    }
+  } while (retry);
+
+  if (is_locked)
+  {
+    az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+  }
+
+#ifndef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+  (void)contract;
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_try_get_interface(
+    az_span name,
+    az_ulib_version version,
+    az_ulib_version_match_criteria match_criteria,
+    az_ulib_ipc_interface_handle* interface_handle)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_VALID_SPAN(name, 1, false);
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+
+  return try_get_interface(name, version, match_criteria, NULL, interface_handle);
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+AZ_NODISCARD uint32_t
+az_ulib_ipc_get_contract(const az_ulib_interface_descriptor* const interface_descriptor)
+{
+  _az_PRECONDITION_NOT_NULL(interface_descriptor);
+
+  uint32_t contract = FNV_OFFSET_BASIS;
+  for (az_ulib_capability_index index = 0; index < interface_descriptor->_internal.size; index++)
+  {
+    const az_ulib_capability_descriptor* capability
+        = &(interface_descriptor->_internal.capability_list[index]);
+    // The type ends each name, so the capabilities "ab" and "c" do not hash as "a" and "bc".
+    contract = hash_append(contract, capability->_internal.name);
+    contract ^= capability->_internal.flags;
+    contract *= FNV_PRIME;
+  }
+
+  return contract;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_try_get_interface_with_contract(
+    az_span name,
+    az_ulib_version version,
+    az_ulib_version_match_criteria match_criteria,
+    uint32_t contract,
+    az_ulib_ipc_interface_handle* interface_handle)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_VALID_SPAN(name, 1, false);
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+
+  return try_get_interface(name, version, match_criteria, &contract, interface_handle);
+}
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+
+/*
+ * Find the capability with the provided name in the interface. The caller shall be inside of the
+ * interface, or hold the IPC lock.
+ */
+static bool find_capability(
+    const _az_ulib_ipc_interface* ipc_interface,
+    volatile const az_ulib_interface_descriptor* interface_descriptor,
+    az_span name,
+    uint32_t name_hash,
+    az_ulib_capability_index* capability_index)
+{
+  bool result = false;
+
+#if AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+  if (interface_descriptor->_internal.size <= MAX_INDEXED_CAPABILITIES)
+  {
+    uint32_t bucket = name_hash & CAPABILITY_INDEX_MASK;
+    uint8_t entry;
+    while ((entry = ipc_interface->capability_index[bucket]) != CAPABILITY_INDEX_EMPTY)
+    {
+      if (az_span_is_content_equal(
+              name, interface_descriptor->_internal.capability_list[entry - 1]._internal.name))
+      {
+        *capability_index = (az_ulib_capability_index)(entry - 1);
+        result = true;
+        break;
+      }
+      bucket = (bucket + 1) & CAPABILITY_INDEX_MASK;
+    }
+  }
+  else
+#else
+  (void)ipc_interface;
+  (void)name_hash;
+#endif // AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE != 0
+  {
+    for (az_ulib_capability_index index = 0; index < interface_descriptor->_internal.size; index++)
+    {
+      if (az_span_is_content_equal(
+              name, interface_descriptor->_internal.capability_list[index]._internal.name))
+      {
+        *capability_index = index;
+        result = true;
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_try_get_capability(
+    az_ulib_ipc_interface_handle interface_handle,
+    az_span name,
+    az_ulib_capability_index* capability_index)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+  _az_PRECONDITION(is_handle_in_range(interface_handle));
+  _az_PRECONDITION_VALID_SPAN(name, 1, false);
+  _az_PRECONDITION_NOT_NULL(capability_index);
+
+  az_result result = AZ_ERROR_ITEM_NOT_FOUND;
+  _az_ulib_ipc_interface* ipc_interface = get_handle_interface(interface_handle);
+  volatile const az_ulib_interface_descriptor* interface_descriptor;
+  long epoch;
+
+  if ((interface_descriptor
+       = enter_interface(ipc_interface, get_handle_generation(interface_handle), &epoch))
+      != NULL)
+  {
+    if (find_capability(
+            ipc_interface, interface_descriptor, name, hash_name(name), capability_index))
+    {
+      result = AZ_OK;
+    }
+    leave_interface(ipc_interface, epoch);
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_get_interface(
+    az_ulib_ipc_interface_handle original_interface_handle,
+    az_ulib_ipc_interface_handle* interface_handle)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(original_interface_handle);
+  _az_PRECONDITION(is_handle_in_range(original_interface_handle));
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+
+  az_result result;
+  _az_ulib_ipc_interface* ipc_interface = get_handle_interface(original_interface_handle);
+
+  // The original handle holds one instance of the interface, so its slot cannot be reused while
+  // this function is running.
+  if ((ipc_interface->interface_descriptor == NULL)
+      || (ipc_interface->generation != get_handle_generation(original_interface_handle)))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else if ((result = get_instance(ipc_interface)) == AZ_OK)
+  {
+    *interface_handle = original_interface_handle;
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_release_interface(az_ulib_ipc_interface_handle interface_handle)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+  _az_PRECONDITION(is_handle_in_range(interface_handle));
+
+  _az_ulib_ipc_interface* ipc_interface = get_handle_interface(interface_handle);
+  az_result result;
+
+  if (AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->ref_count)) < 0)
+  {
+    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(ipc_interface->ref_count));
+    result = AZ_ERROR_ULIB_PRECONDITION;
+  }
+  else
+  {
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_subscribe(
+    const az_ulib_ipc_subscription_filter* filter,
+    az_ulib_ipc_subscription_callback callback,
+    void* context,
+    az_ulib_ipc_subscription_handle* subscription_handle)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(filter);
+  _az_PRECONDITION_NOT_NULL(callback);
+  _az_PRECONDITION_NOT_NULL(subscription_handle);
+
+  az_result result = AZ_ERROR_NOT_ENOUGH_SPACE;
+
+  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.subscription_lock));
+  {
+    for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS; i++)
+    {
+      _az_ulib_ipc_subscription* subscription = &(_az_ipc_cb->_internal.subscription_list[i]);
+      if (subscription->state == SUBSCRIPTION_FREE)
+      {
+        // A free subscription may still be counted by a publisher that saw it active, but the
+        // publisher will test the state again before using the filter and the callback.
+        subscription->filter = *filter;
+        subscription->callback = callback;
+        subscription->context = context;
+        (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(subscription->state), SUBSCRIPTION_ACTIVE);
+        *subscription_handle = (az_ulib_ipc_subscription_handle)subscription;
+        result = AZ_OK;
+        break;
+      }
+    }
+  }
+  az_pal_os_lock_release(&(_az_ipc_cb->_internal.subscription_lock));
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_unsubscribe(
+    az_ulib_ipc_subscription_handle subscription_handle,
+    uint32_t wait_option_ms)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION(is_subscription_handle(subscription_handle));
+
+  az_result result;
+  _az_ulib_ipc_subscription* subscription = (_az_ulib_ipc_subscription*)subscription_handle;
+
+  // The subscription lock serializes the unsubscribes, so only one of them waits for the
+  // subscription_event at a time.
+  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.subscription_lock));
+  {
+    // After this point, no new callback will start. Wait for the ones that are running.
+    (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(subscription->state), SUBSCRIPTION_CLOSING);
+
+    uint32_t retry_interval = get_retry_interval(wait_option_ms);
+    uint32_t retry_total_time = 0;
+    while ((subscription->running_count != 0) && (retry_total_time < wait_option_ms))
+    {
+      if ((!az_pal_os_event_wait(&(_az_ipc_cb->_internal.subscription_event), retry_interval))
+          && (wait_option_ms != AZ_ULIB_WAIT_FOREVER))
+      {
+        retry_total_time += retry_interval;
+      }
+    }
+
+    if (subscription->running_count == 0)
+    {
+      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(subscription->state), SUBSCRIPTION_FREE);
+      result = AZ_OK;
+    }
+    else
+    {
+      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(subscription->state), SUBSCRIPTION_ACTIVE);
+      result = AZ_ERROR_ULIB_BUSY;
+    }
+  }
+  az_pal_os_lock_release(&(_az_ipc_cb->_internal.subscription_lock));
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_call(
+    az_ulib_ipc_interface_handle interface_handle,
+    az_ulib_capability_index command_index,
+    az_ulib_model_in model_in,
+    az_ulib_model_out model_out)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+  _az_PRECONDITION(is_handle_in_range(interface_handle));
+
+  az_result result;
+  _az_ulib_ipc_interface* ipc_interface = get_handle_interface(interface_handle);
+  volatile const az_ulib_interface_descriptor* interface_descriptor;
+  long epoch;
+
+  if ((interface_descriptor
+       = enter_interface(ipc_interface, get_handle_generation(interface_handle), &epoch))
+      != NULL)
+  {
+    bool is_traced = is_call_traced();
+    uint32_t start_time = get_call_time(is_traced);
+    trace_call_begin(is_traced, ipc_interface, command_index, start_time);
+    result = interface_descriptor->_internal.capability_list[command_index]
+                 ._internal.capability_ptr_1.command(model_in, model_out);
+    uint32_t end_time = get_call_time(is_traced);
+    record_call(ipc_interface, command_index, result, start_time, end_time);
+    trace_call_end(is_traced, ipc_interface, command_index, result, end_time);
+    leave_interface(ipc_interface, epoch);
+  }
+  else
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_call_with_str(
+    az_ulib_ipc_interface_handle interface_handle,
+    az_ulib_capability_index command_index,
+    az_span model_in_span,
+    az_span* model_out_span)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+  _az_PRECONDITION(is_handle_in_range(interface_handle));
+
+  az_result result;
+  _az_ulib_ipc_interface* ipc_interface = get_handle_interface(interface_handle);
+  volatile const az_ulib_interface_descriptor* interface_descriptor;
+  long epoch;
+
+  if ((interface_descriptor
+       = enter_interface(ipc_interface, get_handle_generation(interface_handle), &epoch))
+      != NULL)
+  {
+    if (interface_descriptor->_internal.capability_list[command_index]
+            ._internal.span_wrapper_ptr_1.command
+        != NULL)
+    {
+      bool is_traced = is_call_traced();
+      uint32_t start_time = get_call_time(is_traced);
+      trace_call_begin(is_traced, ipc_interface, command_index, start_time);
+      result = interface_descriptor->_internal.capability_list[command_index]
+                   ._internal.span_wrapper_ptr_1.command(model_in_span, model_out_span);
+      uint32_t end_time = get_call_time(is_traced);
+      record_call(ipc_interface, command_index, result, start_time, end_time);
+      trace_call_end(is_traced, ipc_interface, command_index, result, end_time);
+    }
+    else
+    {
+      result = AZ_ERROR_NOT_SUPPORTED;
+    }
+    leave_interface(ipc_interface, epoch);
+  }
+  else
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_call_with_binary(
+    az_ulib_ipc_interface_handle interface_handle,
+    az_ulib_capability_index command_index,
+    az_span model_in_binary,
+    az_span* model_out_binary)
 {
-  struct
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+  _az_PRECONDITION(is_handle_in_range(interface_handle));
+
+  az_result result;
+  _az_ulib_ipc_interface* ipc_interface = get_handle_interface(interface_handle);
+  volatile const az_ulib_interface_descriptor* interface_descriptor;
+  long epoch;
+
+  if ((interface_descriptor
+       = enter_interface(ipc_interface, get_handle_generation(interface_handle), &epoch))
+      != NULL)
+  {
+    if (interface_descriptor->_internal.capability_list[command_index]
+            ._internal.binary_wrapper_ptr_1.command
+        != NULL)
+    {
+      bool is_traced = is_call_traced();
+      uint32_t start_time = get_call_time(is_traced);
+      trace_call_begin(is_traced, ipc_interface, command_index, start_time);
+      result = interface_descriptor->_internal.capability_list[command_index]
+                   ._internal.binary_wrapper_ptr_1.command(model_in_binary, model_out_binary);
+      uint32_t end_time = get_call_time(is_traced);
+      record_call(ipc_interface, command_index, result, start_time, end_time);
+      trace_call_end(is_traced, ipc_interface, command_index, result, end_time);
+    }
+    else
+    {
+      result = AZ_ERROR_NOT_SUPPORTED;
+    }
+    leave_interface(ipc_interface, epoch);
+  }
+  else
   {
-    uint8_t query_type;
-    uint8_t reserved;
-    uint16_t count;
-  } fields;
-  uint32_t val;
-} ipc_continuation_token;
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
 
-/*
- * IPC is a singleton component, and shall be initialized only once.
- *
- * Make it volatile to avoid any compilation optimization.
- */
-static az_ulib_ipc* volatile _az_ipc_cb = NULL;
+  return result;
+}
 
-static _az_ulib_ipc_interface* get_interface(
-    az_span name,
-    az_ulib_version version,
-    az_ulib_version_match_criteria match_criteria)
+AZ_NODISCARD az_result az_ulib_ipc_call_batch(
+    az_ulib_ipc_interface_handle interface_handle,
+    const az_ulib_ipc_call_entry* entries,
+    size_t entries_size,
+    az_result* results,
+    bool stop_on_error)
 {
-  _az_ulib_ipc_interface* result = NULL;
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+  _az_PRECONDITION(is_handle_in_range(interface_handle));
+  _az_PRECONDITION_NOT_NULL(entries);
+  _az_PRECONDITION(entries_size > 0);
+  _az_PRECONDITION_NOT_NULL(results);
 
-  // Find the lowest version that fits the criteria.
-  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++)
+  az_result result = AZ_OK;
+  _az_ulib_ipc_interface* ipc_interface = get_handle_interface(interface_handle);
+  volatile const az_ulib_interface_descriptor* interface_descriptor;
+  long epoch;
+
+  if ((interface_descriptor
+       = enter_interface(ipc_interface, get_handle_generation(interface_handle), &epoch))
+      != NULL)
   {
-    if ((_az_ipc_cb->_internal.interface_list[i].interface_descriptor != NULL)
-        && (az_span_is_content_equal(
-            _az_ipc_cb->_internal.interface_list[i].interface_descriptor->_internal.name, name))
-        && az_ulib_version_match(
-            _az_ipc_cb->_internal.interface_list[i].interface_descriptor->_internal.version,
-            version,
-            match_criteria))
+    const az_ulib_capability_descriptor* capability_list
+        = interface_descriptor->_internal.capability_list;
+    size_t entry_index;
+
+    for (entry_index = 0; entry_index < entries_size; entry_index++)
     {
-      if (result == NULL)
+      const az_ulib_ipc_call_entry* entry = &(entries[entry_index]);
+      bool is_traced = is_call_traced();
+      uint32_t start_time = get_call_time(is_traced);
+      trace_call_begin(is_traced, ipc_interface, entry->command_index, start_time);
+      results[entry_index]
+          = capability_list[entry->command_index]._internal.capability_ptr_1.command(
+              entry->model_in, entry->model_out);
+      uint32_t end_time = get_call_time(is_traced);
+      record_call(ipc_interface, entry->command_index, results[entry_index], start_time, end_time);
+      trace_call_end(
+          is_traced, ipc_interface, entry->command_index, results[entry_index], end_time);
+      if (stop_on_error && az_result_failed(results[entry_index]))
       {
-        result = &(_az_ipc_cb->_internal.interface_list[i]);
+        result = results[entry_index];
+        break;
       }
-      else
+    }
+    leave_interface(ipc_interface, epoch);
+
+    if (result != AZ_OK)
+    {
+      for (entry_index++; entry_index < entries_size; entry_index++)
       {
-        if (result->interface_descriptor->_internal.version
-            > _az_ipc_cb->_internal.interface_list[i].interface_descriptor->_internal.version)
-        {
-          result = &(_az_ipc_cb->_internal.interface_list[i]);
-        }
+        results[entry_index] = AZ_ERROR_CANCELED;
       }
     }
   }
+  else
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
 
   return result;
 }
 
-static _az_ulib_ipc_interface* find_interface_descriptor(
-    const az_ulib_interface_descriptor* interface_descriptor)
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+AZ_NODISCARD az_result az_ulib_ipc_call_async(
+    az_ulib_ipc_interface_handle interface_handle,
+    az_ulib_capability_index command_index,
+    az_ulib_model_in model_in,
+    az_ulib_model_out model_out,
+    az_ulib_capability_result_callback result_callback,
+    az_ulib_capability_token capability_token)
 {
-  _az_ulib_ipc_interface* result = NULL;
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  _az_PRECONDITION_NOT_NULL(interface_handle);
+  _az_PRECONDITION(is_handle_in_range(interface_handle));
+  _az_PRECONDITION_NOT_NULL(result_callback);
 
-  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++)
+  az_result result;
+  _az_ulib_ipc_interface* ipc_interface = get_handle_interface(interface_handle);
+
+  // The call holds one instance of the interface up to the result_callback, so its slot cannot be
+  // reused while the call is in the queue.
+  if ((ipc_interface->interface_descriptor == NULL)
+      || (ipc_interface->generation != get_handle_generation(interface_handle)))
   {
-    if (_az_ipc_cb->_internal.interface_list[i].interface_descriptor == interface_descriptor)
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else if ((result = get_instance(ipc_interface)) == AZ_OK)
+  {
+    uint16_t async_call_index;
+
+    az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
     {
-      result = &(_az_ipc_cb->_internal.interface_list[i]);
-      break;
+      if ((async_call_index = get_first_free_async_call()) == INDEX_EMPTY)
+      {
+        result = AZ_ERROR_NOT_ENOUGH_SPACE;
+      }
+      else
+      {
+        _az_ulib_ipc_async_call* async_call
+            = &(_az_ipc_cb->_internal.async_call_list[async_call_index]);
+        async_call->ipc_interface = ipc_interface;
+        async_call->generation = get_handle_generation(interface_handle);
+        async_call->command_index = command_index;
+        async_call->model_in = model_in;
+        async_call->model_out = model_out;
+        async_call->result_callback = result_callback;
+        async_call->capability_token = capability_token;
+        async_call->state = ASYNC_CALL_QUEUED;
+
+        // The queue has the same size of the async_call_list, so it is never full here.
+        uint16_t tail = (uint16_t)(
+            (_az_ipc_cb->_internal.async_queue_head + _az_ipc_cb->_internal.async_queue_count)
+            % AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE);
+        _az_ipc_cb->_internal.async_queue[tail] = async_call_index;
+        _az_ipc_cb->_internal.async_queue_count++;
+      }
+    }
+    az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+
+    if (result == AZ_OK)
+    {
+      az_pal_os_semaphore_post(&(_az_ipc_cb->_internal.async_semaphore));
+    }
+    else
+    {
+      (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->ref_count));
     }
   }
 
   return result;
 }
 
-static _az_ulib_ipc_interface* get_first_free()
+AZ_NODISCARD az_result az_ulib_ipc_cancel_async(az_ulib_capability_token capability_token)
 {
-  _az_ulib_ipc_interface* result = NULL;
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
 
-  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++)
+  az_result result = AZ_ERROR_ITEM_NOT_FOUND;
+  long state = ASYNC_CALL_FREE;
+  _az_ulib_ipc_interface* ipc_interface = NULL;
+  uint16_t generation = 0;
+  az_ulib_capability_index command_index = 0;
+  az_ulib_model_out model_out = NULL;
+  az_ulib_capability_result_callback result_callback = NULL;
+
+  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
   {
-    if ((_az_ipc_cb->_internal.interface_list[i].interface_descriptor == NULL)
-        && (_az_ipc_cb->_internal.interface_list[i].ref_count == 0))
+    for (uint16_t i = 0; i < AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE; i++)
     {
-      result = &(_az_ipc_cb->_internal.interface_list[i]);
-      break;
+      _az_ulib_ipc_async_call* async_call = &(_az_ipc_cb->_internal.async_call_list[i]);
+      if (((async_call->state == ASYNC_CALL_QUEUED) || (async_call->state == ASYNC_CALL_RUNNING))
+          && (async_call->capability_token == capability_token))
+      {
+        state = async_call->state;
+        ipc_interface = async_call->ipc_interface;
+        generation = async_call->generation;
+        command_index = async_call->command_index;
+        model_out = async_call->model_out;
+        result_callback = async_call->result_callback;
+        if (state == ASYNC_CALL_QUEUED)
+        {
+          // The worker will drop the call when it gets it from the queue.
+          async_call->state = ASYNC_CALL_DROPPED;
+        }
+        else
+        {
+          // The running call holds one instance of the interface, so it is safe to take another
+          // one to keep the interface slot after the call ends.
+          async_call->state = ASYNC_CALL_CANCELED;
+          (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(ipc_interface->ref_count));
+        }
+        result = AZ_OK;
+        break;
+      }
     }
   }
+  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
 
-  return result;
-}
-
-static az_result get_instance(_az_ulib_ipc_interface* ipc_interface)
-{
-  az_result result;
-  if (ipc_interface->ref_count >= AZ_ULIB_CONFIG_MAX_IPC_INSTANCES)
+  if (state == ASYNC_CALL_QUEUED)
   {
-    result = AZ_ERROR_NOT_ENOUGH_SPACE;
+    result_callback(capability_token, AZ_ERROR_CANCELED, model_out);
+    (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->ref_count));
   }
-  else
+  else if (state == ASYNC_CALL_RUNNING)
   {
-    result = AZ_OK;
-    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(ipc_interface->ref_count));
+    volatile const az_ulib_interface_descriptor* interface_descriptor;
+    long epoch;
+    if ((interface_descriptor = enter_interface(ipc_interface, generation, &epoch)) != NULL)
+    {
+      const az_ulib_capability_descriptor* capability
+          = &(interface_descriptor->_internal.capability_list[command_index]);
+      if ((capability->_internal.flags == (uint8_t)AZ_ULIB_CAPABILITY_TYPE_COMMAND_ASYNC)
+          && (capability->_internal.capability_ptr_2.cancel != NULL))
+      {
+        result = capability->_internal.capability_ptr_2.cancel(capability_token);
+      }
+      leave_interface(ipc_interface, epoch);
+    }
+    (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->ref_count));
   }
+
   return result;
 }
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
 
-AZ_NODISCARD az_result az_ulib_ipc_init(az_ulib_ipc* ipc_handle)
+/*
+ * Returns the first published interface in the registry from the provided position, or the number
+ * of interfaces in the registry if there is none.
+ */
+static uint16_t get_next_published(uint16_t interface_index)
 {
-  _az_PRECONDITION_IS_NULL(_az_ipc_cb);
-  _az_PRECONDITION_NOT_NULL(ipc_handle);
+  uint16_t interface_count = get_interface_count();
 
-  _az_ipc_cb = ipc_handle;
+  while ((interface_index < interface_count)
+         && (get_ipc_interface(interface_index)->interface_descriptor == NULL))
+  {
+    interface_index++;
+  }
 
-  az_pal_os_lock_init(&(_az_ipc_cb->_internal.lock));
+  return interface_index;
+}
 
-  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++)
+/*
+ * Move the query to the next interface in the sorted index, from the query position, that exposes
+ * the capability in the query key.
+ */
+static void find_next_capability(ipc_query* query)
+{
+  uint16_t* sorted_index = get_sorted_index();
+  az_ulib_capability_index capability_index;
+
+  query->next_index = INDEX_EMPTY;
+  for (; query->position < _az_ipc_cb->_internal.sorted_count; query->position++)
   {
-    _az_ipc_cb->_internal.interface_list[i].ref_count = 0;
-#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-    _az_ipc_cb->_internal.interface_list[i].running_count = 0;
-    _az_ipc_cb->_internal.interface_list[i].running_count_low_watermark = 0;
-#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
-    _az_ipc_cb->_internal.interface_list[i].interface_descriptor = NULL;
+    _az_ulib_ipc_interface* ipc_interface = get_ipc_interface(sorted_index[query->position]);
+    // The continuation token only keeps the capability index up to 255.
+    if (find_capability(
+            ipc_interface,
+            ipc_interface->interface_descriptor,
+            query->key,
+            query->key_hash,
+            &capability_index)
+        && (capability_index <= UINT8_MAX))
+    {
+      query->next_index = sorted_index[query->position];
+      query->reserved = (uint8_t)capability_index;
+      break;
+    }
   }
-
-  return _az_ulib_ipc_query_interface_publish();
 }
 
-AZ_NODISCARD az_result az_ulib_ipc_deinit(void)
+static bool get_query_argument(az_span query, az_span key, az_span* argument)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+  bool result = (az_span_size(query) >= az_span_size(key))
+      && az_span_is_content_equal(az_span_slice(query, 0, az_span_size(key)), key);
 
-  az_result result;
+  if (result)
+  {
+    *argument = az_span_slice_to_end(query, az_span_size(key));
+  }
 
-  result = _az_ulib_ipc_query_interface_unpublish();
+  return result;
+}
 
-  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++)
+/*
+ * Parse the version range `<min>-<max>`, where both limits are optional, or `<version>`.
+ */
+static az_result parse_version_range(az_span range, az_ulib_version* min, az_ulib_version* max)
+{
+  az_result result = AZ_OK;
+  int32_t separator = az_span_find(range, AZ_SPAN_FROM_STR(QUERY_VERSION_SEPARATOR));
+
+  if (separator < 0)
   {
-    if ((_az_ipc_cb->_internal.interface_list[i].interface_descriptor != NULL)
-        || (_az_ipc_cb->_internal.interface_list[i].ref_count != 0)
-#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-        || (_az_ipc_cb->_internal.interface_list[i].running_count != 0)
-#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
-    )
+    result = az_span_atou32(range, min);
+    *max = *min;
+  }
+  else
+  {
+    az_span min_span = az_span_slice(range, 0, separator);
+    az_span max_span = az_span_slice_to_end(range, separator + 1);
+    if (az_span_size(min_span) > 0)
     {
-      // Do our best to publish IPC query the interface again.
-      (void)_az_ulib_ipc_query_interface_publish();
-      result = AZ_ERROR_ULIB_BUSY;
-      break;
+      result = az_span_atou32(min_span, min);
+    }
+    if ((result == AZ_OK) && (az_span_size(max_span) > 0))
+    {
+      result = az_span_atou32(max_span, max);
     }
   }
 
-  if (result == AZ_OK)
+  return ((result == AZ_OK) && (*min <= *max)) ? AZ_OK : AZ_ERROR_NOT_SUPPORTED;
+}
+
+/*
+ * Start the name query in the lowest version in the range, using the interface index.
+ */
+static void start_name_query(ipc_query* query, az_ulib_version min, az_ulib_version max)
+{
+  uint16_t interface_index = *find_index_bucket(query->key, hash_name(query->key));
+  uint32_t range_size = 0;
+
+  while ((interface_index != INDEX_EMPTY) && (get_ipc_interface(interface_index)->version < min))
   {
-    az_pal_os_lock_deinit(&(_az_ipc_cb->_internal.lock));
-    _az_ipc_cb = NULL;
+    interface_index = get_ipc_interface(interface_index)->next_version;
   }
+  query->next_index = interface_index;
 
-  return result;
+  if (max == UINT32_MAX)
+  {
+    query->reserved = QUERY_OPEN_RANGE;
+  }
+  else
+  {
+    while ((interface_index != INDEX_EMPTY) && (get_ipc_interface(interface_index)->version <= max)
+           && (range_size < QUERY_MAX_RANGE))
+    {
+      range_size++;
+      interface_index = get_ipc_interface(interface_index)->next_version;
+    }
+    query->reserved = (uint8_t)range_size;
+    if (range_size == 0)
+    {
+      query->next_index = INDEX_EMPTY;
+    }
+  }
 }
 
-AZ_NODISCARD az_result az_ulib_ipc_publish(
-    const az_ulib_interface_descriptor* const interface_descriptor,
-    az_ulib_ipc_interface_handle* interface_handle)
+static az_result start_query(ipc_query* query, az_span query_str)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
-  _az_PRECONDITION_NOT_NULL(interface_descriptor);
+  az_result result = AZ_OK;
+  az_ulib_version min = 0;
+  az_ulib_version max = UINT32_MAX;
 
-  az_result result;
-  _az_ulib_ipc_interface* new_interface;
+  query->query_type = 0;
+  query->reserved = 0;
+  query->key = AZ_SPAN_EMPTY;
+  query->position = 0;
 
-  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  if (az_span_size(query_str) == 0)
   {
-    if (get_interface(
-            interface_descriptor->_internal.name,
-            interface_descriptor->_internal.version,
-            AZ_ULIB_VERSION_EQUALS_TO)
-        != NULL)
+    query->query_type = QUERY_TYPE_ALL;
+    query->next_index = get_next_published(0);
+  }
+  else if (get_query_argument(query_str, AZ_SPAN_FROM_STR(QUERY_NAME_KEY), &(query->key)))
+  {
+    int32_t version_pos = az_span_find(query->key, AZ_SPAN_FROM_STR(QUERY_VERSION_KEY));
+    if (version_pos >= 0)
     {
-      // IPC shall not accept interfaces with same name and version because it cannot decided each
-      // one to retrieve when someone uses az_ulib_ipc_try_get_interface().
-      result = AZ_ERROR_ULIB_ELEMENT_DUPLICATE;
+      result = parse_version_range(
+          az_span_slice_to_end(query->key, version_pos + (int32_t)sizeof(QUERY_VERSION_KEY) - 1),
+          &min,
+          &max);
+      query->key = az_span_slice(query->key, 0, version_pos);
     }
-    else if ((new_interface = get_first_free()) == NULL)
+    if ((result == AZ_OK) && (az_span_size(query->key) > 0))
     {
-      result = AZ_ERROR_NOT_ENOUGH_SPACE;
+      query->query_type = QUERY_TYPE_NAME;
+      start_name_query(query, min, max);
     }
-    else
+  }
+  else if (get_query_argument(query_str, AZ_SPAN_FROM_STR(QUERY_PREFIX_KEY), &(query->key)))
+  {
+    if (az_span_size(query->key) <= UINT8_MAX)
     {
-      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
-          (const volatile void**)&(new_interface->interface_descriptor),
-          (const void*)interface_descriptor);
-      new_interface->ref_count = 0;
-#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-      new_interface->running_count = 0;
-      new_interface->running_count_low_watermark = 0;
-#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
-      if (interface_handle != NULL)
-      {
-        *interface_handle = new_interface;
-      }
-      result = AZ_OK;
+      query->query_type = QUERY_TYPE_PREFIX;
+      query->reserved = (uint8_t)az_span_size(query->key);
+      query->position = find_sorted_position(query->key, 0);
+      query->next_index
+          = ((query->position < _az_ipc_cb->_internal.sorted_count)
+             && has_prefix(
+                 get_ipc_interface(get_sorted_index()[query->position]), query->key))
+          ? get_sorted_index()[query->position]
+          : INDEX_EMPTY;
     }
   }
-  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+  else if (get_query_argument(query_str, AZ_SPAN_FROM_STR(QUERY_CAPABILITY_KEY), &(query->key)))
+  {
+    query->query_type = QUERY_TYPE_CAPABILITY;
+    query->key_hash = hash_name(query->key);
+    find_next_capability(query);
+  }
+
+  if ((result == AZ_OK)
+      && ((query->query_type == 0)
+          || ((query->query_type != QUERY_TYPE_ALL)
+              && (az_span_size(query->key) == 0))))
+  {
+    result = AZ_ERROR_NOT_SUPPORTED;
+  }
 
   return result;
 }
 
-#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-AZ_NODISCARD az_result az_ulib_ipc_unpublish(
-    const az_ulib_interface_descriptor* const interface_descriptor,
-    uint32_t wait_option_ms)
+/*
+ * Returns the stamp of the next interface in the continuation token. The query in all interfaces
+ * only needs the position in the registry, so it does not have a stamp.
+ */
+static uint32_t get_query_stamp(const ipc_query* query, const _az_ulib_ipc_interface* ipc_interface)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
-  _az_PRECONDITION_NOT_NULL(interface_descriptor);
+  uint32_t stamp = 0;
 
-  az_result result;
-  _az_ulib_ipc_interface* release_interface;
+  if ((query->query_type == QUERY_TYPE_NAME) && (query->reserved != QUERY_OPEN_RANGE))
+  {
+    stamp = ipc_interface->name_generation;
+  }
+  else if (query->query_type != QUERY_TYPE_ALL)
+  {
+    stamp = ipc_interface->publish_generation;
+  }
 
-  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  return stamp & QUERY_STAMP_MASK;
+}
+
+/*
+ * Rebuild the query from the continuation token. The prefix and the capability name are part of
+ * the next interface to report, so the token does not need to keep them. The stamp of the next
+ * interface shall be the same as in the token, otherwise it may not be the same interface anymore,
+ * or, for a name with a limited version range, a new version may be in the range. The changes in
+ * the other interfaces do not affect the query.
+ */
+static az_result resume_query(ipc_query* query, uint32_t continuation_token)
+{
+  az_result result = AZ_OK;
+  _az_ulib_ipc_interface* ipc_interface = NULL;
+  volatile const az_ulib_interface_descriptor* interface_descriptor = NULL;
+  uint32_t position = (continuation_token >> QUERY_POSITION_SHIFT) & QUERY_POSITION_MASK;
+  bool is_lost = false;
+
+  query->query_type = (uint8_t)(continuation_token & QUERY_TYPE_MASK);
+  query->reserved = (uint8_t)((continuation_token >> QUERY_RESERVED_SHIFT) & QUERY_RESERVED_MASK);
+  query->next_index = (position == QUERY_POSITION_MASK) ? INDEX_EMPTY : (uint16_t)position;
+  if (query->next_index < get_interface_count())
   {
-    if ((release_interface = find_interface_descriptor(interface_descriptor)) == NULL)
-    {
-      result = AZ_ERROR_ITEM_NOT_FOUND;
-    }
-    else
-    {
-      // The order of the code here, including the ones that looks not necessary, are associated to
-      // the interlock between this function and the az_ulib_ipc_call.
+    ipc_interface = get_ipc_interface(query->next_index);
+    interface_descriptor = ipc_interface->interface_descriptor;
+  }
+  if ((query->query_type != QUERY_TYPE_ALL) && (query->next_index != INDEX_EMPTY))
+  {
+    is_lost = (interface_descriptor == NULL)
+        || (get_query_stamp(query, ipc_interface) != (continuation_token >> QUERY_STAMP_SHIFT));
+  }
 
-      // Block access to this interface. After this point, any new call to az_ulib_ipc_call that
-      // didn't get the interface pointer yet will return AZ_ERROR_ITEM_NOT_FOUND.
-      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
-          (const volatile void**)(&(release_interface->interface_descriptor)), (const void*)NULL);
+  switch (query->query_type)
+  {
+    case QUERY_TYPE_ALL:
+      query->next_index = get_next_published(query->next_index);
+      break;
+    case QUERY_TYPE_NAME:
+      if (is_lost)
+      {
+        result = AZ_ERROR_ITEM_NOT_FOUND;
+      }
+      break;
+    case QUERY_TYPE_PREFIX:
+      if (is_lost)
+      {
+        result = AZ_ERROR_ITEM_NOT_FOUND;
+      }
+      else if (
+          (interface_descriptor == NULL)
+          || (az_span_size(ipc_interface->name) < query->reserved))
+      {
+        query->next_index = INDEX_EMPTY;
+      }
+      else
+      {
+        query->key = az_span_slice(ipc_interface->name, 0, query->reserved);
+        query->position = find_sorted_position(ipc_interface->name, ipc_interface->version);
+      }
+      break;
+    case QUERY_TYPE_CAPABILITY:
+      if (is_lost)
+      {
+        result = AZ_ERROR_ITEM_NOT_FOUND;
+      }
+      else if (
+          (interface_descriptor == NULL)
+          || (query->reserved >= interface_descriptor->_internal.size))
+      {
+        query->next_index = INDEX_EMPTY;
+      }
+      else
+      {
+        query->key = interface_descriptor->_internal.capability_list[query->reserved]
+                         ._internal.name;
+        query->key_hash = hash_name(query->key);
+        query->position = find_sorted_position(ipc_interface->name, ipc_interface->version);
+      }
+      break;
+    default:
+      result = AZ_ERROR_NOT_SUPPORTED;
+      break;
+  }
 
-      // If the running_count is `0` is because no other process is inside of any of the functions
-      // commands, and they may be removed from the memory. There will be the case that the other
-      // process is already in the az_ulib_ipc_call, in the direction to call a command in this
-      // interface, but the call will just return AZ_ERROR_ITEM_NOT_FOUND from there.
-      uint32_t retry_interval;
-      if (wait_option_ms == AZ_ULIB_WAIT_FOREVER)
+  return result;
+}
+
+/*
+ * Move the query to the interface after the one in the continuation token.
+ */
+static void move_query_next(ipc_query* query)
+{
+  uint16_t interface_index = query->next_index;
+
+  switch (query->query_type)
+  {
+    case QUERY_TYPE_ALL:
+      query->next_index = get_next_published((uint16_t)(interface_index + 1));
+      break;
+    case QUERY_TYPE_NAME:
+      if ((query->reserved != QUERY_OPEN_RANGE)
+          && (--(query->reserved) == 0))
       {
-        retry_interval = 100;
+        query->next_index = INDEX_EMPTY;
       }
       else
       {
-        retry_interval = wait_option_ms >> 3;
-        if (retry_interval == 0)
-        {
-          retry_interval = 1;
-        }
+        query->next_index = get_ipc_interface(interface_index)->next_version;
       }
+      break;
+    case QUERY_TYPE_PREFIX:
+      query->position++;
+      query->next_index
+          = ((query->position < _az_ipc_cb->_internal.sorted_count)
+             && has_prefix(
+                 get_ipc_interface(get_sorted_index()[query->position]), query->key))
+          ? get_sorted_index()[query->position]
+          : INDEX_EMPTY;
+      break;
+    default:
+      query->position++;
+      find_next_capability(query);
+      break;
+  }
+}
 
-      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
-          &(release_interface->running_count_low_watermark), release_interface->running_count);
-      uint32_t retry_total_time = 0;
+/*
+ * Returns the number of bytes to write the name as the content of a JSON string, and copies it to
+ * the destination if it is not NULL.
+ */
+static int32_t copy_json_escaped(char* destination, az_span name)
+{
+  static const char hex_digits[] = "0123456789ABCDEF";
+  const uint8_t* name_ptr = az_span_ptr(name);
+  int32_t name_size = az_span_size(name);
+  int32_t size = 0;
 
-      // A semaphore here would be more efficient, but it would force a synchronization between
-      // az_ulib_ipc_call and az_ulib_ipc_unpublish that would add extra code on az_ulib_ipc_call,
-      // making it heavier. On the other hand, there is no expectations about heavy usage of the
-      // function az_ulib_ipc_unpublish, in many applications, it will not be used at all. So, we
-      // decided to open an exception here and use a busy loop on the az_ulib_ipc_unpublish
-      // instead of a semaphore.
-      while ((retry_total_time < wait_option_ms)
-             && (release_interface->running_count_low_watermark != 0))
+  for (int32_t i = 0; i < name_size; i++)
+  {
+    uint8_t ch = name_ptr[i];
+    if ((ch == '"') || (ch == '\\'))
+    {
+      if (destination != NULL)
       {
-
-        az_pal_os_sleep(retry_interval);
-
-        if (wait_option_ms != AZ_ULIB_WAIT_FOREVER)
-        {
-          retry_total_time += retry_interval;
-        }
+        destination[size] = '\\';
+        destination[size + 1] = (char)ch;
       }
-
-      if (release_interface->running_count_low_watermark == 0)
+      size += 2;
+    }
+    else if (ch < 0x20)
+    {
+      if (destination != NULL)
       {
-        result = AZ_OK;
+        (void)memcpy(&(destination[size]), "\\u00", 4);
+        destination[size + 4] = hex_digits[ch >> 4];
+        destination[size + 5] = hex_digits[ch & 0x0F];
       }
-      else
+      size += 6;
+    }
+    else
+    {
+      if (destination != NULL)
       {
-        // If caller doesn't want to wait anymore, recover the interface and return
-        // AZ_ERROR_ULIB_BUSY.
-        (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
-            (const volatile void**)(&(release_interface->interface_descriptor)),
-            (const void*)interface_descriptor);
-        result = AZ_ERROR_ULIB_BUSY;
+        destination[size] = (char)ch;
       }
+      size++;
     }
   }
-  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
 
-  return result;
+  return size;
 }
-#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
 
-AZ_NODISCARD az_result az_ulib_ipc_try_get_interface(
-    az_span name,
-    az_ulib_version version,
-    az_ulib_version_match_criteria match_criteria,
-    az_ulib_ipc_interface_handle* interface_handle)
+static az_result append_interface(
+    const _az_ulib_ipc_interface* ipc_interface,
+    char* result_str,
+    int32_t result_size,
+    int32_t* pos)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
-  _az_PRECONDITION_VALID_SPAN(name, 1, false);
-  _az_PRECONDITION_NOT_NULL(interface_handle);
-
   az_result result;
-  _az_ulib_ipc_interface* ipc_interface;
+  int32_t name_size = copy_json_escaped(NULL, ipc_interface->name);
+  char version_str[12];
+  az_span version_span = AZ_SPAN_FROM_BUFFER(version_str);
+  az_span reminder;
 
-  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  if ((result = az_span_u32toa(version_span, ipc_interface->version, &reminder)) == AZ_OK)
   {
-    if ((ipc_interface = get_interface(name, version, match_criteria)) == NULL)
+    int32_t version_size = az_span_size(version_span) - az_span_size(reminder);
+    int32_t separator_size = (*pos == 0) ? 0 : 1;
+
+    // 3 = '"', '.' and '"'
+    if (separator_size + name_size + version_size + 3 > result_size - *pos)
     {
-      result = AZ_ERROR_ITEM_NOT_FOUND;
+      result = AZ_ERROR_NOT_ENOUGH_SPACE;
     }
-    else if ((result = get_instance(ipc_interface)) == AZ_OK)
+    else
     {
-      *interface_handle = ipc_interface;
+      if (separator_size != 0)
+      {
+        result_str[(*pos)++] = ',';
+      }
+      result_str[(*pos)++] = '"';
+      *pos += copy_json_escaped(&(result_str[*pos]), ipc_interface->name);
+      result_str[(*pos)++] = '.';
+      memcpy(&(result_str[*pos]), version_str, (size_t)version_size);
+      *pos += version_size;
+      result_str[(*pos)++] = '"';
     }
   }
-  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
 
   return result;
 }
 
-AZ_NODISCARD az_result az_ulib_ipc_try_get_capability(
-    az_ulib_ipc_interface_handle interface_handle,
-    az_span name,
-    az_ulib_capability_index* capability_index)
+/*
+ * Report the interfaces in the query from the one in the continuation token, up to the first one
+ * that does not fit in the result, which will be the next in the continuation token.
+ */
+static az_result report_query(ipc_query* query, az_span* result, uint32_t* continuation_token)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
-  _az_PRECONDITION_NOT_NULL(interface_handle);
-  _az_PRECONDITION_VALID_SPAN(name, 1, false);
-  _az_PRECONDITION_NOT_NULL(capability_index);
-
-  az_result result;
-  _az_ulib_ipc_interface* ipc_interface = (_az_ulib_ipc_interface*)interface_handle;
+  char* result_str = (char*)az_span_ptr(*result);
+  int32_t result_size = az_span_size(*result);
+  int32_t pos = 0;
 
-  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  az_result res = AZ_ULIB_EOF;
+  while (query->next_index < get_interface_count())
   {
-    result = AZ_ERROR_ITEM_NOT_FOUND;
-    if (ipc_interface->interface_descriptor != NULL)
+    if ((res = append_interface(
+             get_ipc_interface(query->next_index), result_str, result_size, &pos))
+        != AZ_OK)
     {
-      for (az_ulib_capability_index index = 0;
-           index < ipc_interface->interface_descriptor->_internal.size;
-           index++)
+      if ((res == AZ_ERROR_NOT_ENOUGH_SPACE) && (pos != 0))
       {
-        if (az_span_is_content_equal(
-                name,
-                ipc_interface->interface_descriptor->_internal.capability_list[index]
-                    ._internal.name))
-        {
-          *capability_index = index;
-          result = AZ_OK;
-          break;
-        }
+        res = AZ_OK;
       }
+      break;
     }
+    move_query_next(query);
   }
-  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
 
-  return result;
+  if (res == AZ_OK)
+  {
+    // The query in all interfaces may end in the position after the last interface.
+    uint32_t position
+        = (query->next_index == INDEX_EMPTY) ? QUERY_POSITION_MASK : query->next_index;
+    uint32_t stamp = (query->next_index < get_interface_count())
+        ? get_query_stamp(query, get_ipc_interface(query->next_index))
+        : 0;
+    *continuation_token = query->query_type | ((uint32_t)query->reserved << QUERY_RESERVED_SHIFT)
+        | (position << QUERY_POSITION_SHIFT) | (stamp << QUERY_STAMP_SHIFT);
+    *result = az_span_create((uint8_t*)result_str, pos);
+  }
+
+  return res;
 }
 
-AZ_NODISCARD az_result az_ulib_ipc_get_interface(
-    az_ulib_ipc_interface_handle original_interface_handle,
-    az_ulib_ipc_interface_handle* interface_handle)
+AZ_NODISCARD az_result
+az_ulib_ipc_query(az_span query, az_span* result, uint32_t* continuation_token)
 {
   _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
-  _az_PRECONDITION_NOT_NULL(original_interface_handle);
-  _az_PRECONDITION_NOT_NULL(interface_handle);
-
-  az_result result;
+  _az_PRECONDITION_NOT_NULL(result);
+  _az_PRECONDITION_VALID_SPAN(*result, 1, false);
+  _az_PRECONDITION_NOT_NULL(continuation_token);
+  az_result res;
+  ipc_query running_query;
 
   az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
   {
-    _az_ulib_ipc_interface* ipc_interface = original_interface_handle;
-    if (ipc_interface->interface_descriptor == NULL)
-    {
-      result = AZ_ERROR_ITEM_NOT_FOUND;
-    }
-    else if ((result = get_instance(ipc_interface)) == AZ_OK)
+    if ((res = start_query(&running_query, query)) == AZ_OK)
     {
-      *interface_handle = ipc_interface;
+      res = report_query(&running_query, result, continuation_token);
     }
   }
   az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
 
-  return result;
+  return res;
 }
 
-AZ_NODISCARD az_result az_ulib_ipc_release_interface(az_ulib_ipc_interface_handle interface_handle)
+AZ_NODISCARD az_result az_ulib_ipc_query_next(uint32_t* continuation_token, az_span* result)
 {
   _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
-  _az_PRECONDITION_NOT_NULL(interface_handle);
-
-  _az_ulib_ipc_interface* ipc_interface = (_az_ulib_ipc_interface*)interface_handle;
-  az_result result;
+  _az_PRECONDITION_NOT_NULL(result);
+  _az_PRECONDITION_VALID_SPAN(*result, 1, false);
+  _az_PRECONDITION_NOT_NULL(continuation_token);
+  az_result res;
+  ipc_query running_query;
 
   az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
   {
-    if (ipc_interface->ref_count == 0)
+    if ((res = resume_query(&running_query, *continuation_token)) == AZ_OK)
     {
-      result = AZ_ERROR_ULIB_PRECONDITION;
-    }
-    else
-    {
-      result = AZ_OK;
-      ipc_interface->ref_count--;
+      res = report_query(&running_query, result, continuation_token);
     }
   }
   az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
 
-  return result;
+  return res;
 }
 
-AZ_NODISCARD az_result az_ulib_ipc_call(
+AZ_NODISCARD uint32_t az_ulib_ipc_get_generation(void)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
+
+  return _az_ipc_cb->_internal.generation;
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+AZ_NODISCARD az_result az_ulib_ipc_get_stats(
     az_ulib_ipc_interface_handle interface_handle,
-    az_ulib_capability_index command_index,
-    az_ulib_model_in model_in,
-    az_ulib_model_out model_out)
+    az_ulib_capability_index capability_index,
+    az_ulib_ipc_capability_stats* stats)
 {
   _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
   _az_PRECONDITION_NOT_NULL(interface_handle);
+  _az_PRECONDITION(is_handle_in_range(interface_handle));
+  _az_PRECONDITION_NOT_NULL(stats);
 
   az_result result;
-  _az_ulib_ipc_interface* ipc_interface = (_az_ulib_ipc_interface*)interface_handle;
+  _az_ulib_ipc_interface* ipc_interface = get_handle_interface(interface_handle);
+  volatile const az_ulib_interface_descriptor* interface_descriptor;
+  long epoch;
 
-#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-  // The double test on the interface_descriptor is part of the interlock between az_ulib_ipc_call
-  // and az_ulib_ipc_unpublish. It will allow a interface to be unpublished even if it has a high
-  // volume of calls.
-  if (ipc_interface->interface_descriptor != NULL)
+  if ((interface_descriptor
+       = enter_interface(ipc_interface, get_handle_generation(interface_handle), &epoch))
+      == NULL)
   {
-    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(ipc_interface->running_count));
-
-    if (ipc_interface->interface_descriptor == NULL)
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    if (capability_index >= interface_descriptor->_internal.size)
     {
       result = AZ_ERROR_ITEM_NOT_FOUND;
     }
-    else
+    else if (capability_index >= AZ_ULIB_CONFIG_IPC_STATS_MAX_CAPABILITIES)
     {
-#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
-      result = ipc_interface->interface_descriptor->_internal.capability_list[command_index]
-                   ._internal.capability_ptr_1.command(model_in, model_out);
-#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+      result = AZ_ERROR_NOT_SUPPORTED;
     }
-    long new_running_count = AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->running_count));
-    if (new_running_count < ipc_interface->running_count_low_watermark)
+    else
     {
-      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
-          &(ipc_interface->running_count_low_watermark), new_running_count);
+      stats->name
+          = interface_descriptor->_internal.capability_list[capability_index]._internal.name;
+      stats->call_count = 0;
+      stats->error_count = 0;
+      for (size_t bucket = 0; bucket < AZ_ULIB_CONFIG_IPC_STATS_LATENCY_BUCKETS; bucket++)
+      {
+        stats->latency_histogram[bucket] = 0;
+      }
+      for (size_t i = 0; i < _AZ_ULIB_IPC_RUNNING_SHARDS; i++)
+      {
+        _az_ulib_ipc_capability_counters* counters
+            = &(ipc_interface->stats_shard_list[i].capability_list[capability_index]);
+        stats->call_count += (uint32_t)counters->call_count;
+        stats->error_count += (uint32_t)counters->error_count;
+        for (size_t bucket = 0; bucket < AZ_ULIB_CONFIG_IPC_STATS_LATENCY_BUCKETS; bucket++)
+        {
+          stats->latency_histogram[bucket] += (uint32_t)counters->latency_histogram[bucket];
+        }
+      }
+      result = AZ_OK;
     }
+    leave_interface(ipc_interface, epoch);
   }
-  else
-  {
-    result = AZ_ERROR_ITEM_NOT_FOUND;
-  }
-#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
 
   return result;
 }
+#endif // AZ_ULIB_CONFIG_IPC_STATS
 
-AZ_NODISCARD az_result az_ulib_ipc_call_with_str(
-    az_ulib_ipc_interface_handle interface_handle,
-    az_ulib_capability_index command_index,
-    az_span model_in_span,
-    az_span* model_out_span)
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+void az_ulib_ipc_trace_enable(bool enable)
 {
   _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
-  _az_PRECONDITION_NOT_NULL(interface_handle);
-
-  az_result result = AZ_OK;
-  _az_ulib_ipc_interface* ipc_interface = (_az_ulib_ipc_interface*)interface_handle;
-
-#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-  // The double test on the interface_descriptor is part of the interlock between az_ulib_ipc_call
-  // and az_ulib_ipc_unpublish. It will allow a interface to be unpublished even if it has a high
-  // volume of calls.
-  if (ipc_interface->interface_descriptor != NULL)
-  {
-    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(ipc_interface->running_count));
-    if (ipc_interface->interface_descriptor == NULL)
-    {
-      result = AZ_ERROR_ITEM_NOT_FOUND;
-    }
-    else
-    {
-#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
 
-      if (ipc_interface->interface_descriptor->_internal.capability_list[command_index]
-              ._internal.span_wrapper_ptr_1.command
-          != NULL)
-      {
-        result = ipc_interface->interface_descriptor->_internal.capability_list[command_index]
-                     ._internal.span_wrapper_ptr_1.command(model_in_span, model_out_span);
-      }
-      else
-      {
-        result = AZ_ERROR_NOT_SUPPORTED;
-      }
+  (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(_az_ipc_cb->_internal.trace_enabled), enable ? 1 : 0);
+}
 
-#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-    }
+static az_span get_trace_category(uint8_t type)
+{
+  az_span category;
 
-    long new_running_count = AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->running_count));
-    if (new_running_count < ipc_interface->running_count_low_watermark)
-    {
-      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
-          &(ipc_interface->running_count_low_watermark), new_running_count);
-    }
-  }
-  else
+  switch (type)
   {
-    result = AZ_ERROR_ITEM_NOT_FOUND;
+    case TRACE_PUBLISH:
+      category = AZ_SPAN_FROM_STR("publish");
+      break;
+    case TRACE_UNPUBLISH:
+      category = AZ_SPAN_FROM_STR("unpublish");
+      break;
+    case TRACE_REPLACE:
+      category = AZ_SPAN_FROM_STR("replace");
+      break;
+    default:
+      category = AZ_SPAN_FROM_STR("call");
+      break;
   }
-#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
 
-  return result;
+  return category;
 }
 
-static az_result report_interfaces(uint16_t start, az_span* result, uint16_t* next)
+static az_span get_trace_phase(uint8_t type)
 {
-  char* result_str = (char*)az_span_ptr(*result);
-  int32_t result_size = az_span_size(*result);
-  int32_t pos = 0;
-  uint16_t interface_index;
-
-  az_result res = AZ_ULIB_EOF;
-  for (interface_index = start; interface_index < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE;
-       interface_index++)
-  {
-    if (_az_ipc_cb->_internal.interface_list[interface_index].interface_descriptor != NULL)
-    {
-      int32_t next_size = az_span_size(_az_ipc_cb->_internal.interface_list[interface_index]
-                                           .interface_descriptor->_internal.name);
-      char version_str[12];
-      az_span version_span = AZ_SPAN_FROM_BUFFER(version_str);
-      az_span reminder;
-      if ((res = az_span_u32toa(
-               version_span,
-               _az_ipc_cb->_internal.interface_list[interface_index]
-                   .interface_descriptor->_internal.version,
-               &reminder))
-          == AZ_OK)
-      {
-        int32_t next_version_size = az_span_size(version_span) - az_span_size(reminder);
-        if (pos == 0)
-        {
-          if (next_size + next_version_size + 3 > result_size) // 3 = '"', '.' and '"'
-          {
-            res = AZ_ERROR_NOT_ENOUGH_SPACE;
-            break;
-          }
-        }
-        else
-        {
-          if (next_size + 4 + next_version_size > result_size - pos) // 4 = ',', '"', '.' and '"'
-          {
-            break;
-          }
-          else
-          {
-            result_str[pos++] = ',';
-          }
-        }
+  az_span phase;
 
-        res = AZ_OK;
-        result_str[pos++] = '"';
-        memcpy(
-            &(result_str[pos]),
-            az_span_ptr(_az_ipc_cb->_internal.interface_list[interface_index]
-                            .interface_descriptor->_internal.name),
-            (size_t)next_size);
-        pos += next_size;
-        result_str[pos++] = '.';
-        memcpy(&(result_str[pos]), az_span_ptr(version_span), (size_t)next_version_size);
-        pos += next_version_size;
-        result_str[pos++] = '"';
-      }
-      else
-      {
-        break;
-      }
-    }
+  switch (type)
+  {
+    case TRACE_CALL_BEGIN:
+      phase = AZ_SPAN_FROM_STR("B");
+      break;
+    case TRACE_CALL_END:
+      phase = AZ_SPAN_FROM_STR("E");
+      break;
+    default:
+      phase = AZ_SPAN_FROM_STR("i");
+      break;
   }
 
-  if (res == AZ_OK)
+  return phase;
+}
+
+static az_result append_trace_event(az_json_writer* jw, _az_ulib_ipc_trace_event* event)
+{
+  AZ_ULIB_TRY
   {
-    *next = interface_index;
-    *result = az_span_create((uint8_t*)result_str, pos);
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_object(jw));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("name")));
+    AZ_ULIB_THROW_IF_AZ_ERROR(
+        az_json_writer_append_string(jw, az_span_create(event->name, event->name_size)));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("cat")));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_string(jw, get_trace_category(event->type)));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("ph")));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_string(jw, get_trace_phase(event->type)));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("ts")));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_double(jw, (double)event->timestamp, 0));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("pid")));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_int32(jw, 1));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("tid")));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_int32(jw, (int32_t)event->thread_id));
+    if ((event->type == TRACE_PUBLISH) || (event->type == TRACE_UNPUBLISH))
+    {
+      // Instant events in the thread scope.
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("s")));
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_string(jw, AZ_SPAN_FROM_STR("t")));
+    }
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("args")));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_object(jw));
+    AZ_ULIB_THROW_IF_AZ_ERROR(
+        az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("version")));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_double(jw, (double)event->version, 0));
+    if ((event->type == TRACE_CALL_BEGIN) || (event->type == TRACE_CALL_END))
+    {
+      AZ_ULIB_THROW_IF_AZ_ERROR(
+          az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("capability")));
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_int32(jw, event->capability_index));
+    }
+    if (event->type != TRACE_CALL_BEGIN)
+    {
+      AZ_ULIB_THROW_IF_AZ_ERROR(
+          az_json_writer_append_property_name(jw, AZ_SPAN_FROM_STR("result")));
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_int32(jw, (int32_t)event->result));
+    }
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_object(jw));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_object(jw));
   }
+  AZ_ULIB_CATCH(...) {}
 
-  return res;
+  return AZ_ULIB_TRY_RESULT;
 }
 
-AZ_NODISCARD az_result
-az_ulib_ipc_query(az_span query, az_span* result, uint32_t* continuation_token)
+/*
+ * Append the events in the ring from the oldest to the newest. The event is copied, and the copy
+ * is only used if the writers did not touch the event while it was copied.
+ */
+static az_result append_trace_ring(az_json_writer* jw, unsigned long ring_index)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
-  _az_PRECONDITION_NOT_NULL(result);
-  _az_PRECONDITION_VALID_SPAN(*result, 1, false);
-  _az_PRECONDITION_NOT_NULL(continuation_token);
-  az_result res;
+  _az_ulib_ipc_trace_ring* ring = &(_az_ipc_cb->_internal.trace_ring_list[ring_index]);
+  long head = ring->head;
+  long sequence = (head > AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE)
+      ? (head - AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE + 1)
+      : 1;
+  az_result result = AZ_OK;
 
-  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  for (; (sequence <= head) && (result == AZ_OK); sequence++)
   {
-    ipc_continuation_token* token = (ipc_continuation_token*)continuation_token;
-
-    if (az_span_size(query) == 0)
+    volatile _az_ulib_ipc_trace_event* event
+        = &(ring->event_list[((unsigned long)sequence - 1) & TRACE_RING_MASK]);
+    _az_ulib_ipc_trace_event copy;
+    copy.sequence = event->sequence;
+    copy.name_size = event->name_size;
+    if (copy.name_size > AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE)
     {
-      if ((res = report_interfaces(0, result, &(token->fields.count))) == AZ_OK)
-      {
-        token->fields.query_type = 0xFF;
-        token->fields.reserved = 0;
-      }
+      copy.name_size = AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE;
     }
-    else
+    for (uint8_t i = 0; i < copy.name_size; i++)
+    {
+      copy.name[i] = event->name[i];
+    }
+    copy.thread_id = event->thread_id;
+    copy.version = event->version;
+    copy.timestamp = event->timestamp;
+    copy.result = event->result;
+    copy.capability_index = event->capability_index;
+    copy.type = event->type;
+    if ((copy.sequence == sequence) && (event->sequence == sequence))
     {
-      res = AZ_ERROR_NOT_SUPPORTED;
+      result = append_trace_event(jw, &copy);
     }
   }
-  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
 
-  return res;
+  return result;
 }
 
-AZ_NODISCARD az_result az_ulib_ipc_query_next(uint32_t* continuation_token, az_span* result)
+AZ_NODISCARD az_result az_ulib_ipc_trace_dump(az_span* trace)
 {
   _az_PRECONDITION_NOT_NULL(_az_ipc_cb);
-  _az_PRECONDITION_NOT_NULL(result);
-  _az_PRECONDITION_VALID_SPAN(*result, 1, false);
-  _az_PRECONDITION_NOT_NULL(continuation_token);
-  az_result res;
+  _az_PRECONDITION_NOT_NULL(trace);
 
-  az_pal_os_lock_acquire(&(_az_ipc_cb->_internal.lock));
+  AZ_ULIB_TRY
   {
-    ipc_continuation_token* token = (ipc_continuation_token*)continuation_token;
-
-    if (token->fields.query_type == 0xFF)
-    {
-      res = report_interfaces(token->fields.count, result, &(token->fields.count));
-    }
-    else
+    az_json_writer jw;
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_init(&jw, *trace, NULL));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_object(&jw));
+    AZ_ULIB_THROW_IF_AZ_ERROR(
+        az_json_writer_append_property_name(&jw, AZ_SPAN_FROM_STR("traceEvents")));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_array(&jw));
+    for (unsigned long i = 0; (i < _AZ_ULIB_IPC_RUNNING_SHARDS) && (AZ_ULIB_TRY_RESULT == AZ_OK);
+         i++)
     {
-      res = AZ_ERROR_NOT_SUPPORTED;
+      AZ_ULIB_TRY_RESULT = append_trace_ring(&jw, i);
     }
+    AZ_ULIB_THROW_IF_AZ_ERROR(AZ_ULIB_TRY_RESULT);
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_array(&jw));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_object(&jw));
+    *trace = az_json_writer_get_bytes_used_in_destination(&jw);
   }
-  az_pal_os_lock_release(&(_az_ipc_cb->_internal.lock));
+  AZ_ULIB_CATCH(...) {}
 
-  return res;
+  return AZ_ULIB_TRY_RESULT;
 }
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
 
 static const az_ulib_ipc_vtable _vtable = { az_ulib_ipc_publish,
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
                                             az_ulib_ipc_unpublish,
+#else
+                                            NULL,
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
                                             az_ulib_ipc_try_get_interface,
                                             az_ulib_ipc_try_get_capability,
                                             az_ulib_ipc_get_interface,
@@ -679,6 +3464,31 @@ static const az_ulib_ipc_vtable _vtable = { az_ulib_ipc_publish,
                                             az_ulib_ipc_call,
                                             az_ulib_ipc_call_with_str,
                                             az_ulib_ipc_query,
-                                            az_ulib_ipc_query_next };
+                                            az_ulib_ipc_query_next,
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+                                            az_ulib_ipc_call_async,
+                                            az_ulib_ipc_cancel_async,
+#else
+                                            NULL,
+                                            NULL,
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+                                            az_ulib_ipc_call_batch,
+                                            az_ulib_ipc_call_with_binary,
+                                            az_ulib_ipc_subscribe,
+                                            az_ulib_ipc_unsubscribe,
+                                            az_ulib_ipc_get_generation,
+                                            az_ulib_ipc_replace,
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+                                            az_ulib_ipc_get_contract,
+                                            az_ulib_ipc_try_get_interface_with_contract,
+#else
+                                            NULL,
+                                            NULL,
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+                                            az_ulib_ipc_wait_replaced };
+#else
+                                            NULL };
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
 
 const az_ulib_ipc_vtable* az_ulib_ipc_get_vtable(void) { return &_vtable; }
@@ -31,58 +31,58 @@ static az_result query_1_query_concrete(az_ulib_model_in model_in, az_ulib_model
   return az_ulib_ipc_query(in->query, out->result, &(out->continuation_token));
 }
 
-AZ_INLINE int32_t model_out_span_min_size(void)
+#define MODEL_OUT_JSON_BEGIN "{\"" QUERY_1_QUERY_RESULT_NAME "\":["
+#define MODEL_OUT_JSON_CONTINUATION_TOKEN "],\"" QUERY_1_QUERY_CONTINUATION_TOKEN_NAME "\":"
+#define MODEL_OUT_JSON_END "}"
+
+/*
+ * The query result is already a list of JSON strings, so the IPC writes it straight in the
+ * model_out_span, between the beginning of the JSON and the space reserved for the end of it.
+ */
+AZ_INLINE int32_t model_out_span_end_size(void)
 {
   return (int32_t)(
-      2 + // {}
-      sizeof(QUERY_1_NEXT_RESULT_NAME) + 6 + // "result":[],
-      sizeof(QUERY_1_NEXT_CONTINUATION_TOKEN_NAME) + 13 + //"continuation_token":4294967295
-      64); // az_json_writer requires a leftover of _az_MINIMUM_STRING_CHUNK_SIZE to properly work.
+      sizeof(MODEL_OUT_JSON_CONTINUATION_TOKEN) - 1 + // ],"continuation_token":
+      10 + // 4294967295
+      sizeof(MODEL_OUT_JSON_END) - 1); // }
 }
 
-static az_result marshalling_model_out_to_json(
-    query_1_query_model_out* model_out,
-    az_span* model_out_span)
+static az_result begin_model_out_json(az_span model_out_span, az_span* result)
 {
-  AZ_ULIB_TRY
+  int32_t begin_size = (int32_t)sizeof(MODEL_OUT_JSON_BEGIN) - 1;
+  az_result res;
+
+  if (az_span_size(model_out_span) <= begin_size + model_out_span_end_size())
   {
-    az_json_writer jw;
-    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_init(&jw, *model_out_span, NULL));
-    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_object(&jw));
-    AZ_ULIB_THROW_IF_AZ_ERROR(
-        az_json_writer_append_property_name(&jw, AZ_SPAN_FROM_STR(QUERY_1_QUERY_RESULT_NAME)));
-
-    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_array(&jw));
-
-    az_span remaining
-        = az_span_create(az_span_ptr(*(model_out->result)), az_span_size(*(model_out->result)));
-    int32_t split_pos = az_span_find(remaining, AZ_SPAN_FROM_STR(","));
-    while (split_pos != -1)
-    {
-      az_span interface_name = az_span_slice(remaining, 1, split_pos - 1);
-      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_string(&jw, interface_name));
-      remaining = az_span_slice_to_end(remaining, split_pos + 1);
-      split_pos = az_span_find(remaining, AZ_SPAN_FROM_STR(","));
-    }
-    AZ_ULIB_THROW_IF_AZ_ERROR(AZ_ULIB_TRY_RESULT);
-    if (az_span_size(remaining) > 0)
-    {
-      az_span interface_name = az_span_slice(remaining, 1, az_span_size(remaining) - 1);
-      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_string(&jw, interface_name));
-    }
+    res = AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+  else
+  {
+    az_span_copy(model_out_span, AZ_SPAN_FROM_STR(MODEL_OUT_JSON_BEGIN));
+    *result = az_span_slice(
+        model_out_span, begin_size, az_span_size(model_out_span) - model_out_span_end_size());
+    res = AZ_OK;
+  }
 
-    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_array(&jw));
+  return res;
+}
 
-    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(
-        &jw, AZ_SPAN_FROM_STR(QUERY_1_QUERY_CONTINUATION_TOKEN_NAME)));
-    AZ_ULIB_THROW_IF_AZ_ERROR(
-        az_json_writer_append_int32(&jw, (int32_t)model_out->continuation_token));
-    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_object(&jw));
-    *model_out_span = az_json_writer_get_bytes_used_in_destination(&jw);
+static az_result end_model_out_json(query_1_query_model_out* model_out, az_span* model_out_span)
+{
+  int32_t begin_size = (int32_t)sizeof(MODEL_OUT_JSON_BEGIN) - 1;
+  az_span remaining = az_span_slice_to_end(*model_out_span, begin_size);
+  az_result res;
+
+  remaining = az_span_slice_to_end(remaining, az_span_size(*(model_out->result)));
+  remaining = az_span_copy(remaining, AZ_SPAN_FROM_STR(MODEL_OUT_JSON_CONTINUATION_TOKEN));
+  if ((res = az_span_u32toa(remaining, model_out->continuation_token, &remaining)) == AZ_OK)
+  {
+    remaining = az_span_copy(remaining, AZ_SPAN_FROM_STR(MODEL_OUT_JSON_END));
+    *model_out_span = az_span_slice(
+        *model_out_span, 0, az_span_size(*model_out_span) - az_span_size(remaining));
   }
-  AZ_ULIB_CATCH(...) { return AZ_ULIB_TRY_RESULT; }
 
-  return AZ_OK;
+  return res;
 }
 
 static az_result query_1_query_span_wrapper(az_span model_in_span, az_span* model_out_span)
@@ -106,16 +106,17 @@ static az_result query_1_query_span_wrapper(az_span model_in_span, az_span* mode
     }
     AZ_ULIB_THROW_IF_AZ_ERROR(AZ_ULIB_TRY_RESULT);
 
-    // Create a temporary buffer to store the query_model_out.
-    az_span dest_span = az_span_slice_to_end(*model_out_span, model_out_span_min_size() + 1);
-    query_1_query_model_out query_model_out = { .result = &dest_span, .continuation_token = 0 };
+    // The query result goes straight in the JSON array in the model_out_span.
+    az_span result_span;
+    AZ_ULIB_THROW_IF_AZ_ERROR(begin_model_out_json(*model_out_span, &result_span));
+    query_1_query_model_out query_model_out = { .result = &result_span, .continuation_token = 0 };
 
     // Call.
     AZ_ULIB_THROW_IF_AZ_ERROR(query_1_query_concrete(
         (az_ulib_model_in)&query_model_in, (az_ulib_model_out)&query_model_out));
 
-    // Marshalling query_model_out to JSON in model_out_span.
-    AZ_ULIB_THROW_IF_AZ_ERROR(marshalling_model_out_to_json(&query_model_out, model_out_span));
+    // Close the JSON in model_out_span with the query_model_out continuation token.
+    AZ_ULIB_THROW_IF_AZ_ERROR(end_model_out_json(&query_model_out, model_out_span));
   }
   AZ_ULIB_CATCH(...) {}
 
@@ -152,9 +153,10 @@ static az_result query_1_next_span_wrapper(az_span model_in_span, az_span* model
     }
     AZ_ULIB_THROW_IF_AZ_ERROR(AZ_ULIB_TRY_RESULT);
 
-    // Create a temporary buffer to store the next_model_out.
-    az_span dest_span = az_span_slice_to_end(*model_out_span, model_out_span_min_size() + 1);
-    query_1_next_model_out next_model_out = { .result = &dest_span, .continuation_token = 0 };
+    // The query result goes straight in the JSON array in the model_out_span.
+    az_span result_span;
+    AZ_ULIB_THROW_IF_AZ_ERROR(begin_model_out_json(*model_out_span, &result_span));
+    query_1_next_model_out next_model_out = { .result = &result_span, .continuation_token = 0 };
 
     // Call.
     AZ_ULIB_THROW_IF_AZ_ERROR(query_1_next_concrete(
@@ -162,9 +164,9 @@ static az_result query_1_next_span_wrapper(az_span model_in_span, az_span* model
 
     if (AZ_ULIB_TRY_RESULT != AZ_ULIB_EOF)
     {
-      // Marshalling next_model_out to JSON in model_out_span.
+      // Close the JSON in model_out_span with the next_model_out continuation token.
       AZ_ULIB_THROW_IF_AZ_ERROR(
-          marshalling_model_out_to_json((query_1_query_model_out*)&next_model_out, model_out_span));
+          end_model_out_json((query_1_query_model_out*)&next_model_out, model_out_span));
     }
   }
   AZ_ULIB_CATCH(...) {}
@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+/********************************************************************
+ * This code was auto-generated from stats v1 DL.
+ *
+ * Implement the code under the concrete functions.
+ *
+ ********************************************************************/
+
+#include "_az_ulib_ipc_stats.h"
+#include "az_ulib_capability_api.h"
+#include "az_ulib_descriptor_api.h"
+#include "az_ulib_ipc_api.h"
+#include "az_ulib_result.h"
+#include "az_ulib_stats_1_model.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IPC_STATS_1_INTERFACE_NAME "ipc_" STATS_1_INTERFACE_NAME
+
+static az_result stats_1_get_concrete(az_ulib_model_in model_in, az_ulib_model_out model_out)
+{
+  const stats_1_get_model_in* const in = (const stats_1_get_model_in* const)model_in;
+  stats_1_get_model_out* out = (stats_1_get_model_out*)model_out;
+  az_ulib_ipc_interface_handle interface_handle;
+  az_result result;
+
+  if ((result = az_ulib_ipc_try_get_interface(
+           in->name, in->version, AZ_ULIB_VERSION_EQUALS_TO, &interface_handle))
+      == AZ_OK)
+  {
+    // The names point to the descriptor, so copy them before the release of the interface.
+    az_span names = out->names;
+    az_ulib_capability_index count = 0;
+    while ((result == AZ_OK) && (count < out->capabilities_size))
+    {
+      az_ulib_ipc_capability_stats* stats = &(out->capabilities[count]);
+      if ((result = az_ulib_ipc_get_stats(interface_handle, count, stats)) == AZ_OK)
+      {
+        int32_t name_size = az_span_size(stats->name);
+        if (name_size > az_span_size(names))
+        {
+          result = AZ_ERROR_NOT_ENOUGH_SPACE;
+        }
+        else
+        {
+          az_span name = az_span_slice(names, 0, name_size);
+          names = az_span_copy(names, stats->name);
+          stats->name = name;
+          count++;
+        }
+      }
+    }
+
+    // The list ends in the last capability of the interface, or in the last one with statistics.
+    if ((result == AZ_ERROR_ITEM_NOT_FOUND) || (result == AZ_ERROR_NOT_SUPPORTED))
+    {
+      result = AZ_OK;
+    }
+    out->capabilities_size = count;
+
+    az_result release_result = az_ulib_ipc_release_interface(interface_handle);
+    if (result == AZ_OK)
+    {
+      result = release_result;
+    }
+  }
+
+  return result;
+}
+
+/*
+ * The counters may not fit in an int32_t, but a double keeps all uint32_t values exact.
+ */
+AZ_INLINE az_result append_uint32(az_json_writer* jw, uint32_t value)
+{
+  return az_json_writer_append_double(jw, (double)value, 0);
+}
+
+static az_result stats_1_get_span_wrapper(az_span model_in_span, az_span* model_out_span)
+{
+  AZ_ULIB_TRY
+  {
+    // Unmarshalling JSON in model_in_span to get_model_in.
+    az_json_reader jr;
+    stats_1_get_model_in get_model_in = { 0 };
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_reader_init(&jr, model_in_span, NULL));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_reader_next_token(&jr));
+    while (jr.token.kind != AZ_JSON_TOKEN_END_OBJECT)
+    {
+      if (az_json_token_is_text_equal(&jr.token, AZ_SPAN_FROM_STR(STATS_1_GET_NAME_NAME)))
+      {
+        AZ_ULIB_THROW_IF_AZ_ERROR(az_json_reader_next_token(&jr));
+        get_model_in.name
+            = az_span_create(az_span_ptr(jr.token.slice), az_span_size(jr.token.slice));
+      }
+      else if (az_json_token_is_text_equal(
+                   &jr.token, AZ_SPAN_FROM_STR(STATS_1_GET_VERSION_NAME)))
+      {
+        AZ_ULIB_THROW_IF_AZ_ERROR(az_json_reader_next_token(&jr));
+        AZ_ULIB_THROW_IF_AZ_ERROR(az_span_atou32(jr.token.slice, &(get_model_in.version)));
+      }
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_reader_next_token(&jr));
+    }
+    AZ_ULIB_THROW_IF_AZ_ERROR(AZ_ULIB_TRY_RESULT);
+
+    // Call.
+    az_ulib_ipc_capability_stats capabilities[AZ_ULIB_CONFIG_IPC_STATS_MAX_CAPABILITIES];
+    uint8_t names[AZ_ULIB_CONFIG_IPC_STATS_MAX_CAPABILITIES * AZ_ULIB_CONFIG_IPC_STATS_NAME_SIZE];
+    stats_1_get_model_out get_model_out
+        = { .capabilities = capabilities,
+            .capabilities_size = AZ_ULIB_CONFIG_IPC_STATS_MAX_CAPABILITIES,
+            .names = AZ_SPAN_FROM_BUFFER(names) };
+    AZ_ULIB_THROW_IF_AZ_ERROR(
+        stats_1_get_concrete((az_ulib_model_in)&get_model_in, (az_ulib_model_out)&get_model_out));
+
+    // Marshalling get_model_out to JSON in model_out_span.
+    az_json_writer jw;
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_init(&jw, *model_out_span, NULL));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_object(&jw));
+    AZ_ULIB_THROW_IF_AZ_ERROR(
+        az_json_writer_append_property_name(&jw, AZ_SPAN_FROM_STR(STATS_1_GET_CAPABILITIES_NAME)));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_array(&jw));
+    for (az_ulib_capability_index i = 0; i < get_model_out.capabilities_size; i++)
+    {
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_object(&jw));
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(
+          &jw, AZ_SPAN_FROM_STR(STATS_1_GET_CAPABILITY_NAME_NAME)));
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_string(&jw, capabilities[i].name));
+      AZ_ULIB_THROW_IF_AZ_ERROR(
+          az_json_writer_append_property_name(&jw, AZ_SPAN_FROM_STR(STATS_1_GET_CALLS_NAME)));
+      AZ_ULIB_THROW_IF_AZ_ERROR(append_uint32(&jw, capabilities[i].call_count));
+      AZ_ULIB_THROW_IF_AZ_ERROR(
+          az_json_writer_append_property_name(&jw, AZ_SPAN_FROM_STR(STATS_1_GET_ERRORS_NAME)));
+      AZ_ULIB_THROW_IF_AZ_ERROR(append_uint32(&jw, capabilities[i].error_count));
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_property_name(
+          &jw, AZ_SPAN_FROM_STR(STATS_1_GET_LATENCY_US_NAME)));
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_begin_array(&jw));
+      for (size_t bucket = 0; bucket < AZ_ULIB_CONFIG_IPC_STATS_LATENCY_BUCKETS; bucket++)
+      {
+        AZ_ULIB_THROW_IF_AZ_ERROR(append_uint32(&jw, capabilities[i].latency_histogram[bucket]));
+      }
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_array(&jw));
+      AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_object(&jw));
+    }
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_array(&jw));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_json_writer_append_end_object(&jw));
+    *model_out_span = az_json_writer_get_bytes_used_in_destination(&jw);
+  }
+  AZ_ULIB_CATCH(...) {}
+
+  return AZ_ULIB_TRY_RESULT;
+}
+
+static const az_ulib_capability_descriptor STATS_1_CAPABILITIES[STATS_1_CAPABILITY_SIZE]
+    = { AZ_ULIB_DESCRIPTOR_ADD_COMMAND(
+        STATS_1_GET_COMMAND_NAME,
+        stats_1_get_concrete,
+        stats_1_get_span_wrapper) };
+
+static const az_ulib_interface_descriptor STATS_1_DESCRIPTOR = AZ_ULIB_DESCRIPTOR_CREATE(
+    IPC_STATS_1_INTERFACE_NAME,
+    STATS_1_INTERFACE_VERSION,
+    STATS_1_CAPABILITY_SIZE,
+    STATS_1_CAPABILITIES);
+
+az_result _az_ulib_ipc_stats_interface_publish(void)
+{
+  return az_ulib_ipc_publish(&STATS_1_DESCRIPTOR, NULL);
+}
+
+az_result _az_ulib_ipc_stats_interface_unpublish(void)
+{
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  return az_ulib_ipc_unpublish(&STATS_1_DESCRIPTOR, AZ_ULIB_NO_WAIT);
+#else
+  return AZ_OK;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+}
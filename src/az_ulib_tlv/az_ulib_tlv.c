@@ -0,0 +1,236 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_result.h"
+#include "az_ulib_tlv.h"
+#include "azure/az_core.h"
+
+#include <azure/core/internal/az_precondition_internal.h>
+
+#define VARINT_CONTINUATION 0x80
+#define VARINT_VALUE_MASK 0x7F
+#define VARINT_MAX_SIZE 5
+
+/*
+ * Encodes the value as a LEB128 varint in the buffer, which shall have at least VARINT_MAX_SIZE
+ * bytes, and returns the number of bytes used.
+ */
+static int32_t encode_varint(uint32_t value, uint8_t* buffer)
+{
+  int32_t size = 0;
+
+  while (value > VARINT_VALUE_MASK)
+  {
+    buffer[size++] = (uint8_t)((value & VARINT_VALUE_MASK) | VARINT_CONTINUATION);
+    value >>= 7;
+  }
+  buffer[size++] = (uint8_t)value;
+
+  return size;
+}
+
+/*
+ * Decodes a LEB128 varint with up to 32 bits from the buffer. Returns the number of bytes used, 0
+ * if the buffer ends before the varint, or -1 if the varint does not fit in 32 bits.
+ */
+static int32_t decode_varint(const uint8_t* buffer, int32_t buffer_size, uint32_t* value)
+{
+  int32_t size = 0;
+  uint32_t result = 0;
+
+  for (int32_t i = 0; i < buffer_size; i++)
+  {
+    if ((i == (VARINT_MAX_SIZE - 1)) && (buffer[i] > 0x0F))
+    {
+      // The 5th byte may only have the 4 higher bits of a 32 bits value.
+      size = -1;
+      break;
+    }
+
+    result |= (uint32_t)(buffer[i] & VARINT_VALUE_MASK) << (7 * i);
+    if ((buffer[i] & VARINT_CONTINUATION) == 0)
+    {
+      *value = result;
+      size = i + 1;
+      break;
+    }
+  }
+
+  return size;
+}
+
+static az_result append_field(
+    az_ulib_tlv_writer* tlv_writer,
+    uint8_t tag,
+    const uint8_t* value,
+    int32_t value_size)
+{
+  uint8_t header[1 + VARINT_MAX_SIZE];
+  int32_t header_size = 1 + encode_varint((uint32_t)value_size, &header[1]);
+  az_span remainder = az_span_slice_to_end(
+      tlv_writer->_internal.destination, tlv_writer->_internal.bytes_written);
+  az_result result;
+
+  header[0] = tag;
+  if (az_span_size(remainder) - header_size < value_size)
+  {
+    result = AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+  else
+  {
+    remainder = az_span_copy(remainder, az_span_create(header, header_size));
+    if (value_size > 0)
+    {
+      (void)memcpy(az_span_ptr(remainder), value, (size_t)value_size);
+    }
+    tlv_writer->_internal.bytes_written += header_size + value_size;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result
+az_ulib_tlv_writer_init(az_ulib_tlv_writer* tlv_writer, az_span destination_buffer)
+{
+  _az_PRECONDITION_NOT_NULL(tlv_writer);
+
+  tlv_writer->_internal.destination = destination_buffer;
+  tlv_writer->_internal.bytes_written = 0;
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_ulib_tlv_writer_append_uint32(az_ulib_tlv_writer* tlv_writer, uint8_t tag, uint32_t value)
+{
+  _az_PRECONDITION_NOT_NULL(tlv_writer);
+
+  uint8_t varint[VARINT_MAX_SIZE];
+  int32_t varint_size = encode_varint(value, varint);
+
+  return append_field(tlv_writer, tag, varint, varint_size);
+}
+
+AZ_NODISCARD az_result
+az_ulib_tlv_writer_append_int32(az_ulib_tlv_writer* tlv_writer, uint8_t tag, int32_t value)
+{
+  _az_PRECONDITION_NOT_NULL(tlv_writer);
+
+  // Zigzag keeps the small negative numbers small.
+  uint32_t zigzag = (value < 0) ? ~((uint32_t)value << 1) : ((uint32_t)value << 1);
+
+  return az_ulib_tlv_writer_append_uint32(tlv_writer, tag, zigzag);
+}
+
+AZ_NODISCARD az_result
+az_ulib_tlv_writer_append_span(az_ulib_tlv_writer* tlv_writer, uint8_t tag, az_span value)
+{
+  _az_PRECONDITION_NOT_NULL(tlv_writer);
+
+  return append_field(tlv_writer, tag, az_span_ptr(value), az_span_size(value));
+}
+
+AZ_NODISCARD az_span
+az_ulib_tlv_writer_get_bytes_used_in_destination(const az_ulib_tlv_writer* tlv_writer)
+{
+  _az_PRECONDITION_NOT_NULL(tlv_writer);
+
+  return az_span_slice(tlv_writer->_internal.destination, 0, tlv_writer->_internal.bytes_written);
+}
+
+AZ_NODISCARD az_result az_ulib_tlv_reader_init(az_ulib_tlv_reader* tlv_reader, az_span buffer)
+{
+  _az_PRECONDITION_NOT_NULL(tlv_reader);
+
+  tlv_reader->tag = 0;
+  tlv_reader->value = AZ_SPAN_EMPTY;
+  tlv_reader->_internal.buffer = buffer;
+  tlv_reader->_internal.position = 0;
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_ulib_tlv_reader_next(az_ulib_tlv_reader* tlv_reader)
+{
+  _az_PRECONDITION_NOT_NULL(tlv_reader);
+
+  const uint8_t* buffer = az_span_ptr(tlv_reader->_internal.buffer);
+  int32_t buffer_size = az_span_size(tlv_reader->_internal.buffer);
+  int32_t position = tlv_reader->_internal.position;
+  uint32_t value_size = 0;
+  int32_t varint_size = 0;
+  az_result result;
+
+  if (position == buffer_size)
+  {
+    result = AZ_ULIB_EOF;
+  }
+  else if (
+      (varint_size = decode_varint(&buffer[position + 1], buffer_size - position - 1, &value_size))
+      < 0)
+  {
+    result = AZ_ERROR_UNEXPECTED_CHAR;
+  }
+  else if (
+      (varint_size == 0) || (value_size > (uint32_t)(buffer_size - position - 1 - varint_size)))
+  {
+    result = AZ_ERROR_UNEXPECTED_END;
+  }
+  else
+  {
+    int32_t value_start = position + 1 + varint_size;
+    int32_t value_end = value_start + (int32_t)value_size;
+    tlv_reader->tag = buffer[position];
+    tlv_reader->value = az_span_slice(tlv_reader->_internal.buffer, value_start, value_end);
+    tlv_reader->_internal.position = value_end;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result
+az_ulib_tlv_reader_get_uint32(const az_ulib_tlv_reader* tlv_reader, uint32_t* value)
+{
+  _az_PRECONDITION_NOT_NULL(tlv_reader);
+  _az_PRECONDITION_NOT_NULL(value);
+
+  int32_t value_size = az_span_size(tlv_reader->value);
+  uint32_t decoded_value;
+  az_result result;
+
+  if ((value_size == 0)
+      || (decode_varint(az_span_ptr(tlv_reader->value), value_size, &decoded_value) != value_size))
+  {
+    result = AZ_ERROR_UNEXPECTED_CHAR;
+  }
+  else
+  {
+    *value = decoded_value;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result
+az_ulib_tlv_reader_get_int32(const az_ulib_tlv_reader* tlv_reader, int32_t* value)
+{
+  _az_PRECONDITION_NOT_NULL(tlv_reader);
+  _az_PRECONDITION_NOT_NULL(value);
+
+  uint32_t zigzag;
+  az_result result;
+
+  if ((result = az_ulib_tlv_reader_get_uint32(tlv_reader, &zigzag)) == AZ_OK)
+  {
+    *value = ((zigzag & 1) != 0) ? (-(int32_t)(zigzag >> 1) - 1) : (int32_t)(zigzag >> 1);
+  }
+
+  return result;
+}
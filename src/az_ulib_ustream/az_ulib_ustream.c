@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "az_ulib_pal_os_api.h"
 #include "az_ulib_port.h"
 #include "az_ulib_result.h"
 #include "az_ulib_ustream.h"
@@ -47,9 +48,21 @@ static az_result concrete_clone(
     az_ulib_ustream* ustream_instance,
     offset_t offset);
 static az_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_result concrete_peek(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t** const data,
+    size_t* const size);
+static az_result concrete_advance(az_ulib_ustream* ustream_instance, size_t size);
+static az_result concrete_read_at(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size);
 static const az_ulib_ustream_interface api
-    = { concrete_set_position, concrete_reset,   concrete_read,  concrete_get_remaining_size,
-        concrete_get_position, concrete_release, concrete_clone, concrete_dispose };
+    = { concrete_set_position, concrete_reset,   concrete_read,   concrete_get_remaining_size,
+        concrete_get_position, concrete_release, concrete_clone,  concrete_dispose,
+        concrete_peek,         concrete_advance, concrete_read_at };
 
 static void init_instance(
     az_ulib_ustream* ustream_instance,
@@ -82,6 +95,17 @@ static void destroy_control_block(az_ulib_ustream_data_cb* control_block)
   }
 }
 
+static void release_file_data(void* release_pointer)
+{
+  az_ulib_ustream_file_data_cb* file_data = (az_ulib_ustream_file_data_cb*)release_pointer;
+
+  az_pal_os_file_unmap(&(file_data->file_map));
+  if (file_data->file_data_release)
+  {
+    file_data->file_data_release(file_data);
+  }
+}
+
 static az_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position)
 {
   _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
@@ -113,44 +137,56 @@ static az_result concrete_reset(az_ulib_ustream* ustream_instance)
   return AZ_OK;
 }
 
-static az_result concrete_read(
-    az_ulib_ustream* ustream_instance,
+static az_result read_from(
+    const az_ulib_ustream* ustream_instance,
+    offset_t inner_position,
     uint8_t* const buffer,
     size_t buffer_length,
     size_t* const size)
 {
-  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
-  _az_PRECONDITION_NOT_NULL(buffer);
-  _az_PRECONDITION(buffer_length > 0);
-  _az_PRECONDITION_NOT_NULL(size);
-
   az_result result;
 
-  az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
-
-  if (ustream_instance->inner_current_position >= ustream_instance->length)
+  if (inner_position >= ustream_instance->length)
   {
     *size = 0;
     result = AZ_ULIB_EOF;
   }
   else
   {
-    size_t remain_size
-        = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+    size_t remain_size = ustream_instance->length - (size_t)inner_position;
     *size = (buffer_length < remain_size) ? buffer_length : remain_size;
     IGNORE_MEMCPY_TO_NULL
-    memcpy(
-        buffer,
-        (const uint8_t*)control_block->ptr + ustream_instance->inner_current_position,
-        *size);
+    memcpy(buffer, (const uint8_t*)ustream_instance->control_block->ptr + inner_position, *size);
     RESUME_WARNINGS
-    ustream_instance->inner_current_position += *size;
     result = AZ_OK;
   }
 
   return result;
 }
 
+static az_result concrete_read(
+    az_ulib_ustream* ustream_instance,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffer);
+  _az_PRECONDITION(buffer_length > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  if ((result = read_from(
+           ustream_instance, ustream_instance->inner_current_position, buffer, buffer_length, size))
+      == AZ_OK)
+  {
+    ustream_instance->inner_current_position += *size;
+  }
+
+  return result;
+}
+
 static az_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
 {
   _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
@@ -236,6 +272,82 @@ static az_result concrete_dispose(az_ulib_ustream* ustream_instance)
   return AZ_OK;
 }
 
+static az_result concrete_peek(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t** const data,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(data);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  if (ustream_instance->inner_current_position >= ustream_instance->length)
+  {
+    *data = NULL;
+    *size = 0;
+    result = AZ_ULIB_EOF;
+  }
+  else
+  {
+    *data = (const uint8_t*)ustream_instance->control_block->ptr
+        + ustream_instance->inner_current_position;
+    *size = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_advance(az_ulib_ustream* ustream_instance, size_t size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_result result;
+
+  if (size > (ustream_instance->length - ustream_instance->inner_current_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    ustream_instance->inner_current_position += size;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_read_at(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffer);
+  _az_PRECONDITION(buffer_length > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position > (offset_t)(ustream_instance->length))
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    result = read_from(ustream_instance, inner_position, buffer, buffer_length, size);
+  }
+
+  return result;
+}
+
 AZ_NODISCARD az_result az_ulib_ustream_init(
     az_ulib_ustream* ustream_instance,
     az_ulib_ustream_data_cb* ustream_control_block,
@@ -259,3 +371,39 @@ AZ_NODISCARD az_result az_ulib_ustream_init(
 
   return AZ_OK;
 }
+
+AZ_NODISCARD az_result az_ulib_ustream_init_from_file(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_file_data_cb* file_data,
+    az_ulib_release_callback file_data_release,
+    const char* file_name)
+{
+  _az_PRECONDITION_NOT_NULL(ustream_instance);
+  _az_PRECONDITION_NOT_NULL(file_data);
+  _az_PRECONDITION_NOT_NULL(file_name);
+
+  az_result result;
+  const uint8_t* data;
+  size_t size;
+
+  if (!az_pal_os_file_map(&(file_data->file_map), file_name, &data, &size))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    // The mapped content is read by the same API as any other buffer, only the release is
+    // different, it unmaps the file before releasing the control block.
+    file_data->file_data_release = file_data_release;
+    file_data->control_block.api = &api;
+    file_data->control_block.ptr = (const az_ulib_ustream_data*)data;
+    file_data->control_block.ref_count = 0;
+    file_data->control_block.data_release = NULL;
+    file_data->control_block.control_block_release = release_file_data;
+
+    init_instance(ustream_instance, &(file_data->control_block), 0, 0, size);
+    result = AZ_OK;
+  }
+
+  return result;
+}
@@ -42,9 +42,21 @@ static az_result concrete_clone(
     az_ulib_ustream* ustream_instance,
     offset_t offset);
 static az_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_result concrete_peek(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t** const data,
+    size_t* const size);
+static az_result concrete_advance(az_ulib_ustream* ustream_instance, size_t size);
+static az_result concrete_read_at(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size);
 static const az_ulib_ustream_interface api
-    = { concrete_set_position, concrete_reset,   concrete_read,  concrete_get_remaining_size,
-        concrete_get_position, concrete_release, concrete_clone, concrete_dispose };
+    = { concrete_set_position, concrete_reset,   concrete_read,   concrete_get_remaining_size,
+        concrete_get_position, concrete_release, concrete_clone,  concrete_dispose,
+        concrete_peek,         concrete_advance, concrete_read_at };
 
 static void destroy_instance(az_ulib_ustream* ustream_instance)
 {
@@ -91,19 +103,53 @@ static az_result concrete_reset(az_ulib_ustream* ustream_instance)
   return AZ_OK;
 }
 
-static az_result concrete_read(
-    az_ulib_ustream* ustream_instance,
+/*
+ * The inner positions of the multi instance are the inner positions of `ustream_one`, followed by
+ * the positions of `ustream_two`, which was cloned starting at the length of `ustream_one`.
+ */
+static offset_t child_position(
+    const az_ulib_ustream_multi_data_cb* multi_data,
+    const az_ulib_ustream* child_ustream,
+    offset_t inner_position)
+{
+  return (child_ustream == &multi_data->ustream_one)
+      ? inner_position + multi_data->ustream_one.offset_diff
+      : inner_position;
+}
+
+static az_result read_child(
+    az_ulib_ustream_multi_data_cb* multi_data,
+    az_ulib_ustream* child_ustream,
+    offset_t inner_position,
     uint8_t* const buffer,
     size_t buffer_length,
     size_t* const size)
 {
-  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
-  _az_PRECONDITION_NOT_NULL(buffer);
-  _az_PRECONDITION(buffer_length > 0);
-  _az_PRECONDITION_NOT_NULL(size);
+  offset_t position = child_position(multi_data, child_ustream, inner_position);
 
-  az_result result;
+  // The positional read does not change the child, so clones can read it in parallel.
+  az_result result
+      = az_ulib_ustream_read_at(child_ustream, position, buffer, buffer_length, size);
 
+  if (result == AZ_ERROR_NOT_SUPPORTED)
+  {
+    // Critical section to make sure another instance doesn't set_position before this one reads
+    az_pal_os_lock_acquire(&multi_data->lock);
+    az_ulib_ustream_set_position(child_ustream, position);
+    result = az_ulib_ustream_read(child_ustream, buffer, buffer_length, size);
+    az_pal_os_lock_release(&multi_data->lock);
+  }
+
+  return result;
+}
+
+static az_result read_from(
+    const az_ulib_ustream* ustream_instance,
+    offset_t inner_position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
   /* In multidata, `ptr` points to a internal multidata control block, and the multidata code needs
    * write permission to execute its function. So, we have an Warning exception here to remove the
    * `const` qualification of the `ptr`. */
@@ -112,24 +158,27 @@ static az_result concrete_read(
       = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
   RESUME_WARNINGS
 
-  az_ulib_ustream* current_ustream
-      = (ustream_instance->inner_current_position < multi_data->ustream_one.length)
+  az_ulib_ustream* current_ustream = (inner_position < multi_data->ustream_one.length)
       ? &multi_data->ustream_one
       : &multi_data->ustream_two;
 
+  // A split instance may end before the end of its children.
+  size_t remain_size = ustream_instance->length - (size_t)inner_position;
+  size_t read_length = (buffer_length < remain_size) ? buffer_length : remain_size;
+
   *size = 0;
-  az_result intermediate_result = AZ_OK;
-  while ((intermediate_result == AZ_OK) && (*size < buffer_length) && (current_ustream != NULL))
+  az_result intermediate_result = (read_length == 0) ? AZ_ULIB_EOF : AZ_OK;
+  while ((intermediate_result == AZ_OK) && (*size < read_length) && (current_ustream != NULL))
   {
     size_t copied_size;
-    size_t remain_size = buffer_length - *size;
 
-    // Critical section to make sure another instance doesn't set_position before this one reads
-    az_pal_os_lock_acquire(&multi_data->lock);
-    az_ulib_ustream_set_position(current_ustream, ustream_instance->inner_current_position + *size);
-    intermediate_result
-        = az_ulib_ustream_read(current_ustream, &buffer[*size], remain_size, &copied_size);
-    az_pal_os_lock_release(&multi_data->lock);
+    intermediate_result = read_child(
+        multi_data,
+        current_ustream,
+        inner_position + *size,
+        &buffer[*size],
+        read_length - *size,
+        &copied_size);
 
     switch (intermediate_result)
     {
@@ -137,7 +186,7 @@ static az_result concrete_read(
         *size += copied_size;
         _az_FALLTHROUGH;
       case AZ_ULIB_EOF:
-        if (*size < buffer_length)
+        if (*size < read_length)
         {
           if (current_ustream == &multi_data->ustream_one)
           {
@@ -155,14 +204,27 @@ static az_result concrete_read(
     }
   }
 
-  if (*size != 0)
+  return (*size != 0) ? AZ_OK : intermediate_result;
+}
+
+static az_result concrete_read(
+    az_ulib_ustream* ustream_instance,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffer);
+  _az_PRECONDITION(buffer_length > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  if ((result = read_from(
+           ustream_instance, ustream_instance->inner_current_position, buffer, buffer_length, size))
+      == AZ_OK)
   {
     ustream_instance->inner_current_position += *size;
-    result = AZ_OK;
-  }
-  else
-  {
-    result = intermediate_result;
   }
 
   return result;
@@ -281,6 +343,106 @@ static az_result concrete_dispose(az_ulib_ustream* ustream_instance)
   return AZ_OK;
 }
 
+static az_result concrete_peek(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t** const data,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(data);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  /* In multidata, `ptr` points to a internal multidata control block, and the multidata code needs
+   * write permission to execute its function. So, we have an Warning exception here to remove the
+   * `const` qualification of the `ptr`. */
+  IGNORE_CAST_QUALIFICATION
+  az_ulib_ustream_multi_data_cb* multi_data
+      = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
+  RESUME_WARNINGS
+
+  if (ustream_instance->inner_current_position >= ustream_instance->length)
+  {
+    *data = NULL;
+    *size = 0;
+    result = AZ_ULIB_EOF;
+  }
+  else
+  {
+    size_t remain_size
+        = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+    az_ulib_ustream* current_ustream
+        = (ustream_instance->inner_current_position < multi_data->ustream_one.length)
+        ? &multi_data->ustream_one
+        : &multi_data->ustream_two;
+
+    // Critical section to make sure another instance doesn't set_position before this one peeks.
+    // The child only exposes a pointer to its immutable content, so it is safe out of the lock.
+    az_pal_os_lock_acquire(&multi_data->lock);
+    az_ulib_ustream_set_position(
+        current_ustream,
+        child_position(multi_data, current_ustream, ustream_instance->inner_current_position));
+    result = az_ulib_ustream_peek(current_ustream, data, size);
+    az_pal_os_lock_release(&multi_data->lock);
+
+    if ((result == AZ_OK) && (*size > remain_size))
+    {
+      *size = remain_size;
+    }
+  }
+
+  return result;
+}
+
+static az_result concrete_advance(az_ulib_ustream* ustream_instance, size_t size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_result result;
+
+  if (size > (ustream_instance->length - ustream_instance->inner_current_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    ustream_instance->inner_current_position += size;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_read_at(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffer);
+  _az_PRECONDITION(buffer_length > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position > (offset_t)(ustream_instance->length))
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    result = read_from(ustream_instance, inner_position, buffer, buffer_length, size);
+  }
+
+  return result;
+}
+
 static void ustream_multi_init(
     az_ulib_ustream* ustream_instance,
     az_ulib_ustream_data_cb* control_block,
@@ -401,3 +563,59 @@ AZ_NODISCARD az_result az_ulib_ustream_split(
 
   return result;
 }
+
+AZ_NODISCARD az_result az_ulib_ustream_to_span_array(
+    az_ulib_ustream* ustream_instance,
+    az_span* spans,
+    size_t max_spans,
+    size_t* span_count)
+{
+  _az_PRECONDITION_NOT_NULL(ustream_instance);
+  _az_PRECONDITION_NOT_NULL(spans);
+  _az_PRECONDITION(max_spans > 0);
+  _az_PRECONDITION_NOT_NULL(span_count);
+
+  az_result result;
+  az_ulib_ustream cursor;
+
+  *span_count = 0;
+  if ((result = az_ulib_ustream_clone(&cursor, ustream_instance, 0)) == AZ_OK)
+  {
+    const uint8_t* data;
+    size_t size;
+    while ((result = az_ulib_ustream_peek(&cursor, &data, &size)) == AZ_OK)
+    {
+      if (*span_count == max_spans)
+      {
+        result = AZ_ERROR_NOT_ENOUGH_SPACE;
+        break;
+      }
+
+      // An az_span cannot be bigger than INT32_MAX, so bigger parts are split in more spans.
+      if (size > INT32_MAX)
+      {
+        size = INT32_MAX;
+      }
+
+      /* The span exposes the content of the ustream that shall not be changed by the consumer.
+       * So, we have an Warning exception here to remove the `const` qualification of the `data`. */
+      IGNORE_CAST_QUALIFICATION
+      spans[*span_count] = az_span_create((uint8_t*)data, (int32_t)size);
+      RESUME_WARNINGS
+      (*span_count)++;
+
+      if ((result = az_ulib_ustream_advance(&cursor, size)) != AZ_OK)
+      {
+        break;
+      }
+    }
+    az_ulib_ustream_dispose(&cursor);
+
+    if (result == AZ_ULIB_EOF)
+    {
+      result = AZ_OK;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,489 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "az_ulib_pal_os.h"
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_port.h"
+#include "az_ulib_result.h"
+#include "az_ulib_ustream.h"
+
+#include <azure/core/internal/az_precondition_internal.h>
+
+#ifdef __clang__
+#define IGNORE_CAST_QUALIFICATION \
+  _Pragma("clang diagnostic push") _Pragma("clang diagnostic ignored \"-Wcast-qual\"")
+#define RESUME_WARNINGS _Pragma("clang diagnostic pop")
+#elif defined(__GNUC__)
+#define IGNORE_CAST_QUALIFICATION \
+  _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wcast-qual\"")
+#define RESUME_WARNINGS _Pragma("GCC diagnostic pop")
+#else
+#define IGNORE_CAST_QUALIFICATION
+#define RESUME_WARNINGS
+#endif // __clang__
+
+static az_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_result concrete_reset(az_ulib_ustream* ustream_instance);
+static az_result concrete_read(
+    az_ulib_ustream* ustream_instance,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size);
+static az_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_result concrete_clone(
+    az_ulib_ustream* ustream_instance_clone,
+    az_ulib_ustream* ustream_instance,
+    offset_t offset);
+static az_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_result concrete_peek(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t** const data,
+    size_t* const size);
+static az_result concrete_advance(az_ulib_ustream* ustream_instance, size_t size);
+static az_result concrete_read_at(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size);
+static const az_ulib_ustream_interface api
+    = { concrete_set_position, concrete_reset,   concrete_read,   concrete_get_remaining_size,
+        concrete_get_position, concrete_release, concrete_clone,  concrete_dispose,
+        concrete_peek,         concrete_advance, concrete_read_at };
+
+static az_ulib_ustream_rope_data_cb* get_rope_data(const az_ulib_ustream* ustream_instance)
+{
+  /* In the rope, `ptr` points to the rope control block, and the rope code needs write permission
+   * to execute its function. So, we have an Warning exception here to remove the `const`
+   * qualification of the `ptr`. */
+  IGNORE_CAST_QUALIFICATION
+  az_ulib_ustream_rope_data_cb* rope_data
+      = (az_ulib_ustream_rope_data_cb*)ustream_instance->control_block->ptr;
+  RESUME_WARNINGS
+
+  return rope_data;
+}
+
+static void init_instance(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_data_cb* control_block,
+    offset_t inner_current_position,
+    offset_t offset,
+    size_t data_buffer_length)
+{
+  ustream_instance->inner_current_position = inner_current_position;
+  ustream_instance->inner_first_valid_position = inner_current_position;
+  ustream_instance->offset_diff = offset - inner_current_position;
+  ustream_instance->control_block = control_block;
+  ustream_instance->length = data_buffer_length;
+  AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
+}
+
+static void destroy_rope_data(az_ulib_ustream_rope_data_cb* rope_data)
+{
+  for (size_t i = 0; i < rope_data->segment_count; i++)
+  {
+    az_ulib_ustream_dispose(&(rope_data->segments[i].ustream));
+  }
+  az_pal_os_lock_deinit(&rope_data->lock);
+
+  if (rope_data->control_block.data_release != NULL)
+  {
+    rope_data->control_block.data_release(rope_data);
+  }
+}
+
+/*
+ * Returns the index of the segment that contains the inner position, which is the first segment
+ * that ends after it.
+ */
+static size_t find_segment(const az_ulib_ustream_rope_data_cb* rope_data, offset_t inner_position)
+{
+  size_t first = 0;
+  size_t last = rope_data->segment_count;
+
+  while (first < last)
+  {
+    size_t middle = first + ((last - first) / 2);
+    if (rope_data->segments[middle].end <= inner_position)
+    {
+      first = middle + 1;
+    }
+    else
+    {
+      last = middle;
+    }
+  }
+
+  return first;
+}
+
+static az_result read_segment(
+    az_ulib_ustream_rope_data_cb* rope_data,
+    az_ulib_ustream_rope_segment* segment,
+    offset_t inner_position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  // Each segment was cloned starting at its inner position in the rope.
+  az_result result
+      = az_ulib_ustream_read_at(&segment->ustream, inner_position, buffer, buffer_length, size);
+
+  if (result == AZ_ERROR_NOT_SUPPORTED)
+  {
+    // Critical section to make sure another instance doesn't set_position before this one reads
+    az_pal_os_lock_acquire(&rope_data->lock);
+    az_ulib_ustream_set_position(&segment->ustream, inner_position);
+    result = az_ulib_ustream_read(&segment->ustream, buffer, buffer_length, size);
+    az_pal_os_lock_release(&rope_data->lock);
+  }
+
+  return result;
+}
+
+static az_result read_from(
+    const az_ulib_ustream* ustream_instance,
+    offset_t inner_position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  az_ulib_ustream_rope_data_cb* rope_data = get_rope_data(ustream_instance);
+
+  size_t remain_size = ustream_instance->length - (size_t)inner_position;
+  size_t read_length = (buffer_length < remain_size) ? buffer_length : remain_size;
+  size_t index = find_segment(rope_data, inner_position);
+
+  *size = 0;
+  az_result result = (read_length == 0) ? AZ_ULIB_EOF : AZ_OK;
+  while ((result == AZ_OK) && (*size < read_length))
+  {
+    size_t copied_size;
+    if ((result = read_segment(
+             rope_data,
+             &rope_data->segments[index],
+             inner_position + *size,
+             &buffer[*size],
+             read_length - *size,
+             &copied_size))
+        == AZ_OK)
+    {
+      *size += copied_size;
+      if ((inner_position + *size) >= rope_data->segments[index].end)
+      {
+        index++;
+      }
+    }
+  }
+
+  return (*size != 0) ? AZ_OK : result;
+}
+
+static az_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_result result;
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position > (offset_t)(ustream_instance->length))
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    ustream_instance->inner_current_position = inner_position;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_reset(az_ulib_ustream* ustream_instance)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+
+  return AZ_OK;
+}
+
+static az_result concrete_read(
+    az_ulib_ustream* ustream_instance,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffer);
+  _az_PRECONDITION(buffer_length > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  if ((result = read_from(
+           ustream_instance, ustream_instance->inner_current_position, buffer, buffer_length, size))
+      == AZ_OK)
+  {
+    ustream_instance->inner_current_position += *size;
+  }
+
+  return result;
+}
+
+static az_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(size);
+
+  *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+  return AZ_OK;
+}
+
+static az_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(position);
+
+  *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+  return AZ_OK;
+}
+
+static az_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_result result;
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position >= ustream_instance->inner_current_position)
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    result = AZ_ERROR_ARG;
+  }
+  else
+  {
+    ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_clone(
+    az_ulib_ustream* ustream_instance_clone,
+    az_ulib_ustream* ustream_instance,
+    offset_t offset)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(ustream_instance_clone);
+
+  az_result result;
+
+  if (offset > (UINT32_MAX - ustream_instance->length))
+  {
+    result = AZ_ERROR_ARG;
+  }
+  else
+  {
+    init_instance(
+        ustream_instance_clone,
+        ustream_instance->control_block,
+        ustream_instance->inner_current_position,
+        offset,
+        ustream_instance->length);
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_dispose(az_ulib_ustream* ustream_instance)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+  AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
+  if (control_block->ref_count == 0)
+  {
+    destroy_rope_data(get_rope_data(ustream_instance));
+  }
+
+  return AZ_OK;
+}
+
+static az_result concrete_peek(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t** const data,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(data);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  if (ustream_instance->inner_current_position >= ustream_instance->length)
+  {
+    *data = NULL;
+    *size = 0;
+    result = AZ_ULIB_EOF;
+  }
+  else
+  {
+    az_ulib_ustream_rope_data_cb* rope_data = get_rope_data(ustream_instance);
+    size_t remain_size
+        = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+    az_ulib_ustream* segment_ustream
+        = &rope_data->segments[find_segment(rope_data, ustream_instance->inner_current_position)]
+               .ustream;
+
+    // Critical section to make sure another instance doesn't set_position before this one peeks.
+    // The segment only exposes a pointer to its immutable content, so it is safe out of the lock.
+    az_pal_os_lock_acquire(&rope_data->lock);
+    az_ulib_ustream_set_position(segment_ustream, ustream_instance->inner_current_position);
+    result = az_ulib_ustream_peek(segment_ustream, data, size);
+    az_pal_os_lock_release(&rope_data->lock);
+
+    if ((result == AZ_OK) && (*size > remain_size))
+    {
+      *size = remain_size;
+    }
+  }
+
+  return result;
+}
+
+static az_result concrete_advance(az_ulib_ustream* ustream_instance, size_t size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_result result;
+
+  if (size > (ustream_instance->length - ustream_instance->inner_current_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    ustream_instance->inner_current_position += size;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_read_at(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffer);
+  _az_PRECONDITION(buffer_length > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position > (offset_t)(ustream_instance->length))
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    result = read_from(ustream_instance, inner_position, buffer, buffer_length, size);
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ustream_rope_init(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_rope_data_cb* rope_data,
+    az_ulib_release_callback rope_data_release,
+    az_ulib_ustream_rope_segment* segments,
+    size_t max_segments)
+{
+  _az_PRECONDITION_NOT_NULL(ustream_instance);
+  _az_PRECONDITION_NOT_NULL(rope_data);
+  _az_PRECONDITION_NOT_NULL(segments);
+  _az_PRECONDITION(max_segments > 0);
+
+  rope_data->segments = segments;
+  rope_data->segment_count = 0;
+  rope_data->max_segments = max_segments;
+  az_pal_os_lock_init(&rope_data->lock);
+
+  az_ulib_ustream_data_cb* control_block = &rope_data->control_block;
+  control_block->api = &api;
+  control_block->ptr = (void*)rope_data;
+  control_block->ref_count = 0;
+  control_block->data_release = rope_data_release;
+  control_block->control_block_release = NULL;
+
+  init_instance(ustream_instance, control_block, 0, 0, 0);
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_ulib_ustream_rope_append(az_ulib_ustream* ustream_instance, az_ulib_ustream* ustream_to_append)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(ustream_to_append);
+
+  az_result result;
+
+  az_ulib_ustream_rope_data_cb* rope_data = get_rope_data(ustream_instance);
+  offset_t rope_end = (rope_data->segment_count == 0)
+      ? 0
+      : rope_data->segments[rope_data->segment_count - 1].end;
+  size_t remaining_size;
+
+  if (ustream_instance->length != rope_end)
+  {
+    result = AZ_ERROR_ARG;
+  }
+  else if (
+      ((result = az_ulib_ustream_get_remaining_size(ustream_to_append, &remaining_size)) == AZ_OK)
+      && (remaining_size != 0))
+  {
+    // An append with no content does nothing, even if the rope has no free segment.
+    if (rope_data->segment_count == rope_data->max_segments)
+    {
+      result = AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+    else
+    {
+      az_ulib_ustream_rope_segment* segment = &rope_data->segments[rope_data->segment_count];
+      if ((result = az_ulib_ustream_clone(&segment->ustream, ustream_to_append, rope_end))
+          == AZ_OK)
+      {
+        segment->end = rope_end + remaining_size;
+        rope_data->segment_count++;
+        ustream_instance->length += remaining_size;
+      }
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,429 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_port.h"
+#include "az_ulib_result.h"
+#include "az_ulib_ustream.h"
+
+#include <azure/core/internal/az_precondition_internal.h>
+
+#ifdef __clang__
+#define IGNORE_CAST_QUALIFICATION \
+  _Pragma("clang diagnostic push") _Pragma("clang diagnostic ignored \"-Wcast-qual\"")
+#define IGNORE_MEMCPY_TO_NULL _Pragma("GCC diagnostic push")
+#define RESUME_WARNINGS _Pragma("clang diagnostic pop")
+#elif defined(__GNUC__)
+#define IGNORE_CAST_QUALIFICATION \
+  _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wcast-qual\"")
+#define IGNORE_MEMCPY_TO_NULL _Pragma("GCC diagnostic push")
+#define RESUME_WARNINGS _Pragma("GCC diagnostic pop")
+#else
+#define IGNORE_CAST_QUALIFICATION
+#define IGNORE_MEMCPY_TO_NULL \
+  __pragma(warning(push));  \
+  __pragma(warning(suppress: 6387));
+#define RESUME_WARNINGS __pragma(warning(pop));
+#endif // __clang__
+
+static az_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_result concrete_reset(az_ulib_ustream* ustream_instance);
+static az_result concrete_read(
+    az_ulib_ustream* ustream_instance,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size);
+static az_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_result concrete_clone(
+    az_ulib_ustream* ustream_instance_clone,
+    az_ulib_ustream* ustream_instance,
+    offset_t offset);
+static az_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_result concrete_peek(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t** const data,
+    size_t* const size);
+static az_result concrete_advance(az_ulib_ustream* ustream_instance, size_t size);
+static az_result concrete_read_at(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size);
+static const az_ulib_ustream_interface api
+    = { concrete_set_position, concrete_reset,   concrete_read,   concrete_get_remaining_size,
+        concrete_get_position, concrete_release, concrete_clone,  concrete_dispose,
+        concrete_peek,         concrete_advance, concrete_read_at };
+
+static az_ulib_ustream_spans_data_cb* get_spans_data(const az_ulib_ustream* ustream_instance)
+{
+  /* In the spans ustream, `ptr` points to the spans control block, and the spans code needs write
+   * permission to execute its function. So, we have an Warning exception here to remove the
+   * `const` qualification of the `ptr`. */
+  IGNORE_CAST_QUALIFICATION
+  az_ulib_ustream_spans_data_cb* spans_data
+      = (az_ulib_ustream_spans_data_cb*)ustream_instance->control_block->ptr;
+  RESUME_WARNINGS
+
+  return spans_data;
+}
+
+static void init_instance(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_data_cb* control_block,
+    offset_t inner_current_position,
+    offset_t offset,
+    size_t data_buffer_length)
+{
+  ustream_instance->inner_current_position = inner_current_position;
+  ustream_instance->inner_first_valid_position = inner_current_position;
+  ustream_instance->offset_diff = offset - inner_current_position;
+  ustream_instance->control_block = control_block;
+  ustream_instance->length = data_buffer_length;
+  AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
+}
+
+/*
+ * Returns the index of the span that contains the inner position, which is the first span that
+ * ends after it. Empty spans end where they start, so they are never returned.
+ */
+static size_t find_span(const az_ulib_ustream_spans_data_cb* spans_data, offset_t inner_position)
+{
+  size_t first = 0;
+  size_t last = spans_data->span_count;
+
+  while (first < last)
+  {
+    size_t middle = first + ((last - first) / 2);
+    if (spans_data->span_ends[middle] <= inner_position)
+    {
+      first = middle + 1;
+    }
+    else
+    {
+      last = middle;
+    }
+  }
+
+  return first;
+}
+
+/*
+ * Returns the pointer to the inner position, and the number of contiguous bytes after it that
+ * belong to the instance. The inner position shall be before the end of the instance.
+ */
+static const uint8_t* span_data_at(
+    const az_ulib_ustream* ustream_instance,
+    offset_t inner_position,
+    size_t* const size)
+{
+  az_ulib_ustream_spans_data_cb* spans_data = get_spans_data(ustream_instance);
+  size_t index = find_span(spans_data, inner_position);
+  offset_t span_start = (index == 0) ? 0 : spans_data->span_ends[index - 1];
+  size_t remain_size = ustream_instance->length - (size_t)inner_position;
+
+  *size = spans_data->span_ends[index] - inner_position;
+  if (*size > remain_size)
+  {
+    *size = remain_size;
+  }
+
+  return az_span_ptr(spans_data->spans[index]) + (inner_position - span_start);
+}
+
+static az_result read_from(
+    const az_ulib_ustream* ustream_instance,
+    offset_t inner_position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  az_result result;
+
+  if (inner_position >= ustream_instance->length)
+  {
+    *size = 0;
+    result = AZ_ULIB_EOF;
+  }
+  else
+  {
+    *size = 0;
+    while ((*size < buffer_length) && ((inner_position + *size) < ustream_instance->length))
+    {
+      size_t span_size;
+      const uint8_t* data = span_data_at(ustream_instance, inner_position + *size, &span_size);
+      size_t copy_size
+          = ((buffer_length - *size) < span_size) ? (buffer_length - *size) : span_size;
+
+      IGNORE_MEMCPY_TO_NULL
+      memcpy(&buffer[*size], data, copy_size);
+      RESUME_WARNINGS
+      *size += copy_size;
+    }
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_result result;
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position > (offset_t)(ustream_instance->length))
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    ustream_instance->inner_current_position = inner_position;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_reset(az_ulib_ustream* ustream_instance)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+
+  return AZ_OK;
+}
+
+static az_result concrete_read(
+    az_ulib_ustream* ustream_instance,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffer);
+  _az_PRECONDITION(buffer_length > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  if ((result = read_from(
+           ustream_instance, ustream_instance->inner_current_position, buffer, buffer_length, size))
+      == AZ_OK)
+  {
+    ustream_instance->inner_current_position += *size;
+  }
+
+  return result;
+}
+
+static az_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(size);
+
+  *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+  return AZ_OK;
+}
+
+static az_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(position);
+
+  *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+  return AZ_OK;
+}
+
+static az_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_result result;
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position >= ustream_instance->inner_current_position)
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    result = AZ_ERROR_ARG;
+  }
+  else
+  {
+    ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_clone(
+    az_ulib_ustream* ustream_instance_clone,
+    az_ulib_ustream* ustream_instance,
+    offset_t offset)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(ustream_instance_clone);
+
+  az_result result;
+
+  if (offset > (UINT32_MAX - ustream_instance->length))
+  {
+    result = AZ_ERROR_ARG;
+  }
+  else
+  {
+    init_instance(
+        ustream_instance_clone,
+        ustream_instance->control_block,
+        ustream_instance->inner_current_position,
+        offset,
+        ustream_instance->length);
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_dispose(az_ulib_ustream* ustream_instance)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+  AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
+  if (control_block->ref_count == 0)
+  {
+    az_ulib_ustream_spans_data_cb* spans_data = get_spans_data(ustream_instance);
+    if (control_block->data_release != NULL)
+    {
+      control_block->data_release(spans_data);
+    }
+  }
+
+  return AZ_OK;
+}
+
+static az_result concrete_peek(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t** const data,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(data);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  if (ustream_instance->inner_current_position >= ustream_instance->length)
+  {
+    *data = NULL;
+    *size = 0;
+    result = AZ_ULIB_EOF;
+  }
+  else
+  {
+    *data = span_data_at(ustream_instance, ustream_instance->inner_current_position, size);
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_advance(az_ulib_ustream* ustream_instance, size_t size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+
+  az_result result;
+
+  if (size > (ustream_instance->length - ustream_instance->inner_current_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    ustream_instance->inner_current_position += size;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_read_at(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffer);
+  _az_PRECONDITION(buffer_length > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position > (offset_t)(ustream_instance->length))
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    result = read_from(ustream_instance, inner_position, buffer, buffer_length, size);
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ustream_init_from_spans(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_spans_data_cb* spans_data,
+    az_ulib_release_callback spans_data_release,
+    const az_span* spans,
+    offset_t* span_ends,
+    size_t span_count)
+{
+  _az_PRECONDITION_NOT_NULL(ustream_instance);
+  _az_PRECONDITION_NOT_NULL(spans_data);
+  _az_PRECONDITION_NOT_NULL(spans);
+  _az_PRECONDITION_NOT_NULL(span_ends);
+  _az_PRECONDITION(span_count > 0);
+
+  offset_t end = 0;
+  for (size_t i = 0; i < span_count; i++)
+  {
+    end += (offset_t)az_span_size(spans[i]);
+    span_ends[i] = end;
+  }
+
+  spans_data->spans = spans;
+  spans_data->span_ends = span_ends;
+  spans_data->span_count = span_count;
+
+  az_ulib_ustream_data_cb* control_block = &spans_data->control_block;
+  control_block->api = &api;
+  control_block->ptr = (void*)spans_data;
+  control_block->ref_count = 0;
+  control_block->data_release = spans_data_release;
+  control_block->control_block_release = NULL;
+
+  init_instance(ustream_instance, control_block, 0, 0, end);
+
+  return AZ_OK;
+}
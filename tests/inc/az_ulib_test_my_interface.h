@@ -73,6 +73,12 @@ extern "C"
 #define MY_INTERFACE_MY_COMMAND_COMMAND_INDEX_NAME "command_index"
 #define MY_INTERFACE_MY_COMMAND_RETURN_RESULT_NAME "return_result"
 #define MY_INTERFACE_MY_COMMAND_RESULT_NAME "result"
+#define MY_INTERFACE_MY_COMMAND_CAPABILITY_TAG 1
+#define MY_INTERFACE_MY_COMMAND_MAX_SUM_TAG 2
+#define MY_INTERFACE_MY_COMMAND_WAIT_POLICY_MS_TAG 3
+#define MY_INTERFACE_MY_COMMAND_COMMAND_INDEX_TAG 4
+#define MY_INTERFACE_MY_COMMAND_RETURN_RESULT_TAG 5
+#define MY_INTERFACE_MY_COMMAND_RESULT_TAG 1
   typedef enum
   {
     MY_COMMAND_CAPABILITY_JUST_RETURN = 0,
@@ -116,7 +122,8 @@ extern "C"
     MY_COMMAND_ASYNC_CAPABILITY_RELEASE_INTERFACE,
     MY_COMMAND_ASYNC_CAPABILITY_DEINIT,
     MY_COMMAND_ASYNC_CAPABILITY_CALL_AGAIN,
-    MY_COMMAND_ASYNC_CAPABILITY_RETURN_ERROR
+    MY_COMMAND_ASYNC_CAPABILITY_RETURN_ERROR,
+    MY_COMMAND_ASYNC_CAPABILITY_WAIT_CANCEL
   } my_command_async_capability;
 
   typedef struct
@@ -152,6 +159,7 @@ extern "C"
   extern volatile long g_is_running;
   extern volatile long g_lock_thread;
   extern volatile uint32_t g_sum_sleep;
+  extern volatile long g_count_cancel;
 
 #ifdef __cplusplus
 }
@@ -4,6 +4,13 @@
 
 #include "az_ulib_test_my_interface.h"
 #include "az_ulib_ipc_api.h"
+#include "az_ulib_tlv.h"
+
+#ifndef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+// Without unpublish, the test interfaces stay in the registry.
+#define az_ulib_ipc_unpublish(interface_descriptor, wait_option_ms) \
+  ((void)(interface_descriptor), (void)(wait_option_ms), AZ_ERROR_NOT_SUPPORTED)
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
 
 static my_property_model my_property = 0;
 
@@ -88,6 +95,7 @@ static az_result my_command(az_ulib_model_in model_in, az_ulib_model_out model_o
   my_command_model_out* result = (my_command_model_out*)model_out;
   my_command_model_in in_2;
   uint64_t sum = 0;
+  az_result command_result = AZ_OK;
 
   (void)AZ_ULIB_PORT_ATOMIC_INC_W(&g_is_running);
   switch (in->capability)
@@ -124,13 +132,17 @@ static az_result my_command(az_ulib_model_in model_in, az_ulib_model_out model_o
       in_2.return_result = AZ_OK;
       *result = az_ulib_ipc_call(in->handle, in->command_index, &in_2, model_out);
       break;
+    case MY_COMMAND_CAPABILITY_RETURN_ERROR:
+      *result = in->return_result;
+      command_result = in->return_result;
+      break;
     default:
       *result = AZ_ERROR_ITEM_NOT_FOUND;
       break;
   }
   (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&g_is_running);
 
-  return AZ_OK;
+  return command_result;
 }
 
 static az_result my_command_span_wrapper(az_span model_in_span, az_span* model_out_span)
@@ -217,16 +229,93 @@ static az_result my_command_span_wrapper(az_span model_in_span, az_span* model_o
   return AZ_ULIB_TRY_RESULT;
 }
 
+static az_result my_command_binary_wrapper(az_span model_in_binary, az_span* model_out_binary)
+{
+  AZ_ULIB_TRY
+  {
+    // Unmarshalling TLV in model_in_binary to val.
+    az_ulib_tlv_reader tr;
+    my_command_model_in model_in = { 0 };
+    az_result read_result;
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_tlv_reader_init(&tr, model_in_binary));
+    while ((read_result = az_ulib_tlv_reader_next(&tr)) == AZ_OK)
+    {
+      uint32_t val;
+      int32_t signed_val;
+      switch (tr.tag)
+      {
+        case MY_INTERFACE_MY_COMMAND_CAPABILITY_TAG:
+          AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_tlv_reader_get_uint32(&tr, &val));
+          model_in.capability = (uint8_t)val;
+          break;
+        case MY_INTERFACE_MY_COMMAND_MAX_SUM_TAG:
+          AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_tlv_reader_get_uint32(&tr, &model_in.max_sum));
+          break;
+        case MY_INTERFACE_MY_COMMAND_WAIT_POLICY_MS_TAG:
+          AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_tlv_reader_get_uint32(&tr, &model_in.wait_policy_ms));
+          break;
+        case MY_INTERFACE_MY_COMMAND_COMMAND_INDEX_TAG:
+          AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_tlv_reader_get_uint32(&tr, &val));
+          model_in.command_index = (az_ulib_capability_index)val;
+          break;
+        case MY_INTERFACE_MY_COMMAND_RETURN_RESULT_TAG:
+          AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_tlv_reader_get_int32(&tr, &signed_val));
+          model_in.return_result = (az_result)signed_val;
+          break;
+        default:
+          // Skip unknown tags.
+          break;
+      }
+    }
+    if (read_result != AZ_ULIB_EOF)
+    {
+      AZ_ULIB_THROW(read_result);
+    }
+
+    // Call get.
+    my_command_model_out model_out;
+    AZ_ULIB_THROW_IF_AZ_ERROR(
+        my_command((az_ulib_model_in)&model_in, (az_ulib_model_out)&model_out));
+
+    // Marshalling model_out to TLV in model_out_binary.
+    az_ulib_tlv_writer tw;
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_tlv_writer_init(&tw, *model_out_binary));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_tlv_writer_append_int32(
+        &tw, MY_INTERFACE_MY_COMMAND_RESULT_TAG, (int32_t)model_out));
+    *model_out_binary = az_ulib_tlv_writer_get_bytes_used_in_destination(&tw);
+  }
+  AZ_ULIB_CATCH(...) {}
+
+  return AZ_ULIB_TRY_RESULT;
+}
+
 static az_result my_command_async(
     az_ulib_model_in model_in,
     az_ulib_model_out model_out,
     const az_ulib_capability_token capability_token,
     const az_ulib_capability_cancellation_callback cancel)
 {
-  (void)model_in;
-  (void)model_out;
-  (void)capability_token;
-  (void)cancel;
+  const my_command_async_model_in* const in = (const my_command_async_model_in* const)model_in;
+  my_command_async_model_out* result = (my_command_async_model_out*)model_out;
+
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(&g_is_running);
+  switch (in->capability)
+  {
+    case MY_COMMAND_ASYNC_CAPABILITY_JUST_RETURN:
+      *result = in->return_result;
+      break;
+    case MY_COMMAND_ASYNC_CAPABILITY_WAIT_CANCEL:
+      while (cancel(capability_token) == AZ_OK)
+      {
+        az_pal_os_sleep(1);
+      }
+      *result = AZ_ERROR_CANCELED;
+      break;
+    default:
+      *result = AZ_ERROR_ITEM_NOT_FOUND;
+      break;
+  }
+  (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&g_is_running);
 
   return AZ_OK;
 }
@@ -245,9 +334,12 @@ static az_result my_command_async_span_wrapper(
   return AZ_OK;
 }
 
+volatile long g_count_cancel;
+
 static az_result my_command_cancel(const az_ulib_capability_token capability_token)
 {
   (void)capability_token;
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(&g_count_cancel);
 
   return AZ_OK;
 }
@@ -265,10 +357,11 @@ static const az_ulib_capability_descriptor
             set_my_property_span_wrapper),
         AZ_ULIB_DESCRIPTOR_ADD_TELEMETRY(MY_INTERFACE_MY_TELEMETRY_NAME),
         AZ_ULIB_DESCRIPTOR_ADD_TELEMETRY(MY_INTERFACE_MY_TELEMETRY2_NAME),
-        AZ_ULIB_DESCRIPTOR_ADD_COMMAND(
+        AZ_ULIB_DESCRIPTOR_ADD_COMMAND_WITH_BINARY(
             MY_INTERFACE_MY_COMMAND_NAME,
             my_command,
-            my_command_span_wrapper),
+            my_command_span_wrapper,
+            my_command_binary_wrapper),
         AZ_ULIB_DESCRIPTOR_ADD_COMMAND_ASYNC(
             MY_INTERFACE_MY_COMMAND_ASYNC_NAME,
             my_command_async,
@@ -0,0 +1,186 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "az_ulib_bench.h"
+#include "az_ulib_config.h"
+#include "az_ulib_port.h"
+#include "az_ulib_test_thread.h"
+
+#ifdef _WIN32
+#include "windows.h"
+#else
+#include <time.h>
+#endif
+
+#define BENCH_MAX_THREADS 64
+
+typedef struct
+{
+  az_ulib_bench_func func;
+  void* context;
+  uint32_t thread_index;
+  uint32_t iterations;
+} bench_thread;
+
+static volatile long g_ready_threads;
+static volatile long g_start;
+static uint32_t g_reported;
+
+uint32_t g_az_ulib_bench_max_threads = 4;
+
+uint64_t az_ulib_bench_now_ns(void)
+{
+#ifdef _WIN32
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  (void)QueryPerformanceFrequency(&frequency);
+  (void)QueryPerformanceCounter(&counter);
+  return (uint64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+#else
+  struct timespec now;
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static int bench_thread_func(void* arg)
+{
+  bench_thread* thread = (bench_thread*)arg;
+
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(&g_ready_threads);
+  while (g_start == 0)
+  {
+  }
+
+  thread->func(thread->context, thread->thread_index, thread->iterations);
+
+  return 0;
+}
+
+uint64_t az_ulib_bench_run(
+    az_ulib_bench_func func,
+    void* context,
+    uint32_t threads,
+    uint32_t iterations)
+{
+  bench_thread thread_list[BENCH_MAX_THREADS];
+  THREAD_HANDLE thread_handle[BENCH_MAX_THREADS];
+  uint32_t created = 0;
+
+  if (threads > BENCH_MAX_THREADS)
+  {
+    threads = BENCH_MAX_THREADS;
+  }
+
+  g_ready_threads = 0;
+  g_start = 0;
+
+  for (uint32_t i = 0; i < threads; i++)
+  {
+    thread_list[i].func = func;
+    thread_list[i].context = context;
+    thread_list[i].thread_index = i;
+    thread_list[i].iterations = iterations;
+    if (test_thread_create(&(thread_handle[i]), bench_thread_func, &(thread_list[i]))
+        != TEST_THREAD_OK)
+    {
+      (void)fprintf(stderr, "Failed to create benchmark thread %u\r\n", i);
+      break;
+    }
+    created++;
+  }
+
+  while (g_ready_threads < (long)created)
+  {
+  }
+
+  uint64_t start_time = az_ulib_bench_now_ns();
+  g_start = 1;
+
+  for (uint32_t i = 0; i < created; i++)
+  {
+    (void)test_thread_join(thread_handle[i], NULL);
+  }
+
+  return az_ulib_bench_now_ns() - start_time;
+}
+
+void az_ulib_bench_begin(void)
+{
+  g_reported = 0;
+
+  (void)printf("{\n  \"config\": {");
+  (void)printf(
+      "\"ipc_unpublish\": %s, ",
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+      "true"
+#else
+      "false"
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  );
+  (void)printf(
+      "\"ipc_async\": %s, ",
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+      "true"
+#else
+      "false"
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+  );
+  (void)printf(
+      "\"ipc_segmented_registry\": %s, ",
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+      "true"
+#else
+      "false"
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+  );
+  (void)printf(
+      "\"ipc_stats\": %s, ",
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+      "true"
+#else
+      "false"
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+  );
+  (void)printf(
+      "\"ipc_trace\": %s, ",
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+      "true"
+#else
+      "false"
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
+  );
+  (void)printf(
+      "\"ipc_running_shards\": %u, \"max_threads\": %u},\n  \"results\": [",
+      (unsigned)AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS,
+      g_az_ulib_bench_max_threads);
+}
+
+void az_ulib_bench_end(void) { (void)printf("\n  ]\n}\n"); }
+
+void az_ulib_bench_report(
+    const char* name,
+    uint32_t threads,
+    uint64_t operations,
+    uint64_t elapsed_ns)
+{
+  double ns_per_op = (operations == 0) ? 0.0 : (double)elapsed_ns / (double)operations;
+  double mops = (elapsed_ns == 0) ? 0.0 : ((double)operations * 1000.0) / (double)elapsed_ns;
+
+  (void)printf(
+      "%s\n    {\"name\": \"%s\", \"threads\": %u, \"ops\": %llu, \"elapsed_ns\": %llu, "
+      "\"ns_per_op\": %.2f, \"mops\": %.2f}",
+      (g_reported == 0) ? "" : ",",
+      name,
+      threads,
+      (unsigned long long)operations,
+      (unsigned long long)elapsed_ns,
+      ns_per_op,
+      mops);
+  (void)fflush(stdout);
+  g_reported++;
+}
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#ifndef AZ_ULIB_BENCH_H
+#define AZ_ULIB_BENCH_H
+
+#ifdef __cplusplus
+#include <cstdint>
+extern "C"
+{
+#else
+#include <stdint.h>
+#endif
+
+  /*
+   * Function executed by each thread of a benchmark. It shall execute the measured operation
+   * `iterations` times.
+   */
+  typedef void (*az_ulib_bench_func)(void* context, uint32_t thread_index, uint32_t iterations);
+
+  /*
+   * Maximum number of threads that the multi-threaded benchmarks shall use.
+   */
+  extern uint32_t g_az_ulib_bench_max_threads;
+
+  /*
+   * Returns a monotonic time in nanoseconds.
+   */
+  uint64_t az_ulib_bench_now_ns(void);
+
+  /*
+   * Runs `func` in `threads` threads that start at the same time, and returns the elapsed time in
+   * nanoseconds, from the start of the threads up to the end of the last one.
+   */
+  uint64_t az_ulib_bench_run(
+      az_ulib_bench_func func,
+      void* context,
+      uint32_t threads,
+      uint32_t iterations);
+
+  /*
+   * Starts the JSON document with the results, reporting the IPC configuration of the build, so the
+   * results of builds with different options can be compared.
+   */
+  void az_ulib_bench_begin(void);
+
+  /*
+   * Ends the JSON document with the results.
+   */
+  void az_ulib_bench_end(void);
+
+  /*
+   * Reports the result of one benchmark as an entry of the `results` array.
+   */
+  void az_ulib_bench_report(
+      const char* name,
+      uint32_t threads,
+      uint64_t operations,
+      uint64_t elapsed_ns);
+
+  /*
+   * Benchmark suites.
+   */
+  void az_ulib_ipc_bench(void);
+  void az_ulib_ustream_bench(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AZ_ULIB_BENCH_H */
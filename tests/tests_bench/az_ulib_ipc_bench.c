@@ -0,0 +1,676 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "az_ulib_bench.h"
+#include "az_ulib_config.h"
+#include "az_ulib_ipc_api.h"
+#include "az_ulib_port.h"
+#include "az_ulib_result.h"
+#include "az_ulib_test_my_interface.h"
+#include "az_ulib_tlv.h"
+#include "azure/az_core.h"
+
+#define IPC_BENCH_LOOKUP_ITERATIONS 1000000
+#define IPC_BENCH_CALL_ITERATIONS 200000
+#define IPC_BENCH_BATCH_SIZE 8
+#define IPC_BENCH_MARSHALLING_BUFFER_SIZE 64
+#define IPC_BENCH_RUNNING_COUNT_ITERATIONS 2000000
+#define IPC_BENCH_UNPUBLISH_ITERATIONS 1000
+#define IPC_BENCH_REGISTRY_LOOKUP_ITERATIONS 200000
+#define IPC_BENCH_REGISTRY_NAME_SIZE 16
+#define IPC_BENCH_CAPABILITY_ITERATIONS 200000
+#define IPC_BENCH_CAPABILITY_SIZE ((AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE >> 1) + 1)
+#define IPC_BENCH_CAPABILITY_NAME_SIZE 24
+
+/*
+ * Running counter with the same layout as the shards of the IPC interface.
+ */
+typedef struct
+{
+  AZ_ULIB_PORT_CACHE_ALIGNED volatile long running_count[2];
+} running_counter;
+
+static running_counter g_running_counter_list[AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS];
+static volatile const void* g_running_descriptor = &g_running_counter_list;
+static volatile long g_running_epoch = 0;
+
+static az_ulib_ipc g_ipc;
+
+static void try_get_interface_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  (void)context;
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    az_ulib_ipc_interface_handle interface_handle;
+    if ((az_ulib_ipc_try_get_interface(
+             AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+             MY_INTERFACE_1_123_INTERFACE_VERSION,
+             AZ_ULIB_VERSION_EQUALS_TO,
+             &interface_handle)
+         != AZ_OK)
+        || (az_ulib_ipc_release_interface(interface_handle) != AZ_OK))
+    {
+      (void)fprintf(stderr, "ipc_try_get_interface failed\r\n");
+      break;
+    }
+  }
+}
+
+/*
+ * Lookup throughput: each thread gets and releases the same interface, so all threads share the
+ * registry and the ref_count of the interface.
+ */
+static void ipc_try_get_interface_bench(void)
+{
+  for (uint32_t threads = 1; threads <= g_az_ulib_bench_max_threads; threads <<= 1)
+  {
+    uint64_t elapsed = az_ulib_bench_run(
+        try_get_interface_func, NULL, threads, IPC_BENCH_LOOKUP_ITERATIONS);
+    az_ulib_bench_report(
+        "ipc_try_get_interface",
+        threads,
+        (uint64_t)threads * IPC_BENCH_LOOKUP_ITERATIONS,
+        elapsed);
+  }
+}
+
+/*
+ * Same sequence of atomics as the unpublish interlock around each call.
+ */
+static void running_count_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  running_counter* counter
+      = &(g_running_counter_list
+              [(context == NULL) ? 0 : (thread_index & (AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS - 1))]);
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    long epoch = g_running_epoch;
+    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(counter->running_count[epoch]));
+    if (g_running_descriptor == NULL)
+    {
+      (void)fprintf(stderr, "running_count failed\r\n");
+      break;
+    }
+    if ((AZ_ULIB_PORT_ATOMIC_DEC_W(&(counter->running_count[epoch])) == 0)
+        && (epoch != g_running_epoch))
+    {
+      (void)fprintf(stderr, "running_count failed\r\n");
+      break;
+    }
+  }
+}
+
+/*
+ * Thread-local epoch announcement: each thread publishes the epoch that it entered in its own
+ * cache line, and clears it when it leaves. The announcement needs a full barrier before the
+ * descriptor is read, so unpublish cannot miss a call that is about to use it.
+ */
+static void announce_epoch_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  volatile long* announcement
+      = &(((running_counter*)context)[thread_index & (AZ_ULIB_CONFIG_IPC_RUNNING_SHARDS - 1)]
+              .running_count[0]);
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    *announcement = g_running_epoch + 1;
+    AZ_ULIB_PORT_MEMORY_BARRIER();
+    if (g_running_descriptor == NULL)
+    {
+      (void)fprintf(stderr, "announce_epoch failed\r\n");
+      break;
+    }
+    *announcement = 0;
+  }
+}
+
+/*
+ * Contention on the running counter: all threads update a single shared counter, as the IPC did
+ * before the counter was sharded, or each thread updates its own cache aligned shard. The
+ * announcement of a thread-local epoch is the alternative that the shards replace, for
+ * comparison.
+ */
+static void ipc_running_count_bench(void)
+{
+  for (uint32_t threads = 1; threads <= g_az_ulib_bench_max_threads; threads <<= 1)
+  {
+    uint64_t operations = (uint64_t)threads * IPC_BENCH_RUNNING_COUNT_ITERATIONS;
+    uint64_t elapsed = az_ulib_bench_run(
+        running_count_func, NULL, threads, IPC_BENCH_RUNNING_COUNT_ITERATIONS);
+    az_ulib_bench_report("ipc_running_count_shared", threads, operations, elapsed);
+    elapsed = az_ulib_bench_run(
+        running_count_func,
+        g_running_counter_list,
+        threads,
+        IPC_BENCH_RUNNING_COUNT_ITERATIONS);
+    az_ulib_bench_report("ipc_running_count_sharded", threads, operations, elapsed);
+    elapsed = az_ulib_bench_run(
+        announce_epoch_func, g_running_counter_list, threads, IPC_BENCH_RUNNING_COUNT_ITERATIONS);
+    az_ulib_bench_report("ipc_running_count_announce", threads, operations, elapsed);
+  }
+}
+
+static void call_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  az_ulib_ipc_interface_handle interface_handle = (az_ulib_ipc_interface_handle)context;
+  my_command_model_in in = { .capability = MY_COMMAND_CAPABILITY_JUST_RETURN,
+                             .return_result = AZ_OK };
+  az_result out[IPC_BENCH_BATCH_SIZE];
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    for (uint32_t command = 0; command < IPC_BENCH_BATCH_SIZE; command++)
+    {
+      if (az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out[command]) != AZ_OK)
+      {
+        (void)fprintf(stderr, "ipc_call failed\r\n");
+        return;
+      }
+    }
+  }
+}
+
+static void call_batch_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  az_ulib_ipc_interface_handle interface_handle = (az_ulib_ipc_interface_handle)context;
+  my_command_model_in in = { .capability = MY_COMMAND_CAPABILITY_JUST_RETURN,
+                             .return_result = AZ_OK };
+  az_result out[IPC_BENCH_BATCH_SIZE];
+  az_ulib_ipc_call_entry entries[IPC_BENCH_BATCH_SIZE];
+  az_result results[IPC_BENCH_BATCH_SIZE];
+  (void)thread_index;
+
+  for (uint32_t command = 0; command < IPC_BENCH_BATCH_SIZE; command++)
+  {
+    entries[command].command_index = MY_INTERFACE_MY_COMMAND;
+    entries[command].model_in = &in;
+    entries[command].model_out = &out[command];
+  }
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    if (az_ulib_ipc_call_batch(interface_handle, entries, IPC_BENCH_BATCH_SIZE, results, true)
+        != AZ_OK)
+    {
+      (void)fprintf(stderr, "ipc_call_batch failed\r\n");
+      return;
+    }
+  }
+}
+
+/*
+ * Dispatch cost: each thread calls the same sequence of IPC_BENCH_BATCH_SIZE commands in the same
+ * interface, first with one az_ulib_ipc_call() per command, and then with a single
+ * az_ulib_ipc_call_batch(). The reported operations are commands.
+ */
+static void ipc_call_bench(void)
+{
+  az_ulib_ipc_interface_handle interface_handle;
+  if (az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle)
+      != AZ_OK)
+  {
+    (void)fprintf(stderr, "ipc_call benchmark failed to get the interface\r\n");
+    return;
+  }
+
+  for (uint32_t threads = 1; threads <= g_az_ulib_bench_max_threads; threads <<= 1)
+  {
+    uint64_t operations = (uint64_t)threads * IPC_BENCH_CALL_ITERATIONS * IPC_BENCH_BATCH_SIZE;
+    uint64_t elapsed
+        = az_ulib_bench_run(call_func, interface_handle, threads, IPC_BENCH_CALL_ITERATIONS);
+    az_ulib_bench_report("ipc_call", threads, operations, elapsed);
+    elapsed
+        = az_ulib_bench_run(call_batch_func, interface_handle, threads, IPC_BENCH_CALL_ITERATIONS);
+    az_ulib_bench_report("ipc_call_batch", threads, operations, elapsed);
+  }
+
+  if (az_ulib_ipc_release_interface(interface_handle) != AZ_OK)
+  {
+    (void)fprintf(stderr, "ipc_call benchmark failed to release the interface\r\n");
+  }
+}
+
+static void call_with_str_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  az_ulib_ipc_interface_handle interface_handle = (az_ulib_ipc_interface_handle)context;
+  az_span in = AZ_SPAN_LITERAL_FROM_STR("{\"capability\":0,\"return_result\":0}");
+  uint8_t buf[IPC_BENCH_MARSHALLING_BUFFER_SIZE];
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    az_span out = AZ_SPAN_FROM_BUFFER(buf);
+    if (az_ulib_ipc_call_with_str(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ipc_call_with_str failed\r\n");
+      return;
+    }
+  }
+}
+
+static void call_with_binary_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  az_ulib_ipc_interface_handle interface_handle = (az_ulib_ipc_interface_handle)context;
+  uint8_t in_buf[IPC_BENCH_MARSHALLING_BUFFER_SIZE];
+  uint8_t buf[IPC_BENCH_MARSHALLING_BUFFER_SIZE];
+  az_ulib_tlv_writer tw;
+  (void)thread_index;
+
+  if ((az_ulib_tlv_writer_init(&tw, AZ_SPAN_FROM_BUFFER(in_buf)) != AZ_OK)
+      || (az_ulib_tlv_writer_append_uint32(
+              &tw, MY_INTERFACE_MY_COMMAND_CAPABILITY_TAG, MY_COMMAND_CAPABILITY_JUST_RETURN)
+          != AZ_OK)
+      || (az_ulib_tlv_writer_append_int32(&tw, MY_INTERFACE_MY_COMMAND_RETURN_RESULT_TAG, AZ_OK)
+          != AZ_OK))
+  {
+    (void)fprintf(stderr, "ipc_call_with_binary failed to marshal the model\r\n");
+    return;
+  }
+  az_span in = az_ulib_tlv_writer_get_bytes_used_in_destination(&tw);
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    az_span out = AZ_SPAN_FROM_BUFFER(buf);
+    if (az_ulib_ipc_call_with_binary(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ipc_call_with_binary failed\r\n");
+      return;
+    }
+  }
+}
+
+/*
+ * Marshalling cost: a single thread calls the same command with the model in JSON and in TLV. The
+ * ipc_call result in ipc_call_bench() is the baseline without marshalling.
+ */
+static void ipc_call_marshalling_bench(void)
+{
+  az_ulib_ipc_interface_handle interface_handle;
+  if (az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle)
+      != AZ_OK)
+  {
+    (void)fprintf(stderr, "ipc_call_with_str benchmark failed to get the interface\r\n");
+    return;
+  }
+
+  uint64_t elapsed
+      = az_ulib_bench_run(call_with_str_func, interface_handle, 1, IPC_BENCH_CALL_ITERATIONS);
+  az_ulib_bench_report("ipc_call_with_str", 1, IPC_BENCH_CALL_ITERATIONS, elapsed);
+  elapsed
+      = az_ulib_bench_run(call_with_binary_func, interface_handle, 1, IPC_BENCH_CALL_ITERATIONS);
+  az_ulib_bench_report("ipc_call_with_binary", 1, IPC_BENCH_CALL_ITERATIONS, elapsed);
+
+  if (az_ulib_ipc_release_interface(interface_handle) != AZ_OK)
+  {
+    (void)fprintf(stderr, "ipc_call_with_str benchmark failed to release the interface\r\n");
+  }
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+static volatile long g_unpublish_done;
+
+/*
+ * Thread 0 unpublishes and publishes MY_INTERFACE_2 again, measuring each unpublish, while all the
+ * other threads keep calling a command in the same interface.
+ */
+static void unpublish_under_load_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  uint64_t* latency = (uint64_t*)context;
+
+  if (thread_index == 0)
+  {
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+      uint64_t start = az_ulib_bench_now_ns();
+      if (az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_WAIT_FOREVER) != AZ_OK)
+      {
+        (void)fprintf(stderr, "ipc_unpublish failed\r\n");
+        break;
+      }
+      uint64_t elapsed = az_ulib_bench_now_ns() - start;
+      latency[0] += elapsed;
+      if (elapsed > latency[1])
+      {
+        latency[1] = elapsed;
+      }
+      if (az_ulib_test_my_interface_2_v123_publish(NULL) != AZ_OK)
+      {
+        (void)fprintf(stderr, "ipc_publish failed\r\n");
+        break;
+      }
+    }
+    (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&g_unpublish_done, 1);
+  }
+  else
+  {
+    my_command_model_in in = { .capability = MY_COMMAND_CAPABILITY_JUST_RETURN,
+                               .return_result = AZ_OK };
+    az_result out;
+
+    while (g_unpublish_done == 0)
+    {
+      az_ulib_ipc_interface_handle interface_handle;
+      if (az_ulib_ipc_try_get_interface(
+              AZ_SPAN_FROM_STR(MY_INTERFACE_2_123_INTERFACE_NAME),
+              MY_INTERFACE_2_123_INTERFACE_VERSION,
+              AZ_ULIB_VERSION_EQUALS_TO,
+              &interface_handle)
+          == AZ_OK)
+      {
+        while ((g_unpublish_done == 0)
+               && (az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out)
+                   == AZ_OK))
+        {
+        }
+        if (az_ulib_ipc_release_interface(interface_handle) != AZ_OK)
+        {
+          (void)fprintf(stderr, "ipc_release_interface failed\r\n");
+          break;
+        }
+      }
+    }
+  }
+}
+
+/*
+ * Unpublish latency under 100% call load: the average and the worst az_ulib_ipc_unpublish() with
+ * AZ_ULIB_WAIT_FOREVER while the other threads call the interface in a tight loop. The reported
+ * threads are the ones calling the interface.
+ */
+static void ipc_unpublish_under_load_bench(void)
+{
+  for (uint32_t callers = 1; callers <= g_az_ulib_bench_max_threads; callers <<= 1)
+  {
+    uint64_t latency[2] = { 0, 0 };
+    g_unpublish_done = 0;
+    (void)az_ulib_bench_run(
+        unpublish_under_load_func, latency, callers + 1, IPC_BENCH_UNPUBLISH_ITERATIONS);
+    az_ulib_bench_report(
+        "ipc_unpublish_under_load", callers, IPC_BENCH_UNPUBLISH_ITERATIONS, latency[0]);
+    az_ulib_bench_report("ipc_unpublish_under_load_max", callers, 1, latency[1]);
+  }
+}
+
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+static char g_capability_name_list[IPC_BENCH_CAPABILITY_SIZE][IPC_BENCH_CAPABILITY_NAME_SIZE];
+static az_ulib_capability_descriptor g_capability_list[IPC_BENCH_CAPABILITY_SIZE];
+static az_ulib_interface_descriptor g_indexed_descriptor = AZ_ULIB_DESCRIPTOR_CREATE(
+    "BENCH_CAPABILITIES",
+    1,
+    IPC_BENCH_CAPABILITY_SIZE - 1,
+    g_capability_list);
+static az_ulib_interface_descriptor g_not_indexed_descriptor = AZ_ULIB_DESCRIPTOR_CREATE(
+    "BENCH_CAPABILITIES",
+    2,
+    IPC_BENCH_CAPABILITY_SIZE,
+    g_capability_list);
+
+static void try_get_capability_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  const az_ulib_interface_descriptor* interface_descriptor
+      = (const az_ulib_interface_descriptor*)context;
+  az_ulib_ipc_interface_handle interface_handle;
+  (void)thread_index;
+
+  if (az_ulib_ipc_try_get_interface(
+          interface_descriptor->_internal.name,
+          interface_descriptor->_internal.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle)
+      != AZ_OK)
+  {
+    (void)fprintf(stderr, "ipc_try_get_capability failed to get the interface\r\n");
+    return;
+  }
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    az_ulib_capability_index capability_index;
+    if (az_ulib_ipc_try_get_capability(
+            interface_handle,
+            g_capability_list[i % interface_descriptor->_internal.size]._internal.name,
+            &capability_index)
+        != AZ_OK)
+    {
+      (void)fprintf(stderr, "ipc_try_get_capability failed\r\n");
+      break;
+    }
+  }
+
+  if (az_ulib_ipc_release_interface(interface_handle) != AZ_OK)
+  {
+    (void)fprintf(stderr, "ipc_try_get_capability failed to release the interface\r\n");
+  }
+}
+
+/*
+ * Late binding cost: resolve all capability names of an interface, round robin, in an interface
+ * that fits in the capability index, and in an interface with one more capability, which is
+ * searched linearly. Names are long and share a prefix, as in generated interfaces.
+ */
+static void ipc_try_get_capability_bench(void)
+{
+  for (int i = 0; i < IPC_BENCH_CAPABILITY_SIZE; i++)
+  {
+    int name_size = snprintf(
+        g_capability_name_list[i], IPC_BENCH_CAPABILITY_NAME_SIZE, "generated_command_%d", i);
+    az_ulib_capability_descriptor capability
+        = { ._internal = { .name = az_span_create((uint8_t*)g_capability_name_list[i], name_size),
+                           .flags = (uint8_t)AZ_ULIB_CAPABILITY_TYPE_COMMAND } };
+    (void)memcpy(&g_capability_list[i], &capability, sizeof(capability));
+  }
+
+  if ((az_ulib_ipc_publish(&g_indexed_descriptor, NULL) != AZ_OK)
+      || (az_ulib_ipc_publish(&g_not_indexed_descriptor, NULL) != AZ_OK))
+  {
+    (void)fprintf(stderr, "ipc_try_get_capability benchmark failed to publish the interfaces\r\n");
+  }
+  else
+  {
+    uint64_t elapsed = az_ulib_bench_run(
+        try_get_capability_func,
+        &g_indexed_descriptor,
+        1,
+        IPC_BENCH_CAPABILITY_ITERATIONS);
+    az_ulib_bench_report(
+        "ipc_try_get_capability_indexed", 1, IPC_BENCH_CAPABILITY_ITERATIONS, elapsed);
+    elapsed = az_ulib_bench_run(
+        try_get_capability_func,
+        &g_not_indexed_descriptor,
+        1,
+        IPC_BENCH_CAPABILITY_ITERATIONS);
+    az_ulib_bench_report(
+        "ipc_try_get_capability_linear", 1, IPC_BENCH_CAPABILITY_ITERATIONS, elapsed);
+  }
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  if ((az_ulib_ipc_unpublish(&g_indexed_descriptor, AZ_ULIB_NO_WAIT) != AZ_OK)
+      || (az_ulib_ipc_unpublish(&g_not_indexed_descriptor, AZ_ULIB_NO_WAIT) != AZ_OK))
+  {
+    (void)fprintf(
+        stderr, "ipc_try_get_capability benchmark failed to unpublish the interfaces\r\n");
+  }
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+}
+
+/*
+ * Registry with synthetic interfaces, named BENCH_<n>, version 1, without capabilities.
+ */
+typedef struct
+{
+  az_ulib_interface_descriptor* descriptor_list;
+  char* name_list;
+  uint32_t size;
+} registry;
+
+static void registry_lookup_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  registry* bench_registry = (registry*)context;
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    az_ulib_ipc_interface_handle interface_handle;
+    uint32_t interface_index = (i * 7919) % bench_registry->size;
+    if ((az_ulib_ipc_try_get_interface(
+             bench_registry->descriptor_list[interface_index]._internal.name,
+             1,
+             AZ_ULIB_VERSION_EQUALS_TO,
+             &interface_handle)
+         != AZ_OK)
+        || (az_ulib_ipc_release_interface(interface_handle) != AZ_OK))
+    {
+      (void)fprintf(stderr, "ipc_registry_lookup failed\r\n");
+      break;
+    }
+  }
+}
+
+static bool registry_init(registry* bench_registry, uint32_t max_size)
+{
+  bench_registry->size = 0;
+  bench_registry->descriptor_list
+      = (az_ulib_interface_descriptor*)malloc(sizeof(az_ulib_interface_descriptor) * max_size);
+  bench_registry->name_list = (char*)malloc((size_t)IPC_BENCH_REGISTRY_NAME_SIZE * max_size);
+  return (bench_registry->descriptor_list != NULL) && (bench_registry->name_list != NULL);
+}
+
+/*
+ * Publish synthetic interfaces up to `size` interfaces in the registry, or up to the first failure,
+ * so each size measures the lookup in a registry with all the previous interfaces.
+ */
+static void registry_grow(registry* bench_registry, uint32_t size)
+{
+  for (uint32_t i = bench_registry->size; i < size; i++)
+  {
+    char* name = &(bench_registry->name_list[i * IPC_BENCH_REGISTRY_NAME_SIZE]);
+    int name_size = snprintf(name, IPC_BENCH_REGISTRY_NAME_SIZE, "BENCH_%u", (unsigned)i);
+    az_ulib_interface_descriptor descriptor
+        = { ._internal = { .name = az_span_create((uint8_t*)name, (int32_t)name_size),
+                           .version = 1,
+                           .size = 0,
+                           .capability_list = NULL } };
+    (void)memcpy(&(bench_registry->descriptor_list[i]), &descriptor, sizeof(descriptor));
+    if (az_ulib_ipc_publish(&(bench_registry->descriptor_list[i]), NULL) != AZ_OK)
+    {
+      break;
+    }
+    bench_registry->size++;
+  }
+}
+
+static void registry_deinit(registry* bench_registry)
+{
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  for (uint32_t i = 0; i < bench_registry->size; i++)
+  {
+    if (az_ulib_ipc_unpublish(&(bench_registry->descriptor_list[i]), AZ_ULIB_NO_WAIT) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ipc_registry_lookup failed to unpublish\r\n");
+    }
+  }
+  free(bench_registry->descriptor_list);
+  free(bench_registry->name_list);
+#else
+  // Without unpublish, the interfaces stay in the registry up to the end of the process, so their
+  // descriptors shall stay valid.
+  (void)bench_registry;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+}
+
+/*
+ * Lookup cost as the registry grows: a single thread gets and releases interfaces spread over
+ * registries with 10, 1k, and 10k synthetic interfaces. The fixed registry stops at
+ * AZ_ULIB_CONFIG_MAX_IPC_INTERFACE, so the name of each result contains the number of interfaces
+ * actually published.
+ */
+static void ipc_registry_lookup_bench(void)
+{
+  static const uint32_t size_list[] = { 10, 1000, 10000 };
+  registry bench_registry;
+
+  if (registry_init(&bench_registry, size_list[(sizeof(size_list) / sizeof(size_list[0])) - 1]))
+  {
+    for (size_t i = 0; i < sizeof(size_list) / sizeof(size_list[0]); i++)
+    {
+      char name[40];
+      uint32_t last_size = bench_registry.size;
+      registry_grow(&bench_registry, size_list[i]);
+      if ((bench_registry.size != 0) && ((i == 0) || (bench_registry.size != last_size)))
+      {
+        uint64_t elapsed = az_ulib_bench_run(
+            registry_lookup_func, &bench_registry, 1, IPC_BENCH_REGISTRY_LOOKUP_ITERATIONS);
+        (void)snprintf(
+            name, sizeof(name), "ipc_registry_lookup_%u", (unsigned)bench_registry.size);
+        az_ulib_bench_report(name, 1, IPC_BENCH_REGISTRY_LOOKUP_ITERATIONS, elapsed);
+      }
+    }
+  }
+  else
+  {
+    (void)fprintf(stderr, "ipc_registry_lookup benchmark failed to allocate the registry\r\n");
+  }
+
+  registry_deinit(&bench_registry);
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+static const az_ulib_ipc_allocator g_allocator = { malloc, free };
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+void az_ulib_ipc_bench(void)
+{
+  if (
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+      (az_ulib_ipc_init_with_allocator(&g_ipc, &g_allocator) != AZ_OK)
+#else
+      (az_ulib_ipc_init(&g_ipc) != AZ_OK)
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+      || (az_ulib_test_my_interface_1_v123_publish(NULL) != AZ_OK)
+      || (az_ulib_test_my_interface_1_v2_publish(NULL) != AZ_OK)
+      || (az_ulib_test_my_interface_2_v123_publish(NULL) != AZ_OK))
+  {
+    (void)fprintf(stderr, "Failed to initialize the IPC benchmark\r\n");
+    return;
+  }
+
+  ipc_try_get_interface_bench();
+  ipc_call_bench();
+  ipc_call_marshalling_bench();
+  ipc_running_count_bench();
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  ipc_unpublish_under_load_bench();
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  ipc_try_get_capability_bench();
+  ipc_registry_lookup_bench();
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  if ((az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT) != AZ_OK)
+      || (az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT) != AZ_OK)
+      || (az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT) != AZ_OK)
+      || (az_ulib_ipc_deinit() != AZ_OK))
+  {
+    (void)fprintf(stderr, "Failed to release the IPC benchmark\r\n");
+  }
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+}
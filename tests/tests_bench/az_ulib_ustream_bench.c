@@ -0,0 +1,444 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "az_ulib_bench.h"
+#include "az_ulib_result.h"
+#include "az_ulib_ustream.h"
+#include "azure/az_core.h"
+
+#define USTREAM_BENCH_DATA_SIZE 4096
+#define USTREAM_BENCH_MAX_DEPTH 16
+#define USTREAM_BENCH_READ_ITERATIONS 20000
+#define USTREAM_BENCH_CLONE_ITERATIONS 1000000
+#define USTREAM_BENCH_CONCAT_ITERATIONS 100000
+#define USTREAM_BENCH_SPLIT_ITERATIONS 100000
+#define USTREAM_BENCH_CHAIN_READ_BUFFER_SIZE 256
+
+/*
+ * The ustream under test and the buffer size or the concat depth of the benchmark.
+ */
+typedef struct
+{
+  az_ulib_ustream* ustream;
+  uint32_t size;
+} ustream_bench_context;
+
+static uint8_t g_data[USTREAM_BENCH_DATA_SIZE];
+static az_ulib_ustream_data_cb g_data_cb_list[USTREAM_BENCH_MAX_DEPTH + 1];
+static az_ulib_ustream_multi_data_cb g_multi_data_list[USTREAM_BENCH_MAX_DEPTH];
+static az_ulib_ustream_rope_data_cb g_rope_data;
+static az_ulib_ustream_rope_segment g_rope_segment_list[USTREAM_BENCH_MAX_DEPTH + 1];
+static az_ulib_ustream_spans_data_cb g_spans_data;
+static az_span g_span_list[USTREAM_BENCH_MAX_DEPTH + 1];
+static offset_t g_span_end_list[USTREAM_BENCH_MAX_DEPTH + 1];
+
+/*
+ * Create a ustream with all the data in `depth + 1` segments, concatenating each segment to the
+ * previous ones, so reading the end of the data goes through `depth` multi ustreams.
+ */
+static az_result chain_create(az_ulib_ustream* chain, uint32_t depth)
+{
+  size_t segment_size = USTREAM_BENCH_DATA_SIZE / (depth + 1);
+  az_result result
+      = az_ulib_ustream_init(chain, &g_data_cb_list[0], NULL, g_data, segment_size, NULL);
+
+  for (uint32_t i = 1; (i <= depth) && (result == AZ_OK); i++)
+  {
+    size_t start = i * segment_size;
+    size_t size = (i == depth) ? (USTREAM_BENCH_DATA_SIZE - start) : segment_size;
+    az_ulib_ustream segment;
+    if ((result
+         = az_ulib_ustream_init(&segment, &g_data_cb_list[i], NULL, &g_data[start], size, NULL))
+        == AZ_OK)
+    {
+      result = az_ulib_ustream_concat(chain, &segment, &g_multi_data_list[i - 1], NULL);
+      (void)az_ulib_ustream_dispose(&segment);
+    }
+  }
+
+  return result;
+}
+
+/*
+ * Create a rope with the same `depth + 1` segments of chain_create().
+ */
+static az_result rope_create(az_ulib_ustream* rope, uint32_t depth)
+{
+  size_t segment_size = USTREAM_BENCH_DATA_SIZE / (depth + 1);
+  az_result result
+      = az_ulib_ustream_rope_init(rope, &g_rope_data, NULL, g_rope_segment_list, depth + 1);
+
+  for (uint32_t i = 0; (i <= depth) && (result == AZ_OK); i++)
+  {
+    size_t start = i * segment_size;
+    size_t size = (i == depth) ? (USTREAM_BENCH_DATA_SIZE - start) : segment_size;
+    az_ulib_ustream segment;
+    if ((result
+         = az_ulib_ustream_init(&segment, &g_data_cb_list[i], NULL, &g_data[start], size, NULL))
+        == AZ_OK)
+    {
+      result = az_ulib_ustream_rope_append(rope, &segment);
+      (void)az_ulib_ustream_dispose(&segment);
+    }
+  }
+
+  return result;
+}
+
+/*
+ * Create a spans ustream with the same `depth + 1` segments of chain_create().
+ */
+static az_result spans_create(az_ulib_ustream* spans, uint32_t depth)
+{
+  size_t segment_size = USTREAM_BENCH_DATA_SIZE / (depth + 1);
+
+  for (uint32_t i = 0; i <= depth; i++)
+  {
+    size_t start = i * segment_size;
+    size_t size = (i == depth) ? (USTREAM_BENCH_DATA_SIZE - start) : segment_size;
+    g_span_list[i] = az_span_create(&g_data[start], (int32_t)size);
+  }
+
+  return az_ulib_ustream_init_from_spans(
+      spans, &g_spans_data, NULL, g_span_list, g_span_end_list, depth + 1);
+}
+
+static az_result read_all(az_ulib_ustream* ustream, uint8_t* buffer, size_t buffer_size)
+{
+  az_result result;
+  size_t returned_size;
+
+  if ((result = az_ulib_ustream_reset(ustream)) == AZ_OK)
+  {
+    while ((result = az_ulib_ustream_read(ustream, buffer, buffer_size, &returned_size)) == AZ_OK)
+    {
+    }
+  }
+
+  return (result == AZ_ULIB_EOF) ? AZ_OK : result;
+}
+
+static void read_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  ustream_bench_context* bench_context = (ustream_bench_context*)context;
+  uint8_t buffer[USTREAM_BENCH_DATA_SIZE];
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    if (read_all(bench_context->ustream, buffer, bench_context->size) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_read failed\r\n");
+      break;
+    }
+  }
+}
+
+static az_result peek_all(az_ulib_ustream* ustream)
+{
+  az_result result;
+  const uint8_t* data;
+  size_t size;
+
+  if ((result = az_ulib_ustream_reset(ustream)) == AZ_OK)
+  {
+    while (((result = az_ulib_ustream_peek(ustream, &data, &size)) == AZ_OK)
+           && ((result = az_ulib_ustream_advance(ustream, size)) == AZ_OK))
+    {
+    }
+  }
+
+  return (result == AZ_ULIB_EOF) ? AZ_OK : result;
+}
+
+static void peek_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  ustream_bench_context* bench_context = (ustream_bench_context*)context;
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    if (peek_all(bench_context->ustream) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_peek failed\r\n");
+      break;
+    }
+  }
+}
+
+/*
+ * Copy cost: a single thread reads all the data of a ustream with a single buffer, using user
+ * buffers of 16, 256, and 4k bytes, and with peek and advance, which do not copy the data. The
+ * reported operations are full reads of the data.
+ */
+static void ustream_read_bench(void)
+{
+  static const uint32_t buffer_size_list[] = { 16, 256, USTREAM_BENCH_DATA_SIZE };
+  az_ulib_ustream ustream;
+
+  if (chain_create(&ustream, 0) != AZ_OK)
+  {
+    (void)fprintf(stderr, "ustream_read benchmark failed to create the ustream\r\n");
+    return;
+  }
+
+  for (size_t i = 0; i < sizeof(buffer_size_list) / sizeof(buffer_size_list[0]); i++)
+  {
+    char name[40];
+    ustream_bench_context context = { .ustream = &ustream, .size = buffer_size_list[i] };
+    uint64_t elapsed = az_ulib_bench_run(read_func, &context, 1, USTREAM_BENCH_READ_ITERATIONS);
+    (void)snprintf(name, sizeof(name), "ustream_read_%u", (unsigned)buffer_size_list[i]);
+    az_ulib_bench_report(name, 1, USTREAM_BENCH_READ_ITERATIONS, elapsed);
+  }
+
+  ustream_bench_context context = { .ustream = &ustream, .size = 0 };
+  uint64_t elapsed = az_ulib_bench_run(peek_func, &context, 1, USTREAM_BENCH_READ_ITERATIONS);
+  az_ulib_bench_report("ustream_peek", 1, USTREAM_BENCH_READ_ITERATIONS, elapsed);
+
+  (void)az_ulib_ustream_dispose(&ustream);
+}
+
+static void clone_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  az_ulib_ustream* ustream = (az_ulib_ustream*)context;
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    az_ulib_ustream clone;
+    if (az_ulib_ustream_clone(&clone, ustream, 0) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_clone failed\r\n");
+      break;
+    }
+    (void)az_ulib_ustream_dispose(&clone);
+  }
+}
+
+/*
+ * Reference counting cost: each thread clones and disposes the same ustream, so all threads share
+ * the ref_count of its control block.
+ */
+static void ustream_clone_bench(void)
+{
+  az_ulib_ustream ustream;
+
+  if (chain_create(&ustream, 0) != AZ_OK)
+  {
+    (void)fprintf(stderr, "ustream_clone benchmark failed to create the ustream\r\n");
+    return;
+  }
+
+  for (uint32_t threads = 1; threads <= g_az_ulib_bench_max_threads; threads <<= 1)
+  {
+    uint64_t elapsed
+        = az_ulib_bench_run(clone_func, &ustream, threads, USTREAM_BENCH_CLONE_ITERATIONS);
+    az_ulib_bench_report(
+        "ustream_clone", threads, (uint64_t)threads * USTREAM_BENCH_CLONE_ITERATIONS, elapsed);
+  }
+
+  (void)az_ulib_ustream_dispose(&ustream);
+}
+
+static void concat_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  ustream_bench_context* bench_context = (ustream_bench_context*)context;
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    az_ulib_ustream chain;
+    if (chain_create(&chain, bench_context->size) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_concat failed\r\n");
+      break;
+    }
+    (void)az_ulib_ustream_dispose(&chain);
+  }
+}
+
+static void chain_read_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  ustream_bench_context* bench_context = (ustream_bench_context*)context;
+  uint8_t buffer[USTREAM_BENCH_CHAIN_READ_BUFFER_SIZE];
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    if (read_all(bench_context->ustream, buffer, sizeof(buffer)) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_concat_read failed\r\n");
+      break;
+    }
+  }
+}
+
+static void split_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  ustream_bench_context* bench_context = (ustream_bench_context*)context;
+  (void)thread_index;
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    az_ulib_ustream first;
+    az_ulib_ustream second;
+    if (az_ulib_ustream_clone(&first, bench_context->ustream, 0) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_split failed to clone\r\n");
+      break;
+    }
+    if (az_ulib_ustream_split(&first, &second, USTREAM_BENCH_DATA_SIZE / 2) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_split failed\r\n");
+      (void)az_ulib_ustream_dispose(&first);
+      break;
+    }
+    (void)az_ulib_ustream_dispose(&second);
+    (void)az_ulib_ustream_dispose(&first);
+  }
+}
+
+/*
+ * Concat depth cost: for the same data split in `depth + 1` segments, a single thread measures the
+ * concat of all segments and the dispose of the result, the read of all the data with a 256 bytes
+ * user buffer, and the clone and split of the result in the middle of the data. Depth 0 is the
+ * ustream with a single buffer. The same read is measured on a rope and on a spans ustream with the
+ * same segments.
+ */
+static void ustream_concat_bench(void)
+{
+  static const uint32_t depth_list[] = { 0, 1, 4, USTREAM_BENCH_MAX_DEPTH };
+
+  for (size_t i = 0; i < sizeof(depth_list) / sizeof(depth_list[0]); i++)
+  {
+    char name[40];
+    uint64_t elapsed;
+    az_ulib_ustream chain;
+    ustream_bench_context context = { .ustream = &chain, .size = depth_list[i] };
+
+    if (depth_list[i] != 0)
+    {
+      elapsed = az_ulib_bench_run(concat_func, &context, 1, USTREAM_BENCH_CONCAT_ITERATIONS);
+      (void)snprintf(name, sizeof(name), "ustream_concat_%u", (unsigned)depth_list[i]);
+      az_ulib_bench_report(name, 1, USTREAM_BENCH_CONCAT_ITERATIONS, elapsed);
+    }
+
+    if (chain_create(&chain, depth_list[i]) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_concat benchmark failed to create the ustream\r\n");
+      break;
+    }
+
+    elapsed = az_ulib_bench_run(chain_read_func, &context, 1, USTREAM_BENCH_READ_ITERATIONS);
+    (void)snprintf(name, sizeof(name), "ustream_concat_read_%u", (unsigned)depth_list[i]);
+    az_ulib_bench_report(name, 1, USTREAM_BENCH_READ_ITERATIONS, elapsed);
+
+    // The clone starts at the current position, so move it back to the beginning of the data.
+    if (az_ulib_ustream_reset(&chain) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_split benchmark failed to reset the ustream\r\n");
+      (void)az_ulib_ustream_dispose(&chain);
+      break;
+    }
+    elapsed = az_ulib_bench_run(split_func, &context, 1, USTREAM_BENCH_SPLIT_ITERATIONS);
+    (void)snprintf(name, sizeof(name), "ustream_split_%u", (unsigned)depth_list[i]);
+    az_ulib_bench_report(name, 1, USTREAM_BENCH_SPLIT_ITERATIONS, elapsed);
+
+    (void)az_ulib_ustream_dispose(&chain);
+
+    if (rope_create(&chain, depth_list[i]) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_rope benchmark failed to create the ustream\r\n");
+      break;
+    }
+
+    elapsed = az_ulib_bench_run(chain_read_func, &context, 1, USTREAM_BENCH_READ_ITERATIONS);
+    (void)snprintf(name, sizeof(name), "ustream_rope_read_%u", (unsigned)depth_list[i]);
+    az_ulib_bench_report(name, 1, USTREAM_BENCH_READ_ITERATIONS, elapsed);
+
+    (void)az_ulib_ustream_dispose(&chain);
+
+    if (spans_create(&chain, depth_list[i]) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_spans benchmark failed to create the ustream\r\n");
+      break;
+    }
+
+    elapsed = az_ulib_bench_run(chain_read_func, &context, 1, USTREAM_BENCH_READ_ITERATIONS);
+    (void)snprintf(name, sizeof(name), "ustream_spans_read_%u", (unsigned)depth_list[i]);
+    az_ulib_bench_report(name, 1, USTREAM_BENCH_READ_ITERATIONS, elapsed);
+
+    (void)az_ulib_ustream_dispose(&chain);
+  }
+}
+
+static void parallel_read_func(void* context, uint32_t thread_index, uint32_t iterations)
+{
+  ustream_bench_context* bench_context = (ustream_bench_context*)context;
+  uint8_t buffer[USTREAM_BENCH_CHAIN_READ_BUFFER_SIZE];
+  az_ulib_ustream clone;
+  (void)thread_index;
+
+  if (az_ulib_ustream_clone(&clone, bench_context->ustream, 0) != AZ_OK)
+  {
+    (void)fprintf(stderr, "ustream_parallel_read failed to clone\r\n");
+    return;
+  }
+
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    if (read_all(&clone, buffer, sizeof(buffer)) != AZ_OK)
+    {
+      (void)fprintf(stderr, "ustream_parallel_read failed\r\n");
+      break;
+    }
+  }
+
+  (void)az_ulib_ustream_dispose(&clone);
+}
+
+/*
+ * Shared children cost: each thread reads all the data of its own clone of the same concatenated
+ * ustream with a 256 bytes user buffer, so all threads read the same children.
+ */
+static void ustream_parallel_read_bench(void)
+{
+  az_ulib_ustream chain;
+
+  if (chain_create(&chain, 4) != AZ_OK)
+  {
+    (void)fprintf(stderr, "ustream_parallel_read benchmark failed to create the ustream\r\n");
+    return;
+  }
+
+  ustream_bench_context context = { .ustream = &chain, .size = 4 };
+  for (uint32_t threads = 1; threads <= g_az_ulib_bench_max_threads; threads <<= 1)
+  {
+    uint64_t elapsed = az_ulib_bench_run(
+        parallel_read_func, &context, threads, USTREAM_BENCH_READ_ITERATIONS);
+    az_ulib_bench_report(
+        "ustream_parallel_read_4",
+        threads,
+        (uint64_t)threads * USTREAM_BENCH_READ_ITERATIONS,
+        elapsed);
+  }
+
+  (void)az_ulib_ustream_dispose(&chain);
+}
+
+void az_ulib_ustream_bench(void)
+{
+  for (size_t i = 0; i < sizeof(g_data); i++)
+  {
+    g_data[i] = (uint8_t)i;
+  }
+
+  ustream_read_bench();
+  ustream_clone_bench();
+  ustream_concat_bench();
+  ustream_parallel_read_bench();
+}
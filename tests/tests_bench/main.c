@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "az_ulib_bench.h"
+
+/*
+ * Usage: azure_ulib_c_bench [max_threads]
+ *
+ * The results are written to stdout as a JSON document, and the errors to stderr.
+ */
+int main(int argc, char* argv[])
+{
+  if (argc > 1)
+  {
+    int max_threads = atoi(argv[1]);
+    if (max_threads > 0)
+    {
+      g_az_ulib_bench_max_threads = (uint32_t)max_threads;
+    }
+  }
+
+  az_ulib_bench_begin();
+  az_ulib_ipc_bench();
+  az_ulib_ustream_bench();
+  az_ulib_bench_end();
+
+  return 0;
+}
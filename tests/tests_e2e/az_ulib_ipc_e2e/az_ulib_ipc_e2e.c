@@ -18,12 +18,24 @@
 #include "az_ulib_pal_os_api.h"
 #include "az_ulib_query_1_model.h"
 #include "az_ulib_result.h"
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+#include "_az_ulib_ipc_stats.h"
+#include "az_ulib_stats_1_model.h"
+#endif // AZ_ULIB_CONFIG_IPC_STATS
 #include "az_ulib_test_my_interface.h"
 #include "az_ulib_test_thread.h"
 
 #include "cmocka.h"
 
 #define IPC_QUERY_1_INTERFACE_NAME "ipc_" QUERY_1_INTERFACE_NAME
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+#define IPC_STATS_1_INTERFACE_NAME "ipc_" STATS_1_INTERFACE_NAME
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+
+/* The continuation token of the query in all interfaces keeps the position of the next interface
+ * above the type in the lower 11 bits, and has no stamp. */
+#define QUERY_TOKEN_POSITION_3_STR "6151"
+#define QUERY_TOKEN_POSITION_10_STR "20487"
 
 static az_ulib_ipc g_ipc;
 
@@ -48,6 +60,25 @@ static void unpublish_interfaces_and_deinit_ipc(void)
   assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
+/* Query results and continuation tokens depend on the position of each interface in the registry,
+ * so the query tests keep the stats interface out of it. */
+static void init_ipc_without_stats_and_publish_interfaces(void)
+{
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+  assert_int_equal(_az_ulib_ipc_stats_interface_unpublish(), AZ_OK);
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+  init_ipc_and_publish_interfaces(false);
+}
+
+static void unpublish_interfaces_and_deinit_ipc_without_stats(void)
+{
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+  assert_int_equal(_az_ulib_ipc_stats_interface_publish(), AZ_OK);
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+  unpublish_interfaces_and_deinit_ipc();
+}
+
 #define NUMBER_CALLS_IN_THREAD 1000
 #define MAX_THREAD (AZ_ULIB_CONFIG_MAX_IPC_INSTANCES - 1)
 #define SMALL_NUMBER_THREAD (AZ_ULIB_CONFIG_MAX_IPC_INSTANCES >> 1)
@@ -111,12 +142,44 @@ static int call_sync_thread(void* arg)
   return (int)result;
 }
 
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+#define ASYNC_WAIT_MAX_MS 5000
+
+static volatile long g_count_result;
+static az_result g_result;
+
+static void result_callback(
+    const az_ulib_capability_token capability_token,
+    az_result result,
+    az_ulib_model_out const model_out)
+{
+  (void)capability_token;
+  (void)model_out;
+  g_result = result;
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(&g_count_result);
+}
+
+static void wait_for_result(void)
+{
+  for (int i = 0; (i < ASYNC_WAIT_MAX_MS) && (g_count_result == 0); i++)
+  {
+    az_pal_os_sleep(1);
+  }
+}
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+
 static int setup(void** state)
 {
   (void)state;
 
   g_sum_sleep = 0;
   g_lock_thread = 0;
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+  g_count_result = 0;
+  g_result = AZ_ULIB_PENDING;
+  g_is_running = 0;
+  g_count_cancel = 0;
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
 
   return 0;
 }
@@ -157,6 +220,101 @@ static void az_ulib_ipc_e2e_call_sync_command_succeed(void** state)
   unpublish_interfaces_and_deinit_ipc();
 }
 
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+static void az_ulib_ipc_e2e_call_async_command_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces(true);
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          MY_INTERFACE_1_V123._internal.name,
+          MY_INTERFACE_1_V123._internal.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_SUM;
+  in.max_sum = 10000;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+
+  /// act
+  az_result result = az_ulib_ipc_call_async(
+      interface_handle,
+      MY_INTERFACE_MY_COMMAND,
+      &in,
+      &out,
+      result_callback,
+      (az_ulib_capability_token)&out);
+  wait_for_result();
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_count_result, 1);
+  assert_int_equal(g_result, AZ_OK);
+  assert_int_equal(out, AZ_OK);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+static void az_ulib_ipc_e2e_cancel_async_running_command_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces(true);
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          MY_INTERFACE_1_V123._internal.name,
+          MY_INTERFACE_1_V123._internal.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  my_command_async_model_in in;
+  in.capability = MY_COMMAND_ASYNC_CAPABILITY_WAIT_CANCEL;
+  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(
+      az_ulib_ipc_call_async(
+          interface_handle,
+          MY_INTERFACE_MY_COMMAND_ASYNC,
+          &in,
+          &out,
+          result_callback,
+          (az_ulib_capability_token)&out),
+      AZ_OK);
+  for (int i = 0; (i < ASYNC_WAIT_MAX_MS) && (g_is_running == 0); i++)
+  {
+    az_pal_os_sleep(1);
+  }
+  assert_int_equal(g_is_running, 1);
+  assert_int_equal(
+      az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_ERROR_ULIB_BUSY);
+
+  /// act
+  az_result result = az_ulib_ipc_cancel_async((az_ulib_capability_token)&out);
+  wait_for_result();
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_count_cancel, 1);
+  assert_int_equal(g_count_result, 1);
+  assert_int_equal(g_result, AZ_OK);
+  assert_int_equal(out, AZ_ERROR_CANCELED);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+
 static void az_ulib_ipc_e2e_unpublish_interface_in_the_call_failed(void** state)
 {
   /// arrange
@@ -444,6 +602,67 @@ static void az_ulib_ipc_e2e_call_sync_command_in_multiple_threads_unpublish_time
   unpublish_interfaces_and_deinit_ipc();
 }
 
+static int release_command_thread(void* arg)
+{
+  (void)arg;
+  az_pal_os_sleep(10);
+  (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&g_lock_thread);
+  return 0;
+}
+
+static void az_ulib_ipc_e2e_call_sync_command_in_other_thread_and_unpublish_wait_forever_succeed(
+    void** state)
+{
+  /// arrange
+  (void)state;
+  g_thread_max_sum = 100;
+  init_ipc_and_publish_interfaces(true);
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          MY_INTERFACE_1_V123._internal.name,
+          MY_INTERFACE_1_V123._internal.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  THREAD_HANDLE thread_handle;
+  THREAD_HANDLE release_thread_handle;
+
+  g_is_running = 0; // Assume that the command is not running in the thread.
+
+  (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
+      &g_lock_thread, 1); // Lock the command that will run in the thread up to the release thread
+                          // unlock it.
+
+  /// act
+  // Create the thread to call the command.
+  (void)test_thread_create(&thread_handle, &call_sync_thread, interface_handle);
+
+  // Wait for the command start to work.
+  while (g_is_running == 0)
+  {
+  };
+
+  // Release the command while the unpublish is waiting for it.
+  (void)test_thread_create(&release_thread_handle, &release_command_thread, NULL);
+  az_result result = az_ulib_ipc_unpublish(&MY_INTERFACE_1_V123, AZ_ULIB_WAIT_FOREVER);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+
+  /// assert
+  int res;
+  test_thread_join(release_thread_handle, &res);
+  test_thread_join(thread_handle, &res);
+  assert_int_equal(res, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(result, AZ_OK);
+
+  /// cleanup
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
 static void az_ulib_ipc_e2e_call_sync_command_in_multiple_threads_and_unpublish_succeed(
     void** state)
 {
@@ -493,11 +712,146 @@ static void az_ulib_ipc_e2e_call_sync_command_in_multiple_threads_and_unpublish_
   assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
+#define STRESS_INTERFACE_NAME "stress.lookup"
+#define STRESS_PUBLISH_CYCLES 50000
+#define STRESS_NUMBER_PUBLISHERS 2
+#define STRESS_NUMBER_READERS 2
+
+static volatile long g_stress_running_publishers;
+
+static az_ulib_interface_descriptor* create_stress_descriptor(az_ulib_version version)
+{
+  size_t name_size = sizeof(STRESS_INTERFACE_NAME);
+  uint8_t* name = (uint8_t*)malloc(name_size);
+  az_ulib_interface_descriptor* descriptor
+      = (az_ulib_interface_descriptor*)malloc(sizeof(az_ulib_interface_descriptor));
+  assert_non_null(name);
+  assert_non_null(descriptor);
+  (void)memcpy(name, STRESS_INTERFACE_NAME, name_size);
+  az_ulib_interface_descriptor local_descriptor
+      = { ._internal = { .name = az_span_create(name, (int32_t)(name_size - 1)),
+                         .version = version,
+                         .size = 0,
+                         .capability_list = NULL } };
+  (void)memcpy(descriptor, &local_descriptor, sizeof(az_ulib_interface_descriptor));
+  return descriptor;
+}
+
+static void destroy_stress_descriptor(az_ulib_interface_descriptor* descriptor)
+{
+  uint8_t* name = az_span_ptr(descriptor->_internal.name);
+  (void)memset(name, 0xA5, (size_t)az_span_size(descriptor->_internal.name));
+  free(name);
+  free(descriptor);
+}
+
+/*
+ * Publish a descriptor whose name lives in the heap, replace it by another one, and unpublish it,
+ * releasing each name as soon as the IPC does not use it, so a lookup that reads the name of a
+ * replaced or unpublished interface reads released memory.
+ */
+static int stress_publish_thread(void* arg)
+{
+  az_result result = AZ_OK;
+  az_ulib_version version = (az_ulib_version)(uintptr_t)arg;
+
+  for (int i = 0; (i < STRESS_PUBLISH_CYCLES) && (result == AZ_OK); i++)
+  {
+    az_ulib_interface_descriptor* descriptor = create_stress_descriptor(version);
+    if ((result = az_ulib_ipc_publish(descriptor, NULL)) == AZ_OK)
+    {
+      az_ulib_interface_descriptor* new_descriptor = create_stress_descriptor(version);
+      if ((result = az_ulib_ipc_replace(descriptor, new_descriptor, 1000)) == AZ_OK)
+      {
+        destroy_stress_descriptor(descriptor);
+        descriptor = new_descriptor;
+      }
+      else
+      {
+        destroy_stress_descriptor(new_descriptor);
+      }
+      if (result == AZ_OK)
+      {
+        result = az_ulib_ipc_unpublish(descriptor, 1000);
+      }
+    }
+    destroy_stress_descriptor(descriptor);
+  }
+
+  (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&g_stress_running_publishers);
+  return (int)result;
+}
+
+static int stress_lookup_thread(void* arg)
+{
+  (void)arg;
+  az_result result = AZ_OK;
+
+  while ((g_stress_running_publishers != 0) && (result == AZ_OK))
+  {
+    az_ulib_ipc_interface_handle interface_handle;
+    if ((result = az_ulib_ipc_try_get_interface(
+             AZ_SPAN_FROM_STR(STRESS_INTERFACE_NAME), 0, AZ_ULIB_VERSION_ANY, &interface_handle))
+        == AZ_OK)
+    {
+      result = az_ulib_ipc_release_interface(interface_handle);
+    }
+    else if (result == AZ_ERROR_ITEM_NOT_FOUND)
+    {
+      result = AZ_OK;
+    }
+  }
+
+  return (int)result;
+}
+
+/*
+ * The lock-free lookups shall not read an index out of the registry or a released name while other
+ * threads publish, replace, and unpublish the interface that they look for.
+ */
+static void az_ulib_ipc_e2e_lookup_while_publish_replace_and_unpublish_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  g_stress_running_publishers = STRESS_NUMBER_PUBLISHERS;
+
+  /// act
+  THREAD_HANDLE publish_thread_handle[STRESS_NUMBER_PUBLISHERS];
+  THREAD_HANDLE lookup_thread_handle[STRESS_NUMBER_READERS];
+  for (int i = 0; i < STRESS_NUMBER_READERS; i++)
+  {
+    (void)test_thread_create(&lookup_thread_handle[i], &stress_lookup_thread, NULL);
+  }
+  for (int i = 0; i < STRESS_NUMBER_PUBLISHERS; i++)
+  {
+    (void)test_thread_create(
+        &publish_thread_handle[i], &stress_publish_thread, (void*)(uintptr_t)(i + 1));
+  }
+
+  /// assert
+  for (int i = 0; i < STRESS_NUMBER_PUBLISHERS; i++)
+  {
+    int res;
+    test_thread_join(publish_thread_handle[i], &res);
+    assert_int_equal(res, AZ_OK);
+  }
+  for (int i = 0; i < STRESS_NUMBER_READERS; i++)
+  {
+    int res;
+    test_thread_join(lookup_thread_handle[i], &res);
+    assert_int_equal(res, AZ_OK);
+  }
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
 static void az_ulib_ipc_query_query_all_interfaces_succeed(void** state)
 {
   /// arrange
   (void)state;
-  init_ipc_and_publish_interfaces(true);
+  init_ipc_without_stats_and_publish_interfaces();
 
   az_ulib_ipc_interface_handle query_handle;
   assert_int_equal(
@@ -522,18 +876,18 @@ static void az_ulib_ipc_query_query_all_interfaces_succeed(void** state)
       *out.result,
       AZ_SPAN_FROM_STR("\"ipc_query.1\",\"MY_INTERFACE_1.123\",\"MY_INTERFACE_1.2\",\"MY_INTERFACE_"
                        "2.123\",\"MY_INTERFACE_3.123\"")));
-  assert_int_equal(out.continuation_token, 0x000a00ff);
+  assert_int_equal(out.continuation_token, 0x5007);
 
   /// cleanup
   assert_int_equal(az_ulib_ipc_release_interface(query_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
+  unpublish_interfaces_and_deinit_ipc_without_stats();
 }
 
 static void az_ulib_ipc_query_query_w_str_all_interfaces_succeed(void** state)
 {
   /// arrange
   (void)state;
-  init_ipc_and_publish_interfaces(true);
+  init_ipc_without_stats_and_publish_interfaces();
 
   az_ulib_ipc_interface_handle query_handle;
   assert_int_equal(
@@ -557,18 +911,19 @@ static void az_ulib_ipc_query_query_w_str_all_interfaces_succeed(void** state)
       out,
       AZ_SPAN_FROM_STR(
           "{\"result\":[\"ipc_query.1\",\"MY_INTERFACE_1.123\",\"MY_INTERFACE_1.2\",\"MY_INTERFACE_"
-          "2.123\",\"MY_INTERFACE_3.123\"],\"continuation_token\":655615}")));
+          "2.123\",\"MY_INTERFACE_3.123\"],\"continuation_token\":" QUERY_TOKEN_POSITION_10_STR
+          "}")));
 
   /// cleanup
   assert_int_equal(az_ulib_ipc_release_interface(query_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
+  unpublish_interfaces_and_deinit_ipc_without_stats();
 }
 
 static void az_ulib_ipc_query_query_next_succeed(void** state)
 {
   /// arrange
   (void)state;
-  init_ipc_and_publish_interfaces(true);
+  init_ipc_without_stats_and_publish_interfaces();
 
   az_ulib_ipc_interface_handle query_handle;
   assert_int_equal(
@@ -590,7 +945,7 @@ static void az_ulib_ipc_query_query_next_succeed(void** state)
       az_ulib_ipc_call(query_handle, QUERY_1_QUERY_COMMAND, &query_in, &query_out), AZ_OK);
   assert_true(az_span_is_content_equal(
       *query_out.result, AZ_SPAN_FROM_STR("\"ipc_query.1\",\"MY_INTERFACE_1.123\"")));
-  assert_int_equal(query_out.continuation_token, 0x000200FF);
+  assert_int_equal(query_out.continuation_token, 0x1007);
 
   query_1_next_model_in next_in = { .continuation_token = query_out.continuation_token };
   query_result = AZ_SPAN_FROM_BUFFER(buf);
@@ -599,7 +954,7 @@ static void az_ulib_ipc_query_query_next_succeed(void** state)
       az_ulib_ipc_call(query_handle, QUERY_1_NEXT_COMMAND, &next_in, &next_out), AZ_OK);
   assert_true(az_span_is_content_equal(
       *next_out.result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.2\",\"MY_INTERFACE_2.123\"")));
-  assert_int_equal(next_out.continuation_token, 0x000400FF);
+  assert_int_equal(next_out.continuation_token, 0x2007);
 
   next_in.continuation_token = next_out.continuation_token;
   query_result = AZ_SPAN_FROM_BUFFER(buf); // reset az_span size.
@@ -607,7 +962,7 @@ static void az_ulib_ipc_query_query_next_succeed(void** state)
       az_ulib_ipc_call(query_handle, QUERY_1_NEXT_COMMAND, &next_in, &next_out), AZ_OK);
   assert_true(
       az_span_is_content_equal(*next_out.result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_3.123\"")));
-  assert_int_equal(next_out.continuation_token, 0x000a00FF);
+  assert_int_equal(next_out.continuation_token, 0x5007);
 
   next_in.continuation_token = next_out.continuation_token;
   query_result = AZ_SPAN_FROM_BUFFER(buf); // reset az_span size.
@@ -616,14 +971,14 @@ static void az_ulib_ipc_query_query_next_succeed(void** state)
 
   /// cleanup
   assert_int_equal(az_ulib_ipc_release_interface(query_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
+  unpublish_interfaces_and_deinit_ipc_without_stats();
 }
 
 static void az_ulib_ipc_query_query_next_w_str_succeed(void** state)
 {
   /// arrange
   (void)state;
-  init_ipc_and_publish_interfaces(true);
+  init_ipc_without_stats_and_publish_interfaces();
 
   az_ulib_ipc_interface_handle query_handle;
   assert_int_equal(
@@ -634,7 +989,7 @@ static void az_ulib_ipc_query_query_next_w_str_succeed(void** state)
           &query_handle),
       AZ_OK);
 
-  uint8_t buf[170]; // This buffer shall fit the JSON with 3 interfaces, so query next will have
+  uint8_t buf[100]; // This buffer shall fit the JSON with 3 interfaces, so query next will have
                     // some more interfaces to report.
 
   /// act
@@ -645,31 +1000,277 @@ static void az_ulib_ipc_query_query_next_w_str_succeed(void** state)
   assert_true(az_span_is_content_equal(
       out,
       AZ_SPAN_FROM_STR("{\"result\":[\"ipc_query.1\",\"MY_INTERFACE_1.123\",\"MY_INTERFACE_1.2\"],"
-                       "\"continuation_token\":196863}")));
+                       "\"continuation_token\":" QUERY_TOKEN_POSITION_3_STR "}")));
 
-  az_span in_1 = AZ_SPAN_LITERAL_FROM_STR("{\"continuation_token\":196863}");
+  az_span in_1
+      = AZ_SPAN_LITERAL_FROM_STR("{\"continuation_token\":" QUERY_TOKEN_POSITION_3_STR "}");
   az_span out_1 = AZ_SPAN_FROM_BUFFER(buf);
   assert_int_equal(
       az_ulib_ipc_call_with_str(query_handle, QUERY_1_NEXT_COMMAND, in_1, &out_1), AZ_OK);
   assert_true(az_span_is_content_equal(
       out_1,
       AZ_SPAN_FROM_STR("{\"result\":[\"MY_INTERFACE_2.123\",\"MY_INTERFACE_3.123\"],"
-                       "\"continuation_token\":655615}")));
+                       "\"continuation_token\":" QUERY_TOKEN_POSITION_10_STR "}")));
 
-  az_span in_2 = AZ_SPAN_LITERAL_FROM_STR("{\"continuation_token\":655615}");
+  az_span in_2
+      = AZ_SPAN_LITERAL_FROM_STR("{\"continuation_token\":" QUERY_TOKEN_POSITION_10_STR "}");
   az_span out_2 = AZ_SPAN_FROM_BUFFER(buf);
   assert_int_equal(
       az_ulib_ipc_call_with_str(query_handle, QUERY_1_NEXT_COMMAND, in_2, &out_2), AZ_ULIB_EOF);
 
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(query_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc_without_stats();
+}
+
+static void az_ulib_ipc_query_query_w_str_not_enough_space_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces(true);
+
+  az_ulib_ipc_interface_handle query_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(IPC_QUERY_1_INTERFACE_NAME),
+          QUERY_1_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &query_handle),
+      AZ_OK);
+
+  az_span in = AZ_SPAN_LITERAL_FROM_STR("{}");
+  uint8_t buf[50]; // This buffer fits the JSON without any interface.
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
+  /// act
+  az_result result = az_ulib_ipc_call_with_str(query_handle, QUERY_1_QUERY_COMMAND, in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+
   /// cleanup
   assert_int_equal(az_ulib_ipc_release_interface(query_handle), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+static void az_ulib_ipc_stats_get_w_str_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces(true);
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          MY_INTERFACE_1_V123._internal.name,
+          MY_INTERFACE_1_V123._internal.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  my_command_model_in command_in;
+  command_in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  command_in.return_result = AZ_OK;
+  az_result command_out = AZ_ULIB_PENDING;
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &command_in, &command_out),
+      AZ_OK);
+
+  az_ulib_ipc_interface_handle stats_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(IPC_STATS_1_INTERFACE_NAME),
+          STATS_1_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &stats_handle),
+      AZ_OK);
+
+  az_span in = AZ_SPAN_LITERAL_FROM_STR("{\"name\":\"MY_INTERFACE_1\",\"version\":123}");
+  uint8_t buf[1000];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
+  /// act
+  az_result result = az_ulib_ipc_call_with_str(stats_handle, STATS_1_GET_COMMAND, in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_is_content_equal(
+      az_span_slice(out, 0, 108),
+      AZ_SPAN_FROM_STR("{\"capabilities\":[{\"name\":\"my_property\",\"calls\":0,\"errors\":0,"
+                       "\"latency_us\":[0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0]},")));
+  assert_true(
+      az_span_find(
+          out,
+          AZ_SPAN_FROM_STR("{\"name\":\"my_command\",\"calls\":1,\"errors\":0,\"latency_us\":["))
+      > 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(stats_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* The stats get shall copy the capability names to the names buffer, so they are still valid
+ * after the interface is unpublished. */
+static void az_ulib_ipc_stats_get_copy_names_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces(true);
+
+  az_ulib_ipc_interface_handle stats_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(IPC_STATS_1_INTERFACE_NAME),
+          STATS_1_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &stats_handle),
+      AZ_OK);
+
+  stats_1_get_model_in in
+      = { .name = MY_INTERFACE_1_V123._internal.name,
+          .version = MY_INTERFACE_1_V123._internal.version };
+  az_ulib_ipc_capability_stats capabilities[2];
+  uint8_t names[50];
+  stats_1_get_model_out out = { .capabilities = capabilities,
+                                .capabilities_size = 2,
+                                .names = AZ_SPAN_FROM_BUFFER(names) };
+
+  /// act
+  az_result result = az_ulib_ipc_call(stats_handle, STATS_1_GET_COMMAND, &in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(out.capabilities_size, 2);
+  assert_ptr_equal(az_span_ptr(capabilities[0].name), names);
+  assert_ptr_equal(az_span_ptr(capabilities[1].name), &names[az_span_size(capabilities[0].name)]);
+  assert_true(az_span_is_content_equal(
+      capabilities[0].name, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_PROPERTY_NAME)));
+  assert_true(az_span_is_content_equal(
+      capabilities[1].name, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_TELEMETRY_NAME)));
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(stats_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the names buffer cannot hold all capability names, the stats get shall fail with not enough
+ * space. */
+static void az_ulib_ipc_stats_get_names_not_enough_space_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces(true);
+
+  az_ulib_ipc_interface_handle stats_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(IPC_STATS_1_INTERFACE_NAME),
+          STATS_1_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &stats_handle),
+      AZ_OK);
+
+  stats_1_get_model_in in
+      = { .name = MY_INTERFACE_1_V123._internal.name,
+          .version = MY_INTERFACE_1_V123._internal.version };
+  az_ulib_ipc_capability_stats capabilities[2];
+  uint8_t names[15];
+  stats_1_get_model_out out = { .capabilities = capabilities,
+                                .capabilities_size = 2,
+                                .names = AZ_SPAN_FROM_BUFFER(names) };
+
+  /// act
+  az_result result = az_ulib_ipc_call(stats_handle, STATS_1_GET_COMMAND, &in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(stats_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+
+#if defined(AZ_ULIB_CONFIG_IPC_TRACE) && defined(AZ_ULIB_PORT_THREAD_LOCAL)
+#define TRACE_THREADS 2
+
+static int call_once_thread(void* arg)
+{
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+
+  az_result result
+      = az_ulib_ipc_call((az_ulib_ipc_interface_handle)arg, MY_INTERFACE_MY_COMMAND, &in, &out);
+
+  return (int)((result == AZ_OK) ? out : result);
+}
+
+static void az_ulib_ipc_trace_dump_calls_in_multiple_threads_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces(true);
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          MY_INTERFACE_1_V123._internal.name,
+          MY_INTERFACE_1_V123._internal.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  az_ulib_ipc_trace_enable(true);
+  for (int i = 0; i < TRACE_THREADS; i++)
+  {
+    THREAD_HANDLE thread_handle;
+    int res;
+    (void)test_thread_create(&thread_handle, &call_once_thread, interface_handle);
+    test_thread_join(thread_handle, &res);
+    assert_int_equal(res, AZ_OK);
+  }
+  az_ulib_ipc_trace_enable(false);
+  uint8_t buf[1000];
+  az_span trace = AZ_SPAN_FROM_BUFFER(buf);
+
+  /// act
+  az_result result = az_ulib_ipc_trace_dump(&trace);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  int32_t tid[TRACE_THREADS * 2];
+  az_span remaining = trace;
+  for (int i = 0; i < (TRACE_THREADS * 2); i++)
+  {
+    int32_t begin = az_span_find(remaining, AZ_SPAN_FROM_STR("\"tid\":"));
+    assert_true(begin >= 0);
+    remaining = az_span_slice_to_end(remaining, begin + 6);
+    assert_int_equal(
+        az_span_atoi32(
+            az_span_slice(remaining, 0, az_span_find(remaining, AZ_SPAN_FROM_STR(","))), &tid[i]),
+        AZ_OK);
+  }
+  assert_int_equal(az_span_find(remaining, AZ_SPAN_FROM_STR("\"tid\":")), -1);
+  assert_int_equal(tid[0], tid[1]);
+  assert_int_equal(tid[2], tid[3]);
+  assert_int_not_equal(tid[0], tid[2]);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+#endif // defined(AZ_ULIB_CONFIG_IPC_TRACE) && defined(AZ_ULIB_PORT_THREAD_LOCAL)
+
 int az_ulib_ipc_e2e()
 {
   const struct CMUnitTest tests[] = {
     cmocka_unit_test_setup(az_ulib_ipc_e2e_call_sync_command_succeed, setup),
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+    cmocka_unit_test_setup(az_ulib_ipc_e2e_call_async_command_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_e2e_cancel_async_running_command_succeed, setup),
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
     cmocka_unit_test_setup(az_ulib_ipc_e2e_unpublish_interface_in_the_call_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_e2e_release_interface_in_the_call_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_e2e_deinit_ipc_in_the_call_failed, setup),
@@ -679,12 +1280,26 @@ int az_ulib_ipc_e2e()
     cmocka_unit_test_setup(az_ulib_ipc_e2e_call_sync_command_in_multiple_threads_succeed, setup),
     cmocka_unit_test_setup(
         az_ulib_ipc_e2e_call_sync_command_in_multiple_threads_unpublish_timeout_failed, setup),
+    cmocka_unit_test_setup(
+        az_ulib_ipc_e2e_call_sync_command_in_other_thread_and_unpublish_wait_forever_succeed,
+        setup),
     cmocka_unit_test_setup(
         az_ulib_ipc_e2e_call_sync_command_in_multiple_threads_and_unpublish_succeed, setup),
+    cmocka_unit_test_setup(
+        az_ulib_ipc_e2e_lookup_while_publish_replace_and_unpublish_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_query_query_all_interfaces_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_query_query_w_str_all_interfaces_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_query_query_next_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_query_query_next_w_str_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_query_w_str_not_enough_space_failed, setup),
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+    cmocka_unit_test_setup(az_ulib_ipc_stats_get_w_str_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_stats_get_copy_names_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_stats_get_names_not_enough_space_failed, setup),
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+#if defined(AZ_ULIB_CONFIG_IPC_TRACE) && defined(AZ_ULIB_PORT_THREAD_LOCAL)
+    cmocka_unit_test_setup(az_ulib_ipc_trace_dump_calls_in_multiple_threads_succeed, setup),
+#endif // defined(AZ_ULIB_CONFIG_IPC_TRACE) && defined(AZ_ULIB_PORT_THREAD_LOCAL)
   };
 
   return cmocka_run_group_tests_name("az_ulib_ipc_e2e", tests, NULL, NULL);
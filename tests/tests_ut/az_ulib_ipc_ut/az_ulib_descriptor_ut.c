@@ -65,6 +65,14 @@ static az_result my_command_span_wrapper(az_span model_in_span, az_span* model_o
   return AZ_OK;
 }
 
+static az_result my_command_binary_wrapper(az_span model_in_binary, az_span* model_out_binary)
+{
+  (void)model_in_binary;
+  (void)model_out_binary;
+
+  return AZ_OK;
+}
+
 static az_result my_command_async(
     az_ulib_model_in model_in,
     az_ulib_model_out model_out,
@@ -198,6 +206,30 @@ static void az_ulib_descriptor_AZ_ULIB_DESCRIPTOR_ADD_COMMAND_succeed(void** sta
   /// cleanup
 }
 
+/* The AZ_ULIB_DESCRIPTOR_ADD_COMMAND_WITH_BINARY shall create an descriptor for a command with
+ * name, pointer to the command, and the span and binary wrappers. */
+static void az_ulib_descriptor_AZ_ULIB_DESCRIPTOR_ADD_COMMAND_WITH_BINARY_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  const char command_name[] = "my_command";
+
+  /// act
+  static az_ulib_capability_descriptor capability = AZ_ULIB_DESCRIPTOR_ADD_COMMAND_WITH_BINARY(
+      "my_command", my_command, my_command_span_wrapper, my_command_binary_wrapper);
+
+  /// assert
+  assert_int_equal(az_span_size(capability._internal.name), _az_COUNTOF(command_name) - 1);
+  assert_memory_equal(
+      az_span_ptr(capability._internal.name), command_name, _az_COUNTOF(command_name) - 1);
+  assert_ptr_equal(capability._internal.capability_ptr_1.command, my_command);
+  assert_ptr_equal(capability._internal.span_wrapper_ptr_1.command, my_command_span_wrapper);
+  assert_ptr_equal(capability._internal.binary_wrapper_ptr_1.command, my_command_binary_wrapper);
+  assert_int_equal(capability._internal.flags, (uint8_t)AZ_ULIB_CAPABILITY_TYPE_COMMAND);
+
+  /// cleanup
+}
+
 /* The AZ_ULIB_DESCRIPTOR_ADD_COMMAND_ASYNC shall create an descriptor for an async command with
  * name and pointer to the command and the cancellation command. */
 static void az_ulib_descriptor_AZ_ULIB_DESCRIPTOR_ADD_COMMAND_ASYNC_w_null_wrapper_succeed(
@@ -412,6 +444,7 @@ int az_ulib_descriptor_ut()
     cmocka_unit_test(az_ulib_descriptor_AZ_ULIB_DESCRIPTOR_ADD_PROPERTY_succeed),
     cmocka_unit_test(az_ulib_descriptor_AZ_ULIB_DESCRIPTOR_ADD_COMMAND_w_null_wrapper_succeed),
     cmocka_unit_test(az_ulib_descriptor_AZ_ULIB_DESCRIPTOR_ADD_COMMAND_succeed),
+    cmocka_unit_test(az_ulib_descriptor_AZ_ULIB_DESCRIPTOR_ADD_COMMAND_WITH_BINARY_succeed),
     cmocka_unit_test(
         az_ulib_descriptor_AZ_ULIB_DESCRIPTOR_ADD_COMMAND_ASYNC_w_null_wrapper_succeed),
     cmocka_unit_test(az_ulib_descriptor_AZ_ULIB_DESCRIPTOR_ADD_COMMAND_ASYNC_succeed),
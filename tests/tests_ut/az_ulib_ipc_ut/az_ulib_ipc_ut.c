@@ -6,16 +6,19 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "_az_ulib_ipc_query.h"
+#include "_az_ulib_ipc_stats.h"
 #include "az_ulib_capability_api.h"
 #include "az_ulib_descriptor_api.h"
 #include "az_ulib_ipc_api.h"
 #include "az_ulib_ipc_ut.h"
 #include "az_ulib_pal_os_api.h"
 #include "az_ulib_result.h"
+#include "az_ulib_tlv.h"
 #include "azure/az_core.h"
 
 #include "az_ulib_test_my_interface.h"
@@ -24,6 +27,17 @@
 
 #include "cmocka.h"
 
+/* Interfaces that az_ulib_ipc_init publishes by itself. */
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+#define IPC_INIT_INTERFACES 2
+#else
+#define IPC_INIT_INTERFACES 1
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+
+/* The lower 15 bits of the continuation token keep the type, the reserved, and a position in the
+ * registry smaller than 16. The stamp in the bits above it depends on the size of the registry. */
+#define QUERY_TOKEN_POSITION_MASK 0x7FFFU
+
 az_ulib_pal_os_lock* g_lock;
 int8_t g_lock_diff;
 int8_t g_count_acquire;
@@ -61,11 +75,203 @@ void az_pal_os_sleep(uint32_t sleep_time_ms)
   g_count_sleep++;
 }
 
+az_ulib_pal_os_thread_function g_thread_function;
+int8_t g_count_thread;
+int8_t g_count_post;
+
+bool az_pal_os_thread_create(
+    az_ulib_pal_os_thread* thread,
+    az_ulib_pal_os_thread_function function,
+    void* arg)
+{
+  (void)thread;
+  (void)arg;
+  g_thread_function = function;
+  g_count_thread++;
+  return true;
+}
+
+void az_pal_os_thread_join(az_ulib_pal_os_thread* thread)
+{
+  (void)thread;
+  g_count_thread--;
+}
+
+void az_pal_os_semaphore_init(az_ulib_pal_os_semaphore* semaphore, uint32_t initial_count)
+{
+  (void)semaphore;
+  (void)initial_count;
+}
+
+void az_pal_os_semaphore_deinit(az_ulib_pal_os_semaphore* semaphore) { (void)semaphore; }
+
+void az_pal_os_semaphore_wait(az_ulib_pal_os_semaphore* semaphore) { (void)semaphore; }
+
+void az_pal_os_semaphore_post(az_ulib_pal_os_semaphore* semaphore)
+{
+  (void)semaphore;
+  g_count_post++;
+}
+
+int8_t g_count_event_set;
+int8_t g_count_event_wait;
+
+void az_pal_os_event_init(az_ulib_pal_os_event* event) { (void)event; }
+
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event) { (void)event; }
+
+void az_pal_os_event_set(az_ulib_pal_os_event* event)
+{
+  (void)event;
+  g_count_event_set++;
+}
+
+bool az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms)
+{
+  (void)event;
+  (void)wait_option_ms;
+  g_count_event_wait++;
+  return false;
+}
+
+uint32_t g_clock_us;
+uint32_t g_clock_step_us;
+
+/*
+ * Each read of the mocked clock moves it g_clock_step_us ahead, so a call measured between two
+ * reads takes g_clock_step_us.
+ */
+uint32_t az_pal_os_clock_us(void)
+{
+  uint32_t clock_us = g_clock_us;
+  g_clock_us += g_clock_step_us;
+  return clock_us;
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+/*
+ * The mocked semaphore never blocks, so the worker function runs all calls in the queue and
+ * returns when the queue is empty.
+ */
+static void run_async_worker(void) { g_thread_function(NULL); }
+
+static az_ulib_capability_token g_result_token;
+static az_result g_result;
+static int8_t g_count_result;
+
+static void result_callback(
+    const az_ulib_capability_token capability_token,
+    az_result result,
+    az_ulib_model_out const model_out)
+{
+  (void)model_out;
+  g_result_token = capability_token;
+  g_result = result;
+  g_count_result++;
+}
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+
 static az_ulib_ipc g_ipc;
 
-static void init_ipc_and_publish_interfaces(void)
+static int8_t g_count_subscription_event;
+static az_ulib_ipc_event g_subscription_event;
+static az_span g_subscription_name;
+static az_ulib_version g_subscription_version;
+static az_ulib_ipc_interface_handle g_subscription_interface_handle;
+static az_result g_subscription_unsubscribe_result;
+
+static void subscription_callback(
+    az_ulib_ipc_event event,
+    az_span name,
+    az_ulib_version version,
+    az_ulib_ipc_interface_handle interface_handle,
+    void* context)
+{
+  g_subscription_event = event;
+  g_subscription_name = name;
+  g_subscription_version = version;
+  g_subscription_interface_handle = interface_handle;
+  g_count_subscription_event++;
+
+  // The context carries the subscription that shall try to unsubscribe itself.
+  if (context != NULL)
+  {
+    g_subscription_unsubscribe_result = az_ulib_ipc_unsubscribe(
+        *(az_ulib_ipc_subscription_handle*)context, AZ_ULIB_NO_WAIT);
+  }
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+static int g_count_allocate;
+static int g_count_release;
+
+static void* test_allocate(size_t size)
+{
+  g_count_allocate++;
+  return malloc(size);
+}
+
+static void test_release(void* ptr)
+{
+  g_count_release++;
+  free(ptr);
+}
+
+static const az_ulib_ipc_allocator g_test_allocator = { test_allocate, test_release };
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+/*
+ * Interfaces for the az_ulib_ipc_replace tests. The command returns the number of the
+ * implementation that ran. If g_replace_new_descriptor is not NULL, the first implementation
+ * replaces itself by it while it runs.
+ */
+static const az_ulib_interface_descriptor* g_replace_old_descriptor;
+static const az_ulib_interface_descriptor* g_replace_new_descriptor;
+static az_result g_replace_in_command_result;
+
+static az_result replace_command_1(az_ulib_model_in model_in, az_ulib_model_out model_out)
+{
+  (void)model_in;
+  if (g_replace_new_descriptor != NULL)
+  {
+    g_replace_in_command_result = az_ulib_ipc_replace(
+        g_replace_old_descriptor, g_replace_new_descriptor, AZ_ULIB_NO_WAIT);
+  }
+  *((uint32_t*)model_out) = 1;
+  return AZ_OK;
+}
+
+static az_result replace_command_2(az_ulib_model_in model_in, az_ulib_model_out model_out)
+{
+  (void)model_in;
+  *((uint32_t*)model_out) = 2;
+  return AZ_OK;
+}
+
+#define REPLACE_COMMAND 1
+
+static const az_ulib_capability_descriptor REPLACE_CAPABILITIES_1[2]
+    = { AZ_ULIB_DESCRIPTOR_ADD_TELEMETRY("telemetry"),
+        AZ_ULIB_DESCRIPTOR_ADD_COMMAND("command", replace_command_1, NULL) };
+static const az_ulib_capability_descriptor REPLACE_CAPABILITIES_2[2]
+    = { AZ_ULIB_DESCRIPTOR_ADD_TELEMETRY("telemetry"),
+        AZ_ULIB_DESCRIPTOR_ADD_COMMAND("command", replace_command_2, NULL) };
+static const az_ulib_capability_descriptor REPLACE_OTHER_CAPABILITIES[2]
+    = { AZ_ULIB_DESCRIPTOR_ADD_TELEMETRY("telemetry"),
+        AZ_ULIB_DESCRIPTOR_ADD_COMMAND("other_command", replace_command_2, NULL) };
+static const az_ulib_interface_descriptor REPLACE_DESCRIPTOR_1
+    = AZ_ULIB_DESCRIPTOR_CREATE("REPLACE", 1, 2, REPLACE_CAPABILITIES_1);
+static const az_ulib_interface_descriptor REPLACE_DESCRIPTOR_2
+    = AZ_ULIB_DESCRIPTOR_CREATE("REPLACE", 1, 2, REPLACE_CAPABILITIES_2);
+static const az_ulib_interface_descriptor REPLACE_OTHER_CAPABILITIES_DESCRIPTOR
+    = AZ_ULIB_DESCRIPTOR_CREATE("REPLACE", 1, 2, REPLACE_OTHER_CAPABILITIES);
+static const az_ulib_interface_descriptor REPLACE_OTHER_VERSION_DESCRIPTOR
+    = AZ_ULIB_DESCRIPTOR_CREATE("REPLACE", 2, 2, REPLACE_CAPABILITIES_2);
+static const az_ulib_interface_descriptor REPLACE_FEWER_CAPABILITIES_DESCRIPTOR
+    = AZ_ULIB_DESCRIPTOR_CREATE("REPLACE", 1, 1, REPLACE_CAPABILITIES_2);
+
+static void publish_interfaces(void)
 {
-  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_1_v2_publish(NULL), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_2_v123_publish(NULL), AZ_OK);
@@ -110,12 +316,43 @@ static void init_ipc_and_publish_interfaces(void)
   g_count_acquire = 0;
 }
 
-static void unpublish_interfaces_and_deinit_ipc(void)
+static void unpublish_interfaces(void)
 {
   assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+}
+
+static void init_ipc_and_publish_interfaces(void)
+{
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  publish_interfaces();
+}
+
+static void unpublish_interfaces_and_deinit_ipc(void)
+{
+  unpublish_interfaces();
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* Query results and continuation tokens depend on the position of each interface in the registry,
+ * so the query tests keep the stats interface out of it. */
+static void init_ipc_without_stats_and_publish_interfaces(void)
+{
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+  assert_int_equal(_az_ulib_ipc_stats_interface_unpublish(), AZ_OK);
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+  publish_interfaces();
+}
+
+static void unpublish_interfaces_and_deinit_ipc_without_stats(void)
+{
+  unpublish_interfaces();
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+  assert_int_equal(_az_ulib_ipc_stats_interface_publish(), AZ_OK);
+#endif // AZ_ULIB_CONFIG_IPC_STATS
   assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
@@ -131,6 +368,26 @@ static int setup(void** state)
   g_lock_diff = 0;
   g_count_acquire = 0;
   g_count_sleep = 0;
+  g_count_thread = 0;
+  g_count_post = 0;
+  g_count_event_set = 0;
+  g_count_event_wait = 0;
+  g_clock_us = 0;
+  g_clock_step_us = 0;
+  g_replace_old_descriptor = NULL;
+  g_replace_new_descriptor = NULL;
+  g_replace_in_command_result = AZ_ULIB_PENDING;
+  g_count_subscription_event = 0;
+  g_subscription_event = AZ_ULIB_IPC_EVENT_PUBLISH;
+  g_subscription_name = AZ_SPAN_EMPTY;
+  g_subscription_version = 0;
+  g_subscription_interface_handle = NULL;
+  g_subscription_unsubscribe_result = AZ_ULIB_PENDING;
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+  g_result_token = NULL;
+  g_result = AZ_ULIB_PENDING;
+  g_count_result = 0;
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
 
   return 0;
 }
@@ -170,6 +427,22 @@ static void az_ulib_ipc_init_double_initialization_failed(void** state)
   assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+/* If the provided allocator is NULL, the az_ulib_ipc_init_with_allocator shall fail with
+ * precondition. */
+static void az_ulib_ipc_init_with_allocator_with_null_allocator_failed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_init_with_allocator(&g_ipc, NULL));
+
+  /// cleanup
+}
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
 /* If the IPC was not initialized, the az_ulib_ipc_deinit shall fail with precondition. */
 static void az_ulib_ipc_deinit_with_ipc_not_initialized_failed(void** state)
 {
@@ -239,6 +512,81 @@ static void az_ulib_ipc_unpublish_with_null_descriptor_failed(void** state)
   assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
+/* If the ipc was not initialized, the az_ulib_ipc_replace shall fail with precondition. */
+static void az_ulib_ipc_replace_with_ipc_not_initialized_failed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_replace(&REPLACE_DESCRIPTOR_1, &REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT));
+
+  /// cleanup
+}
+
+/* If the old descriptor is NULL, the az_ulib_ipc_replace shall fail with precondition. */
+static void az_ulib_ipc_replace_with_null_old_descriptor_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_replace(NULL, &REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT));
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the new descriptor is NULL, the az_ulib_ipc_replace shall fail with precondition. */
+static void az_ulib_ipc_replace_with_null_new_descriptor_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_replace(&REPLACE_DESCRIPTOR_1, NULL, AZ_ULIB_NO_WAIT));
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the ipc was not initialized, the az_ulib_ipc_wait_replaced shall fail with precondition. */
+static void az_ulib_ipc_wait_replaced_with_ipc_not_initialized_failed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_wait_replaced(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT));
+
+  /// cleanup
+}
+
+/* If the descriptor is NULL, the az_ulib_ipc_wait_replaced shall fail with precondition. */
+static void az_ulib_ipc_wait_replaced_with_null_descriptor_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_wait_replaced(NULL, AZ_ULIB_NO_WAIT));
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
 /* If the provided interface name is NULL, the az_ulib_ipc_try_get_interface shall fail with
  * precondition. */
 static void az_ulib_ipc_try_get_interface_with_null_name_failed(void** state)
@@ -299,6 +647,42 @@ static void az_ulib_ipc_try_get_interface_with_ipc_not_initialized_failed(void**
   /// cleanup
 }
 
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+/* If the descriptor is NULL, the az_ulib_ipc_get_contract shall fail with precondition. */
+static void az_ulib_ipc_get_contract_with_null_descriptor_failed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_get_contract(NULL));
+
+  /// cleanup
+}
+
+/* If the provided handle is NULL, the az_ulib_ipc_try_get_interface_with_contract shall fail with
+ * precondition. */
+static void az_ulib_ipc_try_get_interface_with_contract_with_null_handle_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_try_get_interface_with_contract(
+      AZ_SPAN_FROM_STR("REPLACE"),
+      1,
+      AZ_ULIB_VERSION_EQUALS_TO,
+      az_ulib_ipc_get_contract(&REPLACE_DESCRIPTOR_1),
+      NULL));
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+
 /* If the provided interface name is NULL, the az_ulib_ipc_try_get_capability shall fail with
  * precondition. */
 static void az_ulib_ipc_try_get_capability_with_null_name_failed(void** state)
@@ -489,437 +873,3134 @@ static void az_ulib_ipc_release_interface_with_ipc_not_initialized_failed(void**
   /// cleanup
 }
 
-/* If the IPC is not initialized, the az_ulib_ipc_call shall fail with precondition. */
-static void az_ulib_ipc_call_with_ipc_not_initialized_failed(void** state)
+/* If the IPC is not initialized, the az_ulib_ipc_subscribe shall fail with precondition. */
+static void az_ulib_ipc_subscribe_with_ipc_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
-  my_command_model_in in;
-  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
-  in.return_result = AZ_OK;
-  az_result out = AZ_ULIB_PENDING;
+  az_ulib_ipc_subscription_filter filter
+      = { AZ_SPAN_LITERAL_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME), 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle;
 
   /// act
   /// assert
   AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
-      az_ulib_ipc_call((az_ulib_ipc_interface_handle)0x1234, MY_INTERFACE_MY_COMMAND, &in, &out));
+      az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle));
 
   /// cleanup
 }
 
-/* If the interface handle is NULL, the az_ulib_ipc_call shall fail with precondition. */
-static void az_ulib_ipc_call_with_null_interface_handle_failed(void** state)
+/* If the filter is NULL, the az_ulib_ipc_subscribe shall fail with precondition. */
+static void az_ulib_ipc_subscribe_with_null_filter_failed(void** state)
 {
   /// arrange
   (void)state;
-  init_ipc_and_publish_interfaces();
-
-  my_command_model_in in;
-  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
-  in.return_result = AZ_OK;
-  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_handle subscription_handle;
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call(NULL, MY_INTERFACE_MY_COMMAND, &in, &out));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_subscribe(NULL, subscription_callback, NULL, &subscription_handle));
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If the IPC is not initialized, the az_ulib_ipc_call_with_str shall fail with precondition. */
-static void az_ulib_ipc_call_with_str_with_ipc_not_initialized_failed(void** state)
+/* If the callback is NULL, the az_ulib_ipc_subscribe shall fail with precondition. */
+static void az_ulib_ipc_subscribe_with_null_callback_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
-  uint8_t buf[100];
-  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter
+      = { AZ_SPAN_LITERAL_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME), 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle;
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_with_str(
-      (az_ulib_ipc_interface_handle)0x1234, MY_INTERFACE_MY_COMMAND, in, &out));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_subscribe(&filter, NULL, NULL, &subscription_handle));
 
   /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If the interface handle is NULL, the az_ulib_ipc_call_with_str shall fail with precondition. */
-static void az_ulib_ipc_call_with_str_with_null_interface_handle_failed(void** state)
+/* If the subscription handle is NULL, the az_ulib_ipc_subscribe shall fail with precondition. */
+static void az_ulib_ipc_subscribe_with_null_subscription_handle_failed(void** state)
 {
   /// arrange
   (void)state;
-  init_ipc_and_publish_interfaces();
-
-  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
-  uint8_t buf[100];
-  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter
+      = { AZ_SPAN_LITERAL_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME), 0, AZ_ULIB_VERSION_ANY };
 
   /// act
   /// assert
   AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
-      az_ulib_ipc_call_with_str(NULL, MY_INTERFACE_MY_COMMAND, in, &out));
+      az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, NULL));
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If the IPC is not initialized, the az_ulib_ipc_query shall fail with precondition. */
-static void az_ulib_ipc_query_with_ipc_not_initialized_failed(void** state)
+/* If the IPC is not initialized, the az_ulib_ipc_unsubscribe shall fail with precondition. */
+static void az_ulib_ipc_unsubscribe_with_ipc_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
-  uint8_t buf[100];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
-  uint32_t token = 0;
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query(query, &query_result, &token));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_unsubscribe((az_ulib_ipc_subscription_handle)0x1234, AZ_ULIB_NO_WAIT));
 
   /// cleanup
 }
 
-/* If the pointer to result is NULL, the az_ulib_ipc_query shall fail with precondition. */
-static void az_ulib_ipc_query_with_null_result_failed(void** state)
+/* If the subscription handle is not an active subscription, the az_ulib_ipc_unsubscribe shall fail
+ * with precondition. */
+static void az_ulib_ipc_unsubscribe_with_invalid_subscription_handle_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
-  uint32_t token = 0;
-  init_ipc_and_publish_interfaces();
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter
+      = { AZ_SPAN_LITERAL_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME), 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle;
+  assert_int_equal(
+      az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT), AZ_OK);
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query(query, NULL, &token));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_unsubscribe((az_ulib_ipc_subscription_handle)0x1234, AZ_ULIB_NO_WAIT));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT));
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If the az_span for the result is empty, the az_ulib_ipc_query shall fail with precondition. */
-static void az_ulib_ipc_query_with_empty_result_failed(void** state)
+/* If the IPC is not initialized, the az_ulib_ipc_call shall fail with precondition. */
+static void az_ulib_ipc_call_with_ipc_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
-  az_span query_result = AZ_SPAN_EMPTY;
-  uint32_t token = 0;
-  init_ipc_and_publish_interfaces();
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query(query, &query_result, &token));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_call((az_ulib_ipc_interface_handle)0x1234, MY_INTERFACE_MY_COMMAND, &in, &out));
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the pointer to continuation token is null, the az_ulib_ipc_query shall fail with precondition.
- */
-static void az_ulib_ipc_query_with_null_continuation_token_failed(void** state)
+/* If the interface handle is NULL, the az_ulib_ipc_call shall fail with precondition. */
+static void az_ulib_ipc_call_with_null_interface_handle_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
-  uint8_t buf[100];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
   init_ipc_and_publish_interfaces();
 
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query(query, &query_result, NULL));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call(NULL, MY_INTERFACE_MY_COMMAND, &in, &out));
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the IPC is not initialized, the az_ulib_ipc_query_next shall fail with precondition. */
-static void az_ulib_ipc_query_next_with_ipc_not_initialized_failed(void** state)
+/* If the interface handle does not point to an interface in the IPC, the az_ulib_ipc_call shall
+ * fail with precondition. */
+static void az_ulib_ipc_call_with_invalid_interface_handle_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call(
+      (az_ulib_ipc_interface_handle)(uintptr_t)(AZ_ULIB_CONFIG_MAX_IPC_INTERFACE + 1),
+      MY_INTERFACE_MY_COMMAND,
+      &in,
+      &out));
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the IPC is not initialized, the az_ulib_ipc_call_with_str shall fail with precondition. */
+static void az_ulib_ipc_call_with_str_with_ipc_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
+  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
   uint8_t buf[100];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
-  uint32_t token = 0;
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query_next(&token, &query_result));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_with_str(
+      (az_ulib_ipc_interface_handle)0x1234, MY_INTERFACE_MY_COMMAND, in, &out));
 
   /// cleanup
 }
 
-/* If the pointer to result is NULL, the az_ulib_ipc_query_next shall fail with precondition. */
-static void az_ulib_ipc_query_next_with_null_result_failed(void** state)
+/* If the interface handle is NULL, the az_ulib_ipc_call_with_str shall fail with precondition. */
+static void az_ulib_ipc_call_with_str_with_null_interface_handle_failed(void** state)
 {
   /// arrange
   (void)state;
-  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
 
+  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
+  uint8_t buf[100];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query_next(&token, NULL));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_call_with_str(NULL, MY_INTERFACE_MY_COMMAND, in, &out));
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the az_span for the result is empty, the az_ulib_ipc_query_next shall fail with precondition.
- */
-static void az_ulib_ipc_query_next_with_empty_result_failed(void** state)
+/* If the IPC is not initialized, the az_ulib_ipc_call_with_binary shall fail with precondition. */
+static void az_ulib_ipc_call_with_binary_with_ipc_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query_result = AZ_SPAN_EMPTY;
-  uint32_t token = 0;
-  init_ipc_and_publish_interfaces();
+  uint8_t in_buf[] = { MY_INTERFACE_MY_COMMAND_CAPABILITY_TAG, 1, 0 };
+  az_span in = AZ_SPAN_FROM_BUFFER(in_buf);
+  uint8_t buf[100];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query_next(&token, &query_result));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_with_binary(
+      (az_ulib_ipc_interface_handle)0x1234, MY_INTERFACE_MY_COMMAND, in, &out));
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the pointer to continuation token is null, the az_ulib_ipc_query_next shall fail with
- * precondition.
+/* If the interface handle is NULL, the az_ulib_ipc_call_with_binary shall fail with precondition.
  */
-static void az_ulib_ipc_query_next_with_null_continuation_token_failed(void** state)
+static void az_ulib_ipc_call_with_binary_with_null_interface_handle_failed(void** state)
 {
   /// arrange
   (void)state;
-  uint8_t buf[100];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
   init_ipc_and_publish_interfaces();
 
+  uint8_t in_buf[] = { MY_INTERFACE_MY_COMMAND_CAPABILITY_TAG, 1, 0 };
+  az_span in = AZ_SPAN_FROM_BUFFER(in_buf);
+  uint8_t buf[100];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query_next(NULL, &query_result));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ipc_call_with_binary(NULL, MY_INTERFACE_MY_COMMAND, in, &out));
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
 }
 
-#endif // AZ_NO_PRECONDITION_CHECKING
-
-/* The az_ulib_ipc_init shall initialize the ipc control block. */
-/* The az_ulib_ipc_init shall initialize the lock mechanism. */
-static void az_ulib_ipc_init_succeed(void** state)
+/* If the IPC is not initialized, the az_ulib_ipc_call_batch shall fail with precondition. */
+static void az_ulib_ipc_call_batch_with_ipc_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
-  g_lock = NULL;
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  az_ulib_ipc_call_entry entries[1] = { { MY_INTERFACE_MY_COMMAND, &in, &out } };
+  az_result results[1];
 
   /// act
-  az_result result = az_ulib_ipc_init(&g_ipc);
-
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_non_null(g_lock);
-  assert_int_equal(g_lock_diff, 0);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_batch(
+      (az_ulib_ipc_interface_handle)0x1234, entries, 1, results, false));
+
   /// cleanup
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* The az_ulib_ipc_publish shall store the descriptor published in the IPC. The
- az_ulib_ipc_publish
- * shall be thread safe. */
-static void az_ulib_ipc_publish_succeed(void** state)
+/* If the interface handle is NULL, the az_ulib_ipc_call_batch shall fail with precondition. */
+static void az_ulib_ipc_call_batch_with_null_interface_handle_failed(void** state)
 {
   /// arrange
   (void)state;
-  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  init_ipc_and_publish_interfaces();
 
-  /// act
-  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v2_publish(NULL), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(NULL), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_3_v123_publish(NULL), AZ_OK);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  az_ulib_ipc_call_entry entries[1] = { { MY_INTERFACE_MY_COMMAND, &in, &out } };
+  az_result results[1];
 
+  /// act
   /// assert
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 5);
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_batch(NULL, entries, 1, results, false));
 
   /// cleanup
-  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
 }
 
-/* The az_ulib_ipc_publish shall return a valid handle for the published interface. */
-static void az_ulib_ipc_publish_return_handle_succeed(void** state)
+/* If the entries is NULL, the az_ulib_ipc_call_batch shall fail with precondition. */
+static void az_ulib_ipc_call_batch_with_null_entries_failed(void** state)
 {
   /// arrange
   (void)state;
-  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
-  az_ulib_ipc_interface_handle interface_handle[4];
+  init_ipc_and_publish_interfaces();
+  az_result results[1];
 
   /// act
-  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(&(interface_handle[0])), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v2_publish(&(interface_handle[1])), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(&(interface_handle[2])), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_3_v123_publish(&(interface_handle[3])), AZ_OK);
-
   /// assert
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 5);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_batch(
+      (az_ulib_ipc_interface_handle)0x1234, NULL, 1, results, false));
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the entries_size is zero, the az_ulib_ipc_call_batch shall fail with precondition. */
+static void az_ulib_ipc_call_batch_with_zero_entries_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
   my_command_model_in in;
   in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
   in.return_result = AZ_OK;
   az_result out = AZ_ULIB_PENDING;
-  assert_int_equal(
-      az_ulib_ipc_call(interface_handle[0], MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
-  assert_int_equal(out, AZ_OK);
-  az_ulib_ipc_interface_handle interface_handle_copy;
-  assert_int_equal(az_ulib_ipc_get_interface(interface_handle[0], &interface_handle_copy), AZ_OK);
-  out = AZ_ULIB_PENDING;
-  assert_int_equal(
-      az_ulib_ipc_call(interface_handle_copy, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
-  assert_int_equal(out, AZ_OK);
+  az_ulib_ipc_call_entry entries[1] = { { MY_INTERFACE_MY_COMMAND, &in, &out } };
+  az_result results[1];
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_batch(
+      (az_ulib_ipc_interface_handle)0x1234, entries, 0, results, false));
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle_copy), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the provided descriptor already exist, the az_ulib_ipc_publish shall return
- * AZ_ERROR_ULIB_ELEMENT_DUPLICATE. */
-static void az_ulib_ipc_publish_with_descriptor_with_same_name_and_version_failed(void** state)
+/* If the results is NULL, the az_ulib_ipc_call_batch shall fail with precondition. */
+static void az_ulib_ipc_call_batch_with_null_results_failed(void** state)
 {
   /// arrange
   (void)state;
-  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
-  g_count_acquire = 0;
+  init_ipc_and_publish_interfaces();
 
-  /// act
-  az_result result = az_ulib_test_my_interface_1_v123_publish(NULL);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  az_ulib_ipc_call_entry entries[1] = { { MY_INTERFACE_MY_COMMAND, &in, &out } };
 
+  /// act
   /// assert
-  assert_int_equal(result, AZ_ERROR_ULIB_ELEMENT_DUPLICATE);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_batch(
+      (az_ulib_ipc_interface_handle)0x1234, entries, 1, NULL, false));
 
   /// cleanup
-  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If there is no more memory to store a new descriptor, the az_ulib_ipc_publish shall return
- * AZ_ERROR_NOT_ENOUGH_SPACE. */
-static void az_ulib_ipc_publish_out_of_memory_failed(void** state)
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+/* If the IPC is not initialized, the az_ulib_ipc_call_async shall fail with precondition. */
+static void az_ulib_ipc_call_async_with_ipc_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
-  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
-  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - 1; i++)
-  {
-    assert_int_equal(az_ulib_test_my_interface_publish(i), AZ_OK);
-  }
-  g_count_acquire = 0;
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
 
   /// act
-  az_result result = az_ulib_test_my_interface_1_v123_publish(NULL);
-
   /// assert
-  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_async(
+      (az_ulib_ipc_interface_handle)0x1234,
+      MY_INTERFACE_MY_COMMAND,
+      &in,
+      &out,
+      result_callback,
+      (az_ulib_capability_token)0x5678));
 
   /// cleanup
-  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - 1; i++)
-  {
-    assert_int_equal(az_ulib_test_my_interface_unpublish(i), AZ_OK);
-  }
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* The az_ulib_ipc_unpublish shall remove a descriptor for the IPC. The az_ulib_ipc_unpublish shall
- * be thread safe. */
-/* The az_ulib_ipc_unpublish shall wait as long as the caller wants.*/
-static void az_ulib_ipc_unpublish_succeed(void** state)
+/* If the interface handle is NULL, the az_ulib_ipc_call_async shall fail with precondition. */
+static void az_ulib_ipc_call_async_with_null_interface_handle_failed(void** state)
 {
   /// arrange
   (void)state;
   init_ipc_and_publish_interfaces();
 
-  /// act
-  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_WAIT_FOREVER), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(10000), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
 
+  /// act
   /// assert
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 4);
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
-          MY_INTERFACE_1_2_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_2_123_INTERFACE_NAME),
-          MY_INTERFACE_2_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_3_123_INTERFACE_NAME),
-          MY_INTERFACE_3_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_ERROR_ITEM_NOT_FOUND);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_async(
+      NULL, MY_INTERFACE_MY_COMMAND, &in, &out, result_callback, (az_ulib_capability_token)0x5678));
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
 }
 
-static void az_ulib_ipc_unpublish_random_order_succeed(void** state)
+/* If the result callback is NULL, the az_ulib_ipc_call_async shall fail with precondition. */
+static void az_ulib_ipc_call_async_with_null_result_callback_failed(void** state)
 {
   /// arrange
   (void)state;
   init_ipc_and_publish_interfaces();
 
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+
   /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_call_async(
+      (az_ulib_ipc_interface_handle)0x1234,
+      MY_INTERFACE_MY_COMMAND,
+      &in,
+      &out,
+      NULL,
+      (az_ulib_capability_token)0x5678));
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the IPC is not initialized, the az_ulib_ipc_cancel_async shall fail with precondition. */
+static void az_ulib_ipc_cancel_async_with_ipc_not_initialized_failed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_cancel_async((az_ulib_capability_token)0x5678));
+
+  /// cleanup
+}
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+
+/* If the IPC is not initialized, the az_ulib_ipc_query shall fail with precondition. */
+static void az_ulib_ipc_query_with_ipc_not_initialized_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query(query, &query_result, &token));
+
+  /// cleanup
+}
+
+/* If the pointer to result is NULL, the az_ulib_ipc_query shall fail with precondition. */
+static void az_ulib_ipc_query_with_null_result_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
+  uint32_t token = 0;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query(query, NULL, &token));
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the az_span for the result is empty, the az_ulib_ipc_query shall fail with precondition. */
+static void az_ulib_ipc_query_with_empty_result_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
+  az_span query_result = AZ_SPAN_EMPTY;
+  uint32_t token = 0;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query(query, &query_result, &token));
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the pointer to continuation token is null, the az_ulib_ipc_query shall fail with precondition.
+ */
+static void az_ulib_ipc_query_with_null_continuation_token_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query(query, &query_result, NULL));
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the IPC is not initialized, the az_ulib_ipc_query_next shall fail with precondition. */
+static void az_ulib_ipc_query_next_with_ipc_not_initialized_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query_next(&token, &query_result));
+
+  /// cleanup
+}
+
+/* If the pointer to result is NULL, the az_ulib_ipc_query_next shall fail with precondition. */
+static void az_ulib_ipc_query_next_with_null_result_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint32_t token = 0;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query_next(&token, NULL));
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the az_span for the result is empty, the az_ulib_ipc_query_next shall fail with precondition.
+ */
+static void az_ulib_ipc_query_next_with_empty_result_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span query_result = AZ_SPAN_EMPTY;
+  uint32_t token = 0;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query_next(&token, &query_result));
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the pointer to continuation token is null, the az_ulib_ipc_query_next shall fail with
+ * precondition.
+ */
+static void az_ulib_ipc_query_next_with_null_continuation_token_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_query_next(NULL, &query_result));
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+/* If the pointer to trace is null, the az_ulib_ipc_trace_dump shall fail with precondition. */
+static void az_ulib_ipc_trace_dump_with_null_trace_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ipc_trace_dump(NULL));
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
+
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/* The az_ulib_ipc_init shall initialize the ipc control block. */
+/* The az_ulib_ipc_init shall initialize the lock mechanism. */
+static void az_ulib_ipc_init_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  g_lock = NULL;
+
+  /// act
+  az_result result = az_ulib_ipc_init(&g_ipc);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_non_null(g_lock);
+  assert_int_equal(g_lock_diff, 0);
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_publish shall store the descriptor published in the IPC. The
+ az_ulib_ipc_publish
+ * shall be thread safe. */
+static void az_ulib_ipc_publish_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_publish(NULL), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(NULL), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_publish(NULL), AZ_OK);
+
+  /// assert
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 4);
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+
+  /// cleanup
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_publish shall return a valid handle for the published interface. */
+static void az_ulib_ipc_publish_return_handle_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  g_count_acquire = 0;
+  az_ulib_ipc_interface_handle interface_handle[4];
+
+  /// act
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(&(interface_handle[0])), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_publish(&(interface_handle[1])), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(&(interface_handle[2])), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_publish(&(interface_handle[3])), AZ_OK);
+
+  /// assert
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 4);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle[0], MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
+  assert_int_equal(out, AZ_OK);
+  az_ulib_ipc_interface_handle interface_handle_copy;
+  assert_int_equal(az_ulib_ipc_get_interface(interface_handle[0], &interface_handle_copy), AZ_OK);
+  out = AZ_ULIB_PENDING;
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle_copy, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
+  assert_int_equal(out, AZ_OK);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle_copy), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the provided descriptor already exist, the az_ulib_ipc_publish shall return
+ * AZ_ERROR_ULIB_ELEMENT_DUPLICATE. */
+static void az_ulib_ipc_publish_with_descriptor_with_same_name_and_version_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_test_my_interface_1_v123_publish(NULL);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_ELEMENT_DUPLICATE);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If there is no more memory to store a new descriptor, the az_ulib_ipc_publish shall return
+ * AZ_ERROR_NOT_ENOUGH_SPACE. */
+static void az_ulib_ipc_publish_out_of_memory_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - IPC_INIT_INTERFACES; i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_publish(i), AZ_OK);
+  }
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_test_my_interface_1_v123_publish(NULL);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - IPC_INIT_INTERFACES; i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_unpublish(i), AZ_OK);
+  }
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+/* If the IPC was initialized with an allocator, the az_ulib_ipc_publish shall grow the registry
+ * beyond AZ_ULIB_CONFIG_MAX_IPC_INTERFACE without moving the published interfaces, and the
+ * az_ulib_ipc_deinit shall release all the allocated memory. */
+static void az_ulib_ipc_publish_beyond_max_interface_with_allocator_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  g_count_allocate = 0;
+  g_count_release = 0;
+  assert_int_equal(az_ulib_ipc_init_with_allocator(&g_ipc, &g_test_allocator), AZ_OK);
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - IPC_INIT_INTERFACES; i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_publish(i), AZ_OK);
+  }
+  az_ulib_ipc_interface_handle interface_handle_1;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"), 1000, AZ_ULIB_VERSION_EQUALS_TO, &interface_handle_1),
+      AZ_OK);
+  assert_int_equal(g_count_allocate, 0);
+
+  /// act
+  az_result result = az_ulib_test_my_interface_1_v123_publish(NULL);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_true(g_count_allocate > 0);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(NULL), AZ_OK);
+
+  az_ulib_ipc_interface_handle interface_handle_2;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_2_123_INTERFACE_NAME),
+          MY_INTERFACE_2_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle_2),
+      AZ_OK);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(az_ulib_ipc_call(interface_handle_2, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
+  assert_int_equal(out, AZ_OK);
+  out = AZ_ULIB_PENDING;
+  assert_int_equal(az_ulib_ipc_call(interface_handle_1, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
+  assert_int_equal(out, AZ_OK);
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token;
+  assert_int_equal(
+      az_ulib_ipc_query(AZ_SPAN_FROM_STR("prefix=MY_INTERFACE_"), &query_result, &token), AZ_OK);
+  assert_true(az_span_is_content_equal(
+      query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.123\",\"MY_INTERFACE_2.123\"")));
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle_2), AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle_1), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - IPC_INIT_INTERFACES; i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_unpublish(i), AZ_OK);
+  }
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  assert_int_equal(g_count_release, g_count_allocate);
+}
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+/* The az_ulib_ipc_unpublish shall remove a descriptor for the IPC. The az_ulib_ipc_unpublish shall
+ * be thread safe. */
+/* The az_ulib_ipc_unpublish shall wait as long as the caller wants.*/
+static void az_ulib_ipc_unpublish_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_WAIT_FOREVER), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(10000), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  /// assert
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 4);
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
+          MY_INTERFACE_1_2_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_2_123_INTERFACE_NAME),
+          MY_INTERFACE_2_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_3_123_INTERFACE_NAME),
+          MY_INTERFACE_3_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_ERROR_ITEM_NOT_FOUND);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+static void az_ulib_ipc_unpublish_random_order_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  /// assert
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 4);
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
+          MY_INTERFACE_1_2_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_2_123_INTERFACE_NAME),
+          MY_INTERFACE_2_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_3_123_INTERFACE_NAME),
+          MY_INTERFACE_3_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_ERROR_ITEM_NOT_FOUND);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_unpublish shall release the descriptor position to be used by another
+ descriptor.
+ */
+static void az_ulib_ipc_unpublish_release_resource_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_WAIT_FOREVER), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  /// assert
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 2);
+
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - (IPC_INIT_INTERFACES + 2); i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_publish(i), AZ_OK);
+  }
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - (IPC_INIT_INTERFACES + 2); i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_unpublish(i), AZ_OK);
+  }
+
+  /// cleanup
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the provided descriptor was not published, the az_ulib_ipc_unpublish shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_unpublish_with_unknown_descriptor_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If one of the command in the interface is running and the wait policy is AZ_ULIB_NO_WAIT, the
+ * az_ulib_ipc_unpublish shall return AZ_ERROR_ULIB_BUSY. */
+static void az_ulib_ipc_unpublish_with_command_running_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_UNPUBLISH;
+  in.descriptor = &MY_INTERFACE_1_V123;
+  in.wait_policy_ms = AZ_ULIB_NO_WAIT;
+  az_result out = AZ_ULIB_PENDING;
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  // call unpublish inside of the command.
+  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(out, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If one of the command in the interface is running and the wait policy is not big enough, the
+ * az_ulib_ipc_unpublish shall return AZ_ERROR_ULIB_BUSY. */
+static void az_ulib_ipc_unpublish_with_command_running_with_small_timeout_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_UNPUBLISH;
+  in.descriptor = &MY_INTERFACE_1_V123;
+  in.wait_policy_ms = 10000;
+  az_result out = AZ_ULIB_PENDING;
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  // call unpublish inside of the command.
+  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(out, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(g_count_event_wait, 8);
+  // The running command entered the interface before the unpublish moved the epoch, so it signals
+  // the event when it leaves.
+  assert_int_equal(g_count_event_set, 1);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If there are valid instances of the interface, the az_ulib_ipc_unpublish shall return
+ * AZ_OK. */
+static void az_ulib_ipc_unpublish_with_valid_interface_instance_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* A call with a stale handle may count itself in the position of an unpublished interface while
+ * the az_ulib_ipc_publish reuses it. The az_ulib_ipc_publish shall keep this count, so the call
+ * leaves it balanced, and the new interface may be unpublished. */
+static void az_ulib_ipc_publish_with_stale_handle_in_the_position_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+
+  az_ulib_ipc_interface_handle stale_handle;
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(&stale_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  _az_ulib_ipc_interface* ipc_interface
+      = &(g_ipc._internal.interface_list[((uintptr_t)stale_handle & 0xFFFF) - 1]);
+  volatile long* running_count
+      = &(ipc_interface->running_shard_list[0].running_count[g_ipc._internal.epoch]);
+
+  /// act
+  // The stale call enters the position, the new interface is published in it, and the call leaves
+  // when it sees the new generation.
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(running_count);
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(&interface_handle), AZ_OK);
+  (void)AZ_ULIB_PORT_ATOMIC_DEC_W(running_count);
+
+  /// assert
+  assert_int_equal((uintptr_t)interface_handle & 0xFFFF, (uintptr_t)stale_handle & 0xFFFF);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(
+      az_ulib_ipc_call(stale_handle, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_replace shall replace the descriptor of a published interface by a compatible
+ * one, keeping the handles to the interface valid. */
+/* After the replace, the az_ulib_ipc_unpublish shall only accept the new descriptor. */
+static void az_ulib_ipc_replace_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_1, NULL), AZ_OK);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("REPLACE"), 1, AZ_ULIB_VERSION_EQUALS_TO, &interface_handle),
+      AZ_OK);
+  uint32_t implementation = 0;
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, REPLACE_COMMAND, NULL, &implementation), AZ_OK);
+  assert_int_equal(implementation, 1);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result
+      = az_ulib_ipc_replace(&REPLACE_DESCRIPTOR_1, &REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, REPLACE_COMMAND, NULL, &implementation), AZ_OK);
+  assert_int_equal(implementation, 2);
+  az_ulib_ipc_interface_handle new_interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("REPLACE"), 1, AZ_ULIB_VERSION_EQUALS_TO, &new_interface_handle),
+      AZ_OK);
+  assert_ptr_equal(new_interface_handle, interface_handle);
+  assert_int_equal(az_ulib_ipc_release_interface(new_interface_handle), AZ_OK);
+  assert_int_equal(
+      az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_ERROR_ITEM_NOT_FOUND);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the new descriptor has a different version, or different capabilities, the
+ * az_ulib_ipc_replace shall return AZ_ERROR_ULIB_INCOMPATIBLE_VERSION and keep the old descriptor.
+ */
+static void az_ulib_ipc_replace_with_incompatible_descriptor_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_1, &interface_handle), AZ_OK);
+
+  /// act
+  az_result other_capabilities_result = az_ulib_ipc_replace(
+      &REPLACE_DESCRIPTOR_1, &REPLACE_OTHER_CAPABILITIES_DESCRIPTOR, AZ_ULIB_NO_WAIT);
+  az_result other_version_result = az_ulib_ipc_replace(
+      &REPLACE_DESCRIPTOR_1, &REPLACE_OTHER_VERSION_DESCRIPTOR, AZ_ULIB_NO_WAIT);
+  az_result fewer_capabilities_result = az_ulib_ipc_replace(
+      &REPLACE_DESCRIPTOR_1, &REPLACE_FEWER_CAPABILITIES_DESCRIPTOR, AZ_ULIB_NO_WAIT);
+
+  /// assert
+  assert_int_equal(other_capabilities_result, AZ_ERROR_ULIB_INCOMPATIBLE_VERSION);
+  assert_int_equal(other_version_result, AZ_ERROR_ULIB_INCOMPATIBLE_VERSION);
+  assert_int_equal(fewer_capabilities_result, AZ_ERROR_ULIB_INCOMPATIBLE_VERSION);
+  assert_int_equal(g_lock_diff, 0);
+  uint32_t implementation = 0;
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, REPLACE_COMMAND, NULL, &implementation), AZ_OK);
+  assert_int_equal(implementation, 1);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If a call is still running the old descriptor after the wait_option_ms, the az_ulib_ipc_replace
+ * shall return AZ_ULIB_PENDING, and keep the new descriptor published. */
+/* After the call leaves the old descriptor, the az_ulib_ipc_wait_replaced shall return AZ_OK. */
+static void az_ulib_ipc_replace_with_command_running_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_1, &interface_handle), AZ_OK);
+  g_replace_old_descriptor = &REPLACE_DESCRIPTOR_1;
+  g_replace_new_descriptor = &REPLACE_DESCRIPTOR_2;
+  uint32_t implementation = 0;
+  g_count_acquire = 0;
+
+  /// act
+  // call replace inside of the command.
+  az_result result = az_ulib_ipc_call(interface_handle, REPLACE_COMMAND, NULL, &implementation);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(implementation, 1);
+  assert_int_equal(g_replace_in_command_result, AZ_ULIB_PENDING);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  // The running command entered the interface before the replace moved the epoch, so it signals
+  // the event when it leaves.
+  assert_int_equal(g_count_event_set, 1);
+  g_replace_new_descriptor = NULL;
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, REPLACE_COMMAND, NULL, &implementation), AZ_OK);
+  assert_int_equal(implementation, 2);
+  assert_int_equal(
+      az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_ipc_wait_replaced(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the old descriptor was not published, the az_ulib_ipc_replace shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_replace_with_unknown_descriptor_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_2, NULL), AZ_OK);
+
+  /// act
+  az_result result
+      = az_ulib_ipc_replace(&REPLACE_DESCRIPTOR_1, &REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* While the calls of a previous replace are still running the old descriptor, the
+ * az_ulib_ipc_replace shall return AZ_ERROR_ULIB_BUSY, and keep the current descriptor. */
+static void az_ulib_ipc_replace_with_replaced_descriptor_pending_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_1, &interface_handle), AZ_OK);
+  g_replace_old_descriptor = &REPLACE_DESCRIPTOR_1;
+  g_replace_new_descriptor = &REPLACE_DESCRIPTOR_2;
+  uint32_t implementation = 0;
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, REPLACE_COMMAND, NULL, &implementation), AZ_OK);
+  assert_int_equal(g_replace_in_command_result, AZ_ULIB_PENDING);
+  g_replace_new_descriptor = NULL;
+
+  /// act
+  az_result result
+      = az_ulib_ipc_replace(&REPLACE_DESCRIPTOR_2, &REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, REPLACE_COMMAND, NULL, &implementation), AZ_OK);
+  assert_int_equal(implementation, 2);
+  assert_int_equal(az_ulib_ipc_wait_replaced(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(
+      az_ulib_ipc_replace(&REPLACE_DESCRIPTOR_2, &REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_OK);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the descriptor is still published, the az_ulib_ipc_wait_replaced shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+/* If the descriptor is not published and has no pending calls, the az_ulib_ipc_wait_replaced
+ * shall return AZ_OK. */
+static void az_ulib_ipc_wait_replaced_with_published_descriptor_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_1, NULL), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ipc_wait_replaced(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(az_ulib_ipc_wait_replaced(&REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT), AZ_OK);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_replace shall report AZ_ULIB_IPC_EVENT_REPLACE to the subscribers, with the
+ * handle of the interface. */
+static void az_ulib_ipc_replace_reports_to_subscribers_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_1, &interface_handle), AZ_OK);
+  az_ulib_ipc_subscription_filter filter
+      = { AZ_SPAN_LITERAL_FROM_STR("REPLACE"), 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle;
+  assert_int_equal(
+      az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle), AZ_OK);
+
+  /// act
+  az_result result
+      = az_ulib_ipc_replace(&REPLACE_DESCRIPTOR_1, &REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_count_subscription_event, 1);
+  assert_int_equal(g_subscription_event, AZ_ULIB_IPC_EVENT_REPLACE);
+  assert_true(az_span_is_content_equal(g_subscription_name, AZ_SPAN_FROM_STR("REPLACE")));
+  assert_int_equal(g_subscription_version, 1);
+  assert_ptr_equal(g_subscription_interface_handle, interface_handle);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+/* The az_ulib_ipc_get_contract shall return the same contract for descriptors with the same
+ * capabilities, independent of the version and of the capability implementations. */
+/* The az_ulib_ipc_get_contract shall return different contracts for descriptors with different
+ * capabilities. */
+static void az_ulib_ipc_get_contract_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  uint32_t contract = az_ulib_ipc_get_contract(&REPLACE_DESCRIPTOR_1);
+
+  /// assert
+  assert_int_equal(az_ulib_ipc_get_contract(&REPLACE_DESCRIPTOR_2), contract);
+  assert_int_equal(az_ulib_ipc_get_contract(&REPLACE_OTHER_VERSION_DESCRIPTOR), contract);
+  assert_int_not_equal(
+      az_ulib_ipc_get_contract(&REPLACE_OTHER_CAPABILITIES_DESCRIPTOR), contract);
+  assert_int_not_equal(
+      az_ulib_ipc_get_contract(&REPLACE_FEWER_CAPABILITIES_DESCRIPTOR), contract);
+
+  /// cleanup
+}
+
+/* If the published interface has the expected contract, the
+ * az_ulib_ipc_try_get_interface_with_contract shall return the handle for the interface. */
+static void az_ulib_ipc_try_get_interface_with_contract_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_1, NULL), AZ_OK);
+  az_ulib_ipc_interface_handle interface_handle;
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface_with_contract(
+      AZ_SPAN_FROM_STR("REPLACE"),
+      1,
+      AZ_ULIB_VERSION_EQUALS_TO,
+      az_ulib_ipc_get_contract(&REPLACE_DESCRIPTOR_2),
+      &interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+  uint32_t implementation = 0;
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, REPLACE_COMMAND, NULL, &implementation), AZ_OK);
+  assert_int_equal(implementation, 1);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the published interface has another contract, the az_ulib_ipc_try_get_interface_with_contract
+ * shall return AZ_ERROR_ULIB_INCOMPATIBLE_VERSION and release the interface instance. */
+static void az_ulib_ipc_try_get_interface_with_contract_with_other_contract_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_1, NULL), AZ_OK);
+  az_ulib_ipc_interface_handle interface_handle;
+  g_count_acquire = 0;
+
+  /// act
+  /// assert
+  for (int i = 0; i <= AZ_ULIB_CONFIG_MAX_IPC_INSTANCES; i++)
+  {
+    assert_int_equal(
+        az_ulib_ipc_try_get_interface_with_contract(
+            AZ_SPAN_FROM_STR("REPLACE"),
+            1,
+            AZ_ULIB_VERSION_EQUALS_TO,
+            az_ulib_ipc_get_contract(&REPLACE_OTHER_CAPABILITIES_DESCRIPTOR),
+            &interface_handle),
+        AZ_ERROR_ULIB_INCOMPATIBLE_VERSION);
+  }
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+  // If the failed calls kept their instances, there would be no instance left.
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("REPLACE"), 1, AZ_ULIB_VERSION_EQUALS_TO, &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_1, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+
+/* If one of the command in the interface is running, the wait policy is different than
+ * AZ_ULIB_NO_WAIT and the call ends before the timeout, the az_ulib_ipc_unpublish shall return
+ * AZ_ULIB_SUCCEESS. */
+// TODO: implement the test when the code is ready.
+
+/* If one of the command in the interface is running, the wait policy is different than
+ * AZ_ULIB_NO_WAIT and the call ends after the timeout, the az_ulib_ipc_unpublish shall return
+ * AZ_ERROR_ULIB_BUSY. */
+// TODO: implement the test when the code is ready.
+
+/* The az_ulib_ipc_try_get_interface shall return the handle for the interface. */
+/* The az_ulib_ipc_try_get_interface shall return AZ_OK. */
+static void az_ulib_ipc_try_get_interface_version_equals_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+      MY_INTERFACE_1_123_INTERFACE_VERSION,
+      AZ_ULIB_VERSION_EQUALS_TO,
+      &interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If a writer holds the index in the middle of a change, the az_ulib_ipc_try_get_interface shall
+ * stop retrying and wait for the writer in the IPC lock. */
+static void az_ulib_ipc_try_get_interface_with_index_in_change_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+  g_ipc._internal.sequence++;
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+      MY_INTERFACE_1_123_INTERFACE_VERSION,
+      AZ_ULIB_VERSION_EQUALS_TO,
+      &interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  g_ipc._internal.sequence++;
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+static void az_ulib_ipc_try_get_interface_version_any_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+      0,
+      AZ_ULIB_VERSION_ANY,
+      &interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+static void az_ulib_ipc_try_get_interface_version_greater_than_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  az_ulib_ipc_interface_handle greater_interface_handle;
+  init_ipc_and_publish_interfaces();
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
+          MY_INTERFACE_1_2_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
+      MY_INTERFACE_1_2_INTERFACE_VERSION,
+      AZ_ULIB_VERSION_GREATER_THAN,
+      &greater_interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_ptr_not_equal(interface_handle, greater_interface_handle);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(greater_interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+static void az_ulib_ipc_try_get_interface_version_lower_than_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  az_ulib_ipc_interface_handle lower_interface_handle;
+  init_ipc_and_publish_interfaces();
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+      MY_INTERFACE_1_123_INTERFACE_VERSION,
+      AZ_ULIB_VERSION_LOWER_THAN,
+      &lower_interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_ptr_not_equal(interface_handle, lower_interface_handle);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(lower_interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+static void az_ulib_ipc_try_get_interface_version_lower_or_equal_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  az_ulib_ipc_interface_handle lower_interface_handle;
+  init_ipc_and_publish_interfaces();
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
+          MY_INTERFACE_1_2_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
+      MY_INTERFACE_1_2_INTERFACE_VERSION,
+      AZ_ULIB_VERSION_LOWER_THAN | AZ_ULIB_VERSION_EQUALS_TO,
+      &lower_interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_ptr_equal(interface_handle, lower_interface_handle);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(lower_interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* The az_ulib_ipc_try_get_interface shall return the lowest version that fits the criteria
+ * independent of the publish order. */
+static void az_ulib_ipc_try_get_interface_lowest_version_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  az_ulib_ipc_interface_handle expected_handle_1000;
+  az_ulib_ipc_interface_handle expected_handle_1002;
+  az_ulib_ipc_interface_handle expected_handle_1005;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_publish(5), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_publish(2), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_publish(8), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_publish(0), AZ_OK);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"), 1000, AZ_ULIB_VERSION_EQUALS_TO, &expected_handle_1000),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"), 1002, AZ_ULIB_VERSION_EQUALS_TO, &expected_handle_1002),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"), 1005, AZ_ULIB_VERSION_EQUALS_TO, &expected_handle_1005),
+      AZ_OK);
+
+  /// act
+  /// assert
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"), 0, AZ_ULIB_VERSION_ANY, &interface_handle),
+      AZ_OK);
+  assert_ptr_equal(interface_handle, expected_handle_1000);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"), 1002, AZ_ULIB_VERSION_GREATER_THAN, &interface_handle),
+      AZ_OK);
+  assert_ptr_equal(interface_handle, expected_handle_1005);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"),
+          1005,
+          AZ_ULIB_VERSION_LOWER_THAN | AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_ptr_equal(interface_handle, expected_handle_1000);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+
+  assert_int_equal(az_ulib_ipc_release_interface(expected_handle_1000), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_unpublish(0), AZ_OK);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"), 0, AZ_ULIB_VERSION_ANY, &interface_handle),
+      AZ_OK);
+  assert_ptr_equal(interface_handle, expected_handle_1002);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(expected_handle_1002), AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(expected_handle_1005), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_unpublish(5), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_unpublish(2), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_unpublish(8), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_publish shall accept a version of an interface that was unpublished before. */
+static void az_ulib_ipc_publish_version_unpublished_before_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - IPC_INIT_INTERFACES; i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_publish(i), AZ_OK);
+  }
+  assert_int_equal(az_ulib_test_my_interface_unpublish(4), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_unpublish(0), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_test_my_interface_publish(4);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"), 1003, AZ_ULIB_VERSION_GREATER_THAN, &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR("MY_INTERFACE"), 1000, AZ_ULIB_VERSION_EQUALS_TO, &interface_handle),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_test_my_interface_publish(4), AZ_ERROR_ULIB_ELEMENT_DUPLICATE);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  for (int i = 1; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - IPC_INIT_INTERFACES; i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_unpublish(i), AZ_OK);
+  }
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+#ifndef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+/* If the IPC reach the maximum number of allowed instances for a single interface, the
+ * az_ulib_ipc_try_get_interface shall return AZ_ERROR_NOT_ENOUGH_SPACE. */
+static void az_ulib_ipc_try_get_interface_with_max_interface_instances_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle[AZ_ULIB_CONFIG_MAX_IPC_INSTANCES];
+  az_ulib_ipc_interface_handle interface_handle_plus_one;
+
+  init_ipc_and_publish_interfaces();
+
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES; i++)
+  {
+    assert_int_equal(
+        az_ulib_ipc_try_get_interface(
+            AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+            MY_INTERFACE_1_123_INTERFACE_VERSION,
+            AZ_ULIB_VERSION_EQUALS_TO,
+            &interface_handle[i]),
+        AZ_OK);
+  }
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+      MY_INTERFACE_1_123_INTERFACE_VERSION,
+      AZ_ULIB_VERSION_EQUALS_TO,
+      &interface_handle_plus_one);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES; i++)
+  {
+    assert_int_equal(az_ulib_ipc_release_interface(interface_handle[i]), AZ_OK);
+  }
+  unpublish_interfaces_and_deinit_ipc();
+}
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+/* If the provided interface name does not exist, the az_ulib_ipc_try_get_interface shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_try_get_interface_with_unknown_name_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR("unknown_name"),
+      MY_INTERFACE_1_123_INTERFACE_VERSION,
+      AZ_ULIB_VERSION_EQUALS_TO,
+      &interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+static void az_ulib_ipc_try_get_interface_with_unknown_version_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+      9999,
+      AZ_ULIB_VERSION_EQUALS_TO,
+      &interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+static void az_ulib_ipc_try_get_interface_without_version_greater_than_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+      MY_INTERFACE_1_123_INTERFACE_VERSION,
+      AZ_ULIB_VERSION_GREATER_THAN,
+      &interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+static void az_ulib_ipc_try_get_interface_without_version_lower_than_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_interface(
+      AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
+      MY_INTERFACE_1_2_INTERFACE_VERSION,
+      AZ_ULIB_VERSION_LOWER_THAN,
+      &interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* The az_ulib_ipc_try_get_capability shall return the capability index in the interface. */
+/* The az_ulib_ipc_try_get_capability shall return AZ_OK. */
+static void az_ulib_ipc_try_get_capability_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+  az_ulib_capability_index index0 = 0xFFFF;
+  az_ulib_capability_index index1 = 0xFFFF;
+  az_ulib_capability_index index2 = 0xFFFF;
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  /// act
+  az_result result0 = az_ulib_ipc_try_get_capability(
+      interface_handle, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_PROPERTY_NAME), &index0);
+  az_result result1 = az_ulib_ipc_try_get_capability(
+      interface_handle, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_TELEMETRY_NAME), &index1);
+  az_result result2 = az_ulib_ipc_try_get_capability(
+      interface_handle, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_COMMAND_NAME), &index2);
+
+  /// assert
+  assert_int_equal(result0, AZ_OK);
+  assert_int_equal(index0, 0);
+  assert_int_equal(result1, AZ_OK);
+  assert_int_equal(index1, 1);
+  assert_int_equal(result2, AZ_OK);
+  assert_int_equal(index2, 3);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+#define MANY_CAPABILITIES_SIZE ((AZ_ULIB_CONFIG_IPC_CAPABILITY_INDEX_SIZE >> 1) + 1)
+#define MANY_CAPABILITIES_NAME_SIZE 16
+
+/* The az_ulib_ipc_try_get_capability shall find all capabilities of an interface, including the
+ * interfaces with more capabilities than the capability index can hold. */
+static void az_ulib_ipc_try_get_capability_with_many_capabilities_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  static char name_list[MANY_CAPABILITIES_SIZE][MANY_CAPABILITIES_NAME_SIZE];
+  static az_ulib_capability_descriptor capability_list[MANY_CAPABILITIES_SIZE];
+  for (int i = 0; i < MANY_CAPABILITIES_SIZE; i++)
+  {
+    int name_size = snprintf(name_list[i], MANY_CAPABILITIES_NAME_SIZE, "capability_%d", i);
+    az_ulib_capability_descriptor capability
+        = { ._internal = { .name = az_span_create((uint8_t*)name_list[i], name_size),
+                           .flags = (uint8_t)AZ_ULIB_CAPABILITY_TYPE_COMMAND } };
+    (void)memcpy(&capability_list[i], &capability, sizeof(capability));
+  }
+  const az_ulib_interface_descriptor indexed_descriptor = AZ_ULIB_DESCRIPTOR_CREATE(
+      "MANY_CAPABILITIES", 1, MANY_CAPABILITIES_SIZE - 1, capability_list);
+  const az_ulib_interface_descriptor not_indexed_descriptor = AZ_ULIB_DESCRIPTOR_CREATE(
+      "MANY_CAPABILITIES", 2, MANY_CAPABILITIES_SIZE, capability_list);
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_interface_handle indexed_handle;
+  az_ulib_ipc_interface_handle not_indexed_handle;
+  assert_int_equal(az_ulib_ipc_publish(&indexed_descriptor, &indexed_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_publish(&not_indexed_descriptor, &not_indexed_handle), AZ_OK);
+
+  /// act
+  /// assert
+  for (int i = 0; i < MANY_CAPABILITIES_SIZE; i++)
+  {
+    az_ulib_capability_index index = 0xFF;
+    az_span name = az_span_create_from_str(name_list[i]);
+    if (i < (MANY_CAPABILITIES_SIZE - 1))
+    {
+      assert_int_equal(az_ulib_ipc_try_get_capability(indexed_handle, name, &index), AZ_OK);
+      assert_int_equal(index, i);
+    }
+    else
+    {
+      assert_int_equal(
+          az_ulib_ipc_try_get_capability(indexed_handle, name, &index), AZ_ERROR_ITEM_NOT_FOUND);
+    }
+    index = 0xFF;
+    assert_int_equal(az_ulib_ipc_try_get_capability(not_indexed_handle, name, &index), AZ_OK);
+    assert_int_equal(index, i);
+  }
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unpublish(&indexed_descriptor, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_unpublish(&not_indexed_descriptor, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the interface was unpublished, the az_ulib_ipc_try_get_capability shall not change the content
+ * of capability_index and return AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_try_get_capability_with_interface_unpublished_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+  az_ulib_capability_index index = 0xFFFF;
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_capability(
+      interface_handle, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_PROPERTY_NAME), &index);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(index, 0xFFFF);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the capability name does not belongs to the interface, the az_ulib_ipc_try_get_capability
+ * shall not change the content of capability_index and return AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_try_get_capability_with_not_capability_name_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+  az_ulib_capability_index index = 0xFFFF;
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ipc_try_get_capability(
+      interface_handle, AZ_SPAN_FROM_STR("not_in_interface"), &index);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(index, 0xFFFF);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* The az_ulib_ipc_get_interface shall return the handle for the interface. */
+/* The az_ulib_ipc_get_interface shall return AZ_OK. */
+static void az_ulib_ipc_get_interface_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  az_ulib_ipc_interface_handle new_interface_handle;
+  init_ipc_and_publish_interfaces();
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_get_interface(interface_handle, &new_interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(new_interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+#ifndef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+/* If the IPC reach the maximum number of allowed instances for a single interface, the
+ * az_ulib_ipc_get_interface shall return AZ_ERROR_NOT_ENOUGH_SPACE. */
+static void az_ulib_ipc_get_interface_with_max_interface_instances_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle[AZ_ULIB_CONFIG_MAX_IPC_INSTANCES];
+  az_ulib_ipc_interface_handle interface_handle_plus_one;
+
+  init_ipc_and_publish_interfaces();
+
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES; i++)
+  {
+    assert_int_equal(
+        az_ulib_ipc_try_get_interface(
+            AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+            MY_INTERFACE_1_123_INTERFACE_VERSION,
+            AZ_ULIB_VERSION_EQUALS_TO,
+            &interface_handle[i]),
+        AZ_OK);
+  }
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_get_interface(interface_handle[0], &interface_handle_plus_one);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES; i++)
+  {
+    assert_int_equal(az_ulib_ipc_release_interface(interface_handle[i]), AZ_OK);
+  }
+  unpublish_interfaces_and_deinit_ipc();
+}
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+
+/* If the provided interface name does not exist, the az_ulib_ipc_get_interface shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_get_interface_with_unpublished_interface_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  az_ulib_ipc_interface_handle new_interface_handle;
+  init_ipc_and_publish_interfaces();
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_get_interface(interface_handle, &new_interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_release_interface shall release the instance of the interface. */
+/* The az_ulib_ipc_release_interface shall return AZ_OK. */
+static void az_ulib_ipc_release_interface_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_release_interface(interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the interface is already released, the az_ulib_ipc_release_interface shall return
+ * AZ_ERROR_ULIB_PRECONDITION. */
+static void az_ulib_ipc_release_interface_double_release_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_release_interface(interface_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_PRECONDITION);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If one of the command in the interface is running, the az_ulib_ipc_release_interface shall
+ return
+ * AZ_OK. */
+static void az_ulib_ipc_release_interface_with_command_running_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  g_count_acquire = 0;
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_RELEASE_INTERFACE;
+  in.handle = interface_handle;
+  az_result out = AZ_ULIB_PENDING;
+
+  /// act
+  // call release inside of the command.
+  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(out, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* The az_ulib_ipc_call shall call the command published by the interface. */
+/* The az_ulib_ipc_call shall return AZ_OK. */
+static void az_ulib_ipc_call_calls_the_command_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+
+  /// act
+  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(out, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the interface was unpublished, the az_ulib_ipc_call shall return AZ_ERROR_ITEM_NOT_FOUND
+ * and do not call the command. */
+static void az_ulib_ipc_call_unpublished_interface_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+
+  /// act
+  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(out, AZ_ULIB_PENDING);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the interface was unpublished and another interface was published in the same position, the
+ * az_ulib_ipc_call with the old handle shall return AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_call_with_handle_of_reused_position_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  az_ulib_ipc_interface_handle old_interface_handle;
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(&old_interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  az_ulib_ipc_interface_handle new_interface_handle;
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(&new_interface_handle), AZ_OK);
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+
+  /// act
+  az_result result = az_ulib_ipc_call(old_interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(out, AZ_ULIB_PENDING);
+  assert_ptr_not_equal(old_interface_handle, new_interface_handle);
+  assert_int_equal(
+      az_ulib_ipc_call(new_interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
+  assert_int_equal(out, AZ_OK);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* The az_ulib_ipc_call_batch shall call all commands in the batch, in order. */
+/* The az_ulib_ipc_call_batch shall store the result of each command in the results. */
+/* The az_ulib_ipc_call_batch shall return AZ_OK. */
+static void az_ulib_ipc_call_batch_calls_all_commands_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  my_command_model_in in[3];
+  az_result out[3];
+  az_ulib_ipc_call_entry entries[3];
+  az_result results[3];
+  for (int i = 0; i < 3; i++)
+  {
+    in[i].capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+    in[i].return_result = AZ_OK;
+    out[i] = AZ_ULIB_PENDING;
+    entries[i].command_index = MY_INTERFACE_MY_COMMAND;
+    entries[i].model_in = &in[i];
+    entries[i].model_out = &out[i];
+    results[i] = AZ_ULIB_PENDING;
+  }
+  in[1].capability = MY_COMMAND_CAPABILITY_SUM;
+  in[1].max_sum = 10;
+  in[2].return_result = AZ_ERROR_NOT_SUPPORTED;
+
+  /// act
+  az_result result = az_ulib_ipc_call_batch(interface_handle, entries, 3, results, true);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(out[0], AZ_OK);
+  assert_int_equal(out[1], AZ_OK);
+  assert_int_equal(out[2], AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(results[0], AZ_OK);
+  assert_int_equal(results[1], AZ_OK);
+  assert_int_equal(results[2], AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If stop_on_error is false, the az_ulib_ipc_call_batch shall call all commands even if one of
+ * them fails. */
+static void az_ulib_ipc_call_batch_with_failed_command_calls_all_commands_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  my_command_model_in in[3];
+  az_result out[3];
+  az_ulib_ipc_call_entry entries[3];
+  az_result results[3];
+  for (int i = 0; i < 3; i++)
+  {
+    in[i].capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+    in[i].return_result = AZ_OK;
+    out[i] = AZ_ULIB_PENDING;
+    entries[i].command_index = MY_INTERFACE_MY_COMMAND;
+    entries[i].model_in = &in[i];
+    entries[i].model_out = &out[i];
+    results[i] = AZ_ULIB_PENDING;
+  }
+  in[1].capability = MY_COMMAND_CAPABILITY_RETURN_ERROR;
+  in[1].return_result = AZ_ERROR_NOT_SUPPORTED;
+
+  /// act
+  az_result result = az_ulib_ipc_call_batch(interface_handle, entries, 3, results, false);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(results[0], AZ_OK);
+  assert_int_equal(results[1], AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(results[2], AZ_OK);
+  assert_int_equal(out[2], AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If stop_on_error is true, the az_ulib_ipc_call_batch shall stop on the first command that
+ * fails, set the result of the remaining entries to AZ_ERROR_CANCELED, and return the error. */
+static void az_ulib_ipc_call_batch_stop_on_error_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  my_command_model_in in[3];
+  az_result out[3];
+  az_ulib_ipc_call_entry entries[3];
+  az_result results[3];
+  for (int i = 0; i < 3; i++)
+  {
+    in[i].capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+    in[i].return_result = AZ_OK;
+    out[i] = AZ_ULIB_PENDING;
+    entries[i].command_index = MY_INTERFACE_MY_COMMAND;
+    entries[i].model_in = &in[i];
+    entries[i].model_out = &out[i];
+    results[i] = AZ_ULIB_PENDING;
+  }
+  in[1].capability = MY_COMMAND_CAPABILITY_RETURN_ERROR;
+  in[1].return_result = AZ_ERROR_NOT_SUPPORTED;
+
+  /// act
+  az_result result = az_ulib_ipc_call_batch(interface_handle, entries, 3, results, true);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(results[0], AZ_OK);
+  assert_int_equal(results[1], AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(results[2], AZ_ERROR_CANCELED);
+  assert_int_equal(out[2], AZ_ULIB_PENDING);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the interface was unpublished, the az_ulib_ipc_call_batch shall return
+ * AZ_ERROR_ITEM_NOT_FOUND and do not call any command. */
+static void az_ulib_ipc_call_batch_unpublished_interface_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  az_ulib_ipc_call_entry entries[1] = { { MY_INTERFACE_MY_COMMAND, &in, &out } };
+  az_result results[1] = { AZ_ULIB_PENDING };
+
+  /// act
+  az_result result = az_ulib_ipc_call_batch(interface_handle, entries, 1, results, false);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(results[0], AZ_ULIB_PENDING);
+  assert_int_equal(out, AZ_ULIB_PENDING);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_call_with_str shall call the command published by the interface. */
+/* The az_ulib_ipc_call_with_str shall return AZ_OK. */
+static void az_ulib_ipc_call_with_str_calls_the_command_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
+  uint8_t buf[100];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
+  /// act
+  az_result result = az_ulib_ipc_call_with_str(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_is_content_equal(out, AZ_SPAN_FROM_STR("{\"result\":65536}")));
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the interface does not support call with string, the az_ulib_ipc_call_with_str shall return
+ * AZ_ERROR_NOT_SUPPORTED. */
+static void az_ulib_ipc_call_with_str_calls_not_supporte_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
+          MY_INTERFACE_1_2_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
+  uint8_t buf[100];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
+  /// act
+  az_result result = az_ulib_ipc_call_with_str(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the interface was unpublished, the az_ulib_ipc_call_with_str shall return
+ * AZ_ERROR_ITEM_NOT_FOUND and do not call the command. */
+static void az_ulib_ipc_call_with_str_unpublished_interface_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
+  uint8_t buf[100];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
+  /// act
+  az_result result = az_ulib_ipc_call_with_str(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_call_with_binary shall call the command published by the interface. */
+/* The az_ulib_ipc_call_with_binary shall skip the unknown tags. */
+/* The az_ulib_ipc_call_with_binary shall return AZ_OK. */
+static void az_ulib_ipc_call_with_binary_calls_the_command_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  uint8_t in_buf[100];
+  az_ulib_tlv_writer tw;
+  assert_int_equal(az_ulib_tlv_writer_init(&tw, AZ_SPAN_FROM_BUFFER(in_buf)), AZ_OK);
+  assert_int_equal(
+      az_ulib_tlv_writer_append_uint32(
+          &tw, MY_INTERFACE_MY_COMMAND_CAPABILITY_TAG, MY_COMMAND_CAPABILITY_JUST_RETURN),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_tlv_writer_append_span(&tw, 0xFE, AZ_SPAN_FROM_STR("unknown")), AZ_OK);
+  assert_int_equal(
+      az_ulib_tlv_writer_append_int32(&tw, MY_INTERFACE_MY_COMMAND_RETURN_RESULT_TAG, 65536),
+      AZ_OK);
+  az_span in = az_ulib_tlv_writer_get_bytes_used_in_destination(&tw);
+  uint8_t buf[100];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
+  /// act
+  az_result result
+      = az_ulib_ipc_call_with_binary(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  az_ulib_tlv_reader tr;
+  int32_t command_result;
+  assert_int_equal(az_ulib_tlv_reader_init(&tr, out), AZ_OK);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(tr.tag, MY_INTERFACE_MY_COMMAND_RESULT_TAG);
+  assert_int_equal(az_ulib_tlv_reader_get_int32(&tr, &command_result), AZ_OK);
+  assert_int_equal(command_result, 65536);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_ULIB_EOF);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the capability does not have a binary wrapper, the az_ulib_ipc_call_with_binary shall return
+ * AZ_ERROR_NOT_SUPPORTED. */
+static void az_ulib_ipc_call_with_binary_calls_not_supported_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  uint8_t in_buf[] = { MY_INTERFACE_MY_COMMAND_CAPABILITY_TAG, 1, 0 };
+  az_span in = AZ_SPAN_FROM_BUFFER(in_buf);
+  uint8_t buf[100];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
+  /// act
+  az_result result
+      = az_ulib_ipc_call_with_binary(interface_handle, MY_INTERFACE_MY_COMMAND_ASYNC, in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the interface was unpublished, the az_ulib_ipc_call_with_binary shall return
+ * AZ_ERROR_ITEM_NOT_FOUND and do not call the command. */
+static void az_ulib_ipc_call_with_binary_unpublished_interface_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  uint8_t in_buf[] = { MY_INTERFACE_MY_COMMAND_CAPABILITY_TAG, 1, 0 };
+  az_span in = AZ_SPAN_FROM_BUFFER(in_buf);
+  uint8_t buf[100];
+  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+
+  /// act
+  az_result result
+      = az_ulib_ipc_call_with_binary(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_deinit shall release all resources associate with ipc. */
+/* The az_ulib_ipc_deinit shall return AZ_OK. */
+static void az_ulib_ipc_deinit_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  g_lock = NULL;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  assert_non_null(g_lock);
+
+  /// act
+  az_result result = az_ulib_ipc_deinit();
+
+  /// assert
+  assert_null(g_lock);
+  assert_int_equal(result, AZ_OK);
+
+  /// cleanup
+}
+
+/* If there is published interface, the az_ulib_ipc_deinit shall return AZ_ERROR_ULIB_BUSY. */
+static void az_ulib_ipc_deinit_with_published_interface_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  /// act
+  az_result result = az_ulib_ipc_deinit();
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_BUSY);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If there is instances of the interface, the az_ulib_ipc_deinit shall return AZ_ERROR_ULIB_BUSY.
+ */
+static void az_ulib_ipc_deinit_with_instace_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ipc_deinit();
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_BUSY);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If there is an active subscription, the az_ulib_ipc_deinit shall return AZ_ERROR_ULIB_BUSY. */
+static void az_ulib_ipc_deinit_with_subscription_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter = { { 0 }, 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle;
+  assert_int_equal(
+      az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ipc_deinit();
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(g_count_subscription_event, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_subscribe shall report the publish and the unpublish of the interfaces with the
+ * name in the filter, with the handle of the interface. */
+static void az_ulib_ipc_subscribe_reports_publish_and_unpublish_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter
+      = { AZ_SPAN_LITERAL_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME), 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle;
+  az_ulib_ipc_interface_handle interface_handle;
+
+  /// act
+  az_result result
+      = az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(NULL), AZ_OK);
+  assert_int_equal(g_count_subscription_event, 0);
+
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(&interface_handle), AZ_OK);
+  assert_int_equal(g_count_subscription_event, 1);
+  assert_int_equal(g_subscription_event, AZ_ULIB_IPC_EVENT_PUBLISH);
+  assert_true(az_span_is_content_equal(
+      g_subscription_name, AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME)));
+  assert_int_equal(g_subscription_version, MY_INTERFACE_1_123_INTERFACE_VERSION);
+  assert_ptr_equal(g_subscription_interface_handle, interface_handle);
+
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(g_count_subscription_event, 2);
+  assert_int_equal(g_subscription_event, AZ_ULIB_IPC_EVENT_UNPUBLISH);
+  assert_int_equal(g_subscription_version, MY_INTERFACE_1_123_INTERFACE_VERSION);
+  assert_ptr_equal(g_subscription_interface_handle, interface_handle);
+
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(g_count_subscription_event, 2);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* The az_ulib_ipc_subscribe shall only report the interfaces with a version that matches the
+ * filter. */
+static void az_ulib_ipc_subscribe_with_version_filter_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter
+      = { AZ_SPAN_LITERAL_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
+          MY_INTERFACE_1_2_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO };
+  az_ulib_ipc_subscription_handle subscription_handle;
+  assert_int_equal(
+      az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle), AZ_OK);
+
+  /// act
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_publish(NULL), AZ_OK);
+
+  /// assert
+  assert_int_equal(g_count_subscription_event, 1);
+  assert_int_equal(g_subscription_event, AZ_ULIB_IPC_EVENT_PUBLISH);
+  assert_int_equal(g_subscription_version, MY_INTERFACE_1_2_INTERFACE_VERSION);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(g_count_subscription_event, 1);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the filter has an empty name, the az_ulib_ipc_subscribe shall report all interfaces. */
+static void az_ulib_ipc_subscribe_with_empty_name_reports_all_interfaces_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter = { { 0 }, 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle;
+  assert_int_equal(
+      az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle), AZ_OK);
+
+  /// act
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_publish(NULL), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(NULL), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_publish(NULL), AZ_OK);
+
+  /// assert
+  assert_int_equal(g_count_subscription_event, 4);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If all subscriptions are in use, the az_ulib_ipc_subscribe shall return
+ * AZ_ERROR_NOT_ENOUGH_SPACE. */
+static void az_ulib_ipc_subscribe_out_of_memory_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter = { { 0 }, 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle[AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS];
+  for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS; i++)
+  {
+    assert_int_equal(
+        az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle[i]),
+        AZ_OK);
+  }
+  az_ulib_ipc_subscription_handle extra_subscription_handle;
+
+  /// act
+  az_result result
+      = az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &extra_subscription_handle);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
+  assert_int_equal(g_count_subscription_event, AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS);
+
+  /// cleanup
+  for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_MAX_SUBSCRIPTIONS; i++)
+  {
+    assert_int_equal(az_ulib_ipc_unsubscribe(subscription_handle[i], AZ_ULIB_NO_WAIT), AZ_OK);
+  }
   assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* After the az_ulib_ipc_unsubscribe, the IPC shall not call the subscription callback anymore, and
+ * the subscription may be reused. */
+static void az_ulib_ipc_unsubscribe_stops_the_reports_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter = { { 0 }, 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle;
+  assert_int_equal(
+      az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT);
 
   /// assert
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 4);
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
+  assert_int_equal(g_count_subscription_event, 0);
+  assert_int_equal(
+      az_ulib_ipc_subscribe(&filter, subscription_callback, NULL, &subscription_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(g_count_subscription_event, 1);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+/* If the callback is running, the az_ulib_ipc_unsubscribe shall return AZ_ERROR_ULIB_BUSY and keep
+ * the subscription active. */
+static void az_ulib_ipc_unsubscribe_with_callback_running_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  az_ulib_ipc_subscription_filter filter = { { 0 }, 0, AZ_ULIB_VERSION_ANY };
+  az_ulib_ipc_subscription_handle subscription_handle;
+  assert_int_equal(
+      az_ulib_ipc_subscribe(
+          &filter, subscription_callback, &subscription_handle, &subscription_handle),
+      AZ_OK);
+
+  /// act
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
+
+  /// assert
+  assert_int_equal(g_count_subscription_event, 1);
+  assert_int_equal(g_subscription_unsubscribe_result, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(g_count_subscription_event, 2);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_unsubscribe(subscription_handle, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+/* The az_ulib_ipc_init shall create the worker threads for the asynchronous calls, and the
+ * az_ulib_ipc_deinit shall join them. */
+static void az_ulib_ipc_init_starts_async_workers_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+
+  /// assert
+  assert_int_equal(g_count_thread, AZ_ULIB_CONFIG_IPC_ASYNC_WORKERS);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  assert_int_equal(g_count_thread, 0);
+  assert_int_equal(g_count_post, AZ_ULIB_CONFIG_IPC_ASYNC_WORKERS);
+
+  /// cleanup
+}
+
+/* The az_ulib_ipc_call_async shall queue the call and return AZ_OK, and a worker thread shall call
+ * the command and report the result in the result callback. */
+static void az_ulib_ipc_call_async_calls_the_command_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
   az_ulib_ipc_interface_handle interface_handle;
   assert_int_equal(
       az_ulib_ipc_try_get_interface(
@@ -927,99 +4008,236 @@ static void az_ulib_ipc_unpublish_random_order_succeed(void** state)
           MY_INTERFACE_1_123_INTERFACE_VERSION,
           AZ_ULIB_VERSION_EQUALS_TO,
           &interface_handle),
-      AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
-          MY_INTERFACE_1_2_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_ERROR_ITEM_NOT_FOUND);
+      AZ_OK);
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_ERROR_ULIB_BUSY;
+  az_result out = AZ_ULIB_PENDING;
+  g_count_post = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_call_async(
+      interface_handle,
+      MY_INTERFACE_MY_COMMAND,
+      &in,
+      &out,
+      result_callback,
+      (az_ulib_capability_token)0x5678);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_count_post, 1);
+  assert_int_equal(g_count_result, 0);
+  assert_int_equal(out, AZ_ULIB_PENDING);
+  run_async_worker();
+  assert_int_equal(g_count_result, 1);
+  assert_ptr_equal(g_result_token, (az_ulib_capability_token)0x5678);
+  assert_int_equal(g_result, AZ_OK);
+  assert_int_equal(out, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* The az_ulib_ipc_call_async shall call an asynchronous command with the capability token. */
+static void az_ulib_ipc_call_async_calls_the_command_async_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
   assert_int_equal(
       az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_2_123_INTERFACE_NAME),
-          MY_INTERFACE_2_123_INTERFACE_VERSION,
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
           AZ_ULIB_VERSION_EQUALS_TO,
           &interface_handle),
-      AZ_ERROR_ITEM_NOT_FOUND);
+      AZ_OK);
+
+  my_command_async_model_in in;
+  in.capability = MY_COMMAND_ASYNC_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_ERROR_ULIB_BUSY;
+  az_result out = AZ_ULIB_PENDING;
+
+  /// act
+  az_result result = az_ulib_ipc_call_async(
+      interface_handle,
+      MY_INTERFACE_MY_COMMAND_ASYNC,
+      &in,
+      &out,
+      result_callback,
+      (az_ulib_capability_token)0x5678);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  run_async_worker();
+  assert_int_equal(g_count_result, 1);
+  assert_int_equal(g_result, AZ_OK);
+  assert_int_equal(out, AZ_ERROR_ULIB_BUSY);
+
+  /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the interface was unpublished, the az_ulib_ipc_call_async shall return
+ * AZ_ERROR_ITEM_NOT_FOUND and do not queue the call. */
+static void az_ulib_ipc_call_async_unpublished_interface_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
   assert_int_equal(
       az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_3_123_INTERFACE_NAME),
-          MY_INTERFACE_3_123_INTERFACE_VERSION,
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
           AZ_ULIB_VERSION_EQUALS_TO,
           &interface_handle),
-      AZ_ERROR_ITEM_NOT_FOUND);
+      AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  g_count_post = 0;
+
+  /// act
+  az_result result = az_ulib_ipc_call_async(
+      interface_handle,
+      MY_INTERFACE_MY_COMMAND,
+      &in,
+      &out,
+      result_callback,
+      (az_ulib_capability_token)0x5678);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_count_post, 0);
+  assert_int_equal(g_count_result, 0);
 
   /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* The az_ulib_ipc_unpublish shall release the descriptor position to be used by another
- descriptor.
- */
-static void az_ulib_ipc_unpublish_release_resource_succeed(void** state)
+/* If the interface is unpublished while the call is in the queue, the worker thread shall not call
+ * the command, and shall report AZ_ERROR_ITEM_NOT_FOUND in the result callback. */
+static void az_ulib_ipc_call_async_interface_unpublished_in_the_queue_failed(void** state)
 {
   /// arrange
   (void)state;
   init_ipc_and_publish_interfaces();
 
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(
+      az_ulib_ipc_call_async(
+          interface_handle,
+          MY_INTERFACE_MY_COMMAND,
+          &in,
+          &out,
+          result_callback,
+          (az_ulib_capability_token)0x5678),
+      AZ_OK);
+
   /// act
-  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_WAIT_FOREVER), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  run_async_worker();
 
   /// assert
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 2);
-
-  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - 3; i++)
-  {
-    assert_int_equal(az_ulib_test_my_interface_publish(i), AZ_OK);
-  }
-  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE - 3; i++)
-  {
-    assert_int_equal(az_ulib_test_my_interface_unpublish(i), AZ_OK);
-  }
+  assert_int_equal(g_count_result, 1);
+  assert_int_equal(g_result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(out, AZ_ULIB_PENDING);
 
   /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If the provided descriptor was not published, the az_ulib_ipc_unpublish shall return
- * AZ_ERROR_ITEM_NOT_FOUND. */
-static void az_ulib_ipc_unpublish_with_unknown_descriptor_failed(void** state)
+/* If the queue is full, the az_ulib_ipc_call_async shall return AZ_ERROR_NOT_ENOUGH_SPACE. */
+static void az_ulib_ipc_call_async_with_full_queue_failed(void** state)
 {
   /// arrange
   (void)state;
-  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  for (int i = 0; i < AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE; i++)
+  {
+    assert_int_equal(
+        az_ulib_ipc_call_async(
+            interface_handle,
+            MY_INTERFACE_MY_COMMAND,
+            &in,
+            &out,
+            result_callback,
+            (az_ulib_capability_token)0x5678),
+        AZ_OK);
+  }
 
   /// act
-  az_result result = az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT);
+  az_result result = az_ulib_ipc_call_async(
+      interface_handle,
+      MY_INTERFACE_MY_COMMAND,
+      &in,
+      &out,
+      result_callback,
+      (az_ulib_capability_token)0x5678);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 2);
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  run_async_worker();
+  assert_int_equal(g_count_result, AZ_ULIB_CONFIG_IPC_ASYNC_QUEUE_SIZE);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
 }
-
-/* If one of the command in the interface is running and the wait policy is AZ_ULIB_NO_WAIT, the
- * az_ulib_ipc_unpublish shall return AZ_ERROR_ULIB_BUSY. */
-static void az_ulib_ipc_unpublish_with_command_running_failed(void** state)
+
+/* If the call is in the queue, the az_ulib_ipc_cancel_async shall remove it from the queue,
+ * report AZ_ERROR_CANCELED in the result callback, and return AZ_OK. */
+static void az_ulib_ipc_cancel_async_queued_call_succeed(void** state)
 {
   /// arrange
   (void)state;
   init_ipc_and_publish_interfaces();
 
-  my_command_model_in in;
-  in.capability = MY_COMMAND_CAPABILITY_UNPUBLISH;
-  in.descriptor = &MY_INTERFACE_1_V123;
-  in.wait_policy_ms = AZ_ULIB_NO_WAIT;
-  az_result out = AZ_ULIB_PENDING;
-
   az_ulib_ipc_interface_handle interface_handle;
   assert_int_equal(
       az_ulib_ipc_try_get_interface(
@@ -1028,66 +4246,61 @@ static void az_ulib_ipc_unpublish_with_command_running_failed(void** state)
           AZ_ULIB_VERSION_EQUALS_TO,
           &interface_handle),
       AZ_OK);
-  g_count_acquire = 0;
+
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(
+      az_ulib_ipc_call_async(
+          interface_handle,
+          MY_INTERFACE_MY_COMMAND,
+          &in,
+          &out,
+          result_callback,
+          (az_ulib_capability_token)0x5678),
+      AZ_OK);
 
   /// act
-  // call unpublish inside of the command.
-  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+  az_result result = az_ulib_ipc_cancel_async((az_ulib_capability_token)0x5678);
 
   /// assert
   assert_int_equal(result, AZ_OK);
-  assert_int_equal(out, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(g_count_result, 1);
+  assert_ptr_equal(g_result_token, (az_ulib_capability_token)0x5678);
+  assert_int_equal(g_result, AZ_ERROR_CANCELED);
+  run_async_worker();
+  assert_int_equal(g_count_result, 1);
+  assert_int_equal(out, AZ_ULIB_PENDING);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
   assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If one of the command in the interface is running and the wait policy is not big enough, the
- * az_ulib_ipc_unpublish shall return AZ_ERROR_ULIB_BUSY. */
-static void az_ulib_ipc_unpublish_with_command_running_with_small_timeout_failed(void** state)
+/* If there is no pending call with the token, the az_ulib_ipc_cancel_async shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_cancel_async_with_unknown_token_failed(void** state)
 {
   /// arrange
   (void)state;
   init_ipc_and_publish_interfaces();
 
-  my_command_model_in in;
-  in.capability = MY_COMMAND_CAPABILITY_UNPUBLISH;
-  in.descriptor = &MY_INTERFACE_1_V123;
-  in.wait_policy_ms = 10000;
-  az_result out = AZ_ULIB_PENDING;
-
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  g_count_acquire = 0;
-
   /// act
-  // call unpublish inside of the command.
-  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+  az_result result = az_ulib_ipc_cancel_async((az_ulib_capability_token)0x5678);
 
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(out, AZ_ERROR_ULIB_BUSY);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_int_equal(g_count_sleep, 8);
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_count_result, 0);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If there are valid instances of the interface, the az_ulib_ipc_unpublish shall return
- * AZ_OK. */
-static void az_ulib_ipc_unpublish_with_valid_interface_instance_succeed(void** state)
+/* If there is a pending asynchronous call, the az_ulib_ipc_deinit shall return
+ * AZ_ERROR_ULIB_BUSY. */
+static void az_ulib_ipc_deinit_with_async_call_pending_failed(void** state)
 {
   /// arrange
   (void)state;
@@ -1101,296 +4314,268 @@ static void az_ulib_ipc_unpublish_with_valid_interface_instance_succeed(void** s
           AZ_ULIB_VERSION_EQUALS_TO,
           &interface_handle),
       AZ_OK);
-  g_count_acquire = 0;
-
-  /// act
-  az_result result = az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT);
 
-  /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-
-  /// cleanup
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(
+      az_ulib_ipc_call_async(
+          interface_handle,
+          MY_INTERFACE_MY_COMMAND,
+          &in,
+          &out,
+          result_callback,
+          (az_ulib_capability_token)0x5678),
+      AZ_OK);
   assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
-}
-
-/* If one of the command in the interface is running, the wait policy is different than
- * AZ_ULIB_NO_WAIT and the call ends before the timeout, the az_ulib_ipc_unpublish shall return
- * AZ_ULIB_SUCCEESS. */
-// TODO: implement the test when the code is ready.
-
-/* If one of the command in the interface is running, the wait policy is different than
- * AZ_ULIB_NO_WAIT and the call ends after the timeout, the az_ulib_ipc_unpublish shall return
- * AZ_ERROR_ULIB_BUSY. */
-// TODO: implement the test when the code is ready.
-
-/* The az_ulib_ipc_try_get_interface shall return the handle for the interface. */
-/* The az_ulib_ipc_try_get_interface shall return AZ_OK. */
-static void az_ulib_ipc_try_get_interface_version_equals_succeed(void** state)
-{
-  /// arrange
-  (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
-  init_ipc_and_publish_interfaces();
 
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-      MY_INTERFACE_1_123_INTERFACE_VERSION,
-      AZ_ULIB_VERSION_EQUALS_TO,
-      &interface_handle);
+  az_result result = az_ulib_ipc_deinit();
 
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(result, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(g_count_thread, AZ_ULIB_CONFIG_IPC_ASYNC_WORKERS);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
+  run_async_worker();
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
 
-static void az_ulib_ipc_try_get_interface_version_any_succeed(void** state)
+/* The az_ulib_ipc_get_vtable shall return the IPC vtable.
+ */
+static void az_ulib_ipc_get_vtable_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
-  init_ipc_and_publish_interfaces();
 
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-      0,
-      AZ_ULIB_VERSION_ANY,
-      &interface_handle);
+  const az_ulib_ipc_vtable* vtable = az_ulib_ipc_get_vtable();
 
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_non_null(vtable);
+  assert_ptr_equal(vtable->publish, az_ulib_ipc_publish);
+  assert_ptr_equal(vtable->unpublish, az_ulib_ipc_unpublish);
+  assert_ptr_equal(vtable->try_get_interface, az_ulib_ipc_try_get_interface);
+  assert_ptr_equal(vtable->try_get_capability, az_ulib_ipc_try_get_capability);
+  assert_ptr_equal(vtable->get_interface, az_ulib_ipc_get_interface);
+  assert_ptr_equal(vtable->release_interface, az_ulib_ipc_release_interface);
+  assert_ptr_equal(vtable->call, az_ulib_ipc_call);
+  assert_ptr_equal(vtable->call_with_str, az_ulib_ipc_call_with_str);
+  assert_ptr_equal(vtable->query, az_ulib_ipc_query);
+  assert_ptr_equal(vtable->query_next, az_ulib_ipc_query_next);
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+  assert_ptr_equal(vtable->call_async, az_ulib_ipc_call_async);
+  assert_ptr_equal(vtable->cancel_async, az_ulib_ipc_cancel_async);
+#else
+  assert_null(vtable->call_async);
+  assert_null(vtable->cancel_async);
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
+  assert_ptr_equal(vtable->call_batch, az_ulib_ipc_call_batch);
+  assert_ptr_equal(vtable->call_with_binary, az_ulib_ipc_call_with_binary);
+  assert_ptr_equal(vtable->subscribe, az_ulib_ipc_subscribe);
+  assert_ptr_equal(vtable->unsubscribe, az_ulib_ipc_unsubscribe);
+  assert_ptr_equal(vtable->replace, az_ulib_ipc_replace);
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+  assert_ptr_equal(vtable->get_contract, az_ulib_ipc_get_contract);
+  assert_ptr_equal(
+      vtable->try_get_interface_with_contract, az_ulib_ipc_try_get_interface_with_contract);
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+  assert_ptr_equal(vtable->wait_replaced, az_ulib_ipc_wait_replaced);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
 }
 
-static void az_ulib_ipc_try_get_interface_version_greater_than_succeed(void** state)
+/* If the query is empty, the az_ulib_ipc_query shall return a list of interfaces name and version,
+ * separated by comma. */
+/* The az_ulib_ipc_query shall return AZ_OK. */
+static void az_ulib_ipc_query_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
-  az_ulib_ipc_interface_handle greater_interface_handle;
-  init_ipc_and_publish_interfaces();
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
-          MY_INTERFACE_1_2_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  g_count_acquire = 0;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
+  init_ipc_without_stats_and_publish_interfaces();
 
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
-      MY_INTERFACE_1_2_INTERFACE_VERSION,
-      AZ_ULIB_VERSION_GREATER_THAN,
-      &greater_interface_handle);
+  az_result result = az_ulib_ipc_query(query, &query_result, &token);
 
   /// assert
   assert_int_equal(result, AZ_OK);
-  assert_ptr_not_equal(interface_handle, greater_interface_handle);
+  assert_true(az_span_is_content_equal(
+      query_result,
+      AZ_SPAN_FROM_STR("\"ipc_query.1\",\"MY_INTERFACE_1.123\",\"MY_INTERFACE_1.2\",\"MY_INTERFACE_"
+                       "2.123\",\"MY_INTERFACE_3.123\"")));
+  assert_int_equal(token, 0x5007);
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  assert_int_equal(az_ulib_ipc_release_interface(greater_interface_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
+  unpublish_interfaces_and_deinit_ipc_without_stats();
 }
 
-static void az_ulib_ipc_try_get_interface_version_lower_than_succeed(void** state)
+static void az_ulib_ipc_query_small_buffer_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
-  az_ulib_ipc_interface_handle lower_interface_handle;
-  init_ipc_and_publish_interfaces();
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  g_count_acquire = 0;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
+  uint8_t buf[50];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
+  init_ipc_without_stats_and_publish_interfaces();
 
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-      MY_INTERFACE_1_123_INTERFACE_VERSION,
-      AZ_ULIB_VERSION_LOWER_THAN,
-      &lower_interface_handle);
+  az_result result = az_ulib_ipc_query(query, &query_result, &token);
 
   /// assert
   assert_int_equal(result, AZ_OK);
-  assert_ptr_not_equal(interface_handle, lower_interface_handle);
+  assert_true(az_span_is_content_equal(
+      query_result, AZ_SPAN_FROM_STR("\"ipc_query.1\",\"MY_INTERFACE_1.123\"")));
+  assert_int_equal(token, 0x1007);
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  assert_int_equal(az_ulib_ipc_release_interface(lower_interface_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
+  unpublish_interfaces_and_deinit_ipc_without_stats();
 }
 
-static void az_ulib_ipc_try_get_interface_version_lower_or_equal_succeed(void** state)
+/* If the buffer does not fit, at least, one interface name and version, the az_ulib_ipc_query shall
+ * return AZ_ERROR_NOT_ENOUGH_SPACE. */
+static void az_ulib_ipc_query_buffer_too_small_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
-  az_ulib_ipc_interface_handle lower_interface_handle;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
+  uint8_t buf[3];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
-          MY_INTERFACE_1_2_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  g_count_acquire = 0;
 
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
-      MY_INTERFACE_1_2_INTERFACE_VERSION,
-      AZ_ULIB_VERSION_LOWER_THAN | AZ_ULIB_VERSION_EQUALS_TO,
-      &lower_interface_handle);
+  az_result result = az_ulib_ipc_query(query, &query_result, &token);
 
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_ptr_equal(interface_handle, lower_interface_handle);
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  assert_int_equal(az_ulib_ipc_release_interface(lower_interface_handle), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the IPC reach the maximum number of allowed instances for a single interface, the
- * az_ulib_ipc_try_get_interface shall return AZ_ERROR_NOT_ENOUGH_SPACE. */
-static void az_ulib_ipc_try_get_interface_with_max_interface_instances_failed(void** state)
+/* If the query is not supported, the az_ulib_ipc_query shall return AZ_ERROR_NOT_SUPPORTED. */
+static void az_ulib_ipc_query_not_supported_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle[AZ_ULIB_CONFIG_MAX_IPC_INSTANCES];
-  az_ulib_ipc_interface_handle interface_handle_plus_one;
-
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("\"query\":\"not supported\"");
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
 
-  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES; i++)
-  {
-    assert_int_equal(
-        az_ulib_ipc_try_get_interface(
-            AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-            MY_INTERFACE_1_123_INTERFACE_VERSION,
-            AZ_ULIB_VERSION_EQUALS_TO,
-            &interface_handle[i]),
-        AZ_OK);
-  }
-  g_count_acquire = 0;
-
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-      MY_INTERFACE_1_123_INTERFACE_VERSION,
-      AZ_ULIB_VERSION_EQUALS_TO,
-      &interface_handle_plus_one);
+  az_result result = az_ulib_ipc_query(query, &query_result, &token);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
-  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES; i++)
-  {
-    assert_int_equal(az_ulib_ipc_release_interface(interface_handle[i]), AZ_OK);
-  }
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the provided interface name does not exist, the az_ulib_ipc_try_get_interface shall return
- * AZ_ERROR_ITEM_NOT_FOUND. */
-static void az_ulib_ipc_try_get_interface_with_unknown_name_failed(void** state)
+/* If there is no more interfaces to report, the az_ulib_ipc_query shall return AZ_ULIB_EOF. */
+static void az_ulib_ipc_query_eof_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
-  init_ipc_and_publish_interfaces();
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  _az_ulib_ipc_query_interface_unpublish();
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+  _az_ulib_ipc_stats_interface_unpublish();
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+  g_count_acquire = 0;
 
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR("unknown_name"),
-      MY_INTERFACE_1_123_INTERFACE_VERSION,
-      AZ_ULIB_VERSION_EQUALS_TO,
-      &interface_handle);
+  az_result result = az_ulib_ipc_query(query, &query_result, &token);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(result, AZ_ULIB_EOF);
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+  _az_ulib_ipc_stats_interface_publish();
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+  _az_ulib_ipc_query_interface_publish();
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-static void az_ulib_ipc_try_get_interface_with_unknown_version_failed(void** state)
+/* The az_ulib_ipc_query_next shall return the next part of the query information based on the
+ * continuation token. */
+/* If there are more information, the az_ulib_ipc_query_next shall return AZ_OK. */
+/* If there is no more interfaces to report, the az_ulib_ipc_query_next shall return AZ_ULIB_EOF. */
+static void az_ulib_ipc_query_next_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
-  init_ipc_and_publish_interfaces();
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
+  uint8_t buf[50];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
+  init_ipc_without_stats_and_publish_interfaces();
+  assert_int_equal(az_ulib_ipc_query(query, &query_result, &token), AZ_OK);
 
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-      9999,
-      AZ_ULIB_VERSION_EQUALS_TO,
-      &interface_handle);
-
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_OK);
+  assert_true(az_span_is_content_equal(
+      query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.2\",\"MY_INTERFACE_2.123\"")));
+  assert_int_equal(token, 0x2007);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_OK);
+  assert_true(az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_3.123\"")));
+  assert_int_equal(token, 0x5007);
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_ULIB_EOF);
+
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(g_count_acquire, 4);
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
+  unpublish_interfaces_and_deinit_ipc_without_stats();
 }
 
-static void az_ulib_ipc_try_get_interface_without_version_greater_than_failed(void** state)
+/* If the continuation token is not supported, the az_ulib_ipc_query_next shall return
+ * AZ_ERROR_NOT_SUPPORTED. */
+static void az_ulib_ipc_query_next_not_supported_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
 
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-      MY_INTERFACE_1_123_INTERFACE_VERSION,
-      AZ_ULIB_VERSION_GREATER_THAN,
-      &interface_handle);
+  az_result result = az_ulib_ipc_query_next(&token, &query_result);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 1);
 
@@ -1398,486 +4583,472 @@ static void az_ulib_ipc_try_get_interface_without_version_greater_than_failed(vo
   unpublish_interfaces_and_deinit_ipc();
 }
 
-static void az_ulib_ipc_try_get_interface_without_version_lower_than_failed(void** state)
+/* If the query is a name, the az_ulib_ipc_query shall return all versions of the interface with
+ * this name, sorted by version. */
+static void az_ulib_ipc_query_by_name_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("name=MY_INTERFACE_1");
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
 
   /// act
-  az_result result = az_ulib_ipc_try_get_interface(
-      AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
-      MY_INTERFACE_1_2_INTERFACE_VERSION,
-      AZ_ULIB_VERSION_LOWER_THAN,
-      &interface_handle);
+  az_result result = az_ulib_ipc_query(query, &query_result, &token);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_is_content_equal(
+      query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.2\",\"MY_INTERFACE_1.123\"")));
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_ULIB_EOF);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* The az_ulib_ipc_try_get_capability shall return the capability index in the interface. */
-/* The az_ulib_ipc_try_get_capability shall return AZ_OK. */
-static void az_ulib_ipc_try_get_capability_succeed(void** state)
+/* If the name query has a version range, the az_ulib_ipc_query shall only return the versions in
+ * the range. */
+static void az_ulib_ipc_query_by_name_and_version_range_succeed(void** state)
 {
   /// arrange
   (void)state;
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-  az_ulib_capability_index index0 = 0xFFFF;
-  az_ulib_capability_index index1 = 0xFFFF;
-  az_ulib_capability_index index2 = 0xFFFF;
-  az_ulib_ipc_interface_handle interface_handle;
+
+  /// act
+  /// assert
   assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
+      az_ulib_ipc_query(
+          AZ_SPAN_FROM_STR("name=MY_INTERFACE_1;version=3-200"), &query_result, &token),
       AZ_OK);
+  assert_true(
+      az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.123\"")));
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_ULIB_EOF);
 
-  /// act
-  az_result result0 = az_ulib_ipc_try_get_capability(
-      interface_handle, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_PROPERTY_NAME), &index0);
-  az_result result1 = az_ulib_ipc_try_get_capability(
-      interface_handle, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_TELEMETRY_NAME), &index1);
-  az_result result2 = az_ulib_ipc_try_get_capability(
-      interface_handle, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_COMMAND_NAME), &index2);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(
+      az_ulib_ipc_query(AZ_SPAN_FROM_STR("name=MY_INTERFACE_1;version=2"), &query_result, &token),
+      AZ_OK);
+  assert_true(az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.2\"")));
 
-  /// assert
-  assert_int_equal(result0, AZ_OK);
-  assert_int_equal(index0, 0);
-  assert_int_equal(result1, AZ_OK);
-  assert_int_equal(index1, 1);
-  assert_int_equal(result2, AZ_OK);
-  assert_int_equal(index2, 3);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(
+      az_ulib_ipc_query(AZ_SPAN_FROM_STR("name=MY_INTERFACE_1;version=-2"), &query_result, &token),
+      AZ_OK);
+  assert_true(az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.2\"")));
+
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(
+      az_ulib_ipc_query(
+          AZ_SPAN_FROM_STR("name=MY_INTERFACE_1;version=124-"), &query_result, &token),
+      AZ_ULIB_EOF);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 4);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the interface was unpublished, the az_ulib_ipc_try_get_capability shall not change the content
- * of capability_index and return AZ_ERROR_ITEM_NOT_FOUND. */
-static void az_ulib_ipc_try_get_capability_with_interface_unpublished_failed(void** state)
+/* If the query is a prefix, the az_ulib_ipc_query and az_ulib_ipc_query_next shall return all
+ * interfaces with a name that starts with the prefix, sorted by name and version. */
+static void az_ulib_ipc_query_by_prefix_succeed(void** state)
 {
   /// arrange
   (void)state;
-  init_ipc_and_publish_interfaces();
-  az_ulib_capability_index index = 0xFFFF;
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("prefix=MY_INTERFACE_");
+  uint8_t buf[40];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
+  init_ipc_without_stats_and_publish_interfaces();
 
   /// act
-  az_result result = az_ulib_ipc_try_get_capability(
-      interface_handle, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_PROPERTY_NAME), &index);
+  az_result result = az_ulib_ipc_query(query, &query_result, &token);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(index, 0xFFFF);
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_is_content_equal(
+      query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.2\",\"MY_INTERFACE_1.123\"")));
+  assert_int_equal(token & QUERY_TOKEN_POSITION_MASK, 0x186A);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_OK);
+  assert_true(
+      az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_2.123\"")));
+  assert_int_equal(token & QUERY_TOKEN_POSITION_MASK, 0x206A);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_OK);
+  assert_true(
+      az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_3.123\"")));
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_ULIB_EOF);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 3);
+  assert_int_equal(g_count_acquire, 4);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc_without_stats();
 }
 
-/* If the capability name does not belongs to the interface, the az_ulib_ipc_try_get_capability
- * shall not change the content of capability_index and return AZ_ERROR_ITEM_NOT_FOUND. */
-static void az_ulib_ipc_try_get_capability_with_not_capability_name_failed(void** state)
+/* If the query is a capability, the az_ulib_ipc_query shall return all interfaces that expose a
+ * capability with this name, sorted by name and version. */
+static void az_ulib_ipc_query_by_capability_succeed(void** state)
 {
   /// arrange
   (void)state;
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-  az_ulib_capability_index index = 0xFFFF;
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
 
   /// act
-  az_result result = az_ulib_ipc_try_get_capability(
-      interface_handle, AZ_SPAN_FROM_STR("not_in_interface"), &index);
-
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(index, 0xFFFF);
+  assert_int_equal(
+      az_ulib_ipc_query(AZ_SPAN_FROM_STR("capability=my_command"), &query_result, &token), AZ_OK);
+  assert_true(az_span_is_content_equal(
+      query_result,
+      AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.2\",\"MY_INTERFACE_1.123\",\"MY_INTERFACE_2.123\",\"MY_"
+                       "INTERFACE_3.123\"")));
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_ULIB_EOF);
+
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(
+      az_ulib_ipc_query(AZ_SPAN_FROM_STR("capability=query"), &query_result, &token), AZ_OK);
+  assert_true(az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"ipc_query.1\"")));
+
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(
+      az_ulib_ipc_query(AZ_SPAN_FROM_STR("capability=not_found"), &query_result, &token),
+      AZ_ULIB_EOF);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 2);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* The az_ulib_ipc_get_interface shall return the handle for the interface. */
-/* The az_ulib_ipc_get_interface shall return AZ_OK. */
-static void az_ulib_ipc_get_interface_succeed(void** state)
+/* The az_ulib_ipc_query shall escape the interface names as JSON strings. */
+static void az_ulib_ipc_query_escape_name_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
-  az_ulib_ipc_interface_handle new_interface_handle;
-  init_ipc_and_publish_interfaces();
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  g_count_acquire = 0;
+  static az_ulib_capability_descriptor capability_list[1]
+      = { { ._internal = { .name = AZ_SPAN_LITERAL_FROM_STR("cmd"),
+                           .flags = (uint8_t)AZ_ULIB_CAPABILITY_TYPE_COMMAND } } };
+  const az_ulib_interface_descriptor descriptor
+      = AZ_ULIB_DESCRIPTOR_CREATE("MY\"IF\\\x01", 1, 1, capability_list);
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  assert_int_equal(az_ulib_ipc_publish(&descriptor, NULL), AZ_OK);
 
   /// act
-  az_result result = az_ulib_ipc_get_interface(interface_handle, &new_interface_handle);
+  az_result result = az_ulib_ipc_query(AZ_SPAN_FROM_STR("capability=cmd"), &query_result, &token);
 
   /// assert
   assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_true(az_span_is_content_equal(
+      query_result, AZ_SPAN_FROM_STR("\"MY\\\"IF\\\\\\u0001.1\"")));
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(new_interface_handle), AZ_OK);
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
+  assert_int_equal(az_ulib_ipc_unpublish(&descriptor, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If the IPC reach the maximum number of allowed instances for a single interface, the
- * az_ulib_ipc_get_interface shall return AZ_ERROR_NOT_ENOUGH_SPACE. */
-static void az_ulib_ipc_get_interface_with_max_interface_instances_failed(void** state)
+/* If the query has an invalid argument, the az_ulib_ipc_query shall return
+ * AZ_ERROR_NOT_SUPPORTED. */
+static void az_ulib_ipc_query_with_invalid_argument_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle[AZ_ULIB_CONFIG_MAX_IPC_INSTANCES];
-  az_ulib_ipc_interface_handle interface_handle_plus_one;
-
+  uint8_t buf[100];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
 
-  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES; i++)
-  {
-    assert_int_equal(
-        az_ulib_ipc_try_get_interface(
-            AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-            MY_INTERFACE_1_123_INTERFACE_VERSION,
-            AZ_ULIB_VERSION_EQUALS_TO,
-            &interface_handle[i]),
-        AZ_OK);
-  }
-  g_count_acquire = 0;
-
-  /// act
-  az_result result = az_ulib_ipc_get_interface(interface_handle[0], &interface_handle_plus_one);
-
+  /// act
   /// assert
-  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_ulib_ipc_query(AZ_SPAN_FROM_STR("name="), &query_result, &token),
+      AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(
+      az_ulib_ipc_query(AZ_SPAN_FROM_STR("prefix="), &query_result, &token),
+      AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(
+      az_ulib_ipc_query(AZ_SPAN_FROM_STR("capability="), &query_result, &token),
+      AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(
+      az_ulib_ipc_query(
+          AZ_SPAN_FROM_STR("name=MY_INTERFACE_1;version=5-2"), &query_result, &token),
+      AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(
+      az_ulib_ipc_query(
+          AZ_SPAN_FROM_STR("name=MY_INTERFACE_1;version=a"), &query_result, &token),
+      AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(token, 0);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
-  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES; i++)
-  {
-    assert_int_equal(az_ulib_ipc_release_interface(interface_handle[i]), AZ_OK);
-  }
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the provided interface name does not exist, the az_ulib_ipc_get_interface shall return
- * AZ_ERROR_ITEM_NOT_FOUND. */
-static void az_ulib_ipc_get_interface_with_unpublished_interface_failed(void** state)
+/* If the next interface in the continuation token was unpublished, the az_ulib_ipc_query_next
+ * shall return AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_query_next_after_unpublish_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
-  az_ulib_ipc_interface_handle new_interface_handle;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("prefix=MY_INTERFACE_");
+  uint8_t buf[40];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  g_count_acquire = 0;
+  assert_int_equal(az_ulib_ipc_query(query, &query_result, &token), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
 
   /// act
-  az_result result = az_ulib_ipc_get_interface(interface_handle, &new_interface_handle);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  az_result result = az_ulib_ipc_query_next(&token, &query_result);
 
   /// assert
   assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
   assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* The az_ulib_ipc_release_interface shall release the instance of the interface. */
-/* The az_ulib_ipc_release_interface shall return AZ_OK. */
-static void az_ulib_ipc_release_interface_succeed(void** state)
+/* If the next interface in the continuation token was unpublished and its position reused, the
+ * az_ulib_ipc_query_next shall return AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_query_next_after_republish_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("capability=my_command");
+  uint8_t buf[40];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  g_count_acquire = 0;
+  assert_int_equal(az_ulib_ipc_query(query, &query_result, &token), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(NULL), AZ_OK);
 
   /// act
-  az_result result = az_ulib_ipc_release_interface(interface_handle);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  az_result result = az_ulib_ipc_query_next(&token, &query_result);
 
   /// assert
-  assert_int_equal(result, AZ_OK);
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the interface is already released, the az_ulib_ipc_release_interface shall return
- * AZ_ERROR_ULIB_PRECONDITION. */
-static void az_ulib_ipc_release_interface_double_release_failed(void** state)
+/* If the registry changed, but the next interface in the continuation token is still published,
+ * the az_ulib_ipc_query_next shall continue from its new position. */
+static void az_ulib_ipc_query_next_after_change_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_ipc_interface_handle interface_handle;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("prefix=MY_INTERFACE_");
+  uint8_t buf[40];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  g_count_acquire = 0;
+  assert_int_equal(az_ulib_ipc_query(query, &query_result, &token), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
 
   /// act
-  az_result result = az_ulib_ipc_release_interface(interface_handle);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  az_result result = az_ulib_ipc_query_next(&token, &query_result);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ULIB_PRECONDITION);
+  assert_int_equal(result, AZ_OK);
+  assert_true(
+      az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_2.123\"")));
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_OK);
+  assert_true(
+      az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_3.123\"")));
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_ULIB_EOF);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If one of the command in the interface is running, the az_ulib_ipc_release_interface shall
- return
- * AZ_OK. */
-static void az_ulib_ipc_release_interface_with_command_running_failed(void** state)
+/* If the registry changed, the az_ulib_ipc_query_next for all interfaces shall continue from the
+ * position in the registry, without report the same interface twice. */
+static void az_ulib_ipc_query_next_all_after_change_succeed(void** state)
 {
   /// arrange
   (void)state;
-  init_ipc_and_publish_interfaces();
-
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  g_count_acquire = 0;
-
-  my_command_model_in in;
-  in.capability = MY_COMMAND_CAPABILITY_RELEASE_INTERFACE;
-  in.handle = interface_handle;
-  az_result out = AZ_ULIB_PENDING;
+  uint8_t buf[50];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
+  init_ipc_without_stats_and_publish_interfaces();
+  assert_int_equal(az_ulib_ipc_query(AZ_SPAN_EMPTY, &query_result, &token), AZ_OK);
+  assert_true(az_span_is_content_equal(
+      query_result, AZ_SPAN_FROM_STR("\"ipc_query.1\",\"MY_INTERFACE_1.123\"")));
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
 
   /// act
-  // call release inside of the command.
-  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  az_result result = az_ulib_ipc_query_next(&token, &query_result);
 
   /// assert
   assert_int_equal(result, AZ_OK);
-  assert_int_equal(out, AZ_OK);
+  assert_true(az_span_is_content_equal(
+      query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_2.123\",\"MY_INTERFACE_3.123\"")));
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+  assert_int_equal(_az_ulib_ipc_stats_interface_publish(), AZ_OK);
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* The az_ulib_ipc_call shall call the command published by the interface. */
-/* The az_ulib_ipc_call shall return AZ_OK. */
-static void az_ulib_ipc_call_calls_the_command_succeed(void** state)
+/* If the next interface in the continuation token was unpublished and its position reused, the
+ * az_ulib_ipc_query_next shall return AZ_ERROR_ITEM_NOT_FOUND, even if the registry changed a
+ * multiple of 32 times. */
+static void az_ulib_ipc_query_next_after_republish_and_changes_failed(void** state)
 {
   /// arrange
   (void)state;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("prefix=MY_INTERFACE_");
+  uint8_t buf[40];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-
-  my_command_model_in in;
-  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
-  in.return_result = AZ_OK;
-  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(az_ulib_ipc_query(query, &query_result, &token), AZ_OK);
+  uint32_t generation = az_ulib_ipc_get_generation();
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  for (int i = 0; i < 15; i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+    assert_int_equal(az_ulib_test_my_interface_3_v123_publish(NULL), AZ_OK);
+  }
+  assert_int_equal(az_ulib_test_my_interface_2_v123_publish(NULL), AZ_OK);
+  assert_int_equal(az_ulib_ipc_get_generation() - generation, 32);
 
   /// act
-  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  az_result result = az_ulib_ipc_query_next(&token, &query_result);
 
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(out, AZ_OK);
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
   assert_int_equal(g_lock_diff, 0);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the interface was unpublished, the az_ulib_ipc_call shall return AZ_ERROR_ITEM_NOT_FOUND
- * and do not call the command. */
-static void az_ulib_ipc_call_unpublished_interface_failed(void** state)
+/* If the query is a name with a limited version range, and only the other interfaces changed, the
+ * az_ulib_ipc_query_next shall continue the query. */
+static void az_ulib_ipc_query_next_by_name_range_after_change_succeed(void** state)
 {
   /// arrange
   (void)state;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("name=MY_INTERFACE_1;version=1-200");
+  uint8_t buf[20];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-
-  my_command_model_in in;
-  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
-  in.return_result = AZ_OK;
-  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(az_ulib_ipc_query(query, &query_result, &token), AZ_OK);
+  assert_true(az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.2\"")));
+  for (int i = 0; i < 16; i++)
+  {
+    assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+    assert_int_equal(az_ulib_test_my_interface_3_v123_publish(NULL), AZ_OK);
+  }
 
   /// act
-  az_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  az_result result = az_ulib_ipc_query_next(&token, &query_result);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(out, AZ_ULIB_PENDING);
+  assert_int_equal(result, AZ_OK);
+  assert_true(
+      az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.123\"")));
+  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_ULIB_EOF);
   assert_int_equal(g_lock_diff, 0);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
 }
 
-/* The az_ulib_ipc_call_with_str shall call the command published by the interface. */
-/* The az_ulib_ipc_call_with_str shall return AZ_OK. */
-static void az_ulib_ipc_call_with_str_calls_the_command_succeed(void** state)
+/* If the query is a name with a limited version range, and a version with this name was
+ * unpublished, the az_ulib_ipc_query_next shall return AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_query_next_by_name_range_after_name_change_failed(void** state)
 {
   /// arrange
   (void)state;
+  az_span query = AZ_SPAN_LITERAL_FROM_STR("name=MY_INTERFACE_1;version=1-200");
+  uint8_t buf[20];
+  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
+  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
-          MY_INTERFACE_1_123_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-
-  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
-  uint8_t buf[100];
-  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_query(query, &query_result, &token), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
 
   /// act
-  az_result result = az_ulib_ipc_call_with_str(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out);
+  query_result = AZ_SPAN_FROM_BUFFER(buf);
+  az_result result = az_ulib_ipc_query_next(&token, &query_result);
 
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_true(az_span_is_content_equal(out, AZ_SPAN_FROM_STR("{\"result\":65536}")));
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
   assert_int_equal(g_lock_diff, 0);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If the interface does not support call with string, the az_ulib_ipc_call_with_str shall return
- * AZ_ERROR_NOT_SUPPORTED. */
-static void az_ulib_ipc_call_with_str_calls_not_supporte_failed(void** state)
+/* The az_ulib_ipc_get_generation shall return the number of publishes and unpublishes since the
+ * IPC initialization. */
+static void az_ulib_ipc_get_generation_succeed(void** state)
 {
   /// arrange
   (void)state;
-  init_ipc_and_publish_interfaces();
-
-  az_ulib_ipc_interface_handle interface_handle;
-  assert_int_equal(
-      az_ulib_ipc_try_get_interface(
-          AZ_SPAN_FROM_STR(MY_INTERFACE_1_2_INTERFACE_NAME),
-          MY_INTERFACE_1_2_INTERFACE_VERSION,
-          AZ_ULIB_VERSION_EQUALS_TO,
-          &interface_handle),
-      AZ_OK);
-
-  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
-  uint8_t buf[100];
-  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  uint32_t init_generation = az_ulib_ipc_get_generation();
+  assert_int_equal(init_generation, IPC_INIT_INTERFACES);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_ERROR_ULIB_ELEMENT_DUPLICATE);
 
   /// act
-  az_result result = az_ulib_ipc_call_with_str(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out);
+  uint32_t publish_generation = az_ulib_ipc_get_generation();
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  uint32_t unpublish_generation = az_ulib_ipc_get_generation();
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
-  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(publish_generation, init_generation + 1);
+  assert_int_equal(unpublish_generation, init_generation + 2);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  unpublish_interfaces_and_deinit_ipc();
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If the interface was unpublished, the az_ulib_ipc_call_with_str shall return
- * AZ_ERROR_ITEM_NOT_FOUND and do not call the command. */
-static void az_ulib_ipc_call_with_str_unpublished_interface_failed(void** state)
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+/* The az_ulib_ipc_get_stats shall return the number of calls, errors, and the latency of each call
+ * to the capability. */
+static void az_ulib_ipc_get_stats_succeed(void** state)
 {
   /// arrange
   (void)state;
@@ -1891,71 +5062,112 @@ static void az_ulib_ipc_call_with_str_unpublished_interface_failed(void** state)
           AZ_ULIB_VERSION_EQUALS_TO,
           &interface_handle),
       AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
 
-  az_span in = AZ_SPAN_LITERAL_FROM_STR("{ \"capability\":0, \"return_result\":65536 }");
-  uint8_t buf[100];
-  az_span out = AZ_SPAN_FROM_BUFFER(buf);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  g_clock_step_us = 5;
+  assert_int_equal(az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
+  in.capability = MY_COMMAND_CAPABILITY_RETURN_ERROR;
+  in.return_result = AZ_ERROR_ARG;
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_ERROR_ARG);
+  g_clock_step_us = 0;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  assert_int_equal(az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
+  az_ulib_ipc_capability_stats stats;
 
   /// act
-  az_result result = az_ulib_ipc_call_with_str(interface_handle, MY_INTERFACE_MY_COMMAND, in, &out);
+  az_result result = az_ulib_ipc_get_stats(interface_handle, MY_INTERFACE_MY_COMMAND, &stats);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_is_content_equal(stats.name, AZ_SPAN_FROM_STR(MY_INTERFACE_MY_COMMAND_NAME)));
+  assert_int_equal(stats.call_count, 3);
+  assert_int_equal(stats.error_count, 1);
+  assert_int_equal(stats.latency_histogram[0], 1);
+  assert_int_equal(stats.latency_histogram[3], 2);
+  assert_int_equal(
+      az_ulib_ipc_get_stats(interface_handle, MY_INTERFACE_MY_PROPERTY, &stats), AZ_OK);
+  assert_int_equal(stats.call_count, 0);
   assert_int_equal(g_lock_diff, 0);
 
   /// cleanup
   assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
 }
 
-/* The az_ulib_ipc_deinit shall release all resources associate with ipc. */
-/* The az_ulib_ipc_deinit shall return AZ_OK. */
-static void az_ulib_ipc_deinit_succeed(void** state)
+/* If the interface does not have the capability, the az_ulib_ipc_get_stats shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_get_stats_with_unknown_capability_failed(void** state)
 {
   /// arrange
   (void)state;
-  g_lock = NULL;
-  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
-  assert_non_null(g_lock);
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  az_ulib_ipc_capability_stats stats;
 
   /// act
-  az_result result = az_ulib_ipc_deinit();
+  az_result result = az_ulib_ipc_get_stats(
+      interface_handle, (az_ulib_capability_index)MY_INTERFACE_1_123_CAPABILITY_SIZE, &stats);
 
   /// assert
-  assert_null(g_lock);
-  assert_int_equal(result, AZ_OK);
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
 
   /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If there is published interface, the az_ulib_ipc_deinit shall return AZ_ERROR_ULIB_BUSY. */
-static void az_ulib_ipc_deinit_with_published_interface_failed(void** state)
+/* If the interface was unpublished, the az_ulib_ipc_get_stats shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_ipc_get_stats_unpublished_interface_failed(void** state)
 {
   /// arrange
   (void)state;
   init_ipc_and_publish_interfaces();
 
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  az_ulib_ipc_capability_stats stats;
+
   /// act
-  az_result result = az_ulib_ipc_deinit();
+  az_result result = az_ulib_ipc_get_stats(interface_handle, MY_INTERFACE_MY_COMMAND, &stats);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
 
   /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(NULL), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If there is instances of the interface, the az_ulib_ipc_deinit shall return AZ_ERROR_ULIB_BUSY.
- */
-static void az_ulib_ipc_deinit_with_instace_failed(void** state)
+/* If the interface was published again, the az_ulib_ipc_get_stats shall only return the calls
+ * after the new publish. */
+static void az_ulib_ipc_get_stats_after_republish_succeed(void** state)
 {
   /// arrange
   (void)state;
   init_ipc_and_publish_interfaces();
+
   az_ulib_ipc_interface_handle interface_handle;
   assert_int_equal(
       az_ulib_ipc_try_get_interface(
@@ -1964,232 +5176,305 @@ static void az_ulib_ipc_deinit_with_instace_failed(void** state)
           AZ_ULIB_VERSION_EQUALS_TO,
           &interface_handle),
       AZ_OK);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  assert_int_equal(az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
   assert_int_equal(az_ulib_test_my_interface_1_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_2_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_1_v2_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
-  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_1_v123_publish(&interface_handle), AZ_OK);
+  az_ulib_ipc_capability_stats stats;
 
   /// act
-  az_result result = az_ulib_ipc_deinit();
+  az_result result = az_ulib_ipc_get_stats(interface_handle, MY_INTERFACE_MY_COMMAND, &stats);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_ULIB_BUSY);
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(stats.call_count, 0);
+  assert_int_equal(stats.error_count, 0);
+  assert_int_equal(stats.latency_histogram[0], 0);
 
   /// cleanup
-  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
-  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
 }
+#endif // AZ_ULIB_CONFIG_IPC_STATS
 
-/* The az_ulib_ipc_get_vtable shall return the IPC vtable.
- */
-static void az_ulib_ipc_get_vtable_succeed(void** state)
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+static int32_t count_in_span(az_span span, az_span value)
 {
-  /// arrange
-  (void)state;
-
-  /// act
-  const az_ulib_ipc_vtable* vtable = az_ulib_ipc_get_vtable();
-
-  /// assert
-  assert_non_null(vtable);
-  assert_ptr_equal(vtable->publish, az_ulib_ipc_publish);
-  assert_ptr_equal(vtable->unpublish, az_ulib_ipc_unpublish);
-  assert_ptr_equal(vtable->try_get_interface, az_ulib_ipc_try_get_interface);
-  assert_ptr_equal(vtable->try_get_capability, az_ulib_ipc_try_get_capability);
-  assert_ptr_equal(vtable->get_interface, az_ulib_ipc_get_interface);
-  assert_ptr_equal(vtable->release_interface, az_ulib_ipc_release_interface);
-  assert_ptr_equal(vtable->call, az_ulib_ipc_call);
-  assert_ptr_equal(vtable->call_with_str, az_ulib_ipc_call_with_str);
-  assert_ptr_equal(vtable->query, az_ulib_ipc_query);
-  assert_ptr_equal(vtable->query_next, az_ulib_ipc_query_next);
-
-  /// cleanup
+  int32_t count = 0;
+  int32_t position;
+  while ((position = az_span_find(span, value)) >= 0)
+  {
+    count++;
+    span = az_span_slice_to_end(span, position + az_span_size(value));
+  }
+  return count;
 }
 
-/* If the query is empty, the az_ulib_ipc_query shall return a list of interfaces name and version,
- * separated by comma. */
-/* The az_ulib_ipc_query shall return AZ_OK. */
-static void az_ulib_ipc_query_succeed(void** state)
+/* If the trace was never enabled, the az_ulib_ipc_trace_dump shall return an empty trace. */
+static void az_ulib_ipc_trace_dump_empty_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
-  uint8_t buf[100];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
-  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
+  uint8_t buf[100];
+  az_span trace = AZ_SPAN_FROM_BUFFER(buf);
 
   /// act
-  az_result result = az_ulib_ipc_query(query, &query_result, &token);
+  az_result result = az_ulib_ipc_trace_dump(&trace);
 
   /// assert
   assert_int_equal(result, AZ_OK);
-  assert_true(az_span_is_content_equal(
-      query_result,
-      AZ_SPAN_FROM_STR("\"ipc_query.1\",\"MY_INTERFACE_1.123\",\"MY_INTERFACE_1.2\",\"MY_INTERFACE_"
-                       "2.123\",\"MY_INTERFACE_3.123\"")));
-  assert_int_equal(token, 0x000a00FF);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_true(az_span_is_content_equal(trace, AZ_SPAN_FROM_STR("{\"traceEvents\":[]}")));
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
 }
 
-static void az_ulib_ipc_query_small_buffer_succeed(void** state)
+/* While the trace is enabled, the az_ulib_ipc_call shall record a begin and an end event with the
+ * interface, the capability, the result, and the time of the call. */
+static void az_ulib_ipc_trace_dump_call_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
-  uint8_t buf[50];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
-  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
 
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_RETURN_ERROR;
+  in.return_result = AZ_ERROR_ARG;
+  az_result out = AZ_ULIB_PENDING;
+  g_clock_us = 100;
+  g_clock_step_us = 5;
+  az_ulib_ipc_trace_enable(true);
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_ERROR_ARG);
+  az_ulib_ipc_trace_enable(false);
+  assert_int_equal(
+      az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_ERROR_ARG);
+  uint8_t buf[500];
+  az_span trace = AZ_SPAN_FROM_BUFFER(buf);
+
   /// act
-  az_result result = az_ulib_ipc_query(query, &query_result, &token);
+  az_result result = az_ulib_ipc_trace_dump(&trace);
 
   /// assert
   assert_int_equal(result, AZ_OK);
-  assert_true(az_span_is_content_equal(
-      query_result, AZ_SPAN_FROM_STR("\"ipc_query.1\",\"MY_INTERFACE_1.123\"")));
-  assert_int_equal(token, 0x000200FF);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(count_in_span(trace, AZ_SPAN_FROM_STR("\"ph\"")), 2);
+  assert_int_equal(
+      count_in_span(
+          trace,
+          AZ_SPAN_FROM_STR("{\"name\":\"MY_INTERFACE_1\",\"cat\":\"call\","
+                           "\"ph\":\"B\",\"ts\":100,")),
+      1);
+  assert_int_equal(
+      count_in_span(
+          trace,
+          AZ_SPAN_FROM_STR("{\"name\":\"MY_INTERFACE_1\",\"cat\":\"call\","
+                           "\"ph\":\"E\",\"ts\":105,")),
+      1);
+  assert_int_equal(
+      count_in_span(trace, AZ_SPAN_FROM_STR("\"args\":{\"version\":123,\"capability\":3}}")), 1);
+  assert_int_equal(
+      count_in_span(
+          trace, AZ_SPAN_FROM_STR("\"args\":{\"version\":123,\"capability\":3,\"result\":")),
+      1);
 
   /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the buffer does not fit, at least, one interface name and version, the az_ulib_ipc_query shall
- * return AZ_ERROR_NOT_ENOUGH_SPACE. */
-static void az_ulib_ipc_query_buffer_too_small_failed(void** state)
+/* While the trace is enabled, the az_ulib_ipc_publish and the az_ulib_ipc_unpublish shall record
+ * an instant event. */
+static void az_ulib_ipc_trace_dump_publish_and_unpublish_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
-  uint8_t buf[3];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
-  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
+  az_ulib_ipc_trace_enable(true);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_publish(NULL), AZ_OK);
+  az_ulib_ipc_trace_enable(false);
+  uint8_t buf[500];
+  az_span trace = AZ_SPAN_FROM_BUFFER(buf);
 
   /// act
-  az_result result = az_ulib_ipc_query(query, &query_result, &token);
+  az_result result = az_ulib_ipc_trace_dump(&trace);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(count_in_span(trace, AZ_SPAN_FROM_STR("\"ph\"")), 2);
+  assert_int_equal(
+      count_in_span(
+          trace,
+          AZ_SPAN_FROM_STR("{\"name\":\"MY_INTERFACE_3\",\"cat\":\"unpublish\",\"ph\":\"i\",")),
+      1);
+  assert_int_equal(
+      count_in_span(
+          trace,
+          AZ_SPAN_FROM_STR("{\"name\":\"MY_INTERFACE_3\",\"cat\":\"publish\",\"ph\":\"i\",")),
+      1);
+  assert_int_equal(
+      count_in_span(trace, AZ_SPAN_FROM_STR("\"s\":\"t\",\"args\":{\"version\":123,\"result\":")),
+      2);
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the query is not supported, the az_ulib_ipc_query shall return AZ_ERROR_NOT_SUPPORTED. */
-static void az_ulib_ipc_query_not_supported_failed(void** state)
+/* While the trace is enabled, the az_ulib_ipc_replace shall record an instant event. */
+static void az_ulib_ipc_trace_dump_replace_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("\"query\":\"not supported\"");
-  uint8_t buf[100];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
-  uint32_t token = 0;
-  init_ipc_and_publish_interfaces();
+  assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
+  assert_int_equal(az_ulib_ipc_publish(&REPLACE_DESCRIPTOR_1, NULL), AZ_OK);
+  az_ulib_ipc_trace_enable(true);
+  assert_int_equal(
+      az_ulib_ipc_replace(&REPLACE_DESCRIPTOR_1, &REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT), AZ_OK);
+  az_ulib_ipc_trace_enable(false);
+  uint8_t buf[500];
+  az_span trace = AZ_SPAN_FROM_BUFFER(buf);
 
   /// act
-  az_result result = az_ulib_ipc_query(query, &query_result, &token);
+  az_result result = az_ulib_ipc_trace_dump(&trace);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(count_in_span(trace, AZ_SPAN_FROM_STR("\"ph\"")), 1);
+  assert_int_equal(
+      count_in_span(
+          trace, AZ_SPAN_FROM_STR("{\"name\":\"REPLACE\",\"cat\":\"replace\",\"ph\":\"i\",")),
+      1);
 
   /// cleanup
-  unpublish_interfaces_and_deinit_ipc();
+  assert_int_equal(az_ulib_ipc_unpublish(&REPLACE_DESCRIPTOR_2, AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* If there is no more interfaces to report, the az_ulib_ipc_query shall return AZ_ULIB_EOF. */
-static void az_ulib_ipc_query_eof_succeed(void** state)
+/* The trace events shall keep a copy of the interface name, truncated to
+ * AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE bytes, so the az_ulib_ipc_trace_dump does not read the name of
+ * a descriptor that was already released. */
+static void az_ulib_ipc_trace_dump_released_descriptor_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
-  uint8_t buf[100];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
-  uint32_t token = 0;
   assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
-  _az_ulib_ipc_query_interface_unpublish();
+  uint8_t name[AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE + 8];
+  (void)memset(name, 'a', sizeof(name));
+  az_ulib_interface_descriptor descriptor
+      = { ._internal = { .name = AZ_SPAN_FROM_BUFFER(name),
+                         .version = 1,
+                         .size = 0,
+                         .capability_list = NULL } };
+  az_ulib_ipc_trace_enable(true);
+  assert_int_equal(az_ulib_ipc_publish(&descriptor, NULL), AZ_OK);
+  assert_int_equal(az_ulib_ipc_unpublish(&descriptor, AZ_ULIB_NO_WAIT), AZ_OK);
+  az_ulib_ipc_trace_enable(false);
+  (void)memset(name, 'x', sizeof(name));
+  char expected[AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE + 12] = "{\"name\":\"";
+  size_t prefix_size = strlen(expected);
+  (void)memset(&expected[prefix_size], 'a', AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE);
+  (void)memcpy(&expected[prefix_size + AZ_ULIB_CONFIG_IPC_TRACE_NAME_SIZE], "\",", 3);
+  uint8_t buf[500];
+  az_span trace = AZ_SPAN_FROM_BUFFER(buf);
 
   /// act
-  az_result result = az_ulib_ipc_query(query, &query_result, &token);
+  az_result result = az_ulib_ipc_trace_dump(&trace);
 
   /// assert
-  assert_int_equal(result, AZ_ULIB_EOF);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 3);
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(count_in_span(trace, AZ_SPAN_FROM_STR("\"ph\"")), 2);
+  assert_int_equal(count_in_span(trace, az_span_create_from_str(expected)), 2);
+  assert_int_equal(count_in_span(trace, AZ_SPAN_FROM_STR("x")), 0);
 
   /// cleanup
-  _az_ulib_ipc_query_interface_publish();
   assert_int_equal(az_ulib_ipc_deinit(), AZ_OK);
 }
 
-/* The az_ulib_ipc_query_next shall return the next part of the query information based on the
- * continuation token. */
-/* If there are more information, the az_ulib_ipc_query_next shall return AZ_OK. */
-/* If there is no more interfaces to report, the az_ulib_ipc_query_next shall return AZ_ULIB_EOF. */
-static void az_ulib_ipc_query_next_succeed(void** state)
+/* If the ring is full, the new events shall overwrite the oldest ones. */
+static void az_ulib_ipc_trace_dump_full_ring_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_span query = AZ_SPAN_LITERAL_FROM_STR("");
-  uint8_t buf[50];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
-  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
-  assert_int_equal(az_ulib_ipc_query(query, &query_result, &token), AZ_OK);
+
+  az_ulib_ipc_interface_handle interface_handle;
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_123_INTERFACE_NAME),
+          MY_INTERFACE_1_123_INTERFACE_VERSION,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle),
+      AZ_OK);
+  my_command_model_in in;
+  in.capability = MY_COMMAND_CAPABILITY_JUST_RETURN;
+  in.return_result = AZ_OK;
+  az_result out = AZ_ULIB_PENDING;
+  g_clock_step_us = 1;
+  az_ulib_ipc_trace_enable(true);
+  for (int i = 0; i < AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE; i++)
+  {
+    assert_int_equal(
+        az_ulib_ipc_call(interface_handle, MY_INTERFACE_MY_COMMAND, &in, &out), AZ_OK);
+  }
+  az_ulib_ipc_trace_enable(false);
+  static uint8_t buf[AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE * 200];
+  az_span trace = AZ_SPAN_FROM_BUFFER(buf);
 
   /// act
-  /// assert
-  query_result = AZ_SPAN_FROM_BUFFER(buf);
-  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_OK);
-  assert_true(az_span_is_content_equal(
-      query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_1.2\",\"MY_INTERFACE_2.123\"")));
-  assert_int_equal(token, 0x000400FF);
-  query_result = AZ_SPAN_FROM_BUFFER(buf);
-  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_OK);
-  assert_true(az_span_is_content_equal(query_result, AZ_SPAN_FROM_STR("\"MY_INTERFACE_3.123\"")));
-  assert_int_equal(token, 0x000a00FF);
-  assert_int_equal(az_ulib_ipc_query_next(&token, &query_result), AZ_ULIB_EOF);
+  az_result result = az_ulib_ipc_trace_dump(&trace);
 
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 4);
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(
+      count_in_span(trace, AZ_SPAN_FROM_STR("\"ph\"")), AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE);
+  // The calls recorded 2 * AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE events, 1 microsecond apart.
+  char oldest[20];
+  (void)snprintf(oldest, sizeof(oldest), "\"ts\":%d,", AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE);
+  assert_int_equal(count_in_span(trace, az_span_create_from_str(oldest)), 1);
+  (void)snprintf(oldest, sizeof(oldest), "\"ts\":%d,", AZ_ULIB_CONFIG_IPC_TRACE_RING_SIZE - 1);
+  assert_int_equal(count_in_span(trace, az_span_create_from_str(oldest)), 0);
 
   /// cleanup
+  assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
   unpublish_interfaces_and_deinit_ipc();
 }
 
-/* If the continuation token is not supported, the az_ulib_ipc_query_next shall return
- * AZ_ERROR_NOT_SUPPORTED. */
-static void az_ulib_ipc_query_next_not_supported_failed(void** state)
+/* If the buffer is too small for the events, the az_ulib_ipc_trace_dump shall return
+ * AZ_ERROR_NOT_ENOUGH_SPACE. */
+static void az_ulib_ipc_trace_dump_not_enough_space_failed(void** state)
 {
   /// arrange
   (void)state;
-  uint8_t buf[100];
-  az_span query_result = AZ_SPAN_FROM_BUFFER(buf);
-  uint32_t token = 0;
   init_ipc_and_publish_interfaces();
+  az_ulib_ipc_trace_enable(true);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_unpublish(AZ_ULIB_NO_WAIT), AZ_OK);
+  assert_int_equal(az_ulib_test_my_interface_3_v123_publish(NULL), AZ_OK);
+  az_ulib_ipc_trace_enable(false);
+  uint8_t buf[50];
+  az_span trace = AZ_SPAN_FROM_BUFFER(buf);
 
   /// act
-  az_result result = az_ulib_ipc_query_next(&token, &query_result);
+  az_result result = az_ulib_ipc_trace_dump(&trace);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
 }
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
 
 int az_ulib_ipc_ut()
 {
@@ -2201,14 +5486,26 @@ int az_ulib_ipc_ut()
 #ifndef AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test(az_ulib_ipc_init_with_null_handle_failed),
     cmocka_unit_test(az_ulib_ipc_init_double_initialization_failed),
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+    cmocka_unit_test(az_ulib_ipc_init_with_allocator_with_null_allocator_failed),
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
     cmocka_unit_test(az_ulib_ipc_deinit_with_ipc_not_initialized_failed),
     cmocka_unit_test(az_ulib_ipc_publish_with_ipc_not_initialized_failed),
     cmocka_unit_test(az_ulib_ipc_publish_with_null_descriptor_failed),
     cmocka_unit_test(az_ulib_ipc_unpublish_with_ipc_not_initialized_failed),
     cmocka_unit_test(az_ulib_ipc_unpublish_with_null_descriptor_failed),
+    cmocka_unit_test(az_ulib_ipc_replace_with_ipc_not_initialized_failed),
+    cmocka_unit_test(az_ulib_ipc_replace_with_null_old_descriptor_failed),
+    cmocka_unit_test(az_ulib_ipc_replace_with_null_new_descriptor_failed),
+    cmocka_unit_test(az_ulib_ipc_wait_replaced_with_ipc_not_initialized_failed),
+    cmocka_unit_test(az_ulib_ipc_wait_replaced_with_null_descriptor_failed),
     cmocka_unit_test(az_ulib_ipc_try_get_interface_with_null_name_failed),
     cmocka_unit_test(az_ulib_ipc_try_get_interface_with_null_handle_failed),
     cmocka_unit_test(az_ulib_ipc_try_get_interface_with_ipc_not_initialized_failed),
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+    cmocka_unit_test(az_ulib_ipc_get_contract_with_null_descriptor_failed),
+    cmocka_unit_test(az_ulib_ipc_try_get_interface_with_contract_with_null_handle_failed),
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
     cmocka_unit_test(az_ulib_ipc_try_get_capability_with_null_name_failed),
     cmocka_unit_test(az_ulib_ipc_try_get_capability_with_null_handle_failed),
     cmocka_unit_test(az_ulib_ipc_try_get_capability_with_ipc_not_initialized_failed),
@@ -2218,10 +5515,30 @@ int az_ulib_ipc_ut()
     cmocka_unit_test(az_ulib_ipc_get_interface_with_ipc_not_initialized_failed),
     cmocka_unit_test(az_ulib_ipc_release_interface_with_null_interface_handle_failed),
     cmocka_unit_test(az_ulib_ipc_release_interface_with_ipc_not_initialized_failed),
+    cmocka_unit_test(az_ulib_ipc_subscribe_with_ipc_not_initialized_failed),
+    cmocka_unit_test(az_ulib_ipc_subscribe_with_null_filter_failed),
+    cmocka_unit_test(az_ulib_ipc_subscribe_with_null_callback_failed),
+    cmocka_unit_test(az_ulib_ipc_subscribe_with_null_subscription_handle_failed),
+    cmocka_unit_test(az_ulib_ipc_unsubscribe_with_ipc_not_initialized_failed),
+    cmocka_unit_test(az_ulib_ipc_unsubscribe_with_invalid_subscription_handle_failed),
     cmocka_unit_test(az_ulib_ipc_call_with_ipc_not_initialized_failed),
     cmocka_unit_test(az_ulib_ipc_call_with_null_interface_handle_failed),
+    cmocka_unit_test(az_ulib_ipc_call_with_invalid_interface_handle_failed),
     cmocka_unit_test(az_ulib_ipc_call_with_str_with_ipc_not_initialized_failed),
     cmocka_unit_test(az_ulib_ipc_call_with_str_with_null_interface_handle_failed),
+    cmocka_unit_test(az_ulib_ipc_call_with_binary_with_ipc_not_initialized_failed),
+    cmocka_unit_test(az_ulib_ipc_call_with_binary_with_null_interface_handle_failed),
+    cmocka_unit_test(az_ulib_ipc_call_batch_with_ipc_not_initialized_failed),
+    cmocka_unit_test(az_ulib_ipc_call_batch_with_null_interface_handle_failed),
+    cmocka_unit_test(az_ulib_ipc_call_batch_with_null_entries_failed),
+    cmocka_unit_test(az_ulib_ipc_call_batch_with_zero_entries_failed),
+    cmocka_unit_test(az_ulib_ipc_call_batch_with_null_results_failed),
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+    cmocka_unit_test(az_ulib_ipc_call_async_with_ipc_not_initialized_failed),
+    cmocka_unit_test(az_ulib_ipc_call_async_with_null_interface_handle_failed),
+    cmocka_unit_test(az_ulib_ipc_call_async_with_null_result_callback_failed),
+    cmocka_unit_test(az_ulib_ipc_cancel_async_with_ipc_not_initialized_failed),
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
     cmocka_unit_test(az_ulib_ipc_query_with_ipc_not_initialized_failed),
     cmocka_unit_test(az_ulib_ipc_query_with_null_result_failed),
     cmocka_unit_test(az_ulib_ipc_query_with_empty_result_failed),
@@ -2230,6 +5547,9 @@ int az_ulib_ipc_ut()
     cmocka_unit_test(az_ulib_ipc_query_next_with_null_result_failed),
     cmocka_unit_test(az_ulib_ipc_query_next_with_empty_result_failed),
     cmocka_unit_test(az_ulib_ipc_query_next_with_null_continuation_token_failed),
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+    cmocka_unit_test(az_ulib_ipc_trace_dump_with_null_trace_failed),
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
 #endif // AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test_setup(az_ulib_ipc_init_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_publish_succeed, setup),
@@ -2237,6 +5557,9 @@ int az_ulib_ipc_ut()
     cmocka_unit_test_setup(
         az_ulib_ipc_publish_with_descriptor_with_same_name_and_version_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_publish_out_of_memory_failed, setup),
+#ifdef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
+    cmocka_unit_test_setup(az_ulib_ipc_publish_beyond_max_interface_with_allocator_succeed, setup),
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
     cmocka_unit_test_setup(az_ulib_ipc_unpublish_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_unpublish_random_order_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_unpublish_release_resource_succeed, setup),
@@ -2245,22 +5568,44 @@ int az_ulib_ipc_ut()
     cmocka_unit_test_setup(
         az_ulib_ipc_unpublish_with_command_running_with_small_timeout_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_unpublish_with_valid_interface_instance_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_publish_with_stale_handle_in_the_position_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_replace_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_replace_with_incompatible_descriptor_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_replace_with_command_running_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_replace_with_unknown_descriptor_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_replace_with_replaced_descriptor_pending_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_wait_replaced_with_published_descriptor_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_replace_reports_to_subscribers_succeed, setup),
+#ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
+    cmocka_unit_test_setup(az_ulib_ipc_get_contract_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_with_contract_succeed, setup),
+    cmocka_unit_test_setup(
+        az_ulib_ipc_try_get_interface_with_contract_with_other_contract_failed, setup),
+#endif // AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
     cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_version_equals_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_with_index_in_change_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_version_any_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_version_greater_than_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_version_lower_than_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_version_lower_or_equal_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_lowest_version_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_publish_version_unpublished_before_succeed, setup),
+#ifndef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
     cmocka_unit_test_setup(
         az_ulib_ipc_try_get_interface_with_max_interface_instances_failed, setup),
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
     cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_with_unknown_name_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_with_unknown_version_failed, setup),
     cmocka_unit_test_setup(
         az_ulib_ipc_try_get_interface_without_version_greater_than_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_try_get_interface_without_version_lower_than_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_get_interface_succeed, setup),
+#ifndef AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
     cmocka_unit_test_setup(az_ulib_ipc_get_interface_with_max_interface_instances_failed, setup),
+#endif // AZ_ULIB_CONFIG_IPC_SEGMENTED_REGISTRY
     cmocka_unit_test_setup(az_ulib_ipc_get_interface_with_unpublished_interface_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_try_get_capability_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_try_get_capability_with_many_capabilities_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_try_get_capability_with_interface_unpublished_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_try_get_capability_with_not_capability_name_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_release_interface_succeed, setup),
@@ -2268,12 +5613,40 @@ int az_ulib_ipc_ut()
     cmocka_unit_test_setup(az_ulib_ipc_release_interface_with_command_running_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_call_calls_the_command_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_call_unpublished_interface_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_with_handle_of_reused_position_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_batch_calls_all_commands_succeed, setup),
+    cmocka_unit_test_setup(
+        az_ulib_ipc_call_batch_with_failed_command_calls_all_commands_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_batch_stop_on_error_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_batch_unpublished_interface_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_call_with_str_calls_the_command_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_call_with_str_calls_not_supporte_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_call_with_str_unpublished_interface_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_with_binary_calls_the_command_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_with_binary_calls_not_supported_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_with_binary_unpublished_interface_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_deinit_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_deinit_with_published_interface_failed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_deinit_with_instace_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_deinit_with_subscription_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_subscribe_reports_publish_and_unpublish_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_subscribe_with_version_filter_succeed, setup),
+    cmocka_unit_test_setup(
+        az_ulib_ipc_subscribe_with_empty_name_reports_all_interfaces_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_subscribe_out_of_memory_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_unsubscribe_stops_the_reports_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_unsubscribe_with_callback_running_failed, setup),
+#ifdef AZ_ULIB_CONFIG_IPC_ASYNC
+    cmocka_unit_test_setup(az_ulib_ipc_init_starts_async_workers_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_async_calls_the_command_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_async_calls_the_command_async_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_async_unpublished_interface_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_async_interface_unpublished_in_the_queue_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_call_async_with_full_queue_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_cancel_async_queued_call_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_cancel_async_with_unknown_token_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_deinit_with_async_call_pending_failed, setup),
+#endif // AZ_ULIB_CONFIG_IPC_ASYNC
     cmocka_unit_test_setup(az_ulib_ipc_get_vtable_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_query_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_query_small_buffer_succeed, setup),
@@ -2282,6 +5655,35 @@ int az_ulib_ipc_ut()
     cmocka_unit_test_setup(az_ulib_ipc_query_eof_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_query_next_succeed, setup),
     cmocka_unit_test_setup(az_ulib_ipc_query_next_not_supported_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_by_name_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_by_name_and_version_range_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_by_prefix_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_by_capability_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_escape_name_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_with_invalid_argument_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_next_after_unpublish_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_next_after_republish_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_next_after_republish_and_changes_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_next_by_name_range_after_change_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_next_by_name_range_after_name_change_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_next_after_change_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_query_next_all_after_change_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_get_generation_succeed, setup),
+#ifdef AZ_ULIB_CONFIG_IPC_STATS
+    cmocka_unit_test_setup(az_ulib_ipc_get_stats_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_get_stats_with_unknown_capability_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_get_stats_unpublished_interface_failed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_get_stats_after_republish_succeed, setup),
+#endif // AZ_ULIB_CONFIG_IPC_STATS
+#ifdef AZ_ULIB_CONFIG_IPC_TRACE
+    cmocka_unit_test_setup(az_ulib_ipc_trace_dump_empty_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_trace_dump_call_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_trace_dump_publish_and_unpublish_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_trace_dump_replace_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_trace_dump_released_descriptor_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_trace_dump_full_ring_succeed, setup),
+    cmocka_unit_test_setup(az_ulib_ipc_trace_dump_not_enough_space_failed, setup),
+#endif // AZ_ULIB_CONFIG_IPC_TRACE
   };
 
   return cmocka_run_group_tests_name("az_ulib_ipc_ut", tests, NULL, NULL);
@@ -4,3 +4,4 @@
 
 int az_ulib_ipc_ut();
 int az_ulib_descriptor_ut();
+int az_ulib_tlv_ut();
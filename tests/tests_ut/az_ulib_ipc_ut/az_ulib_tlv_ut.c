@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "az_ulib_ipc_ut.h"
+#include "az_ulib_result.h"
+#include "az_ulib_tlv.h"
+#include "azure/az_core.h"
+
+#include "az_ulib_test_precondition.h"
+#include "azure/core/az_precondition.h"
+
+#include "cmocka.h"
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+AZ_ULIB_ENABLE_PRECONDITION_CHECK_TESTS()
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/*
+ * Tests
+ */
+#ifndef AZ_NO_PRECONDITION_CHECKING
+/* If the writer is NULL, the az_ulib_tlv_writer_init shall fail with precondition. */
+static void az_ulib_tlv_writer_init_with_null_writer_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buf[10];
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_tlv_writer_init(NULL, AZ_SPAN_FROM_BUFFER(buf)));
+
+  /// cleanup
+}
+
+/* If the value is NULL, the az_ulib_tlv_reader_get_uint32 shall fail with precondition. */
+static void az_ulib_tlv_reader_get_uint32_with_null_value_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buf[] = { 1, 1, 0 };
+  az_ulib_tlv_reader tr;
+  assert_int_equal(az_ulib_tlv_reader_init(&tr, AZ_SPAN_FROM_BUFFER(buf)), AZ_OK);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_tlv_reader_get_uint32(&tr, NULL));
+
+  /// cleanup
+}
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/* The az_ulib_tlv_writer shall write fields that the az_ulib_tlv_reader reads back. */
+static void az_ulib_tlv_write_and_read_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buf[100];
+  az_ulib_tlv_writer tw;
+  assert_int_equal(az_ulib_tlv_writer_init(&tw, AZ_SPAN_FROM_BUFFER(buf)), AZ_OK);
+
+  /// act
+  assert_int_equal(az_ulib_tlv_writer_append_uint32(&tw, 1, 0), AZ_OK);
+  assert_int_equal(az_ulib_tlv_writer_append_uint32(&tw, 2, UINT32_MAX), AZ_OK);
+  assert_int_equal(az_ulib_tlv_writer_append_int32(&tw, 3, -1), AZ_OK);
+  assert_int_equal(az_ulib_tlv_writer_append_int32(&tw, 4, INT32_MIN), AZ_OK);
+  assert_int_equal(az_ulib_tlv_writer_append_int32(&tw, 5, INT32_MAX), AZ_OK);
+  assert_int_equal(az_ulib_tlv_writer_append_span(&tw, 6, AZ_SPAN_FROM_STR("hello")), AZ_OK);
+  assert_int_equal(az_ulib_tlv_writer_append_span(&tw, 7, AZ_SPAN_EMPTY), AZ_OK);
+  az_span written = az_ulib_tlv_writer_get_bytes_used_in_destination(&tw);
+
+  /// assert
+  az_ulib_tlv_reader tr;
+  uint32_t uval;
+  int32_t ival;
+  assert_int_equal(az_ulib_tlv_reader_init(&tr, written), AZ_OK);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(tr.tag, 1);
+  assert_int_equal(az_ulib_tlv_reader_get_uint32(&tr, &uval), AZ_OK);
+  assert_int_equal(uval, 0);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(tr.tag, 2);
+  assert_int_equal(az_ulib_tlv_reader_get_uint32(&tr, &uval), AZ_OK);
+  assert_int_equal(uval, UINT32_MAX);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(tr.tag, 3);
+  assert_int_equal(az_span_size(tr.value), 1);
+  assert_int_equal(az_ulib_tlv_reader_get_int32(&tr, &ival), AZ_OK);
+  assert_int_equal(ival, -1);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(tr.tag, 4);
+  assert_int_equal(az_ulib_tlv_reader_get_int32(&tr, &ival), AZ_OK);
+  assert_int_equal(ival, INT32_MIN);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(tr.tag, 5);
+  assert_int_equal(az_ulib_tlv_reader_get_int32(&tr, &ival), AZ_OK);
+  assert_int_equal(ival, INT32_MAX);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(tr.tag, 6);
+  assert_true(az_span_is_content_equal(tr.value, AZ_SPAN_FROM_STR("hello")));
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(tr.tag, 7);
+  assert_int_equal(az_span_size(tr.value), 0);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_ULIB_EOF);
+
+  /// cleanup
+}
+
+/* If the destination buffer is too small, the az_ulib_tlv_writer_append_uint32 shall return
+ * AZ_ERROR_NOT_ENOUGH_SPACE and do not change the writer. */
+static void az_ulib_tlv_writer_append_uint32_not_enough_space_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buf[4];
+  az_ulib_tlv_writer tw;
+  assert_int_equal(az_ulib_tlv_writer_init(&tw, AZ_SPAN_FROM_BUFFER(buf)), AZ_OK);
+  assert_int_equal(az_ulib_tlv_writer_append_uint32(&tw, 1, 1), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_tlv_writer_append_uint32(&tw, 2, 1000);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_span_size(az_ulib_tlv_writer_get_bytes_used_in_destination(&tw)), 3);
+
+  /// cleanup
+}
+
+/* If the buffer ends in the middle of a field, the az_ulib_tlv_reader_next shall return
+ * AZ_ERROR_UNEXPECTED_END. */
+static void az_ulib_tlv_reader_next_truncated_field_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buf[] = { 1, 5, 'a', 'b' };
+  az_ulib_tlv_reader tr;
+  assert_int_equal(az_ulib_tlv_reader_init(&tr, AZ_SPAN_FROM_BUFFER(buf)), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_tlv_reader_next(&tr);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_UNEXPECTED_END);
+
+  /// cleanup
+}
+
+/* If the field length does not fit in 32 bits, the az_ulib_tlv_reader_next shall return
+ * AZ_ERROR_UNEXPECTED_CHAR. */
+static void az_ulib_tlv_reader_next_invalid_length_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buf[] = { 1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 };
+  az_ulib_tlv_reader tr;
+  assert_int_equal(az_ulib_tlv_reader_init(&tr, AZ_SPAN_FROM_BUFFER(buf)), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_tlv_reader_next(&tr);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_UNEXPECTED_CHAR);
+
+  /// cleanup
+}
+
+/* If the value is not a complete varint, the az_ulib_tlv_reader_get_uint32 shall return
+ * AZ_ERROR_UNEXPECTED_CHAR. */
+static void az_ulib_tlv_reader_get_uint32_invalid_value_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buf[] = { 1, 1, 0x80, 2, 2, 0, 0, 3, 0 };
+  az_ulib_tlv_reader tr;
+  uint32_t val;
+  assert_int_equal(az_ulib_tlv_reader_init(&tr, AZ_SPAN_FROM_BUFFER(buf)), AZ_OK);
+
+  /// act
+  /// assert
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(az_ulib_tlv_reader_get_uint32(&tr, &val), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(az_ulib_tlv_reader_get_uint32(&tr, &val), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_ulib_tlv_reader_next(&tr), AZ_OK);
+  assert_int_equal(az_ulib_tlv_reader_get_uint32(&tr, &val), AZ_ERROR_UNEXPECTED_CHAR);
+
+  /// cleanup
+}
+
+int az_ulib_tlv_ut()
+{
+#ifndef AZ_NO_PRECONDITION_CHECKING
+  AZ_ULIB_SETUP_PRECONDITION_CHECK_TESTS();
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+  const struct CMUnitTest tests[] = {
+#ifndef AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test(az_ulib_tlv_writer_init_with_null_writer_failed),
+    cmocka_unit_test(az_ulib_tlv_reader_get_uint32_with_null_value_failed),
+#endif // AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test(az_ulib_tlv_write_and_read_succeed),
+    cmocka_unit_test(az_ulib_tlv_writer_append_uint32_not_enough_space_failed),
+    cmocka_unit_test(az_ulib_tlv_reader_next_truncated_field_failed),
+    cmocka_unit_test(az_ulib_tlv_reader_next_invalid_length_failed),
+    cmocka_unit_test(az_ulib_tlv_reader_get_uint32_invalid_value_failed),
+  };
+
+  return cmocka_run_group_tests_name("az_ulib_tlv_ut", tests, NULL, NULL);
+}
@@ -14,6 +14,8 @@ int main(void)
   result += az_ulib_ipc_ut();
   (void)printf("[==========]\r\n[ STARTING ] Running az_ulib_descriptor_ut.\r\n");
   result += az_ulib_descriptor_ut();
+  (void)printf("[==========]\r\n[ STARTING ] Running az_ulib_tlv_ut.\r\n");
+  result += az_ulib_tlv_ut();
 
   return result;
 }
@@ -253,6 +253,37 @@ static void az_ulib_ustream_split_null_split_instance_failed(void** state)
   /// cleanup
 }
 
+/* az_ulib_ustream_to_span_array shall fail with precondition if the provided ustream is NULL. */
+static void az_ulib_ustream_to_span_array_null_instance_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span spans[4];
+  size_t span_count;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_to_span_array(NULL, spans, 4, &span_count));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_to_span_array shall fail with precondition if the provided spans is NULL. */
+static void az_ulib_ustream_to_span_array_null_spans_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_buffer;
+  size_t span_count;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ustream_to_span_array(&test_buffer, NULL, 4, &span_count));
+
+  /// cleanup
+}
+
 #endif // AZ_NO_PRECONDITION_CHECKING
 
 /* az_ulib_ustream_concat shall return AZ_OK if the ustreams were concatenated successfully
@@ -875,6 +906,302 @@ static void az_ulib_ustream_split_set_position_second_failed(void** state)
   az_ulib_ustream_dispose(test_ustream);
 }
 
+/* The multi ustream shall peek the content of each concatenated ustream without copying it. */
+static void az_ulib_ustream_multi_peek_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_multi;
+  create_test_default_multibuffer(&test_multi);
+  const uint8_t* data;
+  size_t size;
+
+  /// act
+  /// assert
+  assert_int_equal(az_ulib_ustream_peek(&test_multi, &data, &size), AZ_OK);
+  assert_ptr_equal(data, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1);
+  assert_int_equal(size, 10);
+  assert_int_equal(az_ulib_ustream_advance(&test_multi, 15), AZ_OK);
+  assert_int_equal(az_ulib_ustream_peek(&test_multi, &data, &size), AZ_OK);
+  assert_ptr_equal(data, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2 + 5);
+  assert_int_equal(size, 21);
+  assert_int_equal(az_ulib_ustream_advance(&test_multi, 21), AZ_OK);
+  assert_int_equal(az_ulib_ustream_peek(&test_multi, &data, &size), AZ_OK);
+  assert_ptr_equal(data, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_3);
+  assert_int_equal(size, 26);
+  assert_int_equal(az_ulib_ustream_advance(&test_multi, 26), AZ_OK);
+  assert_int_equal(az_ulib_ustream_peek(&test_multi, &data, &size), AZ_ULIB_EOF);
+  assert_int_equal(size, 0);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_multi);
+}
+
+/* The multi ustream peek shall not return content after the end of a split ustream. */
+static void az_ulib_ustream_multi_peek_after_split_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_multi;
+  create_test_default_multibuffer(&test_multi);
+  az_ulib_ustream test_multi_split;
+  assert_int_equal(az_ulib_ustream_split(&test_multi, &test_multi_split, 5), AZ_OK);
+  const uint8_t* data;
+  size_t size;
+
+  /// act
+  az_result result = az_ulib_ustream_peek(&test_multi, &data, &size);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_ptr_equal(data, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1);
+  assert_int_equal(size, 5);
+  assert_int_equal(az_ulib_ustream_advance(&test_multi, 6), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_ustream_advance(&test_multi, 5), AZ_OK);
+  assert_int_equal(az_ulib_ustream_peek(&test_multi, &data, &size), AZ_ULIB_EOF);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_multi);
+  (void)az_ulib_ustream_dispose(&test_multi_split);
+}
+
+/* The multi ustream shall copy the content at the provided position without moving the current
+ * position. */
+static void az_ulib_ustream_multi_read_at_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_multi;
+  create_test_default_multibuffer(&test_multi);
+  uint8_t buf[30];
+  size_t size;
+
+  /// act
+  az_result result = az_ulib_ustream_read_at(&test_multi, 5, buf, sizeof(buf), &size);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size, sizeof(buf));
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 5, size);
+  assert_int_equal(
+      az_ulib_ustream_read_at(
+          &test_multi, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, buf, sizeof(buf), &size),
+      AZ_ULIB_EOF);
+  assert_int_equal(
+      az_ulib_ustream_read_at(
+          &test_multi, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 1, buf, sizeof(buf), &size),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  offset_t position;
+  assert_int_equal(az_ulib_ustream_get_position(&test_multi, &position), AZ_OK);
+  assert_int_equal(position, 0);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_multi);
+}
+
+/* The multi ustream shall read a concatenated ustream that was cloned with an offset. */
+static void az_ulib_ustream_multi_read_with_offset_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block1;
+  az_ulib_ustream test_buffer1;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer1,
+          &control_block1,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+          strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1),
+          NULL),
+      AZ_OK);
+  az_ulib_ustream_data_cb control_block2;
+  az_ulib_ustream test_buffer2;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer2,
+          &control_block2,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2,
+          strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2),
+          NULL),
+      AZ_OK);
+  az_ulib_ustream test_multi;
+  assert_int_equal(az_ulib_ustream_clone(&test_multi, &test_buffer1, 100), AZ_OK);
+  az_ulib_ustream_multi_data_cb multi_data;
+  assert_int_equal(az_ulib_ustream_concat(&test_multi, &test_buffer2, &multi_data, NULL), AZ_OK);
+  uint8_t buf[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  size_t size;
+
+  /// act
+  az_result result = az_ulib_ustream_read(&test_multi, buf, sizeof(buf), &size);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size, 36);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, size);
+  assert_int_equal(az_ulib_ustream_read_at(&test_multi, 108, buf, sizeof(buf), &size), AZ_OK);
+  assert_int_equal(size, 28);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 8, size);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_multi);
+  (void)az_ulib_ustream_dispose(&test_buffer1);
+  (void)az_ulib_ustream_dispose(&test_buffer2);
+}
+
+/* The multi ustream read shall not return content after the end of a split ustream. */
+static void az_ulib_ustream_multi_read_after_split_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_multi;
+  create_test_default_multibuffer(&test_multi);
+  az_ulib_ustream test_multi_split;
+  assert_int_equal(az_ulib_ustream_split(&test_multi, &test_multi_split, 15), AZ_OK);
+  uint8_t buf[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  size_t size;
+
+  /// act
+  az_result result = az_ulib_ustream_read(&test_multi, buf, sizeof(buf), &size);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size, 15);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, size);
+  assert_int_equal(az_ulib_ustream_read(&test_multi, buf, sizeof(buf), &size), AZ_ULIB_EOF);
+  assert_int_equal(az_ulib_ustream_read(&test_multi_split, buf, sizeof(buf), &size), AZ_OK);
+  assert_int_equal(size, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 15);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 15, size);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_multi);
+  (void)az_ulib_ustream_dispose(&test_multi_split);
+}
+
+/* If the ustream does not implement the optional APIs, az_ulib_ustream_peek,
+ * az_ulib_ustream_advance, and az_ulib_ustream_read_at shall return AZ_ERROR_NOT_SUPPORTED. */
+static void az_ulib_ustream_optional_api_not_supported_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+  const uint8_t* data;
+  size_t size;
+
+  /// act
+  /// assert
+  assert_int_equal(az_ulib_ustream_peek(test_ustream, &data, &size), AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(az_ulib_ustream_advance(test_ustream, 1), AZ_ERROR_NOT_SUPPORTED);
+  uint8_t buf[10];
+  assert_int_equal(
+      az_ulib_ustream_read_at(test_ustream, 0, buf, sizeof(buf), &size), AZ_ERROR_NOT_SUPPORTED);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_to_span_array shall fill the spans with the remaining content of the ustream,
+ * without copying it and without changing the current position. */
+static void az_ulib_ustream_to_span_array_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_multi;
+  create_test_default_multibuffer(&test_multi);
+  assert_int_equal(az_ulib_ustream_set_position(&test_multi, 5), AZ_OK);
+  az_span spans[4];
+  size_t span_count;
+
+  /// act
+  az_result result = az_ulib_ustream_to_span_array(&test_multi, spans, 4, &span_count);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(span_count, 3);
+  assert_ptr_equal(az_span_ptr(spans[0]), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1 + 5);
+  assert_int_equal(az_span_size(spans[0]), 5);
+  assert_ptr_equal(az_span_ptr(spans[1]), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2);
+  assert_int_equal(az_span_size(spans[1]), 26);
+  assert_ptr_equal(az_span_ptr(spans[2]), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_3);
+  assert_int_equal(az_span_size(spans[2]), 26);
+  offset_t position;
+  assert_int_equal(az_ulib_ustream_get_position(&test_multi, &position), AZ_OK);
+  assert_int_equal(position, 5);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_multi);
+}
+
+/* If the ustream is at its end, az_ulib_ustream_to_span_array shall return AZ_OK with no spans. */
+static void az_ulib_ustream_to_span_array_end_of_ustream_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_multi;
+  create_test_default_multibuffer(&test_multi);
+  assert_int_equal(az_ulib_ustream_set_position(&test_multi, 62), AZ_OK);
+  az_span spans[4];
+  size_t span_count;
+
+  /// act
+  az_result result = az_ulib_ustream_to_span_array(&test_multi, spans, 4, &span_count);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(span_count, 0);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_multi);
+}
+
+/* If the content needs more spans than max_spans, az_ulib_ustream_to_span_array shall return
+ * AZ_ERROR_NOT_ENOUGH_SPACE with the first max_spans parts of the content. */
+static void az_ulib_ustream_to_span_array_not_enough_space_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_multi;
+  create_test_default_multibuffer(&test_multi);
+  az_span spans[2];
+  size_t span_count;
+
+  /// act
+  az_result result = az_ulib_ustream_to_span_array(&test_multi, spans, 2, &span_count);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(span_count, 2);
+  assert_ptr_equal(az_span_ptr(spans[0]), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1);
+  assert_int_equal(az_span_size(spans[0]), 10);
+  assert_ptr_equal(az_span_ptr(spans[1]), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2);
+  assert_int_equal(az_span_size(spans[1]), 26);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_multi);
+}
+
+/* If the ustream does not implement peek, az_ulib_ustream_to_span_array shall return
+ * AZ_ERROR_NOT_SUPPORTED. */
+static void az_ulib_ustream_to_span_array_not_supported_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+  az_span spans[4];
+  size_t span_count;
+
+  /// act
+  az_result result = az_ulib_ustream_to_span_array(test_ustream, spans, 4, &span_count);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(span_count, 0);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(test_ustream);
+}
+
 #include "az_ulib_ustream_compliance_ut.h"
 
 int az_ulib_ustream_aux_ut()
@@ -890,6 +1217,8 @@ int az_ulib_ustream_aux_ut()
     cmocka_unit_test(az_ulib_ustream_concat_null_multi_data_failed),
     cmocka_unit_test(az_ulib_ustream_split_null_instance_failed),
     cmocka_unit_test(az_ulib_ustream_split_null_split_instance_failed),
+    cmocka_unit_test(az_ulib_ustream_to_span_array_null_instance_failed),
+    cmocka_unit_test(az_ulib_ustream_to_span_array_null_spans_failed),
 #endif // AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test_setup_teardown(
         az_ulib_ustream_concat_multiple_buffers_succeed, setup, teardown),
@@ -923,6 +1252,23 @@ int az_ulib_ustream_aux_ut()
     cmocka_unit_test_setup_teardown(az_ulib_ustream_split_clone_failed, setup, teardown),
     cmocka_unit_test_setup_teardown(
         az_ulib_ustream_split_set_position_second_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_multi_peek_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_multi_peek_after_split_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_multi_read_at_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_multi_read_with_offset_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_multi_read_after_split_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_optional_api_not_supported_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_to_span_array_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_to_span_array_end_of_ustream_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_to_span_array_not_enough_space_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_to_span_array_not_supported_failed, setup, teardown),
 #ifndef AZ_NO_PRECONDITION_CHECKING
     AZ_ULIB_USTREAM_PRECONDITION_COMPLIANCE_UT_LIST
 #endif // AZ_NO_PRECONDITION_CHECKING
@@ -0,0 +1,265 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream_ut.h"
+
+#include "az_ulib_ustream_mock_buffer.h"
+
+#include "az_ulib_test_precondition.h"
+#include "azure/core/az_precondition.h"
+
+#include "cmocka.h"
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT \
+  "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+
+#define TEST_FILE_NAME "az_ulib_ustream_file_ut.bin"
+#define TEST_EMPTY_FILE_NAME "az_ulib_ustream_file_ut_empty.bin"
+
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT
+    = (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+static int g_file_data_release_count;
+
+static void file_data_release(void* release_pointer)
+{
+  g_file_data_release_count++;
+  free(release_pointer);
+}
+
+static void ustream_factory(az_ulib_ustream* ustream)
+{
+  az_ulib_ustream_file_data_cb* file_data
+      = (az_ulib_ustream_file_data_cb*)malloc(sizeof(az_ulib_ustream_file_data_cb));
+  assert_non_null(file_data);
+  assert_int_equal(
+      az_ulib_ustream_init_from_file(ustream, file_data, free, TEST_FILE_NAME), AZ_OK);
+}
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream) ustream_factory(ustream)
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+AZ_ULIB_ENABLE_PRECONDITION_CHECK_TESTS()
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+static void write_file(const char* file_name, const char* content, size_t content_length)
+{
+  FILE* file = fopen(file_name, "wb");
+  assert_non_null(file);
+  assert_int_equal(fwrite(content, 1, content_length, file), content_length);
+  assert_int_equal(fclose(file), 0);
+}
+
+/**
+ * Beginning of the UT for the file ustream.
+ */
+static int group_setup(void** state)
+{
+  (void)state;
+
+  write_file(
+      TEST_FILE_NAME,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  write_file(TEST_EMPTY_FILE_NAME, "", 0);
+
+  return 0;
+}
+
+static int group_teardown(void** state)
+{
+  (void)state;
+
+  (void)remove(TEST_FILE_NAME);
+  (void)remove(TEST_EMPTY_FILE_NAME);
+
+  return 0;
+}
+
+static int setup(void** state)
+{
+  (void)state;
+
+  g_file_data_release_count = 0;
+
+  return 0;
+}
+
+static int teardown(void** state)
+{
+  (void)state;
+
+  reset_mock_buffer();
+
+  return 0;
+}
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+/* az_ulib_ustream_init_from_file shall fail with precondition if the provided ustream is NULL. */
+static void az_ulib_ustream_init_from_file_NULL_ustream_instance_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_file_data_cb file_data;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ustream_init_from_file(NULL, &file_data, NULL, TEST_FILE_NAME));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_init_from_file shall fail with precondition if the provided control block is
+ * NULL. */
+static void az_ulib_ustream_init_from_file_NULL_file_data_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ustream_init_from_file(&ustream_instance, NULL, NULL, TEST_FILE_NAME));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_init_from_file shall fail with precondition if the provided file name is NULL.
+ */
+static void az_ulib_ustream_init_from_file_NULL_file_name_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  az_ulib_ustream_file_data_cb file_data;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ustream_init_from_file(&ustream_instance, &file_data, NULL, NULL));
+
+  /// cleanup
+}
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/* az_ulib_ustream_init_from_file shall create an instance of the ustream with the content of the
+ * file. */
+/* The file ustream shall release the control block when the last instance is disposed. */
+static void az_ulib_ustream_init_from_file_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_file_data_cb* file_data
+      = (az_ulib_ustream_file_data_cb*)malloc(sizeof(az_ulib_ustream_file_data_cb));
+  assert_non_null(file_data);
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  az_result result = az_ulib_ustream_init_from_file(
+      &ustream_instance, file_data, file_data_release, TEST_FILE_NAME);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  uint8_t buf[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 2];
+  size_t size;
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_OK);
+  assert_int_equal(size, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, size);
+  az_ulib_ustream ustream_instance_clone;
+  assert_int_equal(az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, 0), AZ_OK);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_instance), AZ_OK);
+  assert_int_equal(g_file_data_release_count, 0);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_instance_clone), AZ_OK);
+  assert_int_equal(g_file_data_release_count, 1);
+
+  /// cleanup
+}
+
+/* If the file does not exist, az_ulib_ustream_init_from_file shall return AZ_ERROR_ITEM_NOT_FOUND
+ * and do not release the control block. */
+static void az_ulib_ustream_init_from_file_unknown_file_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_file_data_cb file_data;
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  az_result result = az_ulib_ustream_init_from_file(
+      &ustream_instance, &file_data, file_data_release, "az_ulib_ustream_file_ut_unknown.bin");
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_file_data_release_count, 0);
+
+  /// cleanup
+}
+
+/* If the file is empty, az_ulib_ustream_init_from_file shall create an empty ustream that returns
+ * AZ_ULIB_EOF on the first read. */
+static void az_ulib_ustream_init_from_file_empty_file_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_file_data_cb* file_data
+      = (az_ulib_ustream_file_data_cb*)malloc(sizeof(az_ulib_ustream_file_data_cb));
+  assert_non_null(file_data);
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  az_result result = az_ulib_ustream_init_from_file(
+      &ustream_instance, file_data, file_data_release, TEST_EMPTY_FILE_NAME);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  size_t size;
+  assert_int_equal(az_ulib_ustream_get_remaining_size(&ustream_instance, &size), AZ_OK);
+  assert_int_equal(size, 0);
+  uint8_t buf[10];
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_ULIB_EOF);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_instance), AZ_OK);
+  assert_int_equal(g_file_data_release_count, 1);
+
+  /// cleanup
+}
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+int az_ulib_ustream_file_ut()
+{
+#ifndef AZ_NO_PRECONDITION_CHECKING
+  AZ_ULIB_SETUP_PRECONDITION_CHECK_TESTS();
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+  const struct CMUnitTest tests[] = {
+#ifndef AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test(az_ulib_ustream_init_from_file_NULL_ustream_instance_failed),
+    cmocka_unit_test(az_ulib_ustream_init_from_file_NULL_file_data_failed),
+    cmocka_unit_test(az_ulib_ustream_init_from_file_NULL_file_name_failed),
+#endif // AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_init_from_file_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_init_from_file_unknown_file_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_init_from_file_empty_file_succeed, setup, teardown),
+#ifndef AZ_NO_PRECONDITION_CHECKING
+    AZ_ULIB_USTREAM_PRECONDITION_COMPLIANCE_UT_LIST
+#endif // AZ_NO_PRECONDITION_CHECKING
+        AZ_ULIB_USTREAM_COMPLIANCE_UT_LIST
+  };
+
+  return cmocka_run_group_tests_name("az_ulib_ustream_file_ut", tests, group_setup, group_teardown);
+}
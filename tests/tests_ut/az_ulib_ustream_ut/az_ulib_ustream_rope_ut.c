@@ -0,0 +1,537 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream_ut.h"
+
+#include "az_ulib_ustream_mock_buffer.h"
+
+#include "az_ulib_test_precondition.h"
+#include "azure/core/az_precondition.h"
+
+#include "cmocka.h"
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT \
+  "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+
+#define TEST_ROPE_MAX_SEGMENTS 3
+
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT
+    = (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+
+/*
+ * The rope control block and its segments in a single allocation.
+ */
+typedef struct
+{
+  az_ulib_ustream_rope_data_cb rope_data;
+  az_ulib_ustream_rope_segment segments[TEST_ROPE_MAX_SEGMENTS];
+} test_rope;
+
+static int g_rope_data_release_count;
+
+static void rope_data_release(void* release_pointer)
+{
+  g_rope_data_release_count++;
+  free(release_pointer);
+}
+
+static void append_buffer(az_ulib_ustream* rope, size_t start, size_t size)
+{
+  az_ulib_ustream_data_cb* control_block
+      = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+  assert_non_null(control_block);
+  az_ulib_ustream buffer;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &buffer,
+          control_block,
+          free,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + start,
+          size,
+          NULL),
+      AZ_OK);
+  az_result result = az_ulib_ustream_rope_append(rope, &buffer);
+  (void)az_ulib_ustream_dispose(&buffer);
+  assert_int_equal(result, AZ_OK);
+}
+
+static void ustream_factory(az_ulib_ustream* ustream)
+{
+  test_rope* rope = (test_rope*)malloc(sizeof(test_rope));
+  assert_non_null(rope);
+  assert_int_equal(
+      az_ulib_ustream_rope_init(
+          ustream, &rope->rope_data, free, rope->segments, TEST_ROPE_MAX_SEGMENTS),
+      AZ_OK);
+  append_buffer(ustream, 0, 10);
+  append_buffer(ustream, 10, 26);
+  append_buffer(ustream, 36, 26);
+}
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream) ustream_factory(ustream)
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+AZ_ULIB_ENABLE_PRECONDITION_CHECK_TESTS()
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/**
+ * Beginning of the UT for the rope ustream.
+ */
+static int setup(void** state)
+{
+  (void)state;
+
+  g_rope_data_release_count = 0;
+
+  return 0;
+}
+
+static int teardown(void** state)
+{
+  (void)state;
+
+  reset_mock_buffer();
+
+  return 0;
+}
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+/* az_ulib_ustream_rope_init shall fail with precondition if the provided ustream is NULL. */
+static void az_ulib_ustream_rope_init_NULL_ustream_instance_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope rope;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_rope_init(
+      NULL, &rope.rope_data, NULL, rope.segments, TEST_ROPE_MAX_SEGMENTS));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_rope_init shall fail with precondition if the provided control block is NULL. */
+static void az_ulib_ustream_rope_init_NULL_rope_data_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope rope;
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_rope_init(
+      &ustream_instance, NULL, NULL, rope.segments, TEST_ROPE_MAX_SEGMENTS));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_rope_init shall fail with precondition if the provided segments are NULL. */
+static void az_ulib_ustream_rope_init_NULL_segments_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope rope;
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_rope_init(
+      &ustream_instance, &rope.rope_data, NULL, NULL, TEST_ROPE_MAX_SEGMENTS));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_rope_init shall fail with precondition if the provided max_segments is zero. */
+static void az_ulib_ustream_rope_init_zero_max_segments_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope rope;
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_ustream_rope_init(&ustream_instance, &rope.rope_data, NULL, rope.segments, 0));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_rope_append shall fail with precondition if the provided ustream is not a rope.
+ */
+static void az_ulib_ustream_rope_append_not_rope_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_rope_append(test_ustream, test_ustream));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_rope_append shall fail with precondition if the provided ustream to append is
+ * NULL. */
+static void az_ulib_ustream_rope_append_NULL_ustream_to_append_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope rope;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_rope_init(
+          &ustream_instance, &rope.rope_data, NULL, rope.segments, TEST_ROPE_MAX_SEGMENTS),
+      AZ_OK);
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_rope_append(&ustream_instance, NULL));
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/* az_ulib_ustream_rope_init shall create an empty rope, and the rope shall release the control
+ * block when the last instance is disposed. */
+static void az_ulib_ustream_rope_init_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope* rope = (test_rope*)malloc(sizeof(test_rope));
+  assert_non_null(rope);
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  az_result result = az_ulib_ustream_rope_init(
+      &ustream_instance,
+      &rope->rope_data,
+      rope_data_release,
+      rope->segments,
+      TEST_ROPE_MAX_SEGMENTS);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  uint8_t buf[10];
+  size_t size;
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_ULIB_EOF);
+  assert_int_equal(size, 0);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_instance), AZ_OK);
+  assert_int_equal(g_rope_data_release_count, 1);
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_rope_append shall append the content of the ustream from its current position,
+ * and shall do nothing if the ustream has no remaining content. */
+static void az_ulib_ustream_rope_append_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope rope;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_rope_init(
+          &ustream_instance, &rope.rope_data, NULL, rope.segments, TEST_ROPE_MAX_SEGMENTS),
+      AZ_OK);
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream buffer;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &buffer,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+  assert_int_equal(az_ulib_ustream_advance(&buffer, 50), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ustream_rope_append(&ustream_instance, &buffer);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_ulib_ustream_advance(&buffer, 12), AZ_OK);
+  assert_int_equal(az_ulib_ustream_rope_append(&ustream_instance, &buffer), AZ_OK);
+  assert_int_equal(rope.rope_data.segment_count, 1);
+  uint8_t buf[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  size_t size;
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_OK);
+  assert_int_equal(size, 12);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 50, size);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&buffer);
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If all segments are in use, az_ulib_ustream_rope_append shall return
+ * AZ_ERROR_NOT_ENOUGH_SPACE and do not change the rope. */
+static void az_ulib_ustream_rope_append_full_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  ustream_factory(&ustream_instance);
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream buffer;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &buffer,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ustream_rope_append(&ustream_instance, &buffer);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  size_t size;
+  assert_int_equal(az_ulib_ustream_get_remaining_size(&ustream_instance, &size), AZ_OK);
+  assert_int_equal(size, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&buffer);
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If all segments are in use, but the ustream has no remaining content, az_ulib_ustream_rope_append
+ * shall return AZ_OK and do not change the rope. */
+static void az_ulib_ustream_rope_append_empty_to_full_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  ustream_factory(&ustream_instance);
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream buffer;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &buffer,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_advance(&buffer, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ustream_rope_append(&ustream_instance, &buffer);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  uint8_t buf[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  size_t size;
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_OK);
+  assert_int_equal(size, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, size);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&buffer);
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the instance does not end at the end of the rope, az_ulib_ustream_rope_append shall return
+ * AZ_ERROR_ARG. Clones created before the append shall not contain the appended content. */
+static void az_ulib_ustream_rope_append_to_old_clone_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope rope;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_rope_init(
+          &ustream_instance, &rope.rope_data, NULL, rope.segments, TEST_ROPE_MAX_SEGMENTS),
+      AZ_OK);
+  append_buffer(&ustream_instance, 0, 10);
+  az_ulib_ustream ustream_clone;
+  assert_int_equal(az_ulib_ustream_clone(&ustream_clone, &ustream_instance, 0), AZ_OK);
+  append_buffer(&ustream_instance, 10, 26);
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream buffer;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &buffer,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ustream_rope_append(&ustream_clone, &buffer);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ARG);
+  size_t size;
+  assert_int_equal(az_ulib_ustream_get_remaining_size(&ustream_clone, &size), AZ_OK);
+  assert_int_equal(size, 10);
+  assert_int_equal(az_ulib_ustream_get_remaining_size(&ustream_instance, &size), AZ_OK);
+  assert_int_equal(size, 36);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&buffer);
+  (void)az_ulib_ustream_dispose(&ustream_clone);
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The rope shall find the segment of any position, and read across segments. */
+static void az_ulib_ustream_rope_read_at_many_segments_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_rope_data_cb rope_data;
+  az_ulib_ustream_rope_segment segments[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_rope_init(
+          &ustream_instance,
+          &rope_data,
+          NULL,
+          segments,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH),
+      AZ_OK);
+  for (size_t i = 0; i < USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH; i++)
+  {
+    append_buffer(&ustream_instance, i, 1);
+  }
+  uint8_t buf[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  size_t size;
+
+  /// act
+  /// assert
+  for (size_t i = 0; i < USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH; i++)
+  {
+    assert_int_equal(az_ulib_ustream_read_at(&ustream_instance, i, buf, 5, &size), AZ_OK);
+    assert_int_equal(
+        size,
+        ((USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - i) < 5)
+            ? (USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - i)
+            : 5);
+    assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + i, size);
+  }
+  assert_int_equal(az_ulib_ustream_set_position(&ustream_instance, 30), AZ_OK);
+  const uint8_t* data;
+  assert_int_equal(az_ulib_ustream_peek(&ustream_instance, &data, &size), AZ_OK);
+  assert_ptr_equal(data, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 30);
+  assert_int_equal(size, 1);
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_OK);
+  assert_int_equal(size, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 30);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 30, size);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The rope shall read a segment that does not implement read_at from its current position. */
+static void az_ulib_ustream_rope_read_segment_without_read_at_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope rope;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_rope_init(
+          &ustream_instance, &rope.rope_data, NULL, rope.segments, TEST_ROPE_MAX_SEGMENTS),
+      AZ_OK);
+  assert_int_equal(az_ulib_ustream_rope_append(&ustream_instance, ustream_mock_create()), AZ_OK);
+  uint8_t buf[20];
+  size_t size;
+
+  /// act
+  az_result result = az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size, 10);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the segment read fails, the rope read shall return the same error. */
+static void az_ulib_ustream_rope_read_segment_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_rope rope;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_rope_init(
+          &ustream_instance, &rope.rope_data, NULL, rope.segments, TEST_ROPE_MAX_SEGMENTS),
+      AZ_OK);
+  assert_int_equal(az_ulib_ustream_rope_append(&ustream_instance, ustream_mock_create()), AZ_OK);
+  set_read_result(AZ_ERROR_ULIB_SYSTEM);
+  uint8_t buf[20];
+  size_t size;
+
+  /// act
+  az_result result = az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_SYSTEM);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+int az_ulib_ustream_rope_ut()
+{
+#ifndef AZ_NO_PRECONDITION_CHECKING
+  AZ_ULIB_SETUP_PRECONDITION_CHECK_TESTS();
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+  const struct CMUnitTest tests[] = {
+#ifndef AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test(az_ulib_ustream_rope_init_NULL_ustream_instance_failed),
+    cmocka_unit_test(az_ulib_ustream_rope_init_NULL_rope_data_failed),
+    cmocka_unit_test(az_ulib_ustream_rope_init_NULL_segments_failed),
+    cmocka_unit_test(az_ulib_ustream_rope_init_zero_max_segments_failed),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_rope_append_not_rope_failed, setup, teardown),
+    cmocka_unit_test(az_ulib_ustream_rope_append_NULL_ustream_to_append_failed),
+#endif // AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_rope_init_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_rope_append_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_rope_append_full_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_rope_append_empty_to_full_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_rope_append_to_old_clone_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_rope_read_at_many_segments_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_rope_read_segment_without_read_at_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_rope_read_segment_failed, setup, teardown),
+#ifndef AZ_NO_PRECONDITION_CHECKING
+    AZ_ULIB_USTREAM_PRECONDITION_COMPLIANCE_UT_LIST
+#endif // AZ_NO_PRECONDITION_CHECKING
+        AZ_ULIB_USTREAM_COMPLIANCE_UT_LIST
+  };
+
+  return cmocka_run_group_tests_name("az_ulib_ustream_rope_ut", tests, NULL, NULL);
+}
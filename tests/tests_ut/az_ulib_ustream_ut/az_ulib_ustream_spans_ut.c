@@ -0,0 +1,406 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream_ut.h"
+
+#include "az_ulib_ustream_mock_buffer.h"
+
+#include "az_ulib_test_precondition.h"
+#include "azure/core/az_precondition.h"
+
+#include "cmocka.h"
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT \
+  "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+
+#define TEST_SPANS_COUNT 4
+
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT
+    = (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+
+/*
+ * The spans control block, the spans, and their ends in a single allocation.
+ */
+typedef struct
+{
+  az_ulib_ustream_spans_data_cb spans_data;
+  az_span spans[TEST_SPANS_COUNT];
+  offset_t span_ends[TEST_SPANS_COUNT];
+} test_spans;
+
+static int g_spans_data_release_count;
+
+static void spans_data_release(void* release_pointer)
+{
+  g_spans_data_release_count++;
+  free(release_pointer);
+}
+
+/*
+ * Split the expected content in "0123456789", "", "ABC...Z", and "abc...z".
+ */
+static void set_test_spans(test_spans* spans)
+{
+  spans->spans[0] = az_span_create((uint8_t*)USTREAM_COMPLIANCE_EXPECTED_CONTENT, 10);
+  spans->spans[1] = AZ_SPAN_EMPTY;
+  spans->spans[2] = az_span_create((uint8_t*)USTREAM_COMPLIANCE_EXPECTED_CONTENT + 10, 26);
+  spans->spans[3] = az_span_create((uint8_t*)USTREAM_COMPLIANCE_EXPECTED_CONTENT + 36, 26);
+}
+
+static void ustream_factory(az_ulib_ustream* ustream)
+{
+  test_spans* spans = (test_spans*)malloc(sizeof(test_spans));
+  assert_non_null(spans);
+  set_test_spans(spans);
+  assert_int_equal(
+      az_ulib_ustream_init_from_spans(
+          ustream, &spans->spans_data, free, spans->spans, spans->span_ends, TEST_SPANS_COUNT),
+      AZ_OK);
+}
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream) ustream_factory(ustream)
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+AZ_ULIB_ENABLE_PRECONDITION_CHECK_TESTS()
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/**
+ * Beginning of the UT for the spans ustream.
+ */
+static int setup(void** state)
+{
+  (void)state;
+
+  g_spans_data_release_count = 0;
+
+  return 0;
+}
+
+static int teardown(void** state)
+{
+  (void)state;
+
+  reset_mock_buffer();
+
+  return 0;
+}
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+/* az_ulib_ustream_init_from_spans shall fail with precondition if the provided ustream is NULL. */
+static void az_ulib_ustream_init_from_spans_NULL_ustream_instance_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_spans spans;
+  set_test_spans(&spans);
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_init_from_spans(
+      NULL, &spans.spans_data, NULL, spans.spans, spans.span_ends, TEST_SPANS_COUNT));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_init_from_spans shall fail with precondition if the provided control block is
+ * NULL. */
+static void az_ulib_ustream_init_from_spans_NULL_spans_data_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_spans spans;
+  set_test_spans(&spans);
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_init_from_spans(
+      &ustream_instance, NULL, NULL, spans.spans, spans.span_ends, TEST_SPANS_COUNT));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_init_from_spans shall fail with precondition if the provided spans is NULL. */
+static void az_ulib_ustream_init_from_spans_NULL_spans_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_spans spans;
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_init_from_spans(
+      &ustream_instance, &spans.spans_data, NULL, NULL, spans.span_ends, TEST_SPANS_COUNT));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_init_from_spans shall fail with precondition if the provided span ends is NULL.
+ */
+static void az_ulib_ustream_init_from_spans_NULL_span_ends_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_spans spans;
+  set_test_spans(&spans);
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_init_from_spans(
+      &ustream_instance, &spans.spans_data, NULL, spans.spans, NULL, TEST_SPANS_COUNT));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_init_from_spans shall fail with precondition if the provided span count is zero.
+ */
+static void az_ulib_ustream_init_from_spans_zero_span_count_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_spans spans;
+  set_test_spans(&spans);
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_init_from_spans(
+      &ustream_instance, &spans.spans_data, NULL, spans.spans, spans.span_ends, 0));
+
+  /// cleanup
+}
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/* az_ulib_ustream_init_from_spans shall create an instance of the ustream with the content of all
+ * spans, and the ustream shall release the control block when the last instance is disposed. */
+static void az_ulib_ustream_init_from_spans_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_spans* spans = (test_spans*)malloc(sizeof(test_spans));
+  assert_non_null(spans);
+  set_test_spans(spans);
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  az_result result = az_ulib_ustream_init_from_spans(
+      &ustream_instance,
+      &spans->spans_data,
+      spans_data_release,
+      spans->spans,
+      spans->span_ends,
+      TEST_SPANS_COUNT);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  uint8_t buf[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 2];
+  size_t size;
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_OK);
+  assert_int_equal(size, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, size);
+  az_ulib_ustream ustream_instance_clone;
+  assert_int_equal(az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, 0), AZ_OK);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_instance), AZ_OK);
+  assert_int_equal(g_spans_data_release_count, 0);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_instance_clone), AZ_OK);
+  assert_int_equal(g_spans_data_release_count, 1);
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_init_from_spans shall create an empty ustream if all spans are empty. */
+static void az_ulib_ustream_init_from_spans_empty_spans_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_spans_data_cb spans_data;
+  az_span spans[2] = { AZ_SPAN_EMPTY, AZ_SPAN_EMPTY };
+  offset_t span_ends[2];
+  az_ulib_ustream ustream_instance;
+
+  /// act
+  az_result result
+      = az_ulib_ustream_init_from_spans(&ustream_instance, &spans_data, NULL, spans, span_ends, 2);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  uint8_t buf[10];
+  size_t size;
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_ULIB_EOF);
+  assert_int_equal(size, 0);
+  const uint8_t* data;
+  assert_int_equal(az_ulib_ustream_peek(&ustream_instance, &data, &size), AZ_ULIB_EOF);
+  assert_null(data);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The spans ustream peek shall return the content of the current span, skipping empty spans,
+ * without copying it. */
+static void az_ulib_ustream_spans_peek_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_spans spans;
+  set_test_spans(&spans);
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init_from_spans(
+          &ustream_instance,
+          &spans.spans_data,
+          NULL,
+          spans.spans,
+          spans.span_ends,
+          TEST_SPANS_COUNT),
+      AZ_OK);
+  const uint8_t* data;
+  size_t size;
+
+  /// act
+  /// assert
+  assert_int_equal(az_ulib_ustream_advance(&ustream_instance, 4), AZ_OK);
+  assert_int_equal(az_ulib_ustream_peek(&ustream_instance, &data, &size), AZ_OK);
+  assert_ptr_equal(data, az_span_ptr(spans.spans[0]) + 4);
+  assert_int_equal(size, 6);
+  assert_int_equal(az_ulib_ustream_advance(&ustream_instance, 6), AZ_OK);
+  assert_int_equal(az_ulib_ustream_peek(&ustream_instance, &data, &size), AZ_OK);
+  assert_ptr_equal(data, az_span_ptr(spans.spans[2]));
+  assert_int_equal(size, 26);
+  assert_int_equal(az_ulib_ustream_advance(&ustream_instance, 27), AZ_OK);
+  assert_int_equal(az_ulib_ustream_peek(&ustream_instance, &data, &size), AZ_OK);
+  assert_ptr_equal(data, az_span_ptr(spans.spans[3]) + 1);
+  assert_int_equal(size, 25);
+  assert_int_equal(az_ulib_ustream_advance(&ustream_instance, 26), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_ustream_advance(&ustream_instance, 25), AZ_OK);
+  assert_int_equal(az_ulib_ustream_peek(&ustream_instance, &data, &size), AZ_ULIB_EOF);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The spans ustream read_at shall read across spans from any position without changing the current
+ * position. */
+static void az_ulib_ustream_spans_read_at_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_spans spans;
+  set_test_spans(&spans);
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init_from_spans(
+          &ustream_instance,
+          &spans.spans_data,
+          NULL,
+          spans.spans,
+          spans.span_ends,
+          TEST_SPANS_COUNT),
+      AZ_OK);
+  uint8_t buf[30];
+  size_t size;
+
+  /// act
+  az_result result = az_ulib_ustream_read_at(&ustream_instance, 8, buf, sizeof(buf), &size);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size, 30);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 8, size);
+  offset_t position;
+  assert_int_equal(az_ulib_ustream_get_position(&ustream_instance, &position), AZ_OK);
+  assert_int_equal(position, 0);
+  assert_int_equal(
+      az_ulib_ustream_read_at(&ustream_instance, 62, buf, sizeof(buf), &size), AZ_ULIB_EOF);
+  assert_int_equal(
+      az_ulib_ustream_read_at(&ustream_instance, 63, buf, sizeof(buf), &size),
+      AZ_ERROR_ITEM_NOT_FOUND);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_to_span_array shall return the spans of a spans ustream, skipping empty spans,
+ * and clamping the last one to the end of a split ustream. */
+static void az_ulib_ustream_spans_to_span_array_after_split_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_spans spans;
+  set_test_spans(&spans);
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init_from_spans(
+          &ustream_instance,
+          &spans.spans_data,
+          NULL,
+          spans.spans,
+          spans.span_ends,
+          TEST_SPANS_COUNT),
+      AZ_OK);
+  az_ulib_ustream ustream_instance_split;
+  assert_int_equal(az_ulib_ustream_split(&ustream_instance, &ustream_instance_split, 20), AZ_OK);
+  az_span span_array[TEST_SPANS_COUNT];
+  size_t span_count;
+
+  /// act
+  az_result result = az_ulib_ustream_to_span_array(
+      &ustream_instance, span_array, TEST_SPANS_COUNT, &span_count);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(span_count, 2);
+  assert_ptr_equal(az_span_ptr(span_array[0]), az_span_ptr(spans.spans[0]));
+  assert_int_equal(az_span_size(span_array[0]), 10);
+  assert_ptr_equal(az_span_ptr(span_array[1]), az_span_ptr(spans.spans[2]));
+  assert_int_equal(az_span_size(span_array[1]), 10);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance_split);
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+int az_ulib_ustream_spans_ut()
+{
+#ifndef AZ_NO_PRECONDITION_CHECKING
+  AZ_ULIB_SETUP_PRECONDITION_CHECK_TESTS();
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+  const struct CMUnitTest tests[] = {
+#ifndef AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test(az_ulib_ustream_init_from_spans_NULL_ustream_instance_failed),
+    cmocka_unit_test(az_ulib_ustream_init_from_spans_NULL_spans_data_failed),
+    cmocka_unit_test(az_ulib_ustream_init_from_spans_NULL_spans_failed),
+    cmocka_unit_test(az_ulib_ustream_init_from_spans_NULL_span_ends_failed),
+    cmocka_unit_test(az_ulib_ustream_init_from_spans_zero_span_count_failed),
+#endif // AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_init_from_spans_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_init_from_spans_empty_spans_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_spans_peek_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_spans_read_at_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_spans_to_span_array_after_split_succeed, setup, teardown),
+#ifndef AZ_NO_PRECONDITION_CHECKING
+    AZ_ULIB_USTREAM_PRECONDITION_COMPLIANCE_UT_LIST
+#endif // AZ_NO_PRECONDITION_CHECKING
+        AZ_ULIB_USTREAM_COMPLIANCE_UT_LIST
+  };
+
+  return cmocka_run_group_tests_name("az_ulib_ustream_spans_ut", tests, NULL, NULL);
+}
@@ -153,6 +153,32 @@ static void az_ulib_ustream_init_NULL_control_block_failed(void** state)
 
   /// cleanup
 }
+
+/* az_ulib_ustream_peek shall fail with precondition if the provided data is NULL. */
+static void az_ulib_ustream_peek_NULL_data_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_instance,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+  size_t size;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_peek(&ustream_instance, NULL, &size));
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
 #endif // AZ_NO_PRECONDITION_CHECKING
 
 /* az_ulib_ustream_init shall create an instance of the ustream and initialize the instance. */
@@ -209,6 +235,223 @@ static void az_ulib_ustream_init_succeed(void** state)
   (void)az_ulib_ustream_dispose(&ustream_instance);
 }
 
+/* az_ulib_ustream_peek shall return the content at the current position without moving it. */
+static void az_ulib_ustream_peek_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_instance,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+  uint8_t buf[10];
+  size_t size;
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_OK);
+  const uint8_t* data;
+
+  /// act
+  az_result result = az_ulib_ustream_peek(&ustream_instance, &data, &size);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_ptr_equal(data, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 10);
+  assert_int_equal(size, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 10);
+  offset_t position;
+  assert_int_equal(az_ulib_ustream_get_position(&ustream_instance, &position), AZ_OK);
+  assert_int_equal(position, 10);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If there is no more content, az_ulib_ustream_peek shall return AZ_ULIB_EOF with size 0. */
+static void az_ulib_ustream_peek_end_of_ustream_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_instance,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_advance(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH),
+      AZ_OK);
+  const uint8_t* data = USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT;
+  size_t size = 1;
+
+  /// act
+  az_result result = az_ulib_ustream_peek(&ustream_instance, &data, &size);
+
+  /// assert
+  assert_int_equal(result, AZ_ULIB_EOF);
+  assert_null(data);
+  assert_int_equal(size, 0);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_advance shall move the current position forward. */
+static void az_ulib_ustream_advance_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_instance,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ustream_advance(&ustream_instance, 10);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  uint8_t buf[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  size_t size;
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size), AZ_OK);
+  assert_int_equal(size, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 10);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 10, size);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the size is bigger than the remaining size, az_ulib_ustream_advance shall return
+ * AZ_ERROR_ITEM_NOT_FOUND and do not change the current position. */
+static void az_ulib_ustream_advance_out_of_range_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_instance,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+  assert_int_equal(az_ulib_ustream_advance(&ustream_instance, 10), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ustream_advance(
+      &ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 9);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  offset_t position;
+  assert_int_equal(az_ulib_ustream_get_position(&ustream_instance, &position), AZ_OK);
+  assert_int_equal(position, 10);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_read_at shall copy the content at the provided position without moving the
+ * current position. */
+static void az_ulib_ustream_read_at_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_instance,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+  uint8_t buf[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  size_t size;
+
+  /// act
+  az_result result = az_ulib_ustream_read_at(&ustream_instance, 50, buf, sizeof(buf), &size);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 50);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 50, size);
+  offset_t position;
+  assert_int_equal(az_ulib_ustream_get_position(&ustream_instance, &position), AZ_OK);
+  assert_int_equal(position, 0);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_read_at shall return AZ_ULIB_EOF at the end of the ustream, and
+ * AZ_ERROR_ITEM_NOT_FOUND out of the valid positions of the ustream. */
+static void az_ulib_ustream_read_at_out_of_range_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_instance,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+  assert_int_equal(az_ulib_ustream_advance(&ustream_instance, 10), AZ_OK);
+  assert_int_equal(az_ulib_ustream_release(&ustream_instance, 4), AZ_OK);
+  uint8_t buf[10];
+  size_t size;
+
+  /// act
+  /// assert
+  assert_int_equal(
+      az_ulib_ustream_read_at(
+          &ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, buf, sizeof(buf), &size),
+      AZ_ULIB_EOF);
+  assert_int_equal(size, 0);
+  assert_int_equal(
+      az_ulib_ustream_read_at(
+          &ustream_instance,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 1,
+          buf,
+          sizeof(buf),
+          &size),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_ustream_read_at(&ustream_instance, 4, buf, sizeof(buf), &size),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_ustream_read_at(&ustream_instance, 5, buf, sizeof(buf), &size), AZ_OK);
+  assert_memory_equal(buf, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 5, size);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
 #include "az_ulib_ustream_compliance_ut.h"
 
 int az_ulib_ustream_ut()
@@ -223,9 +466,16 @@ int az_ulib_ustream_ut()
     cmocka_unit_test(az_ulib_ustream_init_zero_length_failed),
     cmocka_unit_test(az_ulib_ustream_init_NULL_ustream_instance_failed),
     cmocka_unit_test(az_ulib_ustream_init_NULL_control_block_failed),
+    cmocka_unit_test(az_ulib_ustream_peek_NULL_data_failed),
 #endif // AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test_setup_teardown(az_ulib_ustream_init_const_succeed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_ustream_init_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_peek_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_peek_end_of_ustream_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_advance_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_advance_out_of_range_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_read_at_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_read_at_out_of_range_failed, setup, teardown),
 #ifndef AZ_NO_PRECONDITION_CHECKING
     AZ_ULIB_USTREAM_PRECONDITION_COMPLIANCE_UT_LIST
 #endif // AZ_NO_PRECONDITION_CHECKING
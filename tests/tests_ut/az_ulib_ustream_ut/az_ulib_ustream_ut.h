@@ -4,3 +4,6 @@
 
 int az_ulib_ustream_ut();
 int az_ulib_ustream_aux_ut();
+int az_ulib_ustream_file_ut();
+int az_ulib_ustream_rope_ut();
+int az_ulib_ustream_spans_ut();
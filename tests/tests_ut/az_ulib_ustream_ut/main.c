@@ -14,6 +14,12 @@ int main(void)
   result += az_ulib_ustream_ut();
   (void)printf("[==========]\r\n[ STARTING ] Running az_ulib_ustream_aux_ut.\r\n");
   result += az_ulib_ustream_aux_ut();
+  (void)printf("[==========]\r\n[ STARTING ] Running az_ulib_ustream_file_ut.\r\n");
+  result += az_ulib_ustream_file_ut();
+  (void)printf("[==========]\r\n[ STARTING ] Running az_ulib_ustream_rope_ut.\r\n");
+  result += az_ulib_ustream_rope_ut();
+  (void)printf("[==========]\r\n[ STARTING ] Running az_ulib_ustream_spans_ut.\r\n");
+  result += az_ulib_ustream_spans_ut();
 
   return result;
 }